@@ -0,0 +1,13 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    CubeKernels \
+    GameBoard \
+    GameLog \
+    MoveCheck \
+    MoveGen \
+    PathFinder \
+    Replay \
+    Runner \
+    Snapshot
+
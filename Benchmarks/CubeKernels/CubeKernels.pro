@@ -0,0 +1,25 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_cubekernelsbench
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    tst_cubekernelsbench.cpp \
+    ../../GameLogic/Engine/cubekernels.cpp
+
+HEADERS += \
+    ../../GameLogic/Engine/boardindex.hh \
+    ../../GameLogic/Engine/cubecoordinate.hh \
+    ../../GameLogic/Engine/cubekernels.hh
+
+INCLUDEPATH += ../../GameLogic/Engine/
+DEPENDPATH  += ../../GameLogic/Engine/
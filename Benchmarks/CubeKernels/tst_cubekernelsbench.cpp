@@ -0,0 +1,127 @@
+#include <QString>
+#include <QtTest>
+#include <random>
+#include <vector>
+
+#include "boardindex.hh"
+#include "cubekernels.hh"
+
+const unsigned BCH_SEED = 20181121;
+
+// Coordinates in one batch
+const std::size_t BCH_COORDS = 1000000;
+
+// Coordinates are spread over a board of this radius
+const int BCH_RADIUS = 20;
+
+using Common::CubeKernels::KernelLevel;
+
+class CubeKernelsBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    CubeKernelsBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // Distances of a batch from one origin
+    void benchDistances_data();
+    void benchDistances();
+
+    // The six neighbours of every coordinate of a batch
+    void benchNeighbours_data();
+    void benchNeighbours();
+
+private:
+    void addLevels() const;
+
+    std::vector<Common::CubeCoordinate> coords_;
+    Common::CubeCoordinate origin_;
+};
+
+void CubeKernelsBench::initTestCase()
+{
+    std::mt19937 rng(BCH_SEED);
+    std::uniform_int_distribution<int> axis(-BCH_RADIUS, BCH_RADIUS);
+
+    coords_.reserve(BCH_COORDS);
+    while (coords_.size() < BCH_COORDS) {
+        int x = axis(rng);
+        int z = axis(rng);
+        Common::CubeCoordinate coord(x, -x - z, z);
+        if (Common::BoardIndex::distanceFromCenter(coord) <= BCH_RADIUS) {
+            coords_.push_back(coord);
+        }
+    }
+    origin_ = Common::CubeCoordinate(3, -5, 2);
+
+    qDebug("Kernels use %s", Common::CubeKernels::levelName(
+               Common::CubeKernels::supportedLevel()));
+}
+
+void CubeKernelsBench::addLevels() const
+{
+    QTest::addColumn<int>("level");
+    QTest::newRow("scalar") << static_cast<int>(KernelLevel::SCALAR);
+    QTest::newRow("sse2") << static_cast<int>(KernelLevel::SSE2);
+    QTest::newRow("avx2") << static_cast<int>(KernelLevel::AVX2);
+}
+
+void CubeKernelsBench::benchDistances_data()
+{
+    addLevels();
+}
+
+void CubeKernelsBench::benchDistances()
+{
+    QFETCH(int, level);
+    KernelLevel kernelLevel = static_cast<KernelLevel>(level);
+    if (kernelLevel > Common::CubeKernels::supportedLevel()) {
+        QSKIP("The processor doesn't support the instruction set");
+    }
+
+    std::vector<int> distances(coords_.size());
+    QBENCHMARK {
+        Common::CubeKernels::distancesFrom(origin_, coords_.data(),
+                                           coords_.size(), distances.data(),
+                                           kernelLevel);
+    }
+
+    std::vector<int> expected(coords_.size());
+    Common::CubeKernels::distancesFrom(origin_, coords_.data(),
+                                       coords_.size(), expected.data(),
+                                       KernelLevel::SCALAR);
+    QVERIFY(distances == expected);
+}
+
+void CubeKernelsBench::benchNeighbours_data()
+{
+    addLevels();
+}
+
+void CubeKernelsBench::benchNeighbours()
+{
+    QFETCH(int, level);
+    KernelLevel kernelLevel = static_cast<KernelLevel>(level);
+    if (kernelLevel > Common::CubeKernels::supportedLevel()) {
+        QSKIP("The processor doesn't support the instruction set");
+    }
+
+    std::vector<Common::CubeCoordinate> neighbours(
+                coords_.size() * Common::HEX_NEIGHBOURS);
+    QBENCHMARK {
+        Common::CubeKernels::neighboursOf(coords_.data(), coords_.size(),
+                                          neighbours.data(), kernelLevel);
+    }
+
+    std::vector<Common::CubeCoordinate> expected(neighbours.size());
+    Common::CubeKernels::neighboursOf(coords_.data(), coords_.size(),
+                                      expected.data(), KernelLevel::SCALAR);
+    QVERIFY(neighbours == expected);
+}
+
+QTEST_APPLESS_MAIN(CubeKernelsBench)
+
+#include "tst_cubekernelsbench.moc"
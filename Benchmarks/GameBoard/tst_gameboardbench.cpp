@@ -0,0 +1,392 @@
+#include <QString>
+#include <QFile>
+#include <QtTest>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gameboard.hh"
+#include "flatgameboard.hh"
+#include "columngameboard.hh"
+#include "initialize.hh"
+#include "illegalmoveexception.hh"
+#include "hex.hh"
+#include "actor.hh"
+#include "transport.hh"
+#include "shark.hh"
+#include "kraken.hh"
+#include "seamunster.hh"
+#include "vortex.hh"
+#include "boat.hh"
+#include "dolphin.hh"
+#include "benchfixture.hh"
+
+// Seed of the recorded game, fixed so that every run replays the same calls.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_MAX_TURNS = 400;
+const int BCH_MOVE_ATTEMPTS = 8;
+const int BCH_MOVE_RANGE = 3;
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief One call the engine made to its IGameBoard.
+ */
+struct BoardCall
+{
+    enum Operation {
+        CHECK_OCCUPATION, IS_WATER, GET_HEX, RESERVE, ADD_HEX,
+        ADD_PAWN, MOVE_PAWN, REMOVE_PAWN,
+        ADD_ACTOR, MOVE_ACTOR, REMOVE_ACTOR,
+        ADD_TRANSPORT, MOVE_TRANSPORT, REMOVE_TRANSPORT
+    };
+
+    Operation operation;
+    Common::CubeCoordinate coord;
+    int id;
+    int owner;
+    std::string type;
+};
+
+/**
+ * @brief IGameBoard that forwards every call to a GameBoard and records it.
+ */
+class RecordingBoard : public Common::IGameBoard
+{
+public:
+    RecordingBoard(): board_(std::make_shared<Student::GameBoard>()) {}
+
+    virtual int checkTileOccupation(Common::CubeCoordinate tileCoord) const
+    {
+        record(BoardCall::CHECK_OCCUPATION, tileCoord);
+        return board_->checkTileOccupation(tileCoord);
+    }
+    virtual bool isWaterTile(Common::CubeCoordinate tileCoord) const
+    {
+        record(BoardCall::IS_WATER, tileCoord);
+        return board_->isWaterTile(tileCoord);
+    }
+    virtual std::shared_ptr<Common::Hex> getHex(Common::CubeCoordinate hexCoord) const
+    {
+        record(BoardCall::GET_HEX, hexCoord);
+        return board_->getHex(hexCoord);
+    }
+    virtual void addPawn(int playerId, int pawnId)
+    {
+        board_->addPawn(playerId, pawnId);
+    }
+    virtual void addPawn(int playerId, int pawnId, Common::CubeCoordinate coord)
+    {
+        record(BoardCall::ADD_PAWN, coord, pawnId, playerId);
+        board_->addPawn(playerId, pawnId, coord);
+    }
+    virtual void movePawn(int pawnId, Common::CubeCoordinate pawnCoord)
+    {
+        record(BoardCall::MOVE_PAWN, pawnCoord, pawnId);
+        board_->movePawn(pawnId, pawnCoord);
+    }
+    virtual void removePawn(int pawnId)
+    {
+        record(BoardCall::REMOVE_PAWN, Common::CubeCoordinate(), pawnId);
+        board_->removePawn(pawnId);
+    }
+    virtual void addActor(std::shared_ptr<Common::Actor> actor,
+                          Common::CubeCoordinate actorCoord)
+    {
+        record(BoardCall::ADD_ACTOR, actorCoord, actor->getId(), 0,
+               actor->getActorType());
+        board_->addActor(actor, actorCoord);
+    }
+    virtual void moveActor(int actorId, Common::CubeCoordinate actorCoord)
+    {
+        record(BoardCall::MOVE_ACTOR, actorCoord, actorId);
+        board_->moveActor(actorId, actorCoord);
+    }
+    virtual void removeActor(int actorId)
+    {
+        record(BoardCall::REMOVE_ACTOR, Common::CubeCoordinate(), actorId);
+        board_->removeActor(actorId);
+    }
+    virtual void addHex(std::shared_ptr<Common::Hex> newHex)
+    {
+        record(BoardCall::ADD_HEX, newHex->getCoordinates(), 0, 0,
+               newHex->getPieceType());
+        board_->addHex(newHex);
+    }
+    virtual void reserveRadius(int radius)
+    {
+        record(BoardCall::RESERVE, Common::CubeCoordinate(), radius);
+        board_->reserveRadius(radius);
+    }
+    virtual void addTransport(std::shared_ptr<Common::Transport> transport,
+                              Common::CubeCoordinate coord)
+    {
+        record(BoardCall::ADD_TRANSPORT, coord, transport->getId(), 0,
+               transport->getTransportType());
+        board_->addTransport(transport, coord);
+    }
+    virtual void moveTransport(int id, Common::CubeCoordinate coord)
+    {
+        record(BoardCall::MOVE_TRANSPORT, coord, id);
+        board_->moveTransport(id, coord);
+    }
+    virtual void removeTransport(int id)
+    {
+        record(BoardCall::REMOVE_TRANSPORT, Common::CubeCoordinate(), id);
+        board_->removeTransport(id);
+    }
+
+    std::shared_ptr<Student::GameBoard> board() const { return board_; }
+    const std::vector<BoardCall>& calls() const { return calls_; }
+
+private:
+    void record(BoardCall::Operation operation, Common::CubeCoordinate coord,
+                int id = 0, int owner = 0, std::string type = "") const
+    {
+        calls_.push_back(BoardCall{operation, coord, id, owner, type});
+    }
+
+    std::shared_ptr<Student::GameBoard> board_;
+    mutable std::vector<BoardCall> calls_;
+};
+
+std::shared_ptr<Common::Actor> makeActor(const std::string& type, int id)
+{
+    if (type == "kraken") {
+        return std::make_shared<Common::Kraken>(id);
+    } else if (type == "seamunster") {
+        return std::make_shared<Common::Seamunster>(id);
+    } else if (type == "vortex") {
+        return std::make_shared<Common::Vortex>(id);
+    }
+    return std::make_shared<Common::Shark>(id);
+}
+
+std::shared_ptr<Common::Transport> makeTransport(const std::string& type, int id)
+{
+    if (type == "dolphin") {
+        return std::make_shared<Common::Dolphin>(id);
+    }
+    return std::make_shared<Common::Boat>(id);
+}
+
+}
+
+class GameBoardBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameBoardBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // Whole recorded game replayed against a fresh board
+    void benchReplay_data();
+    void benchReplay();
+
+    // Lookups only, against a board filled by the recorded game
+    void benchGetHex_data();
+    void benchGetHex();
+
+private:
+    std::vector<BoardCall> trace_;
+
+    void recordGame();
+    std::shared_ptr<Common::IGameBoard> createBoard(const QString& name) const;
+    int replay(Common::IGameBoard& board) const;
+};
+
+void GameBoardBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+    recordGame();
+    QVERIFY(!trace_.empty());
+}
+
+void GameBoardBench::recordGame()
+{
+    auto board = std::make_shared<RecordingBoard>();
+    auto state = std::make_shared<BenchState>();
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    auto runner = Common::Initialization::getGameRunner(board, state, players);
+
+    std::vector<Common::CubeCoordinate> coords;
+    for (const auto& hex : board->board()->returnHexes()) {
+        coords.push_back(hex.first);
+    }
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        board->addPawn(id, id, Common::CubeCoordinate(0, 0, 0));
+    }
+
+    std::mt19937 rng(BCH_SEED);
+    std::uniform_int_distribution<int> offset(-BCH_MOVE_RANGE, BCH_MOVE_RANGE);
+
+    for (int turn = 0; turn < BCH_MAX_TURNS; ++turn) {
+        int playerId = state->currentPlayer();
+        auto player = runner->getCurrentPlayer();
+
+        // Movement: a handful of random attempts near the pawn
+        auto pawn = board->board()->getPawn(playerId);
+        for (int i = 0; pawn != nullptr && i < BCH_MOVE_ATTEMPTS; ++i) {
+            Common::CubeCoordinate origin = pawn->getCoordinates();
+            int dx = offset(rng);
+            int dz = offset(rng);
+            Common::CubeCoordinate target(origin.x + dx,
+                                          origin.y - dx - dz,
+                                          origin.z + dz);
+            if (runner->checkPawnMovement(origin, target, playerId) >= 0) {
+                runner->movePawn(origin, target, playerId);
+            }
+        }
+
+        // Sinking: flip the first tile the rules allow
+        std::shuffle(coords.begin(), coords.end(), rng);
+        bool flipped = false;
+        for (const auto& coord : coords) {
+            try {
+                runner->flipTile(coord);
+                flipped = true;
+                break;
+            } catch (Common::IllegalMoveException&) {
+            }
+        }
+        if (!flipped) {
+            break;
+        }
+
+        // Spinning and next player
+        runner->spinWheel();
+        player->setActionsLeft(3);
+        state->changeGamePhase(Common::GamePhase::MOVEMENT);
+        state->changePlayerTurn(playerId % BCH_PLAYERS + 1);
+    }
+
+    trace_ = board->calls();
+}
+
+std::shared_ptr<Common::IGameBoard> GameBoardBench::createBoard(
+        const QString& name) const
+{
+    if (name == "flat") {
+        return std::make_shared<Student::FlatGameBoard>();
+    }
+    if (name == "column") {
+        return std::make_shared<Student::ColumnGameBoard>();
+    }
+    return std::make_shared<Student::GameBoard>();
+}
+
+int GameBoardBench::replay(Common::IGameBoard& board) const
+{
+    // Sum of the query results, keeps the lookups from being optimized away
+    int checksum = 0;
+    for (const auto& call : trace_) {
+        switch (call.operation) {
+        case BoardCall::CHECK_OCCUPATION:
+            checksum += board.checkTileOccupation(call.coord);
+            break;
+        case BoardCall::IS_WATER:
+            checksum += board.isWaterTile(call.coord);
+            break;
+        case BoardCall::GET_HEX:
+            checksum += board.getHex(call.coord) != nullptr;
+            break;
+        case BoardCall::RESERVE:
+            board.reserveRadius(call.id);
+            break;
+        case BoardCall::ADD_HEX: {
+            auto hex = std::make_shared<Common::Hex>();
+            hex->setCoordinates(call.coord);
+            hex->setPieceType(call.type);
+            board.addHex(hex);
+            break;
+        }
+        case BoardCall::ADD_PAWN:
+            board.addPawn(call.owner, call.id, call.coord);
+            break;
+        case BoardCall::MOVE_PAWN:
+            board.movePawn(call.id, call.coord);
+            break;
+        case BoardCall::REMOVE_PAWN:
+            board.removePawn(call.id);
+            break;
+        case BoardCall::ADD_ACTOR:
+            board.addActor(makeActor(call.type, call.id), call.coord);
+            break;
+        case BoardCall::MOVE_ACTOR:
+            board.moveActor(call.id, call.coord);
+            break;
+        case BoardCall::REMOVE_ACTOR:
+            board.removeActor(call.id);
+            break;
+        case BoardCall::ADD_TRANSPORT:
+            board.addTransport(makeTransport(call.type, call.id), call.coord);
+            break;
+        case BoardCall::MOVE_TRANSPORT:
+            board.moveTransport(call.id, call.coord);
+            break;
+        case BoardCall::REMOVE_TRANSPORT:
+            board.removeTransport(call.id);
+            break;
+        }
+    }
+    return checksum;
+}
+
+void GameBoardBench::benchReplay_data()
+{
+    QTest::addColumn<QString>("boardType");
+    QTest::newRow("map") << QString("map");
+    QTest::newRow("flat") << QString("flat");
+    QTest::newRow("column") << QString("column");
+}
+
+void GameBoardBench::benchReplay()
+{
+    QFETCH(QString, boardType);
+    int checksum = 0;
+    QBENCHMARK {
+        std::shared_ptr<Common::IGameBoard> board = createBoard(boardType);
+        checksum = replay(*board);
+    }
+    QVERIFY(checksum > 0);
+}
+
+void GameBoardBench::benchGetHex_data()
+{
+    benchReplay_data();
+}
+
+void GameBoardBench::benchGetHex()
+{
+    QFETCH(QString, boardType);
+    std::shared_ptr<Common::IGameBoard> board = createBoard(boardType);
+    replay(*board);
+
+    int found = 0;
+    QBENCHMARK {
+        for (const auto& call : trace_) {
+            if (call.operation == BoardCall::GET_HEX) {
+                found += board->getHex(call.coord) != nullptr;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_APPLESS_MAIN(GameBoardBench)
+
+#include "tst_gameboardbench.moc"
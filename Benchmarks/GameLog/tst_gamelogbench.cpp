@@ -0,0 +1,234 @@
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "gamelog.hh"
+#include "initialize.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked game, fixed so that every run logs the same game.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+// Turns played into the log that is read back
+const int BCH_TURNS = 10;
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+// Records the move of a movement action the way the game runner does
+void appendMove(Common::GameLog& log, const Common::GameAction& action)
+{
+    if (action.type == Common::GameAction::MOVE_PAWN) {
+        log.pawnMoved(action.id, action.origin, action.target,
+                      action.movesLeft);
+    } else {
+        log.transportMoved(action.id, action.origin, action.target,
+                           action.movesLeft);
+    }
+}
+
+// QBENCHMARK reports the time of one pass, the budget of the log is per
+// record
+void reportTime(const char* name, std::size_t count, qint64 nsecs)
+{
+    if (count > 0) {
+        qDebug("%s: %zu records, %.1f ns each", name, count,
+               static_cast<double>(nsecs) / count);
+    }
+}
+
+}
+
+class GameLogBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameLogBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // Recording the moves of the movement phase
+    void benchAppend();
+
+    // Decoding the log of a game played for a while
+    void benchRead();
+
+    // Every action of the movement phase made and taken back without and
+    // with a log, the difference is the cost of logging in the engine
+    void benchMakeUnmake();
+    void benchMakeUnmakeLogged();
+
+private:
+    void makeUnmake(bool logged, const char* name);
+
+    std::shared_ptr<Student::FlatGameBoard> board_;
+    std::shared_ptr<BenchState> state_;
+    std::shared_ptr<Common::IGameRunner> runner_;
+    std::shared_ptr<Common::GameLog> log_;
+    std::vector<Common::GameAction> moves_;
+};
+
+void GameLogBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+
+    board_ = std::make_shared<Student::FlatGameBoard>();
+    state_ = std::make_shared<BenchState>();
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    runner_ = Common::Initialization::getGameRunner(board_, state_, players,
+                                                    BCH_SEED);
+    log_ = std::make_shared<Common::GameLog>();
+    runner_->setGameLog(log_);
+
+    int pawnId = 0;
+    for (const auto& hex : board_->returnHexes()) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!hex.second->isWaterTile()) {
+            board_->addPawn(pawnId % BCH_PLAYERS + 1, pawnId, hex.first);
+            ++pawnId;
+        }
+    }
+
+    // Every turn moves the first pawn or transport, flips a tile and spins
+    std::vector<Common::GameAction> actions;
+    for (int turn = 0; turn < BCH_TURNS; ++turn) {
+        state_->changeGamePhase(Common::GamePhase::MOVEMENT);
+        actions.clear();
+        if (runner_->legalActions(actions) > 0) {
+            runner_->makeAction(actions.front());
+        }
+        state_->changeGamePhase(Common::GamePhase::SINKING);
+        actions.clear();
+        if (runner_->legalActions(actions) > 0) {
+            runner_->makeAction(actions.back());
+        }
+        runner_->spinWheel();
+        state_->changePlayerTurn(turn % BCH_PLAYERS + 1);
+        runner_->getCurrentPlayer()->setActionsLeft(3);
+    }
+    state_->changeGamePhase(Common::GamePhase::MOVEMENT);
+
+    runner_->legalActions(moves_);
+    QVERIFY(!moves_.empty());
+}
+
+void GameLogBench::benchAppend()
+{
+    Common::GameLog log;
+    Common::GameLog::Mark start = log.mark();
+
+    std::size_t appended = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        log.rewind(start);
+        for (const auto& move : moves_) {
+            appendMove(log, move);
+        }
+        appended += moves_.size();
+    }
+    reportTime("append", appended, timer.nsecsElapsed());
+    qDebug("append: %.1f bytes each",
+           static_cast<double>(log.size() - start.size) / moves_.size());
+
+    // The records decode to the moves
+    Common::GameLog::Reader reader(log);
+    Common::GameLog::Record record;
+    for (const auto& move : moves_) {
+        QVERIFY(reader.next(record));
+        QCOMPARE(record.type,
+                 move.type == Common::GameAction::MOVE_PAWN ?
+                     Common::GameLog::RecordType::PAWN_MOVED :
+                     Common::GameLog::RecordType::TRANSPORT_MOVED);
+        QCOMPARE(record.id, move.id);
+        QVERIFY(record.origin == move.origin);
+        QVERIFY(record.target == move.target);
+        QCOMPARE(record.value, static_cast<std::int64_t>(move.movesLeft));
+    }
+    QVERIFY(!reader.next(record));
+}
+
+void GameLogBench::benchRead()
+{
+    Common::GameLog::Record record;
+    std::size_t read = 0;
+    std::size_t records = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        Common::GameLog::Reader reader(*log_);
+        records = 0;
+        while (reader.next(record)) {
+            ++records;
+        }
+        read += records;
+    }
+    reportTime("read", read, timer.nsecsElapsed());
+
+    // The game, its pawns and every turn are in the log
+    QVERIFY(records >= 1 + BCH_PLAYERS * BCH_PAWNS_PER_PLAYER + BCH_TURNS);
+    Common::GameLog::Reader reader(*log_);
+    QVERIFY(reader.next(record));
+    QCOMPARE(record.type, Common::GameLog::RecordType::GAME_STARTED);
+    QCOMPARE(record.value, static_cast<std::int64_t>(BCH_SEED));
+    QCOMPARE(record.id, BCH_PLAYERS);
+}
+
+void GameLogBench::makeUnmake(bool logged, const char* name)
+{
+    std::size_t logSize = log_->size();
+    runner_->setGameLog(logged ? log_ : nullptr);
+
+    std::size_t made = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (const auto& move : moves_) {
+            QCOMPARE(runner_->makeAction(move), move.movesLeft);
+            runner_->unmakeAction();
+        }
+        made += moves_.size();
+    }
+    if (made > 0) {
+        qDebug("%s: %.1f ns per action", name,
+               static_cast<double>(timer.nsecsElapsed()) / made);
+    }
+
+    runner_->setGameLog(log_);
+    // The records of the taken back actions are dropped
+    QCOMPARE(log_->size(), logSize);
+}
+
+void GameLogBench::benchMakeUnmake()
+{
+    makeUnmake(false, "make and unmake");
+}
+
+void GameLogBench::benchMakeUnmakeLogged()
+{
+    makeUnmake(true, "make and unmake logged");
+}
+
+QTEST_APPLESS_MAIN(GameLogBench)
+
+#include "tst_gamelogbench.moc"
@@ -0,0 +1,195 @@
+#include <QString>
+#include <QFile>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "initialize.hh"
+#include "hex.hh"
+#include "pawn.hh"
+#include "actor.hh"
+#include "transport.hh"
+#include "shark.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked game, fixed so that every run checks the same board.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+// Id of the shark added next to the island, far from the generated ids
+const int BCH_SHARK_ID = 1000;
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief A piece on the board and the hex it stands on.
+ */
+struct Occupant
+{
+    Common::CubeCoordinate coord;
+    int id;
+};
+
+}
+
+class MoveCheckBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    MoveCheckBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // The lookups of one move check, through shared or borrowed pointers
+    void benchLookup_data();
+    void benchLookup();
+
+    // Every target of the board checked for each piece
+    void benchCheckPawn();
+    void benchCheckActor();
+    void benchCheckTransport();
+
+private:
+    std::shared_ptr<Student::FlatGameBoard> board_;
+    std::shared_ptr<Common::IGameRunner> runner_;
+    std::vector<Common::CubeCoordinate> coords_;
+    std::vector<Occupant> pawns_;
+    std::vector<Occupant> actors_;
+    std::vector<Occupant> transports_;
+};
+
+void MoveCheckBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+
+    board_ = std::make_shared<Student::FlatGameBoard>();
+    auto state = std::make_shared<BenchState>();
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    runner_ = Common::Initialization::getGameRunner(board_, state, players,
+                                                    BCH_SEED);
+
+    Common::CubeCoordinate water;
+    for (const auto& hex : board_->returnHexes()) {
+        coords_.push_back(hex.first);
+        if (hex.second->isWaterTile()) {
+            water = hex.first;
+        }
+        for (const auto& transport : hex.second->getTransports()) {
+            transports_.push_back(Occupant{hex.first, transport->getId()});
+        }
+    }
+
+    // Pawns of every player on the land hexes around the center
+    int pawnId = 0;
+    for (const auto& coord : coords_) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!board_->isWaterTile(coord)) {
+            board_->addPawn(pawnId % BCH_PLAYERS + 1, pawnId, coord);
+            pawns_.push_back(Occupant{coord, pawnId});
+            ++pawnId;
+        }
+    }
+
+    board_->addActor(std::make_shared<Common::Shark>(BCH_SHARK_ID), water);
+    actors_.push_back(Occupant{water, BCH_SHARK_ID});
+
+    QVERIFY(!pawns_.empty());
+    QVERIFY(!transports_.empty());
+}
+
+void MoveCheckBench::benchLookup_data()
+{
+    QTest::addColumn<bool>("borrowed");
+    QTest::newRow("shared") << false;
+    QTest::newRow("borrowed") << true;
+}
+
+void MoveCheckBench::benchLookup()
+{
+    QFETCH(bool, borrowed);
+
+    // Each query resolves the source and target hex and the moved piece, as
+    // the checks of the game engine do
+    int found = 0;
+    QBENCHMARK {
+        for (const auto& target : coords_) {
+            for (const auto& pawn : pawns_) {
+                if (borrowed) {
+                    Common::Hex* source = board_->findHex(pawn.coord);
+                    Common::Hex* hex = board_->findHex(target);
+                    found += hex != nullptr &&
+                            source->findPawn(pawn.id) != nullptr;
+                } else {
+                    std::shared_ptr<Common::Hex> source =
+                            board_->getHex(pawn.coord);
+                    std::shared_ptr<Common::Hex> hex = board_->getHex(target);
+                    found += hex != nullptr &&
+                            source->givePawn(pawn.id) != nullptr;
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void MoveCheckBench::benchCheckPawn()
+{
+    int legal = 0;
+    QBENCHMARK {
+        for (const auto& target : coords_) {
+            for (const auto& pawn : pawns_) {
+                legal += runner_->checkPawnMovement(pawn.coord, target,
+                                                    pawn.id) >= 0;
+            }
+        }
+    }
+    QVERIFY(legal > 0);
+}
+
+void MoveCheckBench::benchCheckActor()
+{
+    int legal = 0;
+    QBENCHMARK {
+        for (const auto& target : coords_) {
+            for (const auto& actor : actors_) {
+                legal += runner_->checkActorMovement(actor.coord, target,
+                                                     actor.id, "1");
+            }
+        }
+    }
+    QVERIFY(legal > 0);
+}
+
+void MoveCheckBench::benchCheckTransport()
+{
+    int legal = 0;
+    QBENCHMARK {
+        for (const auto& target : coords_) {
+            for (const auto& transport : transports_) {
+                legal += runner_->checkTransportMovement(
+                            transport.coord, target, transport.id, "3") >= 0;
+            }
+        }
+    }
+    QVERIFY(legal > 0);
+}
+
+QTEST_APPLESS_MAIN(MoveCheckBench)
+
+#include "tst_movecheckbench.moc"
@@ -0,0 +1,265 @@
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "gamearena.hh"
+#include "initialize.hh"
+#include "hex.hh"
+#include "pawn.hh"
+#include "transport.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked game, fixed so that every run lists the same moves.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief Board that keeps the arena the engine gives it, so that the memory
+ * of the game can be checked.
+ */
+class ArenaBoard : public Student::FlatGameBoard
+{
+public:
+    virtual void setArena(std::shared_ptr<Common::GameArena> arena)
+    {
+        arena_ = arena;
+        Student::FlatGameBoard::setArena(std::move(arena));
+    }
+    const std::shared_ptr<Common::GameArena>& arena() const { return arena_; }
+private:
+    std::shared_ptr<Common::GameArena> arena_;
+};
+
+/**
+ * @brief A piece on the board and the hex it stands on.
+ */
+struct Occupant
+{
+    Common::CubeCoordinate coord;
+    int id;
+};
+
+// QBENCHMARK reports the time of one pass, bots care about the rate
+void reportRate(const char* name, std::size_t actions, qint64 nsecs)
+{
+    if (nsecs > 0) {
+        qDebug("%s: %zu actions, %.0f actions/s", name, actions,
+               actions * 1e9 / nsecs);
+    }
+}
+
+}
+
+class MoveGenBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    MoveGenBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // Every legal action of the phase in one call
+    void benchGenerateMovement();
+    void benchGenerateSinking();
+
+    // The actions of the movement phase found by probing every target of
+    // every piece of the player with the check functions
+    void benchProbeMovement();
+
+    // Every action of the movement phase made and taken back in turn
+    void benchMakeUnmakeMovement();
+
+    // Every flip of the sinking phase made and taken back in turn, the
+    // memory of the revealed pieces is reused
+    void benchMakeUnmakeFlip();
+
+private:
+    void generate(Common::GamePhase phase, const char* name);
+
+    std::shared_ptr<ArenaBoard> board_;
+    std::shared_ptr<BenchState> state_;
+    std::shared_ptr<Common::IGameRunner> runner_;
+    std::vector<Common::CubeCoordinate> coords_;
+    std::vector<Occupant> pawns_;
+    std::vector<Occupant> transports_;
+    std::vector<Common::GameAction> actions_;
+};
+
+void MoveGenBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+
+    board_ = std::make_shared<ArenaBoard>();
+    state_ = std::make_shared<BenchState>();
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    runner_ = Common::Initialization::getGameRunner(board_, state_, players,
+                                                    BCH_SEED);
+
+    for (const auto& hex : board_->returnHexes()) {
+        coords_.push_back(hex.first);
+        for (const auto& transport : hex.second->getTransports()) {
+            transports_.push_back(Occupant{hex.first, transport->getId()});
+        }
+    }
+
+    // Pawns of every player on the land hexes around the center, only the
+    // ones of the player in turn can move
+    int pawnId = 0;
+    for (const auto& coord : coords_) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!board_->isWaterTile(coord)) {
+            int playerId = pawnId % BCH_PLAYERS + 1;
+            board_->addPawn(playerId, pawnId, coord);
+            if (playerId == state_->currentPlayer()) {
+                pawns_.push_back(Occupant{coord, pawnId});
+            }
+            ++pawnId;
+        }
+    }
+
+    QVERIFY(!pawns_.empty());
+    QVERIFY(!transports_.empty());
+}
+
+void MoveGenBench::generate(Common::GamePhase phase, const char* name)
+{
+    state_->changeGamePhase(phase);
+
+    std::size_t generated = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        actions_.clear();
+        generated += runner_->legalActions(actions_);
+    }
+    reportRate(name, generated, timer.nsecsElapsed());
+
+    state_->changeGamePhase(Common::GamePhase::MOVEMENT);
+    QVERIFY(!actions_.empty());
+}
+
+void MoveGenBench::benchGenerateMovement()
+{
+    generate(Common::GamePhase::MOVEMENT, "movement");
+}
+
+void MoveGenBench::benchGenerateSinking()
+{
+    generate(Common::GamePhase::SINKING, "sinking");
+}
+
+void MoveGenBench::benchProbeMovement()
+{
+    std::string actionsLeft =
+            std::to_string(runner_->getCurrentPlayer()->getActionsLeft());
+
+    std::size_t probed = 0;
+    std::size_t legal = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        legal = 0;
+        for (const auto& target : coords_) {
+            for (const auto& pawn : pawns_) {
+                legal += !(target == pawn.coord) &&
+                        runner_->checkPawnMovement(pawn.coord, target,
+                                                   pawn.id) >= 0;
+            }
+            for (const auto& transport : transports_) {
+                legal += !(target == transport.coord) &&
+                        runner_->checkTransportMovement(
+                            transport.coord, target, transport.id,
+                            actionsLeft) >= 0;
+            }
+        }
+        probed += legal;
+    }
+    reportRate("probe", probed, timer.nsecsElapsed());
+
+    // The generator finds the same actions
+    actions_.clear();
+    QCOMPARE(runner_->legalActions(actions_), legal);
+}
+
+void MoveGenBench::benchMakeUnmakeMovement()
+{
+    actions_.clear();
+    runner_->legalActions(actions_);
+    QVERIFY(!actions_.empty());
+    std::vector<Common::GameAction> moves = actions_;
+
+    std::size_t made = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (const auto& move : moves) {
+            QCOMPARE(runner_->makeAction(move), move.movesLeft);
+            runner_->unmakeAction();
+        }
+        made += moves.size();
+    }
+    reportRate("make and unmake", made, timer.nsecsElapsed());
+
+    // Taking the moves back leaves the game as it was
+    actions_.clear();
+    QCOMPARE(runner_->legalActions(actions_), moves.size());
+    QCOMPARE(runner_->getCurrentPlayer()->getActionsLeft(), 3u);
+    for (const auto& pawn : pawns_) {
+        QVERIFY(board_->getPawn(pawn.id)->getCoordinates() == pawn.coord);
+    }
+}
+
+void MoveGenBench::benchMakeUnmakeFlip()
+{
+    QVERIFY(board_->arena() != nullptr);
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+    actions_.clear();
+    runner_->legalActions(actions_);
+    QVERIFY(!actions_.empty());
+    std::vector<Common::GameAction> flips = actions_;
+    std::size_t bytes = board_->arena()->bytesAllocated();
+
+    std::size_t made = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (const auto& flip : flips) {
+            runner_->makeAction(flip);
+            runner_->unmakeAction();
+            QCOMPARE(board_->arena()->bytesAllocated(), bytes);
+        }
+        made += flips.size();
+    }
+    reportRate("flip make and unmake", made, timer.nsecsElapsed());
+
+    QCOMPARE(runner_->currentGamePhase(), Common::GamePhase::SINKING);
+    actions_.clear();
+    QCOMPARE(runner_->legalActions(actions_), flips.size());
+    state_->changeGamePhase(Common::GamePhase::MOVEMENT);
+}
+
+QTEST_APPLESS_MAIN(MoveGenBench)
+
+#include "tst_movegenbench.moc"
@@ -0,0 +1,261 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "columngameboard.hh"
+#include "flatgameboard.hh"
+#include "hexbitboard.hh"
+#include "pathfinder.hh"
+#include "hex.hh"
+#include "rules.hh"
+
+const unsigned BCH_SEED = 20181121;
+
+// Share of land hexes turned into water, gives the search some detours
+const double BCH_WATER_SHARE = 0.2;
+
+// Actions a player has in a turn, limits the length of every route
+const unsigned int BCH_ACTIONS = 3;
+
+const int BCH_QUERIES = 1000;
+
+// Radius of the island of Assets/layout.json
+const int BCH_ISLAND_RADIUS = 10;
+
+// Every this many land hexes is full of pawns, routes have to go around them
+const int BCH_CROWD_INTERVAL = 5;
+
+class PathFinderBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    PathFinderBench() = default;
+
+private Q_SLOTS:
+    // Route validation for pawns scattered over boards of different size
+    void benchIsReachable_data();
+    void benchIsReachable();
+
+    // Every target of a pawn, by visiting the hexes and by flooding the
+    // bitboards of a ColumnGameBoard
+    void benchReachableFromSearch();
+    void benchReachableFromFlood();
+
+    // Flooding the whole island with each instruction set
+    void benchSpreadScalar();
+    void benchSpreadAvx2();
+
+private:
+    template <class Board>
+    std::shared_ptr<Board> createBoard(int radius) const;
+
+    template <class Board>
+    std::shared_ptr<Board> createCrowdedBoard(int radius) const;
+
+    std::vector<Common::CubeCoordinate> reachableFrom(
+            const Common::IGameBoard& board) const;
+
+    void spread(Common::CubeKernels::KernelLevel level);
+};
+
+template <class Board>
+std::shared_ptr<Board> PathFinderBench::createBoard(int radius) const
+{
+    auto board = std::make_shared<Board>(radius);
+    std::mt19937 rng(BCH_SEED);
+    std::bernoulli_distribution water(BCH_WATER_SHARE);
+
+    const Common::BoardIndex& index = board->getIndex();
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (!index.contains(coord)) {
+            continue;
+        }
+        auto hex = std::make_shared<Common::Hex>();
+        hex->setCoordinates(coord);
+        hex->setPieceType(water(rng) ? "Water" : "Forest");
+        board->addHex(hex);
+    }
+    // Make sure every origin is on land
+    board->getHex(Common::CubeCoordinate(0, 0, 0))->setPieceType("Forest");
+    return board;
+}
+
+template <class Board>
+std::shared_ptr<Board> PathFinderBench::createCrowdedBoard(int radius) const
+{
+    std::shared_ptr<Board> board = createBoard<Board>(radius);
+    const Common::BoardIndex& index = board->getIndex();
+    int landHexes = 0;
+    int pawnId = 0;
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (!index.contains(coord) || board->isWaterTile(coord) ||
+                coord == Common::CubeCoordinate(0, 0, 0)) {
+            continue;
+        }
+        if (++landHexes % BCH_CROWD_INTERVAL == 0) {
+            for (int i = 0; i < Logic::MAX_PAWNS_PER_HEX; ++i) {
+                board->addPawn(1, pawnId++, coord);
+            }
+        }
+    }
+    return board;
+}
+
+std::vector<Common::CubeCoordinate> PathFinderBench::reachableFrom(
+        const Common::IGameBoard& board) const
+{
+    Logic::PathFinder pathFinder(BCH_ISLAND_RADIUS);
+    std::vector<Common::CubeCoordinate> reached;
+    QBENCHMARK {
+        for (int i = 0; i < BCH_QUERIES; ++i) {
+            reached.clear();
+            pathFinder.reachableFrom(board, Common::CubeCoordinate(0, 0, 0),
+                                     BCH_ACTIONS, reached);
+        }
+    }
+    std::sort(reached.begin(), reached.end());
+    return reached;
+}
+
+void PathFinderBench::spread(Common::CubeKernels::KernelLevel level)
+{
+    auto board = createCrowdedBoard<Student::ColumnGameBoard>(
+                BCH_ISLAND_RADIUS);
+    const Common::BoardBitboards& bits = *board->getBitboards();
+    int origin = board->getIndex().slotOf(Common::CubeCoordinate(0, 0, 0));
+
+    Common::HexBitboard frontier(BCH_ISLAND_RADIUS);
+    Common::HexBitboard layer(BCH_ISLAND_RADIUS);
+    Common::HexBitboard reached(BCH_ISLAND_RADIUS);
+    int steps = 0;
+    QBENCHMARK {
+        for (int i = 0; i < BCH_QUERIES; ++i) {
+            frontier.clear();
+            reached.clear();
+            frontier.set(origin);
+            reached.set(origin);
+            steps = 0;
+            while (Common::HexBitboard::spread(frontier, bits.hexes, reached,
+                                               layer, level)) {
+                std::swap(frontier, layer);
+                frontier &= bits.walkable;
+                ++steps;
+            }
+        }
+    }
+    qDebug("%s: %d steps, %d hexes reached",
+           Common::CubeKernels::levelName(level), steps, reached.count());
+
+    // Every level floods the same hexes
+    Common::HexBitboard expected(BCH_ISLAND_RADIUS);
+    frontier.clear();
+    expected.clear();
+    frontier.set(origin);
+    expected.set(origin);
+    while (Common::HexBitboard::spread(
+               frontier, bits.hexes, expected, layer,
+               Common::CubeKernels::KernelLevel::SCALAR)) {
+        std::swap(frontier, layer);
+        frontier &= bits.walkable;
+    }
+    QVERIFY(reached == expected);
+    QVERIFY(reached.count() > 1);
+}
+
+void PathFinderBench::benchIsReachable_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<int>("distance");
+
+    for (int radius : {10, 50, 200}) {
+        // A target in range, and one just out of range that makes the
+        // search visit everything within the action limit
+        QTest::newRow(qPrintable(QString("r%1-near").arg(radius)))
+                << radius << 2;
+        QTest::newRow(qPrintable(QString("r%1-far").arg(radius)))
+                << radius << 4;
+    }
+}
+
+void PathFinderBench::benchIsReachable()
+{
+    QFETCH(int, radius);
+    QFETCH(int, distance);
+
+    std::shared_ptr<Student::FlatGameBoard> board =
+            createBoard<Student::FlatGameBoard>(radius);
+    Logic::PathFinder pathFinder(radius);
+
+    // Targets all around the center at the given distance
+    std::vector<Common::CubeCoordinate> targets;
+    Common::CubeCoordinate coord(-distance, 0, distance);
+    for (int side = 0; side < Common::HEX_NEIGHBOURS; ++side) {
+        for (int step = 0; step < distance; ++step) {
+            targets.push_back(coord);
+            coord.x += Common::NEIGHBOUR_OFFSETS[side].x;
+            coord.y += Common::NEIGHBOUR_OFFSETS[side].y;
+            coord.z += Common::NEIGHBOUR_OFFSETS[side].z;
+        }
+    }
+
+    Common::CubeCoordinate origin(0, 0, 0);
+    int reachable = 0;
+    QBENCHMARK {
+        for (int i = 0; i < BCH_QUERIES; ++i) {
+            reachable += pathFinder.isReachable(
+                        *board, origin, targets[i % targets.size()],
+                        BCH_ACTIONS);
+        }
+    }
+    QVERIFY(distance <= static_cast<int>(BCH_ACTIONS) || reachable == 0);
+}
+
+void PathFinderBench::benchReachableFromSearch()
+{
+    auto board = createCrowdedBoard<Student::FlatGameBoard>(
+                BCH_ISLAND_RADIUS);
+    QVERIFY(board->getBitboards() == nullptr);
+    QVERIFY(!reachableFrom(*board).empty());
+}
+
+void PathFinderBench::benchReachableFromFlood()
+{
+    auto board = createCrowdedBoard<Student::ColumnGameBoard>(
+                BCH_ISLAND_RADIUS);
+    QVERIFY(board->getBitboards() != nullptr);
+    std::vector<Common::CubeCoordinate> flooded = reachableFrom(*board);
+
+    // The search over the same hexes finds the same targets
+    auto flatBoard = createCrowdedBoard<Student::FlatGameBoard>(
+                BCH_ISLAND_RADIUS);
+    Logic::PathFinder pathFinder(BCH_ISLAND_RADIUS);
+    std::vector<Common::CubeCoordinate> searched;
+    pathFinder.reachableFrom(*flatBoard, Common::CubeCoordinate(0, 0, 0),
+                             BCH_ACTIONS, searched);
+    std::sort(searched.begin(), searched.end());
+    QVERIFY(flooded == searched);
+}
+
+void PathFinderBench::benchSpreadScalar()
+{
+    spread(Common::CubeKernels::KernelLevel::SCALAR);
+}
+
+void PathFinderBench::benchSpreadAvx2()
+{
+    if (Common::CubeKernels::supportedLevel() <
+            Common::CubeKernels::KernelLevel::AVX2) {
+        QSKIP("The processor doesn't support AVX2");
+    }
+    spread(Common::CubeKernels::KernelLevel::AVX2);
+}
+
+QTEST_APPLESS_MAIN(PathFinderBench)
+
+#include "tst_pathfinderbench.moc"
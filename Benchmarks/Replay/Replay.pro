@@ -0,0 +1,89 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_replaybench
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    tst_replaybench.cpp \
+    ../../GameLogic/Engine/actorfactory.cpp \
+    ../../GameLogic/Engine/transportfactory.cpp \
+    ../../GameLogic/Engine/piecefactory.cpp \
+    ../../GameLogic/Engine/boardrecipe.cpp \
+    ../../GameLogic/Engine/boardtemplate.cpp \
+    ../../GameLogic/Engine/wheellayoutparser.cpp \
+    ../../GameLogic/Engine/gameengine.cpp \
+    ../../GameLogic/Engine/pathfinder.cpp \
+    ../../GameLogic/Engine/gamerandom.cpp \
+    ../../GameLogic/Engine/initialize.cpp \
+    ../../GameLogic/Engine/hex.cpp \
+    ../../GameLogic/Engine/cubekernels.cpp \
+    ../../GameLogic/Engine/hexbitboard.cpp \
+    ../../GameLogic/Engine/boardtopology.cpp \
+    ../../GameLogic/Engine/undolog.cpp \
+    ../../GameLogic/Engine/gamelog.cpp \
+    ../../GameLogic/Engine/replay.cpp \
+    ../../GameLogic/Engine/typeregistry.cpp \
+    ../../GameLogic/Engine/gamearena.cpp \
+    ../../GameLogic/Engine/pawn.cpp \
+    ../../GameLogic/Engine/actor.cpp \
+    ../../GameLogic/Engine/transport.cpp \
+    ../../GameLogic/Engine/shark.cpp \
+    ../../GameLogic/Engine/kraken.cpp \
+    ../../GameLogic/Engine/seamunster.cpp \
+    ../../GameLogic/Engine/vortex.cpp \
+    ../../GameLogic/Engine/dolphin.cpp \
+    ../../GameLogic/Engine/boat.cpp \
+    ../../GameLogic/Engine/gameexception.cpp \
+    ../../GameLogic/Engine/formatexception.cpp \
+    ../../GameLogic/Engine/illegalmoveexception.cpp \
+    ../../GameLogic/Engine/ioexception.cpp \
+    ../../UI/gameboardbase.cpp \
+    ../../UI/gameboard.cpp \
+    ../../UI/flatgameboard.cpp
+
+HEADERS += \
+    ../benchfixture.hh \
+    ../../GameLogic/Engine/boardindex.hh \
+    ../../GameLogic/Engine/boardtopology.hh \
+    ../../GameLogic/Engine/hexbitboard.hh \
+    ../../GameLogic/Engine/iundotarget.hh \
+    ../../GameLogic/Engine/undolog.hh \
+    ../../GameLogic/Engine/gamelog.hh \
+    ../../GameLogic/Engine/varint.hh \
+    ../../GameLogic/Engine/replay.hh \
+    ../../GameLogic/Engine/gameaction.hh \
+    ../../GameLogic/Engine/gamesnapshot.hh \
+    ../../GameLogic/Engine/gameengine.hh \
+    ../../GameLogic/Engine/pathfinder.hh \
+    ../../GameLogic/Engine/gamerandom.hh \
+    ../../GameLogic/Engine/hex.hh \
+    ../../GameLogic/Engine/ihexlistener.hh \
+    ../../GameLogic/Engine/smallvector.hh \
+    ../../GameLogic/Engine/igameboard.hh \
+    ../../GameLogic/Engine/initialize.hh \
+    ../../UI/gameboardbase.hh \
+    ../../UI/gameboard.hh \
+    ../../UI/flatgameboard.hh
+
+INCLUDEPATH += .. \
+                ../../UI \
+                ../../GameLogic/Engine/
+DEPENDPATH  += .. \
+                ../../UI \
+                ../../GameLogic/Engine/
+
+# The engine reads its configuration from Assets/ in the working directory
+unix {
+    copyfiles.commands += cp -r $$_PRO_FILE_PWD_/../../GameLogic/Assets $$DESTDIR
+    QMAKE_EXTRA_TARGETS += copyfiles
+    POST_TARGETDEPS += copyfiles
+}
@@ -0,0 +1,285 @@
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "gamesnapshot.hh"
+#include "initialize.hh"
+#include "replay.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked game, fixed so that every run replays the same game.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+// Turns recorded into the replay
+const int BCH_TURNS = 64;
+
+const char BCH_REPLAY_FILE[] = "tst_replaybench.replay";
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief The objects of one game.
+ */
+struct Game
+{
+    std::shared_ptr<Student::FlatGameBoard> board;
+    std::shared_ptr<BenchState> state;
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    std::shared_ptr<Common::IGameRunner> runner;
+};
+
+Game createObjects()
+{
+    Game game;
+    game.board = std::make_shared<Student::FlatGameBoard>();
+    game.state = std::make_shared<BenchState>();
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        game.players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    return game;
+}
+
+bool samePieces(const std::vector<Common::GameSnapshot::Piece>& a,
+                const std::vector<Common::GameSnapshot::Piece>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].type != b[i].type ||
+                a[i].owner != b[i].owner || a[i].hex != b[i].hex ||
+                a[i].firstPassenger != b[i].firstPassenger ||
+                a[i].passengerCount != b[i].passengerCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A turn read from the replay has to be the state that was recorded
+bool sameState(const Common::GameSnapshot& a, const Common::GameSnapshot& b)
+{
+    if (a.players.size() != b.players.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.players.size(); ++i) {
+        if (a.players[i].id != b.players[i].id ||
+                a.players[i].actionsLeft != b.players[i].actionsLeft) {
+            return false;
+        }
+    }
+    return *a.coordinates == *b.coordinates && a.terrain == b.terrain &&
+            samePieces(a.pawns, b.pawns) && samePieces(a.actors, b.actors) &&
+            samePieces(a.transports, b.transports) &&
+            a.passengers == b.passengers && a.phase == b.phase &&
+            a.currentPlayer == b.currentPlayer &&
+            a.islandPieces == b.islandPieces && a.spun == b.spun &&
+            a.spinType == b.spinType && a.spinMoves == b.spinMoves &&
+            a.rng.seed() == b.rng.seed() && a.rng.state() == b.rng.state() &&
+            a.lastActorId == b.lastActorId &&
+            a.lastTransportId == b.lastTransportId;
+}
+
+// QBENCHMARK reports the time of one pass, scrubbing cares about the time
+// of one turn
+void reportTime(const char* name, int count, qint64 nsecs)
+{
+    if (count > 0) {
+        qDebug("%s: %.2f us each", name, nsecs / 1e3 / count);
+    }
+}
+
+}
+
+class ReplayBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReplayBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Recording every turn of the game and finishing the file
+    void benchWrite();
+
+    // Mapping the file and reading its index
+    void benchOpen();
+
+    // Reconstructing every turn, from the last one back
+    void benchSeek();
+
+    // Reconstructing a turn and continuing it on a new board, the cost of
+    // showing a turn
+    void benchSeekAndFork();
+
+private:
+    void writeReplay();
+
+    std::vector<std::shared_ptr<const Common::GameSnapshot>> turns_;
+};
+
+void ReplayBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+
+    Game game = createObjects();
+    game.runner = Common::Initialization::getGameRunner(
+                game.board, game.state, game.players, BCH_SEED);
+
+    int pawnId = 0;
+    for (const auto& hex : game.board->returnHexes()) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!hex.second->isWaterTile()) {
+            game.board->addPawn(pawnId % BCH_PLAYERS + 1, pawnId, hex.first);
+            ++pawnId;
+        }
+    }
+
+    // Every turn moves the first pawn or transport, flips a tile and spins
+    std::vector<Common::GameAction> actions;
+    for (int turn = 0; turn < BCH_TURNS; ++turn) {
+        game.state->changeGamePhase(Common::GamePhase::MOVEMENT);
+        turns_.push_back(game.runner->snapshot());
+        actions.clear();
+        if (game.runner->legalActions(actions) > 0) {
+            game.runner->makeAction(actions.front());
+        }
+        game.state->changeGamePhase(Common::GamePhase::SINKING);
+        actions.clear();
+        if (game.runner->legalActions(actions) > 0) {
+            game.runner->makeAction(actions.back());
+        }
+        game.state->changeGamePhase(Common::GamePhase::SPINNING);
+        game.runner->spinWheel();
+        game.state->changePlayerTurn(turn % BCH_PLAYERS + 1);
+        game.runner->getCurrentPlayer()->setActionsLeft(3);
+    }
+
+    writeReplay();
+}
+
+void ReplayBench::cleanupTestCase()
+{
+    QFile::remove(BCH_REPLAY_FILE);
+}
+
+void ReplayBench::writeReplay()
+{
+    Common::ReplayWriter writer(BCH_REPLAY_FILE);
+    for (const auto& turn : turns_) {
+        writer.addTurn(*turn);
+    }
+    writer.finish();
+}
+
+void ReplayBench::benchWrite()
+{
+    int written = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        writeReplay();
+        written += BCH_TURNS;
+    }
+    reportTime("write", written, timer.nsecsElapsed());
+
+    QFile file(BCH_REPLAY_FILE);
+    qDebug("write: %.1f bytes per turn",
+           static_cast<double>(file.size()) / BCH_TURNS);
+}
+
+void ReplayBench::benchOpen()
+{
+    int turns = 0;
+    int opened = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        Common::ReplayReader reader(BCH_REPLAY_FILE);
+        turns = reader.turnCount();
+        ++opened;
+    }
+    reportTime("open", opened, timer.nsecsElapsed());
+    QCOMPARE(turns, BCH_TURNS);
+}
+
+void ReplayBench::benchSeek()
+{
+    Common::ReplayReader reader(BCH_REPLAY_FILE);
+    QCOMPARE(reader.turnCount(), BCH_TURNS);
+
+    std::vector<std::shared_ptr<const Common::GameSnapshot>> read(BCH_TURNS);
+    int seeks = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (int turn = BCH_TURNS - 1; turn >= 0; --turn) {
+            read[turn] = reader.snapshotAt(turn);
+        }
+        seeks += BCH_TURNS;
+    }
+    reportTime("seek", seeks, timer.nsecsElapsed());
+
+    for (int turn = 0; turn < BCH_TURNS; ++turn) {
+        QVERIFY(read[turn] != nullptr);
+        QVERIFY(sameState(*read[turn], *turns_[turn]));
+    }
+    QVERIFY(reader.snapshotAt(BCH_TURNS) == nullptr);
+}
+
+void ReplayBench::benchSeekAndFork()
+{
+    Common::ReplayReader reader(BCH_REPLAY_FILE);
+
+    // The turn right before a keyframe has the most changes to apply
+    const int turn = reader.keyframeInterval() - 1;
+    Game fork;
+    int forked = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        fork = createObjects();
+        fork.runner = Common::Initialization::forkGameRunner(
+                    fork.board, fork.state, fork.players,
+                    reader.snapshotAt(turn));
+        ++forked;
+    }
+    reportTime("seek and fork", forked, timer.nsecsElapsed());
+
+    // The turn continues like the recorded one
+    Game expected = createObjects();
+    expected.runner = Common::Initialization::forkGameRunner(
+                expected.board, expected.state, expected.players,
+                turns_[turn]);
+    std::vector<Common::GameAction> expectedActions;
+    std::vector<Common::GameAction> actions;
+    expected.runner->legalActions(expectedActions);
+    QCOMPARE(fork.runner->legalActions(actions), expectedActions.size());
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        QVERIFY(actions[i].target == expectedActions[i].target);
+        QCOMPARE(actions[i].id, expectedActions[i].id);
+    }
+}
+
+QTEST_APPLESS_MAIN(ReplayBench)
+
+#include "tst_replaybench.moc"
@@ -0,0 +1,667 @@
+#include <QString>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gamesnapshot.hh"
+#include "initialize.hh"
+#include "hex.hh"
+#include "pawn.hh"
+#include "actor.hh"
+#include "transport.hh"
+#include "shark.hh"
+#include "piecefactory.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked games, fixed so that every run measures the same
+// islands.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+// Id of the shark added to the island, far from the generated ids
+const int BCH_SHARK_ID = 1000;
+
+// Samples taken of every operation in each pass of QBENCHMARK
+const int BCH_SAMPLES = 100;
+
+// Calls of the cheap operations timed together as one sample, a single call
+// takes about as long as reading the clock
+const int BCH_BATCH = 32;
+
+// Results of every operation and island, written by cleanupTestCase
+const char BCH_RESULTS_FILE[] = "tst_runnerbench.json";
+
+// Version of the layout of BCH_RESULTS_FILE, raised when fields change
+const int BCH_RESULTS_VERSION = 1;
+
+namespace {
+
+// Every allocation of the program, the difference over a sample is the
+// allocations of the benchmarked calls
+std::atomic<unsigned long long> allocationCount(0);
+
+}
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief A piece on the board and the hex it stands on.
+ */
+struct Occupant
+{
+    Common::CubeCoordinate coord;
+    int id;
+};
+
+/**
+ * @brief The objects of one game.
+ */
+struct Game
+{
+    std::shared_ptr<Student::FlatGameBoard> board;
+    std::shared_ptr<BenchState> state;
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    std::shared_ptr<Common::IGameRunner> runner;
+};
+
+Game createObjects()
+{
+    Game game;
+    game.board = std::make_shared<Student::FlatGameBoard>();
+    game.state = std::make_shared<BenchState>();
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        game.players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    return game;
+}
+
+/**
+ * @brief A game on an island of one size, and the pieces the operations
+ * are called with.
+ */
+struct Island
+{
+    std::shared_ptr<const Logic::BoardRecipe> recipe;
+    Game game;
+    std::shared_ptr<const Common::GameSnapshot> start;
+    std::vector<Common::CubeCoordinate> coords;
+    std::vector<Occupant> pawns;
+    std::vector<Occupant> transports;
+
+    // A pawn of player 1 and a land hex next to it
+    Occupant pawn;
+    Common::CubeCoordinate pawnTarget;
+
+    // The shark and a water hex next to it
+    Occupant shark;
+    Common::CubeCoordinate sharkTarget;
+
+    // The land hexes in an order flipTile accepts them
+    std::vector<Common::CubeCoordinate> flipOrder;
+};
+
+/**
+ * @brief Times the calls of one operation and counts their allocations.
+ * @details A sample is one or more calls between start() and stop(). The
+ * percentiles are of the time per call of the samples, so the calls of a
+ * batch share the same time.
+ */
+class Sampler
+{
+public:
+    Sampler(): calls_(0), allocations_(0), totalNs_(0), startAllocations_(0) {}
+
+    void start()
+    {
+        startAllocations_ = allocationCount.load(std::memory_order_relaxed);
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    void stop(int calls)
+    {
+        auto end = std::chrono::steady_clock::now();
+        allocations_ += allocationCount.load(std::memory_order_relaxed) -
+                startAllocations_;
+        double ns = std::chrono::duration<double, std::nano>(
+                    end - start_).count();
+        totalNs_ += ns;
+        calls_ += calls;
+        samples_.push_back(ns / calls);
+    }
+
+    // Nearest rank percentile of the time per call, p in 0...100
+    double percentile(const std::vector<double>& sorted, double p) const
+    {
+        std::size_t rank = static_cast<std::size_t>(
+                    p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted.at(rank);
+    }
+
+    QJsonObject result(const char* operation, int radius) const
+    {
+        std::vector<double> sorted = samples_;
+        std::sort(sorted.begin(), sorted.end());
+
+        QJsonObject result;
+        result["operation"] = operation;
+        result["radius"] = radius;
+        result["calls"] = static_cast<double>(calls_);
+        result["samples"] = static_cast<int>(sorted.size());
+        if (calls_ == 0) {
+            return result;
+        }
+        result["ns_per_op"] = totalNs_ / calls_;
+        result["allocs_per_op"] = static_cast<double>(allocations_) / calls_;
+        result["p50_ns"] = percentile(sorted, 50);
+        result["p90_ns"] = percentile(sorted, 90);
+        result["p99_ns"] = percentile(sorted, 99);
+        result["max_ns"] = sorted.back();
+        return result;
+    }
+
+private:
+    unsigned long long calls_;
+    unsigned long long allocations_;
+    double totalNs_;
+    std::vector<double> samples_;
+
+    std::chrono::steady_clock::time_point start_;
+    unsigned long long startAllocations_;
+};
+
+}
+
+class RunnerBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    RunnerBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Laying out the island of a new game
+    void benchInitialize_data();
+    void benchInitialize();
+
+    // getHex of every hex of the island through GameBoardBase
+    void benchGetHex_data();
+    void benchGetHex();
+
+    // Every hex of the island as the target of each pawn and transport
+    void benchCheckPawnMovement_data();
+    void benchCheckPawnMovement();
+    void benchCheckTransportMovement_data();
+    void benchCheckTransportMovement();
+
+    // A pawn and the shark moved to the next hex and back
+    void benchMovePawn_data();
+    void benchMovePawn();
+    void benchMoveActor_data();
+    void benchMoveActor();
+
+    // Sinking the island a tile at a time, a new game once it is gone
+    void benchFlipTile_data();
+    void benchFlipTile();
+
+    void benchSpinWheel_data();
+    void benchSpinWheel();
+    void benchGetSpinnerLayout_data();
+    void benchGetSpinnerLayout();
+
+private:
+    void addIslands();
+    Island& islandOf(int layers);
+    void setUpIsland(Island& island, int layers);
+    void record(const Sampler& sampler, const char* operation,
+                const Island& island);
+
+    std::shared_ptr<const Logic::BoardRecipe> recipe_;
+    std::map<int, Island> islands_;
+    QJsonArray results_;
+};
+
+void RunnerBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+    recipe_ = Logic::PieceFactory::getInstance().getRecipe();
+}
+
+void RunnerBench::cleanupTestCase()
+{
+    Logic::PieceFactory::getInstance().setRecipe(recipe_);
+
+    QJsonObject root;
+    root["benchmark"] = "RunnerBench";
+    root["version"] = BCH_RESULTS_VERSION;
+    root["seed"] = static_cast<double>(BCH_SEED);
+    root["results"] = results_;
+
+    QFile file(BCH_RESULTS_FILE);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(QJsonDocument(root).toJson());
+    qDebug("%d results written to %s", results_.size(), BCH_RESULTS_FILE);
+}
+
+// The islands of Assets/pieces.json with each piece type having 1, 2 and 4
+// times its layers
+void RunnerBench::addIslands()
+{
+    QTest::addColumn<int>("layers");
+    QTest::newRow("layers x1") << 1;
+    QTest::newRow("layers x2") << 2;
+    QTest::newRow("layers x4") << 4;
+}
+
+Island& RunnerBench::islandOf(int layers)
+{
+    auto found = islands_.find(layers);
+    if (found == islands_.end()) {
+        found = islands_.emplace(layers, Island()).first;
+        setUpIsland(found->second, layers);
+    }
+    return found->second;
+}
+
+void RunnerBench::setUpIsland(Island& island, int layers)
+{
+    Logic::BoardRecipe::PieceVector pieces = recipe_->getPieces();
+    for (auto& piece : pieces) {
+        piece.second *= layers;
+    }
+    island.recipe = std::make_shared<const Logic::BoardRecipe>(
+                std::move(pieces), recipe_->getSpinnerLayout());
+
+    Logic::PieceFactory::getInstance().setRecipe(island.recipe);
+    island.game = createObjects();
+    island.game.runner = Common::Initialization::getGameRunner(
+                island.game.board, island.game.state, island.game.players,
+                BCH_SEED);
+    island.start = island.game.runner->snapshot();
+    Logic::PieceFactory::getInstance().setRecipe(recipe_);
+
+    Student::FlatGameBoard& board = *island.game.board;
+    Common::CubeCoordinate water;
+    for (const auto& coord : *island.start->coordinates) {
+        island.coords.push_back(coord);
+        Common::Hex* hex = board.findHex(coord);
+        if (hex->isWaterTile()) {
+            water = coord;
+        }
+        for (const auto& transport : hex->getTransportSpan()) {
+            island.transports.push_back(Occupant{coord, transport->getId()});
+        }
+    }
+
+    // Flipping goes by piece type from the shore inwards
+    for (auto layer = island.start->islandPieces.rbegin();
+         layer != island.start->islandPieces.rend(); ++layer) {
+        for (std::size_t i = 0; i < island.coords.size(); ++i) {
+            if (island.start->terrain[i] == layer->first) {
+                island.flipOrder.push_back(island.coords[i]);
+            }
+        }
+    }
+
+    // Pawns of every player on the land hexes around the center
+    int pawnId = 0;
+    for (const auto& coord : island.coords) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!board.isWaterTile(coord)) {
+            board.addPawn(pawnId % BCH_PLAYERS + 1, pawnId, coord);
+            island.pawns.push_back(Occupant{coord, pawnId});
+            ++pawnId;
+        }
+    }
+
+    board.addActor(std::make_shared<Common::Shark>(BCH_SHARK_ID), water);
+    island.shark = Occupant{water, BCH_SHARK_ID};
+
+    // The first move of one action each piece can make
+    island.game.state->changePlayerTurn(1);
+    island.pawn = island.pawns.front();
+    for (const auto& target : island.game.runner->reachablePawnTargets(
+             island.pawn.coord, island.pawn.id)) {
+        if (target.second == 2) {
+            island.pawnTarget = target.first;
+            break;
+        }
+    }
+    for (const auto& coord : island.coords) {
+        if (island.game.runner->checkActorMovement(water, coord,
+                                                   BCH_SHARK_ID, "1") &&
+                !(coord == water)) {
+            island.sharkTarget = coord;
+            break;
+        }
+    }
+}
+
+void RunnerBench::record(const Sampler& sampler, const char* operation,
+                         const Island& island)
+{
+    QJsonObject result = sampler.result(operation,
+                                        island.recipe->getRadius());
+    qDebug("%s radius %d: %.1f ns/op, %.2f allocs/op, p50 %.1f ns, "
+           "p99 %.1f ns", operation, island.recipe->getRadius(),
+           result["ns_per_op"].toDouble(), result["allocs_per_op"].toDouble(),
+           result["p50_ns"].toDouble(), result["p99_ns"].toDouble());
+    results_.append(result);
+}
+
+void RunnerBench::benchInitialize_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchInitialize()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+
+    // The objects of the game are made and freed outside the samples
+    Logic::PieceFactory::getInstance().setRecipe(island.recipe);
+    Sampler sampler;
+    Game game;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            game = createObjects();
+            sampler.start();
+            game.runner = Common::Initialization::getGameRunner(
+                        game.board, game.state, game.players, BCH_SEED);
+            sampler.stop(1);
+        }
+    }
+    Logic::PieceFactory::getInstance().setRecipe(recipe_);
+    record(sampler, "initialize", island);
+
+    QCOMPARE(game.board->returnHexes().size(), island.coords.size());
+}
+
+void RunnerBench::benchGetHex_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchGetHex()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+
+    // The UI looks the hexes up through the base class
+    const Student::GameBoardBase& board = *island.game.board;
+    Sampler sampler;
+    int found = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            sampler.start();
+            for (const auto& coord : island.coords) {
+                found += board.getHex(coord) != nullptr;
+            }
+            sampler.stop(island.coords.size());
+        }
+    }
+    record(sampler, "getHex", island);
+    QVERIFY(found > 0);
+}
+
+void RunnerBench::benchCheckPawnMovement_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchCheckPawnMovement()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+
+    Sampler sampler;
+    int legal = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            const Occupant& pawn = island.pawns[sample % island.pawns.size()];
+            island.game.state->changePlayerTurn(pawn.id % BCH_PLAYERS + 1);
+            sampler.start();
+            for (const auto& target : island.coords) {
+                legal += runner.checkPawnMovement(pawn.coord, target,
+                                                  pawn.id) >= 0;
+            }
+            sampler.stop(island.coords.size());
+        }
+    }
+    island.game.state->changePlayerTurn(1);
+    record(sampler, "checkPawnMovement", island);
+    QVERIFY(legal > 0);
+}
+
+void RunnerBench::benchCheckTransportMovement_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchCheckTransportMovement()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+    QVERIFY(!island.transports.empty());
+
+    Sampler sampler;
+    int legal = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            const Occupant& transport =
+                    island.transports[sample % island.transports.size()];
+            sampler.start();
+            for (const auto& target : island.coords) {
+                legal += runner.checkTransportMovement(
+                            transport.coord, target, transport.id, "3") >= 0;
+            }
+            sampler.stop(island.coords.size());
+        }
+    }
+    record(sampler, "checkTransportMovement", island);
+    QVERIFY(legal > 0);
+}
+
+void RunnerBench::benchMovePawn_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchMovePawn()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+    Common::IPlayer& player = *island.game.players.front();
+    QVERIFY(!(island.pawnTarget == island.pawn.coord));
+
+    Sampler sampler;
+    int movesLeft = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            player.setActionsLeft(3);
+            sampler.start();
+            movesLeft += runner.movePawn(island.pawn.coord, island.pawnTarget,
+                                         island.pawn.id);
+            sampler.stop(1);
+
+            player.setActionsLeft(3);
+            sampler.start();
+            movesLeft += runner.movePawn(island.pawnTarget, island.pawn.coord,
+                                         island.pawn.id);
+            sampler.stop(1);
+        }
+    }
+    player.setActionsLeft(3);
+    record(sampler, "movePawn", island);
+    QVERIFY(movesLeft > 0);
+}
+
+void RunnerBench::benchMoveActor_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchMoveActor()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+    QVERIFY(!(island.sharkTarget == island.shark.coord));
+
+    Sampler sampler;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            sampler.start();
+            runner.moveActor(island.shark.coord, island.sharkTarget,
+                             island.shark.id, "1");
+            runner.moveActor(island.sharkTarget, island.shark.coord,
+                             island.shark.id, "1");
+            sampler.stop(2);
+        }
+    }
+    record(sampler, "moveActor", island);
+    QVERIFY(island.game.board->findHex(island.shark.coord)->findActor(
+                island.shark.id) != nullptr);
+}
+
+void RunnerBench::benchFlipTile_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchFlipTile()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    QVERIFY(!island.flipOrder.empty());
+
+    // The tiles are flipped on forks of the new game, the island itself
+    // stays whole for the other operations. Forks are built from the
+    // recipe of their island.
+    Logic::PieceFactory::getInstance().setRecipe(island.recipe);
+    Sampler sampler;
+    Game game;
+    std::size_t next = island.flipOrder.size();
+    int appeared = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            if (next == island.flipOrder.size()) {
+                game = createObjects();
+                game.runner = Common::Initialization::forkGameRunner(
+                            game.board, game.state, game.players,
+                            island.start);
+                next = 0;
+            }
+            sampler.start();
+            appeared += !game.runner->flipTile(island.flipOrder[next]).empty();
+            sampler.stop(1);
+            ++next;
+        }
+    }
+    Logic::PieceFactory::getInstance().setRecipe(recipe_);
+    record(sampler, "flipTile", island);
+    QVERIFY(appeared > 0);
+}
+
+void RunnerBench::benchSpinWheel_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchSpinWheel()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+
+    Sampler sampler;
+    std::size_t spun = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            sampler.start();
+            for (int call = 0; call < BCH_BATCH; ++call) {
+                spun += runner.spinWheel().first.size();
+            }
+            sampler.stop(BCH_BATCH);
+        }
+    }
+    island.game.state->changeGamePhase(Common::GamePhase::MOVEMENT);
+    record(sampler, "spinWheel", island);
+    QVERIFY(spun > 0);
+}
+
+void RunnerBench::benchGetSpinnerLayout_data()
+{
+    addIslands();
+}
+
+void RunnerBench::benchGetSpinnerLayout()
+{
+    QFETCH(int, layers);
+    Island& island = islandOf(layers);
+    Common::IGameRunner& runner = *island.game.runner;
+
+    Sampler sampler;
+    std::size_t sections = 0;
+    QBENCHMARK {
+        for (int sample = 0; sample < BCH_SAMPLES; ++sample) {
+            sampler.start();
+            for (int call = 0; call < BCH_BATCH; ++call) {
+                sections += runner.getSpinnerLayout().size();
+            }
+            sampler.stop(BCH_BATCH);
+        }
+    }
+    record(sampler, "getSpinnerLayout", island);
+    QVERIFY(sections > 0);
+}
+
+QTEST_APPLESS_MAIN(RunnerBench)
+
+#include "tst_runnerbench.moc"
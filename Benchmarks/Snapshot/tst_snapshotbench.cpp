@@ -0,0 +1,187 @@
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QtTest>
+#include <memory>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "gamesnapshot.hh"
+#include "initialize.hh"
+#include "benchfixture.hh"
+
+// Seed of the benchmarked game, fixed so that every run forks the same game.
+const unsigned BCH_SEED = 20181121;
+const int BCH_PLAYERS = 3;
+const int BCH_PAWNS_PER_PLAYER = 3;
+
+// Turns played before the game is forked
+const int BCH_TURNS = 10;
+
+namespace {
+
+using Benchmark::BenchState;
+using Benchmark::BenchPlayer;
+
+/**
+ * @brief The objects of one game.
+ */
+struct Game
+{
+    std::shared_ptr<Student::FlatGameBoard> board;
+    std::shared_ptr<BenchState> state;
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    std::shared_ptr<Common::IGameRunner> runner;
+};
+
+Game createObjects()
+{
+    Game game;
+    game.board = std::make_shared<Student::FlatGameBoard>();
+    game.state = std::make_shared<BenchState>();
+    for (int id = 1; id <= BCH_PLAYERS; ++id) {
+        game.players.push_back(std::make_shared<BenchPlayer>(id));
+    }
+    return game;
+}
+
+// QBENCHMARK reports the time of one pass, forking searches care about the
+// time of one fork
+void reportTime(const char* name, int count, qint64 nsecs)
+{
+    if (count > 0) {
+        qDebug("%s: %.2f us each", name, nsecs / 1e3 / count);
+    }
+}
+
+}
+
+class SnapshotBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    SnapshotBench() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    // Capturing the state of a game played for a while
+    void benchSnapshot();
+
+    // Continuing that game on a new board
+    void benchFork();
+
+    // Starting a new game, for comparison
+    void benchNewGame();
+
+private:
+    Game game_;
+    std::shared_ptr<const Common::GameSnapshot> snapshot_;
+};
+
+void SnapshotBench::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+
+    game_ = createObjects();
+    game_.runner = Common::Initialization::getGameRunner(
+                game_.board, game_.state, game_.players, BCH_SEED);
+
+    int pawnId = 0;
+    for (const auto& hex : game_.board->returnHexes()) {
+        if (pawnId == BCH_PLAYERS * BCH_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!hex.second->isWaterTile()) {
+            game_.board->addPawn(pawnId % BCH_PLAYERS + 1, pawnId, hex.first);
+            ++pawnId;
+        }
+    }
+
+    // Every turn moves the first pawn or transport, flips a tile and spins
+    std::vector<Common::GameAction> actions;
+    for (int turn = 0; turn < BCH_TURNS; ++turn) {
+        game_.state->changeGamePhase(Common::GamePhase::MOVEMENT);
+        actions.clear();
+        if (game_.runner->legalActions(actions) > 0) {
+            game_.runner->makeAction(actions.front());
+        }
+        game_.state->changeGamePhase(Common::GamePhase::SINKING);
+        actions.clear();
+        if (game_.runner->legalActions(actions) > 0) {
+            game_.runner->makeAction(actions.back());
+        }
+        game_.state->changeGamePhase(Common::GamePhase::SPINNING);
+        game_.runner->spinWheel();
+        game_.state->changePlayerTurn(turn % BCH_PLAYERS + 1);
+        game_.runner->getCurrentPlayer()->setActionsLeft(3);
+    }
+    game_.state->changeGamePhase(Common::GamePhase::MOVEMENT);
+}
+
+void SnapshotBench::benchSnapshot()
+{
+    int taken = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        snapshot_ = game_.runner->snapshot();
+        ++taken;
+    }
+    reportTime("snapshot", taken, timer.nsecsElapsed());
+    QVERIFY(snapshot_ != nullptr);
+}
+
+void SnapshotBench::benchFork()
+{
+    std::shared_ptr<const Common::GameSnapshot> snapshot =
+            game_.runner->snapshot();
+
+    Game fork;
+    int forked = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        fork = createObjects();
+        fork.runner = Common::Initialization::forkGameRunner(
+                    fork.board, fork.state, fork.players, snapshot);
+        ++forked;
+    }
+    reportTime("fork", forked, timer.nsecsElapsed());
+
+    // The fork accepts the same actions as the game
+    std::vector<Common::GameAction> expected;
+    std::vector<Common::GameAction> actions;
+    game_.runner->legalActions(expected);
+    QCOMPARE(fork.runner->legalActions(actions), expected.size());
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        QVERIFY(actions[i].target == expected[i].target);
+        QCOMPARE(actions[i].id, expected[i].id);
+    }
+}
+
+void SnapshotBench::benchNewGame()
+{
+    Game game;
+    int created = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        game = createObjects();
+        game.runner = Common::Initialization::getGameRunner(
+                    game.board, game.state, game.players, BCH_SEED);
+        ++created;
+    }
+    reportTime("new game", created, timer.nsecsElapsed());
+    QVERIFY(game.runner != nullptr);
+}
+
+QTEST_APPLESS_MAIN(SnapshotBench)
+
+#include "tst_snapshotbench.moc"
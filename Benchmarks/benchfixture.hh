@@ -0,0 +1,47 @@
+#ifndef BENCHFIXTURE_HH
+#define BENCHFIXTURE_HH
+
+#include "igamestate.hh"
+#include "iplayer.hh"
+
+/**
+ * @file
+ * @brief The game state and players the benchmarks drive the engine with.
+ */
+
+namespace Benchmark {
+
+/**
+ * @brief Minimal game state for driving the engine without the UI.
+ */
+class BenchState : public Common::IGameState
+{
+public:
+    BenchState(): phase_(Common::GamePhase::MOVEMENT), player_(1) {}
+    virtual Common::GamePhase currentGamePhase() const { return phase_; }
+    virtual int currentPlayer() const { return player_; }
+    virtual void changeGamePhase(Common::GamePhase nextPhase) { phase_ = nextPhase; }
+    virtual void changePlayerTurn(int nextPlayer) { player_ = nextPlayer; }
+private:
+    Common::GamePhase phase_;
+    int player_;
+};
+
+/**
+ * @brief Minimal player for driving the engine without the UI.
+ */
+class BenchPlayer : public Common::IPlayer
+{
+public:
+    explicit BenchPlayer(int id): id_(id), actions_(3) {}
+    virtual int getPlayerId() const { return id_; }
+    virtual void setActionsLeft(unsigned int actionsLeft) { actions_ = actionsLeft; }
+    virtual unsigned int getActionsLeft() const { return actions_; }
+private:
+    int id_;
+    unsigned int actions_;
+};
+
+}
+
+#endif // BENCHFIXTURE_HH
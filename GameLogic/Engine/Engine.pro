@@ -17,9 +17,19 @@ SOURCES += \
     ioexception.cpp \
     actorfactory.cpp \
     piecefactory.cpp \
+    boardrecipe.cpp \
+    boardtemplate.cpp \
     gameengine.cpp \
     initialize.cpp \
     hex.cpp \
+    cubekernels.cpp \
+    hexbitboard.cpp \
+    boardtopology.cpp \
+    undolog.cpp \
+    gamelog.cpp \
+    replay.cpp \
+    typeregistry.cpp \
+    gamearena.cpp \
     pawn.cpp \
     actor.cpp \
     transport.cpp \
@@ -30,7 +40,9 @@ SOURCES += \
     vortex.cpp \
     dolphin.cpp \
     boat.cpp \
-    wheellayoutparser.cpp
+    wheellayoutparser.cpp \
+    pathfinder.cpp \
+    gamerandom.cpp
 
 HEADERS += \
     gameexception.hh \
@@ -39,10 +51,28 @@ HEADERS += \
     ioexception.hh \
     actorfactory.hh \
     piecefactory.hh \
+    boardrecipe.hh \
+    boardtemplate.hh \
     cubecoordinate.hh \
+    gameaction.hh \
+    gamesnapshot.hh \
+    packedcoordinate.hh \
+    boardindex.hh \
+    boardtopology.hh \
+    iundotarget.hh \
+    undolog.hh \
+    gamelog.hh \
+    varint.hh \
+    replay.hh \
+    cubekernels.hh \
+    hexbitboard.hh \
     gameengine.hh \
     initialize.hh \
     hex.hh \
+    ihexlistener.hh \
+    typeregistry.hh \
+    gamearena.hh \
+    smallvector.hh \
     pawn.hh \
     igameboard.hh \
     igamerunner.hh \
@@ -57,7 +87,10 @@ HEADERS += \
     vortex.hh \
     dolphin.hh \
     boat.hh \
-    wheellayoutparser.hh
+    wheellayoutparser.hh \
+    pathfinder.hh \
+    gamerandom.hh \
+    rules.hh
 
 unix {
     target.path = /usr/lib
@@ -1,12 +1,14 @@
 #include "actor.hh"
+#include "gamelog.hh"
+#include "igameboard.hh"
+#include "undolog.hh"
 #include <string>
 #include <memory>
 
 namespace Common {
 
 Actor::Actor(int id ):
-    id_( id ),
-    hex_(nullptr){}
+    id_( id ){}
 
 Actor::~Actor(){}
 
@@ -22,6 +24,14 @@ std::string Actor::getActorType() const
     return "DefaultActorType";
 }
 
+TypeId Actor::getActorTypeId() const
+{
+    if (typeId_ == NO_TYPE) {
+        typeId_ = TypeRegistry::getInstance().intern(getActorType());
+    }
+    return typeId_;
+}
+
 int Actor::getId() const
 {
     return id_;
@@ -29,16 +39,44 @@ int Actor::getId() const
 
 void Actor::addHex( std::shared_ptr<Common::Hex> hex )
 {
-    hex->addActor(shared_from_this());
-    if (hex_ != nullptr) {
-        hex_->removeActor(shared_from_this());
+    UndoLog* log = UndoLog::of(*hex);
+    if (log != nullptr) {
+        log->saveActor(*this);
+    }
+    std::shared_ptr<Actor> self = shared_from_this();
+    hex->addActor(self);
+    std::shared_ptr<Common::Hex> oldHex = hex_.lock();
+    if (oldHex != nullptr) {
+        oldHex->removeActor(self);
     }
     hex_ = hex;
 }
 
 std::shared_ptr<Hex> Actor::getHex()
 {
-    return hex_;
+    return hex_.lock();
+}
+
+Actor::State Actor::saveState() const
+{
+    return State{hex_};
+}
+
+void Actor::restoreState(const State& state)
+{
+    hex_ = state.hex;
+}
+
+void Actor::recordAction()
+{
+    std::shared_ptr<Hex> hex = hex_.lock();
+    if (hex == nullptr || hex->getBoard() == nullptr) {
+        return;
+    }
+    GameLog* log = hex->getBoard()->getGameLog();
+    if (log != nullptr) {
+        log->actorActed(id_, getActorTypeId(), hex->getCoordinates());
+    }
 }
 
 }
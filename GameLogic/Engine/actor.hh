@@ -22,6 +22,13 @@ namespace Common
 class Actor : public std::enable_shared_from_this<Actor>
 {
 public:
+    /**
+     * @brief The location of an actor, see saveState().
+     */
+    struct State {
+        std::weak_ptr<Common::Hex> hex;
+    };
+
     /**
      * @brief Default constructor, exists solely for documentation.
      */
@@ -62,6 +69,15 @@ public:
      */
     virtual std::string getActorType() const;
 
+    /**
+     * @brief getActorTypeId returns the type of the actor without building
+     * its name.
+     * @details By default the name from getActorType is interned on the first
+     * call.
+     * @return Identifier of the actor type, see TypeRegistry.
+     */
+    virtual Common::TypeId getActorTypeId() const;
+
     /**
      * @brief getId returns the id of the actor
      * @return id of the actor
@@ -84,11 +100,39 @@ public:
      */
     virtual std::shared_ptr<Common::Hex> getHex();
 
+    /**
+     * @brief saveState copies the location of the actor.
+     * @return The state.
+     */
+    State saveState() const;
+
+    /**
+     * @brief restoreState puts back a location saved with saveState().
+     * @details Only the actor is changed, the hexes are restored on their
+     * own.
+     * @param state The state.
+     * @post Exception quarantee: nothrow
+     */
+    void restoreState(const State& state);
+
 protected:
-    std::shared_ptr<Common::Hex> hex_;
+    /**
+     * @brief recordAction appends the action of the actor to the log of the
+     * game, if the board of its hex has one, see IGameBoard::getGameLog().
+     * @details Called by doAction() before the action changes the board.
+     * @post Exception quarantee: strong
+     */
+    void recordAction();
+
+    //! The hex the actor is on, owned by the board. Subclasses lock() it,
+    //! the hex may be gone.
+    std::weak_ptr<Common::Hex> hex_;
 
 private:
     int id_;
+
+    //! Interned getActorType(), NO_TYPE until it is needed.
+    mutable Common::TypeId typeId_ = NO_TYPE;
 };
 
 }
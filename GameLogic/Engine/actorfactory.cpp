@@ -8,11 +8,22 @@ using std::vector;
 
 ActorFactory::ActorFactory():
     actorDefinitions(),
-    idCounter(0)
+    idCounter(0),
+    arena_(nullptr)
 {
 
 }
 
+ActorFactory::ActorFactory(const ActorFactory& other):
+    actorDefinitions(),
+    idCounter(0)
+{
+    std::lock_guard<std::mutex> lock(other.mutex_);
+    actorDefinitions = other.actorDefinitions;
+    idCounter = other.idCounter;
+    arena_ = other.arena_;
+}
+
 ActorFactory& ActorFactory::getInstance()
 {
 
@@ -23,11 +34,32 @@ ActorFactory& ActorFactory::getInstance()
 
 void ActorFactory::addActor(string type, ActorBuildFunction buildFunction)
 {
+    Common::TypeRegistry::getInstance().intern(type);
+    std::lock_guard<std::mutex> lock(mutex_);
+    actorDefinitions[type] =
+            [buildFunction] (int id,
+                             const std::shared_ptr<Common::GameArena>&)
+    {
+        return buildFunction(id);
+    };
+}
+
+void ActorFactory::addActor(string type, ActorArenaBuildFunction buildFunction)
+{
+    Common::TypeRegistry::getInstance().intern(type);
+    std::lock_guard<std::mutex> lock(mutex_);
     actorDefinitions[type] = buildFunction;
 }
 
+void ActorFactory::setArena(std::shared_ptr<Common::GameArena> arena)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    arena_ = std::move(arena);
+}
+
 std::vector<std::string> ActorFactory::getAvailableActors() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto types = vector<string>();
     for (auto it = actorDefinitions.begin();
          it != actorDefinitions.end();
@@ -40,8 +72,27 @@ std::vector<std::string> ActorFactory::getAvailableActors() const
 
 ActorPointer ActorFactory::createActor(string type)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     ++idCounter;
-    return actorDefinitions[type](idCounter);
+    return actorDefinitions[type](idCounter, arena_);
+}
+
+ActorPointer ActorFactory::createActor(string type, int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return actorDefinitions[type](id, arena_);
+}
+
+int ActorFactory::lastId() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idCounter;
+}
+
+void ActorFactory::rewindIds(int lastId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    idCounter = lastId;
 }
 
 }
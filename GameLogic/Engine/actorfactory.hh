@@ -2,8 +2,10 @@
 #define ACTORFACTORY_HH
 
 #include "actor.hh"
+#include "gamearena.hh"
 
 #include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <map>
@@ -18,6 +20,8 @@ namespace Logic {
 
 using ActorPointer = std::shared_ptr<Common::Actor>;
 using ActorBuildFunction = std::function<ActorPointer (int)>;
+using ActorArenaBuildFunction = std::function<ActorPointer (
+        int, const std::shared_ptr<Common::GameArena>&)>;
 /**
  * @brief Singleton class for creating actors.
  *
@@ -33,13 +37,38 @@ public:
      */
     static ActorFactory& getInstance();
 
+    /**
+     * @brief Copy constructor.
+     * @details Copies the registered types, so that a game can create
+     * actors with ids of its own while other games use the shared
+     * factory. Safe to call while other threads register types.
+     * @param other The factory to copy.
+     */
+    ActorFactory(const ActorFactory& other);
+
+    ActorFactory& operator=(const ActorFactory&) = delete;
+
     /**
      * @brief Adds a build
-     * @param type Actor type identifier
+     * @param type Actor type identifier, also interned in TypeRegistry
      * @param buildFunction function that performs the building
      */
     void addActor(std::string type, ActorBuildFunction buildFunction);
 
+    /**
+     * @brief Adds a build function that allocates from the arena of the game
+     * @param type Actor type identifier, also interned in TypeRegistry
+     * @param buildFunction function that performs the building, gets the id
+     * and the arena, which may be nullptr. See Common::GameArena::make.
+     */
+    void addActor(std::string type, ActorArenaBuildFunction buildFunction);
+
+    /**
+     * @brief setArena sets the arena the created actors are allocated from
+     * @param arena arena of the game, nullptr for the heap
+     */
+    void setArena(std::shared_ptr<Common::GameArena> arena);
+
     /**
      * @brief getAvailableActors
      * @return vector contailing the type identifiers of available actors
@@ -53,12 +82,38 @@ public:
      */
     ActorPointer createActor(std::string type);
 
+    /**
+     * @brief createActor creates a actor with the given id, used when a game is
+     * forked. The ids of the next created actors are not changed.
+     * @param type
+     * @param id
+     * @return the created actor. Ownership is transferred to caller
+     */
+    ActorPointer createActor(std::string type, int id);
+
+    /**
+     * @brief lastId tells the id of the last created actor
+     * @return the id, 0 if no actor has been created
+     */
+    int lastId() const;
+
+    /**
+     * @brief rewindIds makes the next created actor get the id after lastId,
+     * used when created actors are taken back
+     * @param lastId the id of the last actor that still exists
+     */
+    void rewindIds(int lastId);
+
 private:
 
     ActorFactory();
 
-    std::map<std::string, ActorBuildFunction> actorDefinitions;
+    std::map<std::string, ActorArenaBuildFunction> actorDefinitions;
     int idCounter;
+    std::shared_ptr<Common::GameArena> arena_;
+
+    //! Guards the definitions and the counter.
+    mutable std::mutex mutex_;
 };
 
 }
@@ -0,0 +1,142 @@
+#ifndef BOARDINDEX_HH
+#define BOARDINDEX_HH
+
+#include "cubecoordinate.hh"
+
+#include <cstdlib>
+
+/**
+ * @file
+ * @brief Maps the hexes of a hexagonal board into a dense array.
+ */
+
+namespace Common {
+
+//! Number of neighbours each hex has.
+int const HEX_NEIGHBOURS = 6;
+
+/**
+ * @brief Offsets from a hex to its neighbours. Same order as in
+ * Hex::getNeighbourVector().
+ */
+const static CubeCoordinate NEIGHBOUR_OFFSETS[HEX_NEIGHBOURS] = {
+    CubeCoordinate(1,-1,0),
+    CubeCoordinate(1,0,-1),
+    CubeCoordinate(0,1,-1),
+    CubeCoordinate(-1,1,0),
+    CubeCoordinate(-1,0,1),
+    CubeCoordinate(0,-1,1)
+};
+
+/**
+ * @brief Maps cube coordinates of a board centered at (0,0,0) into slots of a
+ * dense array and back.
+ * @details Slots are laid out row by row in axial coordinates (q = x, r = z),
+ * so the array covers the bounding rhombus of the board. Mapping in either
+ * direction is a couple of integer operations.
+ */
+class BoardIndex {
+
+  public:
+
+    /**
+     * @brief Default constructor, creates an index for a single hex.
+     */
+    BoardIndex(): radius_(0), width_(1) {}
+
+    /**
+     * @brief Constructor.
+     * @param radius Largest distance from the center that can be indexed.
+     */
+    explicit BoardIndex(int radius):
+        radius_(radius < 0 ? 0 : radius),
+        width_(2 * radius_ + 1)
+    {}
+
+    /**
+     * @brief radius tells the largest distance from the center the index covers.
+     * @return The radius of the index.
+     */
+    int radius() const { return radius_; }
+
+    /**
+     * @brief width tells the number of slots in one row.
+     * @return The width of a row.
+     */
+    int width() const { return width_; }
+
+    /**
+     * @brief slotCount tells the number of slots needed for the array.
+     * @return The number of slots.
+     */
+    int slotCount() const { return width_ * width_; }
+
+    /**
+     * @brief contains checks if the coordinate fits into the index.
+     * @param coord Coordinate to check.
+     * @return true, if the coordinate has a slot, otherwise false.
+     */
+    bool contains(CubeCoordinate coord) const
+    {
+        return distanceFromCenter(coord) <= radius_ && isValid(coord);
+    }
+
+    /**
+     * @brief slotOf maps the coordinate to its slot.
+     * @param coord Coordinate to map.
+     * @return The slot of the coordinate or -1 if it is outside the index.
+     */
+    int slotOf(CubeCoordinate coord) const
+    {
+        if (!contains(coord)) {
+            return -1;
+        }
+        return (coord.z + radius_) * width_ + (coord.x + radius_);
+    }
+
+    /**
+     * @brief coordinateOf maps the slot back to a coordinate.
+     * @param slot Slot to map.
+     * @pre 0 <= slot < slotCount()
+     * @return The coordinate of the slot. The coordinate may be outside the
+     * radius, since slots cover the bounding rhombus of the board.
+     */
+    CubeCoordinate coordinateOf(int slot) const
+    {
+        int x = slot % width_ - radius_;
+        int z = slot / width_ - radius_;
+        return CubeCoordinate(x, -x - z, z);
+    }
+
+    /**
+     * @brief isValid checks that the coordinate is a cube coordinate.
+     * @param coord Coordinate to check.
+     * @return true, if coord.x + coord.y + coord.z == 0, otherwise false.
+     */
+    static bool isValid(CubeCoordinate coord)
+    {
+        return coord.x + coord.y + coord.z == 0;
+    }
+
+    /**
+     * @brief distanceFromCenter tells the distance of the coordinate from (0,0,0).
+     * @param coord Coordinate to measure.
+     * @return The distance in hexes.
+     */
+    static int distanceFromCenter(CubeCoordinate coord)
+    {
+        return (std::abs(coord.x) + std::abs(coord.y) + std::abs(coord.z)) / 2;
+    }
+
+  private:
+
+    //! Largest distance from the center that can be indexed.
+    int radius_;
+
+    //! Slots in one row.
+    int width_;
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "boardrecipe.hh"
+#include "formatexception.hh"
+#include "ioexception.hh"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+namespace Logic {
+
+std::shared_ptr<const BoardRecipe> BoardRecipe::readJSON(
+        const std::string& piecesPath,
+        const std::string& layoutPath)
+{
+    QFile file(QString::fromStdString(piecesPath));
+
+    if (!file.open(QFile::ReadOnly))
+    {
+        throw Common::IoException("Could not read file");
+    }
+
+    QJsonDocument json = QJsonDocument::fromJson(file.readAll());
+    if (json.isNull()) {
+        throw Common::FormatException("JSON parsing failed for input file");
+    }
+
+    PieceVector pieces;
+    QJsonArray common = json.object()["Common"].toArray();
+    for (int i = 0; i < common.size(); ++i) {
+        QJsonObject piece = common[i].toObject();
+        pieces.push_back(std::make_pair(
+                             piece.value("name").toString().toStdString(),
+                             piece.value("layers").toInt()));
+    }
+
+    return std::make_shared<const BoardRecipe>(
+                std::move(pieces), WheelLayoutParser(layoutPath));
+}
+
+BoardRecipe::BoardRecipe(PieceVector pieces, WheelLayoutParser spinnerLayout):
+    pieces_(std::move(pieces)),
+    radius_(-1),
+    spinnerLayout_(std::move(spinnerLayout)),
+    boardTemplate_(pieces_)
+{
+    // Every layer adds one ring around the center-piece
+    for (const auto& piece : pieces_) {
+        radius_ += piece.second;
+    }
+}
+
+const BoardRecipe::PieceVector& BoardRecipe::getPieces() const
+{
+    return pieces_;
+}
+
+int BoardRecipe::getRadius() const
+{
+    return radius_;
+}
+
+const WheelLayoutParser& BoardRecipe::getSpinnerLayout() const
+{
+    return spinnerLayout_;
+}
+
+const BoardTemplate& BoardRecipe::getBoardTemplate() const
+{
+    return boardTemplate_;
+}
+
+}
@@ -0,0 +1,89 @@
+#ifndef BOARDRECIPE_HH
+#define BOARDRECIPE_HH
+
+#include "boardtemplate.hh"
+#include "wheellayoutparser.hh"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief Parsed contents of the configuration files a game is built from.
+ */
+
+namespace Logic {
+
+/**
+ * @brief Everything GameEngine reads from Assets/: the piece layers of the
+ * island and the spinner layout, and the island built from the pieces.
+ * @details A recipe never changes once it has been read, so one instance is
+ * shared by every engine in every thread. Use PieceFactory::getRecipe() to
+ * get the shared instance instead of reading the files again.
+ */
+class BoardRecipe
+{
+public:
+    //! Piece types from the center outwards, and the layers of each.
+    using PieceVector = std::vector<std::pair<std::string, int>>;
+
+    /**
+     * @brief readJSON reads a recipe from the configuration files.
+     * @param piecesPath Path of the pieces file.
+     * @param layoutPath Path of the spinner layout file.
+     * @exception IOException Could not open a file for reading.
+     * @exception FormatException Format of a file is invalid.
+     * @return The recipe.
+     * @post Exception quarantee: strong
+     */
+    static std::shared_ptr<const BoardRecipe> readJSON(
+            const std::string& piecesPath,
+            const std::string& layoutPath);
+
+    /**
+     * @brief Constructor.
+     * @param pieces Piece types from the center outwards, and their layers.
+     * @param spinnerLayout The compiled spinner layout.
+     */
+    BoardRecipe(PieceVector pieces, WheelLayoutParser spinnerLayout);
+
+    /**
+     * @brief getPieces tells the piece layers of the island.
+     * @return Piece types from the center outwards, and the layers of each.
+     * @post Exception quarantee: nothrow
+     */
+    const PieceVector& getPieces() const;
+
+    /**
+     * @brief getRadius tells the radius of the board the pieces fill.
+     * @return The radius, -1 if there are no pieces.
+     * @post Exception quarantee: nothrow
+     */
+    int getRadius() const;
+
+    /**
+     * @brief getSpinnerLayout gives the compiled spinner layout.
+     * @return The spinner layout.
+     * @post Exception quarantee: nothrow
+     */
+    const WheelLayoutParser& getSpinnerLayout() const;
+
+    /**
+     * @brief getBoardTemplate gives the island the games start with.
+     * @return The board template.
+     * @post Exception quarantee: nothrow
+     */
+    const BoardTemplate& getBoardTemplate() const;
+
+private:
+    PieceVector pieces_;
+    int radius_;
+    WheelLayoutParser spinnerLayout_;
+    BoardTemplate boardTemplate_;
+};
+
+}
+
+#endif // BOARDRECIPE_HH
@@ -0,0 +1,221 @@
+#include "boardtemplate.hh"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Logic {
+
+namespace {
+
+// Size (radius) of the goal areas on the edge of the board
+const int GOAL_SIZE = 2;
+
+Common::CubeCoordinate neighbourOf(Common::CubeCoordinate coord, int side)
+{
+    const Common::CubeCoordinate& offset = Common::NEIGHBOUR_OFFSETS[side];
+    return Common::CubeCoordinate(coord.x + offset.x, coord.y + offset.y,
+                                  coord.z + offset.z);
+}
+
+}
+
+BoardTemplate::BoardTemplate(const PieceVector& pieces):
+    islandRadius_(0)
+{
+    // Every layer adds one ring around the center-piece
+    int boardRadius = -1;
+    for (const auto& piece : pieces) {
+        boardRadius += piece.second;
+    }
+    index_ = Common::BoardIndex(boardRadius);
+    slots_.assign(index_.slotCount(), -1);
+
+    // Generate layers of the island starting from center
+    int currentLayer = 0;
+    for (auto iter = pieces.begin(); iter != pieces.end(); ++iter)
+    {
+        Common::TypeId pieceType =
+                Common::TypeRegistry::getInstance().intern(iter->first);
+
+        // Do as many layers as specified for this piece-type
+        for (int i = 0; i < iter->second; ++i)
+        {
+            // Count this layer to islandRadius
+            if (pieceType != Common::WATER_TYPE
+                    && pieceType != Common::CORAL_TYPE) {
+                ++islandRadius_;
+            }
+
+            // Center-piece
+            if (i == 0 && iter == pieces.begin())
+            {
+                addHex(Common::CubeCoordinate(0,0,0), pieceType);
+            }
+
+            // Start from bottom-left corner of the ring and step through
+            // neighbours until a closed ring
+            Common::CubeCoordinate coord(-currentLayer, 0, currentLayer);
+            for (int j = 0; j < Common::HEX_NEIGHBOURS; ++j)
+            {
+                // Looping sides of the ring
+                for (int k = 0; k < currentLayer; ++k)
+                {
+                    Common::TypeId type = pieceType;
+
+                    // Place goal-hexes only in corners
+                    if (type == Common::CORAL_TYPE
+                            && std::abs(coord.x) >= GOAL_SIZE
+                            && std::abs(coord.y) >= GOAL_SIZE
+                            && std::abs(coord.z) >= GOAL_SIZE)
+                    {
+                        // Put water between goal-hexes
+                        type = Common::WATER_TYPE;
+                    }
+
+                    addHex(coord, type);
+                    // Next tile
+                    coord = neighbourOf(coord, j);
+                }
+            }
+            ++currentLayer;
+        }
+    }
+
+    findBoatSpawns();
+}
+
+std::vector<std::shared_ptr<Common::Hex>> BoardTemplate::createHexes(
+        const std::shared_ptr<Common::GameArena>& arena) const
+{
+    // Each hex has its own control block, so that shared_from_this works,
+    // both come from the arena of the game
+    std::vector<std::shared_ptr<Common::Hex>> hexes;
+    hexes.reserve(prototypes_.size());
+    for (const Common::Hex& prototype : prototypes_) {
+        hexes.push_back(Common::GameArena::make<Common::Hex>(arena,
+                                                              prototype));
+    }
+    return hexes;
+}
+
+const BoardTemplate::IslandPieceVector& BoardTemplate::getIslandPieces() const
+{
+    return islandPieces_;
+}
+
+int BoardTemplate::getIslandRadius() const
+{
+    return islandRadius_;
+}
+
+std::vector<Common::CubeCoordinate> BoardTemplate::getBoatSpawns(
+        int players) const
+{
+    std::vector<Common::CubeCoordinate> spawns;
+    for (const auto& spawn : boatSpawns_) {
+        if (spawn.first <= players) {
+            spawns.push_back(spawn.second);
+        }
+    }
+    return spawns;
+}
+
+void BoardTemplate::addHex(Common::CubeCoordinate coord,
+                           Common::TypeId pieceType)
+{
+    // Keep track of piece-types and amounts
+    auto matchType = [pieceType](const auto& a)->bool{
+        return a.first == pieceType;
+    };
+    auto islandPiecesField = std::find_if(islandPieces_.begin(),
+                                          islandPieces_.end(), matchType);
+
+    int& slot = slots_[index_.slotOf(coord)];
+    if (slot >= 0) {
+        // There's already a hex in this position, it is going to be replaced
+        if (islandPiecesField != islandPieces_.end())
+        {
+            islandPiecesField->second = std::max(
+                        islandPiecesField->second - 1, 0);
+        }
+    } else if (islandPiecesField != islandPieces_.end()) {
+        islandPiecesField->second += 1;
+    } else if (pieceType != Common::WATER_TYPE
+               && pieceType != Common::CORAL_TYPE) {
+        // Water and Coral can't be sunk, so don't push them here.
+        // New pieceType, push back for sinking-order
+        islandPieces_.push_back({pieceType, 1});
+    }
+
+    Common::Hex hex;
+    hex.setCoordinates(coord);
+    hex.setPieceTypeId(pieceType);
+    if (slot >= 0) {
+        prototypes_[slot] = hex;
+    } else {
+        slot = prototypes_.size();
+        prototypes_.push_back(hex);
+    }
+}
+
+void BoardTemplate::findBoatSpawns()
+{
+    /* Spawns boats first in opposing corners of the island. When all corners
+     * are full, spawns more boats along each side of the island (equally if
+     * possible). Stops spawning boats if the coastline is full.
+     */
+    int offset = 0;
+    for (int i = 0; offset < islandRadius_; ++i)
+    {
+        Common::CubeCoordinate coordToAdd;
+
+        int islandSides = 6;
+        switch (i % islandSides) {
+        case 0: {
+            coordToAdd = Common::CubeCoordinate(
+                        islandRadius_, -islandRadius_+offset, -offset);
+            break;
+        }
+        case 1: {
+            coordToAdd = Common::CubeCoordinate(
+                        -islandRadius_, islandRadius_-offset, offset);
+            break;
+        }
+        case 2: {
+            coordToAdd = Common::CubeCoordinate(
+                        offset, -islandRadius_, islandRadius_-offset);
+            break;
+        }
+        case 3: {
+            coordToAdd = Common::CubeCoordinate(
+                        -offset, islandRadius_, -islandRadius_+offset);
+            break;
+        }
+        case 4: {
+            coordToAdd = Common::CubeCoordinate(
+                        islandRadius_-offset, offset, -islandRadius_);
+            break;
+        }
+        case 5: {
+            coordToAdd = Common::CubeCoordinate(
+                        -islandRadius_+offset, -offset, islandRadius_);
+            // Update offset before next lap
+            ++offset;
+            break;
+        }
+        default: {
+            break;
+        }
+        }
+
+        // The boat needs a water hex, player i+1 is the first to need it
+        if (index_.contains(coordToAdd)) {
+            int slot = slots_[index_.slotOf(coordToAdd)];
+            if (slot >= 0 && prototypes_[slot].isWaterTile()) {
+                boatSpawns_.push_back(std::make_pair(i + 1, coordToAdd));
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef BOARDTEMPLATE_HH
+#define BOARDTEMPLATE_HH
+
+#include "boardindex.hh"
+#include "cubecoordinate.hh"
+#include "gamearena.hh"
+#include "hex.hh"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief Prebuilt starting island that new games are copied from.
+ */
+
+namespace Logic {
+
+/**
+ * @brief The island every game of a BoardRecipe starts with.
+ * @details The island is laid out ring by ring once, when the recipe is
+ * read. A game gets its own hexes by copying the prototype hexes in one
+ * block. The hexes find their neighbours through the board they are added
+ * to, so the copies need no linking.
+ */
+class BoardTemplate
+{
+public:
+    //! Piece types and their numbers of layers.
+    using PieceVector = std::vector<std::pair<std::string, int>>;
+
+    //! Piece types that can be sunk and their numbers of hexes.
+    using IslandPieceVector = std::vector<std::pair<Common::TypeId, int>>;
+
+    /**
+     * @brief Constructor, lays out the island.
+     * @param pieces Piece types from the center outwards, and the layers of
+     * each.
+     */
+    explicit BoardTemplate(const PieceVector& pieces);
+
+    /**
+     * @brief createHexes creates the hexes of a new game.
+     * @details The hexes are copies of the prototypes, each created with
+     * GameArena::make.
+     * Changing them doesn't change the template.
+     * @param arena Arena of the game the hexes are allocated from, nullptr
+     * for the heap.
+     * @return The hexes, in the order the island was laid out in.
+     * @post Exception quarantee: strong
+     */
+    std::vector<std::shared_ptr<Common::Hex>> createHexes(
+            const std::shared_ptr<Common::GameArena>& arena = nullptr) const;
+
+    /**
+     * @brief getIslandPieces tells the hexes of each type that can be sunk.
+     * @return Piece types in the order they first appear from the center
+     * outwards, and the number of hexes of each.
+     */
+    const IslandPieceVector& getIslandPieces() const;
+
+    /**
+     * @brief getIslandRadius tells the number of rings that are not water or
+     * coral.
+     * @return The radius of the island.
+     */
+    int getIslandRadius() const;
+
+    /**
+     * @brief getBoatSpawns tells where the boats of a game start.
+     * @details Boats start first in opposing corners of the island, then
+     * along each side of it, one for each player as long as the coastline
+     * has room and the spot is water.
+     * @param players The number of players.
+     * @return Coordinates of the boats.
+     */
+    std::vector<Common::CubeCoordinate> getBoatSpawns(int players) const;
+
+private:
+    void addHex(Common::CubeCoordinate coord, Common::TypeId pieceType);
+    void findBoatSpawns();
+
+    //! Maps coordinates to prototypes while the island is laid out.
+    Common::BoardIndex index_;
+    std::vector<int> slots_;
+
+    //! Hexes not on any board, in the order they were laid out.
+    std::vector<Common::Hex> prototypes_;
+
+    IslandPieceVector islandPieces_;
+    int islandRadius_;
+
+    //! Boat spawns and the number of players that needs each.
+    std::vector<std::pair<int, Common::CubeCoordinate>> boatSpawns_;
+};
+
+}
+
+#endif // BOARDTEMPLATE_HH
@@ -0,0 +1,42 @@
+#include "boardtopology.hh"
+
+#include <map>
+#include <mutex>
+
+namespace Common {
+
+const int BoardTopology::NO_SLOT;
+
+BoardTopology::BoardTopology(int radius):
+    index_(radius),
+    neighbours_(index_.slotCount() * HEX_NEIGHBOURS)
+{
+    for (int slot = 0; slot < index_.slotCount(); ++slot) {
+        CubeCoordinate coord = index_.coordinateOf(slot);
+        for (int side = 0; side < HEX_NEIGHBOURS; ++side) {
+            const CubeCoordinate& offset = NEIGHBOUR_OFFSETS[side];
+            CubeCoordinate neighbour(coord.x + offset.x, coord.y + offset.y,
+                                     coord.z + offset.z);
+            // slotOf gives -1 outside the index
+            neighbours_[slot * HEX_NEIGHBOURS + side] =
+                    index_.slotOf(neighbour);
+        }
+    }
+}
+
+std::shared_ptr<const BoardTopology> BoardTopology::forRadius(int radius)
+{
+    // Games come and go with the same few radii, the tables are kept so
+    // that a new game doesn't rebuild them
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const BoardTopology>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const BoardTopology>& table = tables[radius];
+    if (table == nullptr) {
+        table = std::make_shared<const BoardTopology>(radius);
+    }
+    return table;
+}
+
+}
@@ -0,0 +1,99 @@
+#ifndef BOARDTOPOLOGY_HH
+#define BOARDTOPOLOGY_HH
+
+#include "boardindex.hh"
+#include "smallvector.hh"
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief Neighbour table of a hexagonal board, shared by the boards of the
+ * same size.
+ */
+
+namespace Common {
+
+/**
+ * @brief The slots of the neighbours of every slot of a BoardIndex.
+ * @details The table only depends on the radius of the board, so it is
+ * computed once and shared by every board, path finder and game of that
+ * radius, see forRadius(). A table never changes after it is built, and
+ * reading it doesn't allocate.
+ */
+class BoardTopology {
+
+  public:
+
+    //! Neighbour slot of a side that is outside the index.
+    static const int NO_SLOT = -1;
+
+    /**
+     * @brief Constructor, computes the table.
+     * @param radius Radius of the board index.
+     * @post Exception quarantee: strong
+     */
+    explicit BoardTopology(int radius);
+
+    /**
+     * @brief forRadius returns the shared table of a radius.
+     * @details The table is built the first time a radius is asked for and
+     * kept for the rest of the program. Can be called from several threads.
+     * @param radius Radius of the board index.
+     * @return The table.
+     * @post Exception quarantee: strong
+     */
+    static std::shared_ptr<const BoardTopology> forRadius(int radius);
+
+    /**
+     * @brief getIndex returns the mapping between coordinates and slots.
+     * @return The index the slots of the table refer to.
+     */
+    const BoardIndex& getIndex() const { return index_; }
+
+    /**
+     * @brief radius tells the largest distance from the center the table
+     * covers.
+     * @return The radius of the index.
+     */
+    int radius() const { return index_.radius(); }
+
+    /**
+     * @brief neighbourSlots returns the slots of the neighbours of a slot.
+     * @param slot The slot.
+     * @pre 0 <= slot < getIndex().slotCount()
+     * @return HEX_NEIGHBOURS slots in the order of NEIGHBOUR_OFFSETS, NO_SLOT
+     * for the neighbours outside the index.
+     * @post Exception quarantee: nothrow
+     */
+    Span<const int> neighbourSlots(int slot) const
+    {
+        return Span<const int>(neighbours_.data() + slot * HEX_NEIGHBOURS,
+                               HEX_NEIGHBOURS);
+    }
+
+    /**
+     * @brief neighbourSlot returns the slot of one neighbour of a slot.
+     * @param slot The slot.
+     * @param side Index of the neighbour in NEIGHBOUR_OFFSETS.
+     * @pre 0 <= slot < getIndex().slotCount(), 0 <= side < HEX_NEIGHBOURS
+     * @return The slot of the neighbour, NO_SLOT if it is outside the index.
+     * @post Exception quarantee: nothrow
+     */
+    int neighbourSlot(int slot, int side) const
+    {
+        return neighbours_[slot * HEX_NEIGHBOURS + side];
+    }
+
+  private:
+
+    BoardIndex index_;
+
+    //! HEX_NEIGHBOURS slots for each slot of index_.
+    std::vector<int> neighbours_;
+};
+
+}
+
+#endif // BOARDTOPOLOGY_HH
@@ -2,6 +2,7 @@
 #include "hex.hh"
 
 #include <algorithm>
+#include <map>
 
 namespace Common {
 
@@ -14,11 +15,17 @@ std::string Boat::getTransportType()
     return "boat";
 }
 
+TypeId Boat::getTransportTypeId()
+{
+    return BOAT_TYPE;
+}
+
 void Boat::move(std::shared_ptr<Hex> to) {
+    std::shared_ptr<Hex> from = getHex();
     std::vector<std::shared_ptr<Common::Pawn>>::iterator i;
     for( i = pawns_.begin(); i != pawns_.end(); ++i){
         to->addPawn(*i);
-        hex_->removePawn(*i);
+        from->removePawn(*i);
         (*i)->setCoordinates(to->getCoordinates());
     }
     addHex(to);
@@ -24,6 +24,11 @@ public:
      */
     virtual std::string getTransportType();
 
+    /**
+     * @copydoc Common::Transport::getTransportTypeId()
+     */
+    virtual Common::TypeId getTransportTypeId();
+
     /**
      * @brief move moves the boat from the current hex tile to another
      * @param to indicates the target tile
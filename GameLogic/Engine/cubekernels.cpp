@@ -0,0 +1,312 @@
+#include "cubekernels.hh"
+#include "boardindex.hh"
+
+#include <cstdlib>
+#include <type_traits>
+
+// The vector versions need the intrinsics and the function attributes of
+// GCC and Clang. SSE2 is part of x86-64, AVX2 is checked at run time.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CUBEKERNELS_X86_64
+#include <immintrin.h>
+#endif
+
+namespace Common {
+
+namespace CubeKernels {
+
+namespace {
+
+static_assert(sizeof(CubeCoordinate) == 3 * sizeof(int) &&
+              std::is_standard_layout<CubeCoordinate>::value,
+              "The kernels read coordinates as arrays of x, y and z");
+
+using DistanceKernel = void (*)(CubeCoordinate, const CubeCoordinate*,
+                                std::size_t, int*);
+using NeighbourKernel = void (*)(const CubeCoordinate*, std::size_t,
+                                 CubeCoordinate*);
+
+void distancesScalar(CubeCoordinate origin, const CubeCoordinate* coords,
+                     std::size_t count, int* distances)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        distances[i] = (std::abs(coords[i].x - origin.x) +
+                        std::abs(coords[i].y - origin.y) +
+                        std::abs(coords[i].z - origin.z)) / 2;
+    }
+}
+
+void neighboursScalar(const CubeCoordinate* coords, std::size_t count,
+                      CubeCoordinate* neighbours)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int side = 0; side < HEX_NEIGHBOURS; ++side) {
+            const CubeCoordinate& offset = NEIGHBOUR_OFFSETS[side];
+            neighbours[i * HEX_NEIGHBOURS + side] =
+                    CubeCoordinate(coords[i].x + offset.x,
+                                   coords[i].y + offset.y,
+                                   coords[i].z + offset.z);
+        }
+    }
+}
+
+#ifdef CUBEKERNELS_X86_64
+
+// NEIGHBOUR_OFFSETS as consecutive x, y and z, padded to full vectors
+alignas(32) const int FLAT_OFFSETS[24] = {
+    1, -1, 0,   1, 0, -1,   0, 1, -1,
+    -1, 1, 0,   -1, 0, 1,   0, -1, 1
+};
+
+// Shuffles four coordinates held in three vectors into x, y and z vectors.
+// Each of them is built from two vectors holding two of the components.
+void deinterleave4(__m128i first, __m128i second, __m128i third,
+                   __m128i& x, __m128i& y, __m128i& z)
+{
+    __m128 a = _mm_castsi128_ps(first);
+    __m128 b = _mm_castsi128_ps(second);
+    __m128 c = _mm_castsi128_ps(third);
+    const int pick = _MM_SHUFFLE(2, 0, 2, 0);
+
+    x = _mm_castps_si128(_mm_shuffle_ps(
+            _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)),
+            _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), pick));
+    y = _mm_castps_si128(_mm_shuffle_ps(
+            _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), pick));
+    z = _mm_castps_si128(_mm_shuffle_ps(
+            _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), pick));
+}
+
+// |value| without SSSE3
+__m128i abs4(__m128i value)
+{
+    __m128i sign = _mm_srai_epi32(value, 31);
+    return _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+}
+
+void distancesSse2(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances)
+{
+    const __m128i originX = _mm_set1_epi32(origin.x);
+    const __m128i originY = _mm_set1_epi32(origin.y);
+    const __m128i originZ = _mm_set1_epi32(origin.z);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i* ints = reinterpret_cast<const __m128i*>(coords + i);
+        __m128i x, y, z;
+        deinterleave4(_mm_loadu_si128(ints), _mm_loadu_si128(ints + 1),
+                      _mm_loadu_si128(ints + 2), x, y, z);
+
+        __m128i sum = _mm_add_epi32(
+                    _mm_add_epi32(abs4(_mm_sub_epi32(x, originX)),
+                                  abs4(_mm_sub_epi32(y, originY))),
+                    abs4(_mm_sub_epi32(z, originZ)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(distances + i),
+                         _mm_srli_epi32(sum, 1));
+    }
+    distancesScalar(origin, coords + i, count - i, distances + i);
+}
+
+void neighboursSse2(const CubeCoordinate* coords, std::size_t count,
+                    CubeCoordinate* neighbours)
+{
+    const __m128i* offsets = reinterpret_cast<const __m128i*>(FLAT_OFFSETS);
+    const __m128i offset0 = _mm_load_si128(offsets);
+    const __m128i offset1 = _mm_load_si128(offsets + 1);
+    const __m128i offset2 = _mm_load_si128(offsets + 2);
+    const __m128i offset3 = _mm_load_si128(offsets + 3);
+    const __m128i offset4 = _mm_load_si128(offsets + 4);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        // The six neighbours repeat x, y, z; lanes of four start the
+        // pattern at x, y or z in turn
+        __m128i xyzx = _mm_setr_epi32(coords[i].x, coords[i].y, coords[i].z,
+                                      coords[i].x);
+        __m128i yzxy = _mm_shuffle_epi32(xyzx, _MM_SHUFFLE(1, 0, 2, 1));
+        __m128i zxyz = _mm_shuffle_epi32(xyzx, _MM_SHUFFLE(2, 1, 0, 2));
+
+        __m128i* out = reinterpret_cast<__m128i*>(neighbours +
+                                                  i * HEX_NEIGHBOURS);
+        _mm_storeu_si128(out, _mm_add_epi32(xyzx, offset0));
+        _mm_storeu_si128(out + 1, _mm_add_epi32(yzxy, offset1));
+        _mm_storeu_si128(out + 2, _mm_add_epi32(zxyz, offset2));
+        _mm_storeu_si128(out + 3, _mm_add_epi32(xyzx, offset3));
+        _mm_storel_epi64(out + 4, _mm_add_epi32(yzxy, offset4));
+    }
+}
+
+__attribute__((target("avx2")))
+void distancesAvx2(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances)
+{
+    // Eight coordinates fill three vectors. Blending them puts each
+    // component in every lane once, a permutation sorts them.
+    const __m256i orderX = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+    const __m256i orderY = _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6);
+    const __m256i orderZ = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+    const __m256i originX = _mm256_set1_epi32(origin.x);
+    const __m256i originY = _mm256_set1_epi32(origin.y);
+    const __m256i originZ = _mm256_set1_epi32(origin.z);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i* ints = reinterpret_cast<const __m256i*>(coords + i);
+        __m256i a = _mm256_loadu_si256(ints);
+        __m256i b = _mm256_loadu_si256(ints + 1);
+        __m256i c = _mm256_loadu_si256(ints + 2);
+
+        __m256i x = _mm256_permutevar8x32_epi32(
+                    _mm256_blend_epi32(_mm256_blend_epi32(a, b, 0x92), c, 0x24),
+                    orderX);
+        __m256i y = _mm256_permutevar8x32_epi32(
+                    _mm256_blend_epi32(_mm256_blend_epi32(a, b, 0x24), c, 0x49),
+                    orderY);
+        __m256i z = _mm256_permutevar8x32_epi32(
+                    _mm256_blend_epi32(_mm256_blend_epi32(a, b, 0x49), c, 0x92),
+                    orderZ);
+
+        __m256i sum = _mm256_add_epi32(
+                    _mm256_add_epi32(
+                        _mm256_abs_epi32(_mm256_sub_epi32(x, originX)),
+                        _mm256_abs_epi32(_mm256_sub_epi32(y, originY))),
+                    _mm256_abs_epi32(_mm256_sub_epi32(z, originZ)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(distances + i),
+                            _mm256_srli_epi32(sum, 1));
+    }
+    distancesScalar(origin, coords + i, count - i, distances + i);
+}
+
+__attribute__((target("avx2")))
+void neighboursAvx2(const CubeCoordinate* coords, std::size_t count,
+                    CubeCoordinate* neighbours)
+{
+    const __m256i* offsets = reinterpret_cast<const __m256i*>(FLAT_OFFSETS);
+    const __m256i offset0 = _mm256_load_si256(offsets);
+    const __m256i offset1 = _mm256_load_si256(offsets + 1);
+    const __m128i offset2 = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(FLAT_OFFSETS + 16));
+    const __m256i patternFromX = _mm256_setr_epi32(0, 1, 2, 0, 1, 2, 0, 1);
+    const __m256i patternFromZ = _mm256_setr_epi32(2, 0, 1, 2, 0, 1, 2, 0);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        __m128i xyz = _mm_setr_epi32(coords[i].x, coords[i].y, coords[i].z,
+                                     0);
+        __m256i wide = _mm256_castsi128_si256(xyz);
+        __m256i xyzxyzxy = _mm256_permutevar8x32_epi32(wide, patternFromX);
+        __m256i zxyzxyzx = _mm256_permutevar8x32_epi32(wide, patternFromZ);
+        __m128i yz = _mm_shuffle_epi32(xyz, _MM_SHUFFLE(3, 3, 2, 1));
+
+        int* out = reinterpret_cast<int*>(neighbours + i * HEX_NEIGHBOURS);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                            _mm256_add_epi32(xyzxyzxy, offset0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8),
+                            _mm256_add_epi32(zxyzxyzx, offset1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16),
+                         _mm_add_epi32(yz, offset2));
+    }
+}
+
+KernelLevel detectLevel()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return KernelLevel::AVX2;
+    }
+    return KernelLevel::SSE2;
+}
+
+#else
+
+KernelLevel detectLevel()
+{
+    return KernelLevel::SCALAR;
+}
+
+#endif
+
+KernelLevel usableLevel(KernelLevel level)
+{
+    KernelLevel supported = supportedLevel();
+    return level > supported ? supported : level;
+}
+
+DistanceKernel distanceKernel(KernelLevel level)
+{
+    switch (usableLevel(level)) {
+#ifdef CUBEKERNELS_X86_64
+    case KernelLevel::AVX2:
+        return distancesAvx2;
+    case KernelLevel::SSE2:
+        return distancesSse2;
+#endif
+    default:
+        return distancesScalar;
+    }
+}
+
+NeighbourKernel neighbourKernel(KernelLevel level)
+{
+    switch (usableLevel(level)) {
+#ifdef CUBEKERNELS_X86_64
+    case KernelLevel::AVX2:
+        return neighboursAvx2;
+    case KernelLevel::SSE2:
+        return neighboursSse2;
+#endif
+    default:
+        return neighboursScalar;
+    }
+}
+
+}
+
+KernelLevel supportedLevel()
+{
+    static const KernelLevel level = detectLevel();
+    return level;
+}
+
+const char* levelName(KernelLevel level)
+{
+    switch (level) {
+    case KernelLevel::AVX2:
+        return "avx2";
+    case KernelLevel::SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+void distancesFrom(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances)
+{
+    static const DistanceKernel kernel = distanceKernel(supportedLevel());
+    kernel(origin, coords, count, distances);
+}
+
+void distancesFrom(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances, KernelLevel level)
+{
+    distanceKernel(level)(origin, coords, count, distances);
+}
+
+void neighboursOf(const CubeCoordinate* coords, std::size_t count,
+                  CubeCoordinate* neighbours)
+{
+    static const NeighbourKernel kernel = neighbourKernel(supportedLevel());
+    kernel(coords, count, neighbours);
+}
+
+void neighboursOf(const CubeCoordinate* coords, std::size_t count,
+                  CubeCoordinate* neighbours, KernelLevel level)
+{
+    neighbourKernel(level)(coords, count, neighbours);
+}
+
+}
+
+}
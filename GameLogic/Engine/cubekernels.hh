@@ -0,0 +1,93 @@
+#ifndef CUBEKERNELS_HH
+#define CUBEKERNELS_HH
+
+#include "cubecoordinate.hh"
+
+#include <cstddef>
+
+/**
+ * @file
+ * @brief Distances and neighbours of many cube coordinates at once.
+ */
+
+namespace Common {
+
+/**
+ * @brief Batched computations on arrays of cube coordinates.
+ * @details Each kernel has a scalar version and, on x86-64 with GCC or
+ * Clang, SSE2 and AVX2 versions. The best version the processor supports is
+ * chosen the first time a kernel is called. All the versions give the same
+ * results.
+ */
+namespace CubeKernels {
+
+/**
+ * @brief Instruction sets the kernels can use, from the slowest.
+ */
+enum class KernelLevel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief supportedLevel tells the best instruction set the kernels can use
+ * on this processor.
+ * @return The instruction set used by the kernels without a level.
+ * @post Exception quarantee: nothrow
+ */
+KernelLevel supportedLevel();
+
+/**
+ * @brief levelName gives the name of an instruction set.
+ * @param level The instruction set.
+ * @return "scalar", "sse2" or "avx2".
+ */
+const char* levelName(KernelLevel level);
+
+/**
+ * @brief distancesFrom computes the distance of every coordinate from an
+ * origin, in hexes.
+ * @param origin The origin.
+ * @param coords Array of count coordinates.
+ * @param count Number of coordinates.
+ * @param distances Array of count distances, filled in the order of coords.
+ * @post Exception quarantee: nothrow
+ */
+void distancesFrom(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances);
+
+/**
+ * @brief distancesFrom computes the distances with the given instruction
+ * set, see distancesFrom().
+ * @param level The instruction set. A level the processor doesn't support
+ * falls back to supportedLevel().
+ */
+void distancesFrom(CubeCoordinate origin, const CubeCoordinate* coords,
+                   std::size_t count, int* distances, KernelLevel level);
+
+/**
+ * @brief neighboursOf computes the neighbours of every coordinate.
+ * @param coords Array of count coordinates.
+ * @param count Number of coordinates.
+ * @param neighbours Array of count * HEX_NEIGHBOURS coordinates, filled with
+ * the neighbours of each coordinate in the order of NEIGHBOUR_OFFSETS.
+ * @post Exception quarantee: nothrow
+ */
+void neighboursOf(const CubeCoordinate* coords, std::size_t count,
+                  CubeCoordinate* neighbours);
+
+/**
+ * @brief neighboursOf computes the neighbours with the given instruction
+ * set, see neighboursOf().
+ * @param level The instruction set. A level the processor doesn't support
+ * falls back to supportedLevel().
+ */
+void neighboursOf(const CubeCoordinate* coords, std::size_t count,
+                  CubeCoordinate* neighbours, KernelLevel level);
+
+}
+
+}
+
+#endif // CUBEKERNELS_HH
@@ -2,6 +2,7 @@
 #include "hex.hh"
 
 #include <algorithm>
+#include <map>
 
 namespace Common {
 
@@ -16,11 +17,17 @@ std::string Dolphin::getTransportType()
     return "dolphin";
 }
 
+TypeId Dolphin::getTransportTypeId()
+{
+    return DOLPHIN_TYPE;
+}
+
 void Dolphin::move(std::shared_ptr<Hex> to) {
+    std::shared_ptr<Hex> from = getHex();
     std::vector<std::shared_ptr<Common::Pawn>>::iterator i;
     for( i = pawns_.begin(); i != pawns_.end(); ++i){
         to->addPawn(*i);
-        hex_->removePawn(*i);
+        from->removePawn(*i);
         (*i)->setCoordinates(to->getCoordinates());
     }
     addHex(to);
@@ -23,6 +23,11 @@ public:
      */
     virtual std::string getTransportType();
 
+    /**
+     * @copydoc Common::Transport::getTransportTypeId()
+     */
+    virtual Common::TypeId getTransportTypeId();
+
     /**
      * @copydoc Common::Transport::move()
      */
@@ -0,0 +1,52 @@
+#ifndef GAMEACTION_HH
+#define GAMEACTION_HH
+
+#include "cubecoordinate.hh"
+
+/**
+ * @file
+ * @brief One legal action of the player in turn, as listed by
+ * IGameRunner::legalActions().
+ */
+
+namespace Common {
+
+/**
+ * @brief A move or flip the game runner accepts in the current game phase.
+ * @details Each type names the IGameRunner function that performs it:\n
+ * MOVE_PAWN: movePawn(origin, target, id)\n
+ * MOVE_TRANSPORT: moveTransport(origin, target, id)\n
+ * MOVE_ACTOR: moveActor(origin, target, id, moves of the last spin)\n
+ * MOVE_TRANSPORT_WITH_SPINNER: moveTransportWithSpinner(origin, target, id,
+ * moves of the last spin)\n
+ * FLIP_TILE: flipTile(target)
+ */
+struct GameAction
+{
+    enum Type {
+        MOVE_PAWN,
+        MOVE_TRANSPORT,
+        MOVE_ACTOR,
+        MOVE_TRANSPORT_WITH_SPINNER,
+        FLIP_TILE
+    };
+
+    Type type;
+
+    //! Coordinates of the moved piece, the flipped tile for FLIP_TILE.
+    CubeCoordinate origin;
+
+    //! Coordinates the piece moves to, the flipped tile for FLIP_TILE.
+    CubeCoordinate target;
+
+    //! Identifier of the moved pawn, transport or actor, 0 for FLIP_TILE.
+    int id;
+
+    //! Actions the player has left after the move, as returned by the move
+    //! function. 0 for the actions that don't return one.
+    int movesLeft;
+};
+
+}
+
+#endif // GAMEACTION_HH
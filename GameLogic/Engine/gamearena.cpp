@@ -0,0 +1,96 @@
+#include "gamearena.hh"
+
+#include <cstdint>
+
+namespace Common {
+
+namespace {
+
+// Chunk headers are padded so that the memory after them is fully aligned
+const std::size_t HEADER_SIZE =
+        (sizeof(void*) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);
+
+}
+
+GameArena::GameArena(std::size_t chunkSize):
+    chunkSize_(chunkSize),
+    chunks_(nullptr),
+    current_(nullptr),
+    left_(0),
+    chunkCount_(0),
+    allocated_(0)
+{
+}
+
+GameArena::~GameArena()
+{
+    while (chunks_ != nullptr) {
+        Chunk* next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+}
+
+void* GameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(current_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+
+    if (current_ == nullptr || padding + size > left_) {
+        if (size > chunkSize_ / 4) {
+            // Large blocks get a chunk of their own, so the current chunk
+            // stays in use
+            allocated_ += size;
+            return allocateChunk(size);
+        }
+        current_ = static_cast<char*>(allocateChunk(chunkSize_));
+        left_ = chunkSize_;
+        padding = 0;
+    }
+
+    void* memory = current_ + padding;
+    current_ += padding + size;
+    left_ -= padding + size;
+    allocated_ += padding + size;
+    return memory;
+}
+
+std::size_t GameArena::chunkCount() const
+{
+    return chunkCount_;
+}
+
+std::size_t GameArena::bytesAllocated() const
+{
+    return allocated_;
+}
+
+GameArena::Mark GameArena::mark() const
+{
+    return Mark{chunks_, current_, left_, chunkCount_, allocated_};
+}
+
+void GameArena::rewind(const Mark& mark)
+{
+    while (chunks_ != mark.chunks) {
+        Chunk* next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+    current_ = mark.current;
+    left_ = mark.left;
+    chunkCount_ = mark.chunkCount;
+    allocated_ = mark.allocated;
+}
+
+void* GameArena::allocateChunk(std::size_t size)
+{
+    Chunk* chunk = static_cast<Chunk*>(::operator new(HEADER_SIZE + size));
+    chunk->next = chunks_;
+    chunks_ = chunk;
+    ++chunkCount_;
+    return reinterpret_cast<char*>(chunk) + HEADER_SIZE;
+}
+
+}
@@ -0,0 +1,210 @@
+#ifndef GAMEARENA_HH
+#define GAMEARENA_HH
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/**
+ * @file
+ * @brief Memory of the pieces and hexes of a single game.
+ */
+
+namespace Common {
+
+/**
+ * @brief Hands out memory for the objects of one game from a few large
+ * chunks, and frees all of it at once when the game is over.
+ * @details Allocation moves a pointer forward inside the current chunk, and
+ * freeing a single object does nothing. The chunks are returned to the heap
+ * when the arena is destroyed, so a game costs a handful of heap calls no
+ * matter how many objects it creates. Objects are created with make(), their
+ * control blocks keep the arena alive until the last of them is destroyed.
+ * An arena is meant for one game and is not safe to use from several threads
+ * at the same time.
+ */
+class GameArena
+{
+    struct Chunk;
+
+public:
+    /**
+     * @brief Position of the arena, given to rewind() to free everything
+     * allocated after it.
+     */
+    struct Mark
+    {
+        Chunk* chunks;
+        char* current;
+        std::size_t left;
+        std::size_t chunkCount;
+        std::size_t allocated;
+    };
+
+    //! Size of the chunks, larger requests get a chunk of their own.
+    static const std::size_t DEFAULT_CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * @brief Constructor. Does not allocate, the first chunk is taken when
+     * it is needed.
+     * @param chunkSize Size of the chunks in bytes.
+     */
+    explicit GameArena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Destructor, frees every chunk.
+     * @pre No object allocated from the arena is alive.
+     */
+    ~GameArena();
+
+    GameArena(const GameArena&) = delete;
+    GameArena& operator=(const GameArena&) = delete;
+
+    /**
+     * @brief allocate reserves memory from the arena.
+     * @param size Number of bytes needed.
+     * @param alignment Alignment of the memory, a power of two that is at
+     * most alignof(std::max_align_t).
+     * @return Pointer to the memory, valid until the arena is destroyed.
+     * @exception std::bad_alloc A new chunk could not be allocated.
+     * @post Exception quarantee: strong
+     */
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * @brief chunkCount tells how many chunks the arena has taken from the
+     * heap.
+     * @return The number of chunks.
+     */
+    std::size_t chunkCount() const;
+
+    /**
+     * @brief bytesAllocated tells how much memory has been handed out.
+     * @return The number of bytes, padding included.
+     */
+    std::size_t bytesAllocated() const;
+
+    /**
+     * @brief mark tells the current position of the arena.
+     * @return The position, for rewind().
+     * @post Exception quarantee: nothrow
+     */
+    Mark mark() const;
+
+    /**
+     * @brief rewind frees the memory allocated after a mark, the next
+     * allocations reuse it. Chunks taken after the mark go back to the heap.
+     * @param mark A position returned by mark() of this arena.
+     * @pre No object allocated after the mark is alive, and the arena hasn't
+     * been rewound to an earlier position since the mark was taken.
+     * @post Exception quarantee: nothrow
+     */
+    void rewind(const Mark& mark);
+
+    /**
+     * @brief make creates an object whose memory and control block come from
+     * an arena.
+     * @param arena The arena to allocate from. If nullptr, the object is
+     * created on the heap like with std::make_shared.
+     * @param args Arguments of the constructor of T.
+     * @return Shared pointer to the new object.
+     * @post Exception quarantee: strong
+     */
+    template <class T, class... Args>
+    static std::shared_ptr<T> make(const std::shared_ptr<GameArena>& arena,
+                                   Args&&... args);
+
+private:
+    struct Chunk
+    {
+        Chunk* next;
+    };
+
+    void* allocateChunk(std::size_t size);
+
+    std::size_t chunkSize_;
+    Chunk* chunks_;
+    char* current_;
+    std::size_t left_;
+    std::size_t chunkCount_;
+    std::size_t allocated_;
+};
+
+/**
+ * @brief Standard allocator that allocates from a GameArena.
+ * @details Each allocator keeps its arena alive. Without an arena it falls
+ * back to the heap, so that containers and objects can take an allocator
+ * whether or not the game uses an arena.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    /**
+     * @brief Constructor.
+     * @param arena The arena to allocate from, or nullptr for the heap.
+     */
+    explicit ArenaAllocator(std::shared_ptr<GameArena> arena = nullptr):
+        arena_(std::move(arena))
+    {
+    }
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other):
+        arena_(other.arena())
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (arena_ == nullptr) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(count * sizeof(T),
+                                                alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count)
+    {
+        // Arena memory is freed with the arena
+        (void)count;
+        if (arena_ == nullptr) {
+            ::operator delete(pointer);
+        }
+    }
+
+    const std::shared_ptr<GameArena>& arena() const
+    {
+        return arena_;
+    }
+
+private:
+    std::shared_ptr<GameArena> arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class... Args>
+std::shared_ptr<T> GameArena::make(const std::shared_ptr<GameArena>& arena,
+                                   Args&&... args)
+{
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                   std::forward<Args>(args)...);
+}
+
+}
+
+#endif // GAMEARENA_HH
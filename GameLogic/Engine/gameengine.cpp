@@ -3,48 +3,90 @@
 #include "hex.hh"
 #include "actor.hh"
 #include "boat.hh"
+#include "cubekernels.hh"
 #include "illegalmoveexception.hh"
 #include "piecefactory.hh"
+#include "rules.hh"
+#include "transport.hh"
 #include "transportfactory.hh"
 
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
-#include <ctime>
 
 namespace Logic {
 
-//! Rule for max pawns per tile
-int const MAX_PAWNS_PER_HEX = 3;
-int const MAX_ACTIONS_PER_TURN = 3;
+namespace {
 
-GameEngine::GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
-                       std::shared_ptr<Common::IGameState> statePtr,
-                       std::vector<std::shared_ptr<Common::IPlayer> > players):
-    playerVector_(players),
-    board_(boardPtr),
-    gameState_(statePtr),
-    islandRadius_(0)
+// Range of a move that may go any distance
+const int UNLIMITED_RANGE = -1;
+
+// Number of hexes at most range hexes from a hex, the hex included
+std::size_t hexesWithin(int range)
 {
-    // Initialize random-number seed
-    std::srand(std::time(0));
+    return 3 * static_cast<std::size_t>(range) * (range + 1) + 1;
+}
 
-    PieceFactory::getInstance().readJSON();
+}
 
+GameEngine::GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
+                       std::shared_ptr<Common::IGameState> statePtr,
+                       std::vector<std::shared_ptr<Common::IPlayer> > players,
+                       unsigned int seed):
+    GameEngine(boardPtr, statePtr, players, GameRandom(seed))
+{
     initializeBoard();
     try {
         initializeBoats();
     } catch (Common::GameException& e) {
         std::cout<< e.msg() <<std::endl;
     }
+}
 
-    layoutParser_.readJSON("Assets/layout.json");
+GameEngine::GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
+                       std::shared_ptr<Common::IGameState> statePtr,
+                       std::vector<std::shared_ptr<Common::IPlayer> > players,
+                       std::shared_ptr<const Common::GameSnapshot> snapshot):
+    GameEngine(boardPtr, statePtr, players, snapshot->rng)
+{
+    restoreSnapshot(*snapshot);
+}
+
+GameEngine::GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
+                       std::shared_ptr<Common::IGameState> statePtr,
+                       std::vector<std::shared_ptr<Common::IPlayer> > players,
+                       const GameRandom& rng):
+    playerVector_(players),
+    board_(boardPtr),
+    gameState_(statePtr),
+    rng_(rng),
+    arena_(std::make_shared<Common::GameArena>()),
+    actorFactory_(ActorFactory::getInstance()),
+    transportFactory_(TransportFactory::getInstance()),
+    creatables_(actorFactory_.getAvailableActors()),
+    actorTypeCount_(creatables_.size()),
+    recipe_(PieceFactory::getInstance().getRecipe()),
+    islandRadius_(0),
+    undoLog_(std::make_shared<Common::UndoLog>())
+{
+    auto transports = transportFactory_.getAvailableTransports();
+    creatables_.insert(creatables_.end(), transports.begin(), transports.end());
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    for (const auto& type : creatables_) {
+        creatableTypes_.push_back(registry.intern(type));
+    }
+
+    actorFactory_.setArena(arena_);
+    transportFactory_.setArena(arena_);
+    board_->setArena(arena_);
+    board_->setUndoLog(undoLog_);
 }
 
 int GameEngine::movePawn(Common::CubeCoordinate origin,
                          Common::CubeCoordinate target,
                          int pawnId)
 {
-    std::shared_ptr<Common::IPlayer> player = getCurrentPlayer();
+    Common::IPlayer* player = findCurrentPlayer();
 
     // Current player not found
     if (player == nullptr){
@@ -59,6 +101,9 @@ int GameEngine::movePawn(Common::CubeCoordinate origin,
     } else {
         board_->movePawn(pawnId, target);
         player->setActionsLeft(movesLeft);
+        if (gameLog_ != nullptr) {
+            gameLog_->pawnMoved(pawnId, origin, target, movesLeft);
+        }
     }
 
     return movesLeft;
@@ -78,8 +123,8 @@ int GameEngine::checkPawnMovement(Common::CubeCoordinate origin,
     //    (5) distance != 1 if moving in water
     //    (6) No possible route to target found
 
-    std::shared_ptr<Common::Hex> sourceHex = board_->getHex(origin);
-    std::shared_ptr<Common::Hex> targetHex = board_->getHex(target);
+    Common::Hex* sourceHex = board_->findHex(origin);
+    Common::Hex* targetHex = board_->findHex(target);
 
     // (1)
 
@@ -88,7 +133,7 @@ int GameEngine::checkPawnMovement(Common::CubeCoordinate origin,
     }
 
     // (2)
-    std::shared_ptr<Common::Pawn> pawn = sourceHex->givePawn(pawnId);
+    Common::Pawn* pawn = sourceHex->findPawn(pawnId);
     if (pawn == nullptr) {
         return -1;
     }
@@ -100,31 +145,22 @@ int GameEngine::checkPawnMovement(Common::CubeCoordinate origin,
 
     unsigned int distance = cubeCoordinateDistance(origin, target);
 
-    int playerId = pawn->getPlayerId();
-    if (playerId == gameState_->currentPlayer()) {
-
-        // Find ptr to player
-        auto playerIt = playerVector_.begin();
-        while (playerIt != playerVector_.end()) {
-            if ((*playerIt)->getPlayerId() == gameState_->currentPlayer()) {
-                break;
-            }
-            ++playerIt;
-        }
+    Common::IPlayer* player = findCurrentPlayer();
+    if (player != nullptr && pawn->getPlayerId() == player->getPlayerId()) {
+        unsigned int actionsLeft = player->getActionsLeft();
 
         // (4)
-        if ((*playerIt)->getActionsLeft() >= distance) {
-            if (board_->isWaterTile(origin) > 0) {
+        if (actionsLeft >= distance) {
+            if (sourceHex->isWaterTile()) {
                 // (5)
-                if ((distance == 1) && ((*playerIt)->getActionsLeft() >= 3)) {
+                if ((distance == 1) && (actionsLeft >= 3)) {
                     return 0;
                 }
             } else {
                 // (6)
-                if (breadthFirst(origin,target,
-                                (*playerIt)->getActionsLeft())) {
-                    unsigned int hadActions = (*playerIt)->getActionsLeft();
-                    return hadActions - distance;
+                if (pathFinder_.isReachable(*board_, origin, target,
+                                            actionsLeft)) {
+                    return actionsLeft - distance;
                 }
             }
         }
@@ -134,6 +170,84 @@ int GameEngine::checkPawnMovement(Common::CubeCoordinate origin,
 
 }
 
+Common::MoveTargets GameEngine::reachablePawnTargets(
+        Common::CubeCoordinate origin, int pawnId)
+{
+    // Same rules as in checkPawnMovement, checked for every target at once
+
+    Common::Hex* sourceHex = board_->findHex(origin);
+    if (sourceHex == nullptr) {
+        return Common::MoveTargets();
+    }
+
+    Common::Pawn* pawn = sourceHex->findPawn(pawnId);
+    if (pawn == nullptr || pawn->getPlayerId() != gameState_->currentPlayer()) {
+        return Common::MoveTargets();
+    }
+
+    Common::IPlayer* player = findCurrentPlayer();
+    if (player == nullptr) {
+        return Common::MoveTargets();
+    }
+    unsigned int actionsLeft = player->getActionsLeft();
+
+    // Every change of a hex of the board counts in the generation of its
+    // undo log, a board without the engine's log can't be cached
+    bool cacheable = board_->getUndoLog() == undoLog_.get();
+    if (cacheable && moveCache_.valid &&
+            moveCache_.generation == undoLog_->generation() &&
+            moveCache_.origin == origin &&
+            moveCache_.pawnId == pawnId &&
+            moveCache_.playerId == player->getPlayerId() &&
+            moveCache_.actionsLeft == actionsLeft) {
+        return moveCache_.targets;
+    }
+
+    // Built straight into the cache when there is one
+    moveCache_.valid = false;
+    Common::MoveTargets uncachedTargets;
+    Common::MoveTargets& targets =
+            cacheable ? moveCache_.targets : uncachedTargets;
+    targets.clear();
+    if (sourceHex->isWaterTile()) {
+        // Swimming takes all the actions and only one hex at a time
+        if (actionsLeft >= MAX_ACTIONS_PER_TURN) {
+            Common::CubeCoordinate neighbours[Common::HEX_NEIGHBOURS];
+            Common::CubeKernels::neighboursOf(&origin, 1, neighbours);
+            for (const auto& coord : neighbours) {
+                Common::Hex* targetHex = board_->findHex(coord);
+                if (targetHex != nullptr &&
+                        targetHex->getPawnAmount() < MAX_PAWNS_PER_HEX) {
+                    targets[coord] = 0;
+                }
+            }
+        }
+    } else {
+        reached_.clear();
+        pathFinder_.reachableFrom(*board_, origin, actionsLeft, reached_);
+        reachedDistances_.resize(reached_.size());
+        Common::CubeKernels::distancesFrom(origin, reached_.data(),
+                                           reached_.size(),
+                                           reachedDistances_.data());
+        for (std::size_t i = 0; i < reached_.size(); ++i) {
+            if (board_->findHex(reached_[i])->getPawnAmount() <
+                    MAX_PAWNS_PER_HEX) {
+                targets[reached_[i]] = actionsLeft - reachedDistances_[i];
+            }
+        }
+    }
+
+    if (cacheable) {
+        moveCache_.generation = undoLog_->generation();
+        moveCache_.origin = origin;
+        moveCache_.pawnId = pawnId;
+        moveCache_.playerId = player->getPlayerId();
+        moveCache_.actionsLeft = actionsLeft;
+        moveCache_.valid = true;
+    }
+    return targets;
+}
+
 void GameEngine::moveActor(Common::CubeCoordinate origin,
                            Common::CubeCoordinate target,
                            int actorId,
@@ -148,6 +262,10 @@ void GameEngine::moveActor(Common::CubeCoordinate origin,
     {
         board_->moveActor(actorId, target);
         getCurrentPlayer()->setActionsLeft(MAX_ACTIONS_PER_TURN);
+        spin_.valid = false;
+        if (gameLog_ != nullptr) {
+            gameLog_->actorMoved(actorId, origin, target, moves);
+        }
     }
 
 
@@ -165,15 +283,14 @@ bool GameEngine::checkActorMovement(Common::CubeCoordinate origin,
     //    (4) Target-hex is too far away
 
     // (1)
-    std::shared_ptr<Common::Hex> sourceHex = board_->getHex(origin);
-    std::shared_ptr<Common::Hex> targetHex = board_->getHex(target);
+    Common::Hex* sourceHex = board_->findHex(origin);
+    Common::Hex* targetHex = board_->findHex(target);
     if ( (sourceHex == nullptr) || (targetHex == nullptr) ) {
         return false;
     }
 
     // (2)
-    std::shared_ptr<Common::Actor> actor = sourceHex->giveActor(actorId);
-    if (actor == nullptr) {
+    if (sourceHex->findActor(actorId) == nullptr) {
         return false;
     }
 
@@ -214,7 +331,7 @@ int GameEngine::moveTransport(Common::CubeCoordinate origin,
                               int transportId)
 {
     // Find current player
-    std::shared_ptr<Common::IPlayer> player = getCurrentPlayer();
+    Common::IPlayer* player = findCurrentPlayer();
 
     // Current player not found
     if (player == nullptr){
@@ -232,6 +349,9 @@ int GameEngine::moveTransport(Common::CubeCoordinate origin,
     {
         player->setActionsLeft(movesLeft);
         board_->moveTransport(transportId, target);
+        if (gameLog_ != nullptr) {
+            gameLog_->transportMoved(transportId, origin, target, movesLeft);
+        }
     }
     return movesLeft;
 }
@@ -256,6 +376,10 @@ int GameEngine::moveTransportWithSpinner(Common::CubeCoordinate origin,
     }
     if (movesLeft == 0 ){
         getCurrentPlayer()->setActionsLeft(MAX_ACTIONS_PER_TURN);
+        spin_.valid = false;
+    }
+    if (gameLog_ != nullptr) {
+        gameLog_->transportSpun(transportId, origin, target, moves, movesLeft);
     }
     return movesLeft;
 
@@ -275,15 +399,14 @@ int GameEngine::checkTransportMovement(Common::CubeCoordinate origin,
     //    (6) Current player is not allowed to move this transport
 
     // (1)
-    std::shared_ptr<Common::Hex> sourceHex = board_->getHex(origin);
-    std::shared_ptr<Common::Hex> targetHex = board_->getHex(target);
+    Common::Hex* sourceHex = board_->findHex(origin);
+    Common::Hex* targetHex = board_->findHex(target);
     if (sourceHex == nullptr || targetHex == nullptr) {
         return -1;
     }
 
     // (2)
-    std::shared_ptr<Common::Transport> transport =
-            sourceHex->giveTransport(transportId);
+    Common::Transport* transport = sourceHex->findTransport(transportId);
     if (transport == nullptr) {
         return -1;
     }
@@ -340,22 +463,156 @@ int GameEngine::checkTransportMovement(Common::CubeCoordinate origin,
     return movesLeft;
 }
 
+std::size_t GameEngine::legalActions(std::vector<Common::GameAction>& actions)
+{
+    std::size_t firstAction = actions.size();
+    switch (currentGamePhase()) {
+    case Common::GamePhase::MOVEMENT:
+        addMovementActions(actions);
+        break;
+    case Common::GamePhase::SINKING:
+        addFlipActions(actions);
+        break;
+    case Common::GamePhase::SPINNING:
+        addSpinnerActions(actions);
+        break;
+    }
+    return actions.size() - firstAction;
+}
+
+int GameEngine::makeAction(const Common::GameAction& action)
+{
+    if (board_->getUndoLog() != undoLog_.get()) {
+        throw Common::GameException("The board does not keep the undo log,"
+                                    " actions can't be taken back");
+    }
+
+    Common::IPlayer* player = findCurrentPlayer();
+    UndoLevel level{rng_, spin_, islandPieces_.size(), {},
+                    actorFactory_.lastId(), transportFactory_.lastId(),
+                    currentGamePhase(), player,
+                    player == nullptr ? 0 : player->getActionsLeft(),
+                    gameLog_ == nullptr ? Common::GameLog::Mark{} :
+                                          gameLog_->mark(),
+                    arena_->mark()};
+    if (!islandPieces_.empty()) {
+        level.topLayer = islandPieces_.back();
+    }
+    undoLevels_.push_back(level);
+    undoLog_->begin();
+
+    try {
+        return performAction(action);
+    } catch (...) {
+        unmakeAction();
+        throw;
+    }
+}
+
+void GameEngine::unmakeAction()
+{
+    const UndoLevel& level = undoLevels_.back();
+    undoLog_->undo();
+
+    rng_ = level.rng;
+    spin_ = level.spin;
+    // A flip only changes the top layer, or removes it when it runs out
+    if (level.islandLayers > 0) {
+        islandPieces_.resize(level.islandLayers);
+        islandPieces_.back() = level.topLayer;
+    }
+    actorFactory_.rewindIds(level.lastActorId);
+    transportFactory_.rewindIds(level.lastTransportId);
+    if (gameState_->currentGamePhase() != level.phase) {
+        gameState_->changeGamePhase(level.phase);
+    }
+    if (level.player != nullptr) {
+        level.player->setActionsLeft(level.actionsLeft);
+    }
+    // A log set after the makeAction keeps its records
+    if (gameLog_ != nullptr && level.logMark.size != 0) {
+        gameLog_->rewind(level.logMark);
+    }
+    // The undo dropped the pieces the taken back flips created
+    arena_->rewind(level.arenaMark);
+
+    undoLevels_.pop_back();
+}
+
+std::shared_ptr<const Common::GameSnapshot> GameEngine::snapshot() const
+{
+    using Piece = Common::GameSnapshot::Piece;
+
+    auto snapshot = std::make_shared<Common::GameSnapshot>();
+    snapshot->coordinates = hexCoords_;
+
+    const std::vector<Common::CubeCoordinate>& coords = *hexCoords_;
+    snapshot->terrain.reserve(coords.size());
+    for (std::size_t i = 0; i < coords.size(); ++i) {
+        const Common::Hex* hex = board_->findHex(coords[i]);
+        if (hex == nullptr) {
+            snapshot->terrain.push_back(Common::NO_TYPE);
+            continue;
+        }
+        int index = static_cast<int>(i);
+        snapshot->terrain.push_back(hex->getPieceTypeId());
+        for (const auto& pawn : hex->getPawnSpan()) {
+            snapshot->pawns.push_back(Piece{pawn->getId(), Common::NO_TYPE,
+                                            pawn->getPlayerId(), index, 0, 0});
+        }
+        for (const auto& actor : hex->getActorSpan()) {
+            snapshot->actors.push_back(Piece{actor->getId(),
+                                             actor->getActorTypeId(), 0,
+                                             index, 0, 0});
+        }
+        for (const auto& transport : hex->getTransportSpan()) {
+            int firstPassenger = static_cast<int>(snapshot->passengers.size());
+            for (const auto& pawn : transport->getPawnsInTransport()) {
+                snapshot->passengers.push_back(pawn->getId());
+            }
+            snapshot->transports.push_back(Piece{
+                transport->getId(), transport->getTransportTypeId(), 0, index,
+                firstPassenger,
+                static_cast<int>(snapshot->passengers.size()) -
+                firstPassenger});
+        }
+    }
+
+    for (const auto& player : playerVector_) {
+        snapshot->players.push_back(Common::GameSnapshot::Player{
+            player->getPlayerId(), player->getActionsLeft()});
+    }
+    snapshot->phase = gameState_->currentGamePhase();
+    snapshot->currentPlayer = gameState_->currentPlayer();
+
+    snapshot->islandPieces.assign(islandPieces_.begin(), islandPieces_.end());
+    snapshot->spun = spin_.valid;
+    snapshot->spinType = spin_.type;
+    snapshot->spinMoves = spin_.moves;
+    snapshot->rng = rng_;
+    snapshot->lastActorId = actorFactory_.lastId();
+    snapshot->lastTransportId = transportFactory_.lastId();
+
+    return snapshot;
+}
+
 std::string GameEngine::flipTile(Common::CubeCoordinate tileCoord)
 {
 
     gameState_->changeGamePhase(Common::GamePhase::SINKING);
+    spin_.valid = false;
 
     // Haetaan ko. saaripala ja tarkistetaan sen olemassaolo.
     std::shared_ptr<Common::Hex> currentHex = board_->getHex(tileCoord);
     if (currentHex == nullptr) {
         throw Common::IllegalMoveException("The tile does not exist.");
     }
-    std::string pieceType = currentHex->getPieceType();
+    Common::TypeId pieceType = currentHex->getPieceTypeId();
 
     // Vesi- ja maaliruutuja ei voi olla mahdollista kääntää.
-    if (pieceType == "Water") {
+    if (pieceType == Common::WATER_TYPE) {
         throw Common::IllegalMoveException("Can not flip the water tile.");
-    } else if (pieceType == "Coral") {
+    } else if (pieceType == Common::CORAL_TYPE) {
         throw Common::IllegalMoveException("Can not flip the coral tile.");
     }
 
@@ -367,9 +624,16 @@ std::string GameEngine::flipTile(Common::CubeCoordinate tileCoord)
 
     auto& currentLayer = islandPieces_.back();
     if( pieceType != currentLayer.first ) {
-        throw Common::IllegalMoveException("All tiles of type " +
-                                           currentLayer.first +
-                                           " have not yet been flipped.");
+        throw Common::IllegalMoveException(
+                    "All tiles of type " +
+                    Common::TypeRegistry::getInstance().nameOf(
+                        currentLayer.first) +
+                    " have not yet been flipped.");
+    }
+
+    if (creatables_.empty()) {
+        throw Common::IllegalMoveException("No actor or transport types"
+                                           " registered");
     }
 
     // Laskurin päivitys.
@@ -380,25 +644,23 @@ std::string GameEngine::flipTile(Common::CubeCoordinate tileCoord)
     }
 
     // Toimijan arvontaa.
-    auto actors = Logic::ActorFactory::getInstance().getAvailableActors();
-    auto transports = Logic::TransportFactory::getInstance().getAvailableTransports();
-
-
-    std::vector<std::string> creatables;
-    creatables.reserve(actors.size() + transports.size());
-    creatables.insert(creatables.end(), actors.begin(), actors.end());
-    creatables.insert(creatables.end(), transports.begin(), transports.end());
-    std::random_shuffle(creatables.begin(), creatables.end());
-    auto selected = creatables.back();
-
-    auto matchString = [selected](auto a)->bool{return a == selected;};
-    if(std::find_if(transports.begin(), transports.end(), matchString) != transports.end()){
-        board_->addTransport(Logic::TransportFactory::getInstance().createTransport(selected), tileCoord);
-    } else if (std::find_if(actors.begin(), actors.end(), matchString) != actors.end()) {
-        board_->addActor(ActorFactory::ActorFactory::getInstance().createActor(selected), tileCoord);
+    std::size_t index = rng_.below(creatables_.size());
+    const std::string& selected = creatables_[index];
+    int appearedId = 0;
+    if (index < actorTypeCount_) {
+        auto actor = actorFactory_.createActor(selected);
+        appearedId = actor->getId();
+        board_->addActor(actor, tileCoord);
+    } else {
+        auto transport = transportFactory_.createTransport(selected);
+        appearedId = transport->getId();
+        board_->addTransport(transport, tileCoord);
     }
     // muutetaan ruutu vesiruuduksi.
-    currentHex->setPieceType("Water");
+    currentHex->setPieceTypeId(Common::WATER_TYPE);
+    if (gameLog_ != nullptr) {
+        gameLog_->tileFlipped(tileCoord, creatableTypes_[index], appearedId);
+    }
 
     return selected;
 
@@ -409,29 +671,28 @@ std::pair<std::string,std::string> GameEngine::spinWheel()
 
     gameState_->changeGamePhase(Common::GamePhase::SPINNING);
 
-    // Mikä eläin (arvonta)...
-    layoutParser_.getSections();
-    std::vector<std::string> sections = layoutParser_.getSections();;
-    std::random_shuffle(sections.begin(),sections.end());
-    std::string toMove = sections.back();
-
-    // ...ja paljon liikkuu (1,2,3,D -> arvonta).
+    // Mikä eläin ja paljonko se liikkuu (arvonta layout.jsonin painoilla).
+    Common::TypeId type = Common::NO_TYPE;
+    std::pair<std::string,std::string> result =
+            recipe_->getSpinnerLayout().spin(rng_, type);
 
-    auto moves = layoutParser_.getChancesForSection(toMove);
-    std::random_shuffle(moves.begin(),moves.end());
-    std::string moveAmount = moves.back().first;
+    setSpin(type, result.second);
+    if (gameLog_ != nullptr) {
+        gameLog_->wheelSpun(spin_.type, spin_.moves);
+    }
 
-    return std::pair<std::string,std::string> (toMove, moveAmount);
+    return result;
 
 }
 
 Common::SpinnerLayout GameEngine::getSpinnerLayout() const
 {
     using Common::SpinnerLayout;
-    auto sections = layoutParser_.getSections();
+    const WheelLayoutParser& layoutParser = recipe_->getSpinnerLayout();
+    auto sections = layoutParser.getSections();
     SpinnerLayout layout;
     for (const auto& section: sections){
-        auto chaces = layoutParser_.getChancesForSection(section);
+        auto chaces = layoutParser.getChancesForSection(section);
         for (const auto& chance: chaces) {
             layout[section].insert(chance);
         }
@@ -439,249 +700,180 @@ Common::SpinnerLayout GameEngine::getSpinnerLayout() const
     return layout;
 }
 
-std::shared_ptr<Common::IPlayer> GameEngine::getCurrentPlayer()
+int GameEngine::performAction(const Common::GameAction& action)
 {
-    int id = currentPlayer();
-    auto end = playerVector_.end();
-    for (auto iter = playerVector_.begin(); iter != end; ++iter) {
-        if ((*iter)->getPlayerId() == id) {
-            return *iter;
+    switch (action.type) {
+    case Common::GameAction::MOVE_PAWN:
+        return movePawn(action.origin, action.target, action.id);
+    case Common::GameAction::MOVE_TRANSPORT:
+        return moveTransport(action.origin, action.target, action.id);
+    case Common::GameAction::MOVE_ACTOR:
+        if (!spin_.valid) {
+            throw Common::IllegalMoveException("The wheel has not been spun");
         }
+        moveActor(action.origin, action.target, action.id, spin_.moves);
+        return 0;
+    case Common::GameAction::MOVE_TRANSPORT_WITH_SPINNER:
+        if (!spin_.valid) {
+            throw Common::IllegalMoveException("The wheel has not been spun");
+        }
+        return moveTransportWithSpinner(action.origin, action.target,
+                                        action.id, spin_.moves);
+    case Common::GameAction::FLIP_TILE:
+        flipTile(action.target);
+        return 0;
     }
-    return nullptr;
+    throw Common::IllegalMoveException("Unknown action");
 }
 
-bool GameEngine::breadthFirst(Common::CubeCoordinate FromCoord, Common::CubeCoordinate ToCoord, unsigned int actionsLeft)
+void GameEngine::setSpin(Common::TypeId type, const std::string& moves)
 {
-
-    unsigned int currentIndex = 0;
-    std::vector<std::pair<Common::CubeCoordinate,unsigned int>> checkVector;
-    std::pair<Common::CubeCoordinate,unsigned int> firstTile = std::make_pair(FromCoord,currentIndex);
-    checkVector.push_back(firstTile);
-
-    std::vector<Common::CubeCoordinate> workVector;
-    workVector.push_back(FromCoord);
-
-    while(not workVector.empty()){
-
-        Common::CubeCoordinate currentCoord = workVector.at(0);
-        workVector.erase(workVector.begin());
-        std::shared_ptr<Common::Hex> currentHex = board_->getHex(currentCoord);
-
-        if(currentHex->getPawnAmount() < MAX_PAWNS_PER_HEX
-                || currentCoord == FromCoord){
-            if(!(currentHex)->isWaterTile()){
-                unsigned int newIndex = 0;
-                while(newIndex < checkVector.size()){
-                    if(checkVector.at(newIndex).first == currentCoord){
-                        break;
-                    }
-                    newIndex++;
-                }
-                currentIndex = newIndex;
-
-                // Use only existing neighbours
-                std::vector<Common::CubeCoordinate> neighbourVector = {};
-                auto neighbourCoords = currentHex->getNeighbourVector();
-                auto neighboursEnd = neighbourCoords.end();
-                for (auto iter = neighbourCoords.begin(); iter != neighboursEnd;
-                     ++iter)
-                {
-                    if (board_->getHex(*iter) != nullptr) {
-                        neighbourVector.push_back(*iter);
-                    }
-                }
-
-                for(auto neighIt = neighbourVector.begin(); neighIt != neighbourVector.end(); neighIt++){
-
-                    if((*neighIt) == ToCoord){
-                        std::pair<Common::CubeCoordinate,int> finalTile = std::make_pair((*neighIt),currentIndex);
-                        checkVector.push_back(finalTile);
-
-                        unsigned int nextTile = checkVector.size();
-                        std::vector<Common::CubeCoordinate> finalRoadVector;
-                        while(nextTile != 0){
-
-                            finalRoadVector.insert(finalRoadVector.begin(),checkVector.at(nextTile - 1).first);
-                            nextTile = checkVector.at(nextTile  - 1).second;
-                        }
-                        //finalRoadVector.push_back(FromCoord);
-                        if(finalRoadVector.size() <= actionsLeft){
-                            return true;
-                        }
-                        else{
-                            return false;
-                        }
-                    }
-
-                    auto checkerIt = checkVector.begin();
-                    bool tileNotVisited = true;
-                    while(checkerIt != checkVector.end()){
-                        if((*checkerIt).first == (*neighIt)){
-                            tileNotVisited = false;
-                            break;
-                        }
-                        checkerIt++;
-                    }
-                    if(tileNotVisited){
-                        std::pair<Common::CubeCoordinate,int> tileToCheck = std::make_pair((*neighIt),currentIndex);
-                        checkVector.push_back(tileToCheck);
-                        workVector.push_back((*neighIt));
-                    }
-                }
-
-            }
+    // Resolved once here, so that legalActions doesn't parse it again
+    spin_.type = type;
+    spin_.dive = moves == "D";
+    spin_.moves = moves;
+    if (spin_.dive) {
+        spin_.range = UNLIMITED_RANGE;
+    } else {
+        try {
+            spin_.range = std::stoi(moves);
+        } catch (...) {
+            spin_.range = 0;
+        }
+        // The checks compare the distance to the moves as unsigned
+        if (spin_.range < 0) {
+            spin_.range = UNLIMITED_RANGE;
         }
-        currentIndex++;
     }
-
-    return false;
-
+    spin_.valid = true;
 }
 
-std::vector<Common::CubeCoordinate> GameEngine::addHexToBoard(
-                            Common::CubeCoordinate coord, std::string pieceType)
+Common::IPlayer* GameEngine::findCurrentPlayer() const
 {
-    /* Method creates a new hex and adds it to board.
-     * Also tracks the amount of hexes added to the board in _islandPieces
-     * Returns the neighbour-vector of the created hex to be used in algorithms
-    */
-
-    // Keep track of piece-types and amounts
-
-    // Find the field in islandPieces tracking the amount of this pieceType
-    auto matchType = [pieceType](auto a)->bool{return a.first == pieceType;};
-    auto islandPiecesField = std::find_if(islandPieces_.begin(),
-                                          islandPieces_.end(), matchType);
-
-    std::shared_ptr<Common::Hex> prevHex = board_->getHex(coord);
-    if (prevHex != nullptr) {
-        // There's already a hex in this position, for whatever reason.
-        // It is going to be replaced.
-
-        std::string prevType = prevHex->getPieceType();
-        if (islandPiecesField != islandPieces_.end())
-        {
-            islandPiecesField->second -= 1;
-            if (islandPiecesField->second < 0) islandPiecesField->second = 0;
+    int id = currentPlayer();
+    for (const auto& player : playerVector_) {
+        if (player->getPlayerId() == id) {
+            return player.get();
         }
-
-    } else if (islandPiecesField != islandPieces_.end()) {
-        islandPiecesField->second += 1;
-    } else if (pieceType != "Water" && pieceType != "Coral") {
-        // Water and Coral can't be sunk, so don't push them here.
-        // New pieceType, push front for sinking-order
-        islandPieces_.push_back({pieceType, 1});
-
-    } else {
-        // Do nothing to track the amount of Water and Coral
     }
+    return nullptr;
+}
 
-    // Add the hex
-    std::shared_ptr<Common::Hex> newHex = std::make_shared<Common::Hex>();
-    newHex->setCoordinates(coord);
-    newHex->setPieceType(pieceType);
-
-    // Add all already existing neighbour-pointers for this hex and add this
-    // hex as their neighbour
-    auto neighbourVector = newHex->getNeighbourVector();
-    for (auto it = neighbourVector.begin(); it != neighbourVector.end(); ++it) {
-        std::shared_ptr<Common::Hex> neighbourHex = board_->getHex(*it);
-        if (neighbourHex != nullptr) {
-            newHex->addNeighbour(neighbourHex);
-            neighbourHex->addNeighbour(newHex);
+std::shared_ptr<Common::IPlayer> GameEngine::getCurrentPlayer()
+{
+    int id = currentPlayer();
+    auto end = playerVector_.end();
+    for (auto iter = playerVector_.begin(); iter != end; ++iter) {
+        if ((*iter)->getPlayerId() == id) {
+            return *iter;
         }
     }
-
-    board_->addHex(newHex);
-
-    return neighbourVector;
+    return nullptr;
 }
 
 void GameEngine::initializeBoard()
 {
     /* Method initializes the game board -hexes
-     * Pieces to fill the board with are defined in Assets/pieces.json
+     * The island is laid out once for the recipe, here it is only copied
     */
+    const BoardTemplate& boardTemplate = recipe_->getBoardTemplate();
 
-    // Size (radius) of the goal areas on the edge of the board
-    int goalSize = 2;
+    int boardRadius = recipe_->getRadius();
+    if (boardRadius >= 0) {
+        board_->reserveRadius(boardRadius);
+        pathFinder_.reserveRadius(boardRadius);
+    }
 
-    // Get pieces from piecefactory
-    Logic::PieceFactory pieceFactory = Logic::PieceFactory::getInstance();
-    pieceFactory.readJSON();
-    typedef std::vector<std::pair<std::string,int>> pieceVector;
-    pieceVector pieces =
-            pieceFactory.getGamePieces();
+    auto hexCoords = std::make_shared<std::vector<Common::CubeCoordinate>>();
+    for (const auto& hex : boardTemplate.createHexes(arena_)) {
+        board_->addHex(hex);
+        // Not every IGameBoard sets itself, the hexes need it for
+        // clearAllFromNeightbours
+        hex->setBoard(board_.get());
+        hexCoords->push_back(hex->getCoordinates());
+    }
+    hexCoords_ = hexCoords;
+    islandPieces_ = boardTemplate.getIslandPieces();
+    islandRadius_ = boardTemplate.getIslandRadius();
+}
 
-    // Generate layers of the island starting from center
-    int currentLayer = 0;
-    pieceVector::iterator iter = pieces.begin();
-    while (iter != pieces.end())
-    {
-        // Do as many layers as specified for this piece-type
-        for (int i = 0; i < iter->second; ++i)
-        {
-            Common::CubeCoordinate coord;
-
-            // Count this layer to islandRadius
-            if ((iter->first != "Water") && (iter->first != "Coral")) {
-                ++islandRadius_;
-            }
+void GameEngine::restoreSnapshot(const Common::GameSnapshot& snapshot)
+{
+    const BoardTemplate& boardTemplate = recipe_->getBoardTemplate();
 
-            // Center-piece
-            if (i == 0 && iter == pieces.begin())
-            {
-                coord = Common::CubeCoordinate(0,0,0);
-                addHexToBoard(coord, iter->first);
-            }
+    int boardRadius = recipe_->getRadius();
+    if (boardRadius >= 0) {
+        board_->reserveRadius(boardRadius);
+        pathFinder_.reserveRadius(boardRadius);
+    }
 
-            // Start from bottom-left corner of the ring and step through
-            // neighbours until a closed ring
-            coord = Common::CubeCoordinate(-currentLayer, 0, currentLayer);
-
-            for (int j = 0; j < 6; ++j)
-            {
-                // Looping sides of the ring
-                for(int k = 0; k < currentLayer; ++k)
-                {
-                    std::string type = iter->first;
-
-                    // Place goal-hexes only in corners
-                    if (type == "Coral")
-                    {
-                        if (abs(coord.x) >= goalSize && abs(coord.y) >= goalSize
-                            && abs(coord.z) >= goalSize)
-                        {
-                            // Put water between goal-hexes
-                            type = "Water";
-                        }
-                    }
-
-                    std::vector<Common::CubeCoordinate> neighbours =
-                            addHexToBoard(coord, type);
-                    // Next tile
-                    coord = neighbours.at(j);
-                }
+    // The island of the snapshot was copied from the same template, so the
+    // hexes only differ in their terrain
+    const std::vector<Common::CubeCoordinate>& coords = *snapshot.coordinates;
+    std::vector<std::shared_ptr<Common::Hex>> hexes =
+            boardTemplate.createHexes(arena_);
+    if (hexes.size() != coords.size()) {
+        throw Common::GameException("The snapshot is of another island");
+    }
+    for (std::size_t i = 0; i < hexes.size(); ++i) {
+        if (!(hexes[i]->getCoordinates() == coords[i])) {
+            throw Common::GameException("The snapshot is of another island");
+        }
+        if (hexes[i]->getPieceTypeId() != snapshot.terrain[i]) {
+            hexes[i]->setPieceTypeId(snapshot.terrain[i]);
+        }
+        board_->addHex(hexes[i]);
+        hexes[i]->setBoard(board_.get());
+    }
+    hexCoords_ = snapshot.coordinates;
+    islandPieces_.assign(snapshot.islandPieces.begin(),
+                         snapshot.islandPieces.end());
+    islandRadius_ = boardTemplate.getIslandRadius();
+
+    Common::TypeRegistry& types = Common::TypeRegistry::getInstance();
+    for (const auto& pawn : snapshot.pawns) {
+        board_->addPawn(pawn.owner, pawn.id, coords[pawn.hex]);
+    }
+    for (const auto& actor : snapshot.actors) {
+        board_->addActor(actorFactory_.createActor(types.nameOf(actor.type),
+                                                   actor.id),
+                         coords[actor.hex]);
+    }
+    for (const auto& transport : snapshot.transports) {
+        std::shared_ptr<Common::Transport> created =
+                transportFactory_.createTransport(
+                    types.nameOf(transport.type), transport.id);
+        board_->addTransport(created, coords[transport.hex]);
+        Common::Hex* hex = board_->findHex(coords[transport.hex]);
+        for (int i = 0; i < transport.passengerCount; ++i) {
+            created->addPawn(hex->givePawn(
+                    snapshot.passengers[transport.firstPassenger + i]));
+        }
+    }
+    actorFactory_.rewindIds(snapshot.lastActorId);
+    transportFactory_.rewindIds(snapshot.lastTransportId);
+
+    if (snapshot.spun) {
+        setSpin(snapshot.spinType, snapshot.spinMoves);
+    }
+    gameState_->changeGamePhase(snapshot.phase);
+    gameState_->changePlayerTurn(snapshot.currentPlayer);
+    for (const auto& player : playerVector_) {
+        for (const auto& saved : snapshot.players) {
+            if (saved.id == player->getPlayerId()) {
+                player->setActionsLeft(saved.actionsLeft);
             }
-            ++currentLayer;
         }
-        ++iter;
     }
 }
 
 void GameEngine::initializeBoats()
 {
-    /* Initializes boats at the corners of the board.
-     * Spawns boats first in opposing corners of the island. When all corners
-     * are full, spawns more boats along each side of the island (equally if
-     * possible).
-     * Stops spawning boats if the coastline is full.
+    /* Initializes boats at the spawns of the board template.
      * Should be called after initializeBoard()
      * Expects transportfactory to already know how to build boats.
      */
-    auto& factory = Logic::TransportFactory::getInstance();
-    int players = playerAmount();
+    auto& factory = transportFactory_;
 
     // Throw if transportfactory doesn't know boats.
     auto available = factory.getAvailableTransports();
@@ -691,67 +883,204 @@ void GameEngine::initializeBoats()
                                     " are transports initialized?");
     }
 
-    int offset = 0;
-    for (int i = 0; i < players; ++i)
-    {
+    const BoardTemplate& boardTemplate = recipe_->getBoardTemplate();
+    for (const auto& coord : boardTemplate.getBoatSpawns(playerAmount())) {
+        board_->addTransport(factory.createTransport("boat"), coord);
+    }
+}
+
+void GameEngine::addMovementActions(std::vector<Common::GameAction>& actions)
+{
+    // As checkPawnMovement and checkTransportMovement, with the moves of
+    // moveTransport
+    Common::IPlayer* player = findCurrentPlayer();
+    if (player == nullptr) {
+        return;
+    }
+    int playerId = player->getPlayerId();
+    unsigned int actionsLeft = player->getActionsLeft();
 
-        // Stop adding boats if the coastline is full
-        if (offset >= islandRadius_) {
-            break;
+    for (const auto& coord : *hexCoords_) {
+        const Common::Hex* hex = board_->findHex(coord);
+        if (hex == nullptr) {
+            continue;
         }
 
-        Common::CubeCoordinate coordToAdd;
+        for (const auto& pawn : hex->getPawnSpan()) {
+            if (pawn->getPlayerId() == playerId) {
+                addPawnActions(*hex, pawn->getId(), actionsLeft, actions);
+            }
+        }
 
-        int islandSides = 6;
-        switch (i % islandSides) {
-        case 0: {
-            coordToAdd = Common::CubeCoordinate(
-                        islandRadius_, -islandRadius_+offset, -offset);
-            break;
+        for (const auto& transport : hex->getTransportSpan()) {
+            bool isTransportEmpty =
+                    transport->getMaxCapacity() == transport->getCapacity();
+            if (!transport->canMove(playerId) && !isTransportEmpty) {
+                continue;
+            }
+            findWaterTargets(coord, static_cast<int>(actionsLeft));
+            for (std::size_t i = 0; i < targets_.size(); ++i) {
+                actions.push_back(Common::GameAction{
+                        Common::GameAction::MOVE_TRANSPORT, coord,
+                        targets_[i], transport->getId(),
+                        static_cast<int>(actionsLeft) - targetDistances_[i]});
+            }
         }
-        case 1: {
-            coordToAdd = Common::CubeCoordinate(
-                        -islandRadius_, islandRadius_-offset, offset);
-            break;
+    }
+}
+
+void GameEngine::addFlipActions(std::vector<Common::GameAction>& actions)
+{
+    // As flipTile, only the outermost layer left can be flipped
+    if (islandPieces_.empty() || creatables_.empty()) {
+        return;
+    }
+    Common::TypeId pieceType = islandPieces_.back().first;
+
+    for (const auto& coord : *hexCoords_) {
+        const Common::Hex* hex = board_->findHex(coord);
+        if (hex != nullptr && hex->getPieceTypeId() == pieceType) {
+            actions.push_back(Common::GameAction{
+                    Common::GameAction::FLIP_TILE, coord, coord, 0, 0});
         }
-        case 2: {
-            coordToAdd = Common::CubeCoordinate(
-                        offset, -islandRadius_, islandRadius_-offset);
-            break;
+    }
+}
+
+void GameEngine::addSpinnerActions(std::vector<Common::GameAction>& actions)
+{
+    // As checkActorMovement and checkTransportMovement with the last spin.
+    // moveActor and moveTransportWithSpinner need a current player.
+    if (!spin_.valid || findCurrentPlayer() == nullptr) {
+        return;
+    }
+    int playerId = gameState_->currentPlayer();
+
+    for (const auto& coord : *hexCoords_) {
+        const Common::Hex* hex = board_->findHex(coord);
+        if (hex == nullptr) {
+            continue;
         }
-        case 3: {
-            coordToAdd = Common::CubeCoordinate(
-                        -offset, islandRadius_, -islandRadius_+offset);
-            break;
+        bool targetsFound = false;
+
+        for (const auto& actor : hex->getActorSpan()) {
+            if (actor->getActorTypeId() != spin_.type) {
+                continue;
+            }
+            if (!targetsFound) {
+                findWaterTargets(coord, spin_.range);
+                targetsFound = true;
+            }
+            for (const auto& target : targets_) {
+                actions.push_back(Common::GameAction{
+                        Common::GameAction::MOVE_ACTOR, coord, target,
+                        actor->getId(), 0});
+            }
         }
-        case 4: {
-            coordToAdd = Common::CubeCoordinate(
-                        islandRadius_-offset, offset, -islandRadius_);
-            break;
+
+        for (const auto& transport : hex->getTransportSpan()) {
+            if (transport->getTransportTypeId() != spin_.type) {
+                continue;
+            }
+            // A diving transport may be moved by anyone
+            bool isTransportEmpty =
+                    transport->getMaxCapacity() == transport->getCapacity();
+            if (!spin_.dive && !transport->canMove(playerId) &&
+                    !isTransportEmpty) {
+                continue;
+            }
+            if (!targetsFound) {
+                findWaterTargets(coord, spin_.range);
+                targetsFound = true;
+            }
+            for (const auto& target : targets_) {
+                actions.push_back(Common::GameAction{
+                        Common::GameAction::MOVE_TRANSPORT_WITH_SPINNER,
+                        coord, target, transport->getId(), 0});
+            }
         }
-        case 5: {
-            coordToAdd = Common::CubeCoordinate(
-                        -islandRadius_+offset, -offset, islandRadius_);
-            // Update offset before next lap
-            ++offset;
-            break;
+    }
+}
+
+void GameEngine::addPawnActions(const Common::Hex& hex, int pawnId,
+                                unsigned int actionsLeft,
+                                std::vector<Common::GameAction>& actions)
+{
+    // A swimmer moves one hex with all its actions, a pawn on land walks
+    // to every hex that isn't full within its actions left
+    Common::CubeCoordinate origin = hex.getCoordinates();
+
+    if (hex.isWaterTile()) {
+        // Swimming takes all the actions and only one hex at a time
+        if (actionsLeft < MAX_ACTIONS_PER_TURN) {
+            return;
         }
-        default: {
-            break;
+        Common::Hex* neighbours[Common::HEX_NEIGHBOURS];
+        board_->findNeighbours(origin, neighbours);
+        for (const Common::Hex* neighbour : neighbours) {
+            if (neighbour != nullptr &&
+                    neighbour->getPawnAmount() < MAX_PAWNS_PER_HEX) {
+                actions.push_back(Common::GameAction{
+                        Common::GameAction::MOVE_PAWN, origin,
+                        neighbour->getCoordinates(), pawnId, 0});
+            }
         }
+        return;
+    }
+
+    reached_.clear();
+    pathFinder_.reachableFrom(*board_, origin, actionsLeft, reached_);
+    reachedDistances_.resize(reached_.size());
+    Common::CubeKernels::distancesFrom(origin, reached_.data(),
+                                       reached_.size(),
+                                       reachedDistances_.data());
+    for (std::size_t i = 0; i < reached_.size(); ++i) {
+        if (board_->findHex(reached_[i])->getPawnAmount() <
+                MAX_PAWNS_PER_HEX) {
+            actions.push_back(Common::GameAction{
+                    Common::GameAction::MOVE_PAWN, origin, reached_[i],
+                    pawnId,
+                    static_cast<int>(actionsLeft) - reachedDistances_[i]});
         }
+    }
+}
 
-        // Add the boat, if a water hex exists at coordToAdd.
-        // No boats are added, if the board doesn't have a singe water-hex
-        std::shared_ptr<Common::Hex> hexToAdd = board_->getHex(coordToAdd);
-        if (hexToAdd != nullptr) {
-            if (hexToAdd->getPieceType() == "Water") {
-                std::shared_ptr<Common::Transport> newBoat =
-                                factory.createTransport("boat");
-                board_->addTransport(newBoat, coordToAdd);
+void GameEngine::findWaterTargets(Common::CubeCoordinate origin, int range)
+{
+    targets_.clear();
+    targetDistances_.clear();
+
+    if (range < 0 || hexesWithin(range) >= hexCoords_->size()) {
+        // The range covers the board, scan it instead of the hexagon
+        for (const auto& coord : *hexCoords_) {
+            if (!(coord == origin) && board_->isWaterTile(coord) &&
+                    (range < 0 ||
+                     cubeCoordinateDistance(origin, coord) <=
+                     static_cast<unsigned int>(range))) {
+                targets_.push_back(coord);
             }
         }
+        targetDistances_.resize(targets_.size());
+        Common::CubeKernels::distancesFrom(origin, targets_.data(),
+                                           targets_.size(),
+                                           targetDistances_.data());
+        return;
+    }
 
+    // Walk the hexagon of the given radius around the origin. The walk
+    // knows the offset of every hex, the distances come with it.
+    for (int dx = -range; dx <= range; ++dx) {
+        int minDy = std::max(-range, -dx - range);
+        int maxDy = std::min(range, -dx + range);
+        for (int dy = minDy; dy <= maxDy; ++dy) {
+            Common::CubeCoordinate coord(origin.x + dx, origin.y + dy,
+                                         origin.z - dx - dy);
+            if ((dx != 0 || dy != 0) && board_->isWaterTile(coord)) {
+                targets_.push_back(coord);
+                targetDistances_.push_back(
+                            (std::abs(dx) + std::abs(dy) +
+                             std::abs(dx + dy)) / 2);
+            }
+        }
     }
 }
 
@@ -782,6 +1111,20 @@ int GameEngine::playerAmount() const
     return playerVector_.size();
 }
 
+unsigned int GameEngine::getSeed() const
+{
+    return rng_.seed();
+}
+
+void GameEngine::setGameLog(std::shared_ptr<Common::GameLog> log)
+{
+    if (log != nullptr && log->empty()) {
+        log->gameStarted(getSeed(), playerAmount());
+    }
+    gameLog_ = log;
+    board_->setGameLog(std::move(log));
+}
+
 
 
 }
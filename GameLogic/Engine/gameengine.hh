@@ -1,13 +1,22 @@
 #ifndef GAMEENGINE_HH
 #define GAMEENGINE_HH
 
+#include "actorfactory.hh"
+#include "boardrecipe.hh"
 #include "cubecoordinate.hh"
+#include "gamearena.hh"
+#include "gamelog.hh"
+#include "gamerandom.hh"
+#include "gamesnapshot.hh"
 #include "igameboard.hh"
 #include "igamerunner.hh"
 #include "igamestate.hh"
 #include "iplayer.hh"
-#include "wheellayoutparser.hh"
+#include "pathfinder.hh"
+#include "transportfactory.hh"
+#include "undolog.hh"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,10 +45,34 @@ class GameEngine : public Common::IGameRunner
      * @param boardPtr Shared pointer to the game board.
      * @param statePtr Shared pointer to the game state.
      * @param playerVector Vector that contains players.
+     * @param seed Seed of the random events of the game.
+     * @details The engine copies the registered actor and transport types,
+     * and draws random events from a generator of its own, so engines can
+     * be used concurrently from different threads.
      */
     GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
                std::shared_ptr<Common::IGameState> statePtr,
-               std::vector<std::shared_ptr<Common::IPlayer>> players);
+               std::vector<std::shared_ptr<Common::IPlayer>> players,
+               unsigned int seed);
+
+    /**
+     * @brief Constructor, continues the game of a snapshot.
+     * @param boardPtr Shared pointer to an empty game board.
+     * @param statePtr Shared pointer to the game state, set to the phase
+     * and the player of the snapshot.
+     * @param playerVector Vector that contains players with the ids of the
+     * snapshot, their actions left are set.
+     * @param snapshot The game to continue, see snapshot().
+     * @details The island is copied from the recipe like for a new game and
+     * the pieces are created from the snapshot, no files are read. The new
+     * game plays out like the game of the snapshot would have from that
+     * moment.
+     * @pre The actor and transport types of the snapshot are registered.
+     */
+    GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
+               std::shared_ptr<Common::IGameState> statePtr,
+               std::vector<std::shared_ptr<Common::IPlayer>> players,
+               std::shared_ptr<const Common::GameSnapshot> snapshot);
 
     /**
      * @copydoc Common::IGameRunner::movePawn()
@@ -54,6 +87,13 @@ class GameEngine : public Common::IGameRunner
     virtual int checkPawnMovement(Common::CubeCoordinate origin,
                                   Common::CubeCoordinate target,
                                   int pawnId);
+
+    /**
+     * @copydoc Common::IGameRunner::reachablePawnTargets()
+     */
+    virtual Common::MoveTargets reachablePawnTargets(
+            Common::CubeCoordinate origin, int pawnId);
+
     /**
      * @copydoc Common::IGameRunner::moveActor()
      */
@@ -95,6 +135,26 @@ class GameEngine : public Common::IGameRunner
                                     Common::CubeCoordinate target,
                                     int transportId,
                                     std::string moves);
+    /**
+     * @copydoc Common::IGameRunner::legalActions()
+     */
+    virtual std::size_t legalActions(std::vector<Common::GameAction>& actions);
+
+    /**
+     * @copydoc Common::IGameRunner::makeAction()
+     */
+    virtual int makeAction(const Common::GameAction& action);
+
+    /**
+     * @copydoc Common::IGameRunner::unmakeAction()
+     */
+    virtual void unmakeAction();
+
+    /**
+     * @copydoc Common::IGameRunner::snapshot()
+     */
+    virtual std::shared_ptr<const Common::GameSnapshot> snapshot() const;
+
     /**
      * @copydoc Common::IGameRunner::flipTile()
      */
@@ -130,30 +190,147 @@ class GameEngine : public Common::IGameRunner
      */
     virtual int playerAmount() const;
 
+    /**
+     * @copydoc Common::IGameRunner::getSeed()
+     */
+    virtual unsigned int getSeed() const;
+
+    /**
+     * @copydoc Common::IGameRunner::setGameLog()
+     */
+    virtual void setGameLog(std::shared_ptr<Common::GameLog> log);
+
   private:
 
-    bool breadthFirst(Common::CubeCoordinate FromCoord, Common::CubeCoordinate ToCoord, unsigned int actionsLeft);
+    //! Sets up everything but the board, for the public constructors.
+    GameEngine(std::shared_ptr<Common::IGameBoard> boardPtr,
+               std::shared_ptr<Common::IGameState> statePtr,
+               std::vector<std::shared_ptr<Common::IPlayer>> players,
+               const GameRandom& rng);
 
     unsigned int cubeCoordinateDistance(Common::CubeCoordinate source, Common::CubeCoordinate target) const;
 
-    std::vector<Common::CubeCoordinate> addHexToBoard(Common::CubeCoordinate coord,
-                                                      std::string pieceType);
     void initializeBoard();
     void initializeBoats();
+    void restoreSnapshot(const Common::GameSnapshot& snapshot);
+
+    // Actions of each game phase for legalActions
+    void addMovementActions(std::vector<Common::GameAction>& actions);
+    void addFlipActions(std::vector<Common::GameAction>& actions);
+    void addSpinnerActions(std::vector<Common::GameAction>& actions);
+    void addPawnActions(const Common::Hex& hex, int pawnId,
+                        unsigned int actionsLeft,
+                        std::vector<Common::GameAction>& actions);
+
+    //! Fills targets_ and targetDistances_ with the water hexes at most range
+    //! hexes from the origin, the origin excluded. A negative range reaches
+    //! every hex.
+    void findWaterTargets(Common::CubeCoordinate origin, int range);
+
+    //! Current player without sharing its ownership, nullptr if not found.
+    Common::IPlayer* findCurrentPlayer() const;
+
+    //! Calls the function that performs the action, for makeAction.
+    int performAction(const Common::GameAction& action);
+
+    //! Sets spin_ to a result of the wheel.
+    void setSpin(Common::TypeId type, const std::string& moves);
 
     std::vector<std::shared_ptr<Common::IPlayer>> playerVector_;
     std::shared_ptr<Common::IGameBoard> board_;
     std::shared_ptr<Common::IGameState> gameState_;
 
-    //! Actortypes.
+    //! Random events of this game.
+    GameRandom rng_;
+
+    //! Memory of the hexes and pieces of this game, freed when the last of
+    //! them is destroyed.
+    std::shared_ptr<Common::GameArena> arena_;
 
-    WheelLayoutParser layoutParser_;
+    //! Copies of the registered types, ids are unique within this game.
+    ActorFactory actorFactory_;
+    TransportFactory transportFactory_;
+
+    //! Types a flipped tile can reveal, actors first, then transports.
+    std::vector<std::string> creatables_;
+    //! The interned creatables_, for the game log.
+    std::vector<Common::TypeId> creatableTypes_;
+    std::size_t actorTypeCount_;
+
+    //! Island pieces and spinner layout, shared with the other games.
+    std::shared_ptr<const BoardRecipe> recipe_;
 
     //! Piecetypes.
-    std::vector<std::pair<std::string,int>> islandPieces_;
+    BoardTemplate::IslandPieceVector islandPieces_;
 
     // Radius of the island, needed to spawn boats
     int islandRadius_;
+
+    //! Coordinates of the hexes of the game, in the order they were laid
+    //! out. Shared with the snapshots and forks of the game.
+    std::shared_ptr<const std::vector<Common::CubeCoordinate>> hexCoords_;
+
+    //! Result of the last spinWheel, parsed once for legalActions. Invalid
+    //! once the spun piece has moved or a tile is flipped.
+    struct SpinResult {
+        bool valid = false;
+        Common::TypeId type = Common::NO_TYPE;
+        bool dive = false;
+        //! Hexes the piece may move, negative for any distance.
+        int range = 0;
+        //! The moves as spinWheel returned them, for makeAction.
+        std::string moves;
+    };
+    SpinResult spin_;
+
+    //! Route search for pawn movement, reused between moves.
+    PathFinder pathFinder_;
+
+    //! Last answer of reachablePawnTargets and the query it answers. The
+    //! hexes haven't changed while undoLog_ has the same generation.
+    struct MoveCache {
+        bool valid = false;
+        std::uint64_t generation = 0;
+        Common::CubeCoordinate origin;
+        int pawnId = 0;
+        int playerId = 0;
+        unsigned int actionsLeft = 0;
+        Common::MoveTargets targets;
+    };
+    MoveCache moveCache_;
+
+    //! Changes of the board since the open makeActions, shared with the
+    //! board.
+    std::shared_ptr<Common::UndoLog> undoLog_;
+
+    //! State of the engine and the game at a makeAction. The board and the
+    //! pieces are restored by undoLog_.
+    struct UndoLevel {
+        GameRandom rng;
+        SpinResult spin;
+        std::size_t islandLayers;
+        BoardTemplate::IslandPieceVector::value_type topLayer;
+        int lastActorId;
+        int lastTransportId;
+        Common::GamePhase phase;
+        Common::IPlayer* player;
+        unsigned int actionsLeft;
+        Common::GameLog::Mark logMark;
+        Common::GameArena::Mark arenaMark;
+    };
+    std::vector<UndoLevel> undoLevels_;
+
+    //! Records the game, nullptr if it isn't recorded. Shared with the
+    //! board.
+    std::shared_ptr<Common::GameLog> gameLog_;
+
+    //! Scratch space for the searches of reachablePawnTargets.
+    std::vector<Common::CubeCoordinate> reached_;
+    std::vector<int> reachedDistances_;
+
+    //! Scratch space for the water targets of legalActions.
+    std::vector<Common::CubeCoordinate> targets_;
+    std::vector<int> targetDistances_;
 };
 
 }
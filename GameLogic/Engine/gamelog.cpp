@@ -0,0 +1,411 @@
+#include "gamelog.hh"
+
+#include "formatexception.hh"
+#include "ioexception.hh"
+#include "varint.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace Common {
+
+namespace {
+
+const std::size_t HEADER_SIZE = sizeof(GameLog::LOG_MAGIC) + 1;
+
+}
+
+const char GameLog::LOG_MAGIC[4] = {'I', 'G', 'L', 'G'};
+const std::uint8_t GameLog::LOG_VERSION;
+
+/**
+ * @brief The fixed fields of one record, encoded into a buffer on the stack.
+ * @details The moves of a spin or the name of a type are the last field of
+ * the records that have one, only their length is in the buffer.
+ */
+class GameLog::Writer {
+
+  public:
+
+    Writer(RecordType type, CubeCoordinate cursor):
+        size_(0), cursor_(cursor), string_(nullptr)
+    {
+        buffer_[size_++] = static_cast<std::uint8_t>(type);
+    }
+
+    void putUnsigned(std::uint64_t value)
+    {
+        size_ += Varint::put(buffer_ + size_, value);
+    }
+
+    void putSigned(std::int64_t value)
+    {
+        putUnsigned(Varint::zigzag(value));
+    }
+
+    //! Writes coord relative to the last coordinate, which it becomes.
+    void putCoordinate(CubeCoordinate coord)
+    {
+        putSigned(static_cast<std::int64_t>(coord.x) - cursor_.x);
+        putSigned(static_cast<std::int64_t>(coord.z) - cursor_.z);
+        cursor_ = coord;
+    }
+
+    void putString(const std::string& string)
+    {
+        putUnsigned(string.size());
+        string_ = &string;
+    }
+
+    const std::uint8_t* begin() const { return buffer_; }
+    const std::uint8_t* end() const { return buffer_ + size_; }
+    std::size_t size() const
+    {
+        return size_ + (string_ == nullptr ? 0 : string_->size());
+    }
+    CubeCoordinate cursor() const { return cursor_; }
+    const std::string* string() const { return string_; }
+
+  private:
+
+    std::uint8_t buffer_[MAX_RECORD_BYTES];
+    int size_;
+    CubeCoordinate cursor_;
+    const std::string* string_;
+};
+
+GameLog::Reader::Reader(const std::uint8_t* data, std::size_t size):
+    data_(data), size_(size), position_(HEADER_SIZE), cursor_(0, 0, 0)
+{
+    if (size < HEADER_SIZE ||
+            !std::equal(LOG_MAGIC, LOG_MAGIC + sizeof(LOG_MAGIC),
+                        reinterpret_cast<const char*>(data))) {
+        throw FormatException("Not a game log");
+    }
+    if (data[sizeof(LOG_MAGIC)] != LOG_VERSION) {
+        throw FormatException("Unsupported game log version");
+    }
+}
+
+GameLog::Reader::Reader(const GameLog& log):
+    Reader(log.data(), log.size())
+{
+}
+
+bool GameLog::Reader::next(Record& record)
+{
+    if (position_ == size_) {
+        return false;
+    }
+
+    std::uint8_t type = data_[position_++];
+    while (type == static_cast<std::uint8_t>(RecordType::TYPE_NAMED)) {
+        std::uint64_t logType = readUnsigned();
+        readString(record.moves);
+        if (logType == NO_TYPE ||
+                logType > std::numeric_limits<TypeId>::max()) {
+            throw FormatException("Invalid game log type " +
+                                  std::to_string(logType));
+        }
+        if (logType >= types_.size()) {
+            types_.resize(static_cast<std::size_t>(logType) + 1, NO_TYPE);
+        }
+        types_[logType] = TypeRegistry::getInstance().intern(record.moves);
+        if (position_ == size_) {
+            return false;
+        }
+        type = data_[position_++];
+    }
+
+    record.type = static_cast<RecordType>(type);
+    record.id = 0;
+    record.owner = 0;
+    record.pieceType = NO_TYPE;
+    record.origin = CubeCoordinate(0, 0, 0);
+    record.target = CubeCoordinate(0, 0, 0);
+    record.value = 0;
+    record.moves.clear();
+
+    bool hasMoves = false;
+    switch (record.type) {
+    case RecordType::GAME_STARTED:
+        record.value = static_cast<std::int64_t>(readUnsigned());
+        record.id = static_cast<int>(readUnsigned());
+        break;
+    case RecordType::PAWN_ADDED:
+        record.id = static_cast<int>(readSigned());
+        record.owner = static_cast<int>(readSigned());
+        record.target = readCoordinate(cursor_);
+        break;
+    case RecordType::PAWN_REMOVED:
+    case RecordType::ACTOR_REMOVED:
+    case RecordType::TRANSPORT_REMOVED:
+        record.id = static_cast<int>(readSigned());
+        break;
+    case RecordType::PAWN_MOVED:
+    case RecordType::TRANSPORT_MOVED:
+    case RecordType::ACTOR_MOVED:
+    case RecordType::TRANSPORT_SPUN:
+        record.id = static_cast<int>(readSigned());
+        record.origin = readCoordinate(cursor_);
+        record.target = readCoordinate(record.origin);
+        if (record.type != RecordType::ACTOR_MOVED) {
+            record.value = readSigned();
+        }
+        hasMoves = record.type == RecordType::ACTOR_MOVED ||
+                record.type == RecordType::TRANSPORT_SPUN;
+        break;
+    case RecordType::TILE_FLIPPED:
+        record.target = readCoordinate(cursor_);
+        record.pieceType = readType();
+        record.id = static_cast<int>(readSigned());
+        break;
+    case RecordType::WHEEL_SPUN:
+        record.pieceType = readType();
+        hasMoves = true;
+        break;
+    case RecordType::ACTOR_ACTED:
+        record.id = static_cast<int>(readSigned());
+        record.pieceType = readType();
+        record.target = readCoordinate(cursor_);
+        break;
+    default:
+        throw FormatException("Unknown game log record " +
+                              std::to_string(type) + " at " +
+                              std::to_string(position_ - 1));
+    }
+
+    if (hasMoves) {
+        readString(record.moves);
+    }
+    return true;
+}
+
+std::uint64_t GameLog::Reader::readUnsigned()
+{
+    std::uint64_t value = 0;
+    if (!Varint::get(data_, size_, position_, value)) {
+        throw FormatException("Game log record cut short");
+    }
+    return value;
+}
+
+std::int64_t GameLog::Reader::readSigned()
+{
+    return Varint::unzigzag(readUnsigned());
+}
+
+CubeCoordinate GameLog::Reader::readCoordinate(CubeCoordinate from)
+{
+    int x = from.x + static_cast<int>(readSigned());
+    int z = from.z + static_cast<int>(readSigned());
+    cursor_ = CubeCoordinate(x, -x - z, z);
+    return cursor_;
+}
+
+TypeId GameLog::Reader::readType()
+{
+    std::uint64_t logType = readUnsigned();
+    if (logType == NO_TYPE) {
+        return NO_TYPE;
+    }
+    if (logType >= types_.size() || types_[logType] == NO_TYPE) {
+        throw FormatException("Game log type " + std::to_string(logType) +
+                              " used before it is named");
+    }
+    return types_[logType];
+}
+
+void GameLog::Reader::readString(std::string& string)
+{
+    std::uint64_t length = readUnsigned();
+    if (length > size_ - position_) {
+        throw FormatException("Game log record cut short");
+    }
+    string.assign(reinterpret_cast<const char*>(data_ + position_),
+                  static_cast<std::size_t>(length));
+    position_ += static_cast<std::size_t>(length);
+}
+
+GameLog::GameLog():
+    cursor_(0, 0, 0)
+{
+    bytes_.assign(LOG_MAGIC, LOG_MAGIC + sizeof(LOG_MAGIC));
+    bytes_.push_back(LOG_VERSION);
+}
+
+bool GameLog::empty() const
+{
+    return bytes_.size() == HEADER_SIZE;
+}
+
+void GameLog::rewind(const Mark& mark)
+{
+    bytes_.resize(mark.size);
+    cursor_ = mark.cursor;
+    while (named_.size() > mark.namedTypes) {
+        isNamed_[named_.back()] = false;
+        named_.pop_back();
+    }
+}
+
+void GameLog::save(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes_.data()),
+               static_cast<std::streamsize>(bytes_.size()));
+    file.close();
+    if (!file) {
+        throw IoException("Could not write file " + fileName);
+    }
+}
+
+void GameLog::gameStarted(unsigned int seed, int players)
+{
+    Writer writer(RecordType::GAME_STARTED, cursor_);
+    writer.putUnsigned(seed);
+    writer.putUnsigned(static_cast<unsigned int>(std::max(players, 0)));
+    append(writer);
+}
+
+void GameLog::pawnAdded(int pawnId, int playerId, CubeCoordinate coord)
+{
+    Writer writer(RecordType::PAWN_ADDED, cursor_);
+    writer.putSigned(pawnId);
+    writer.putSigned(playerId);
+    writer.putCoordinate(coord);
+    append(writer);
+}
+
+void GameLog::pawnRemoved(int pawnId)
+{
+    Writer writer(RecordType::PAWN_REMOVED, cursor_);
+    writer.putSigned(pawnId);
+    append(writer);
+}
+
+void GameLog::actorRemoved(int actorId)
+{
+    Writer writer(RecordType::ACTOR_REMOVED, cursor_);
+    writer.putSigned(actorId);
+    append(writer);
+}
+
+void GameLog::transportRemoved(int transportId)
+{
+    Writer writer(RecordType::TRANSPORT_REMOVED, cursor_);
+    writer.putSigned(transportId);
+    append(writer);
+}
+
+void GameLog::pawnMoved(int pawnId, CubeCoordinate origin,
+                        CubeCoordinate target, int movesLeft)
+{
+    Writer writer(RecordType::PAWN_MOVED, cursor_);
+    writer.putSigned(pawnId);
+    writer.putCoordinate(origin);
+    writer.putCoordinate(target);
+    writer.putSigned(movesLeft);
+    append(writer);
+}
+
+void GameLog::transportMoved(int transportId, CubeCoordinate origin,
+                             CubeCoordinate target, int movesLeft)
+{
+    Writer writer(RecordType::TRANSPORT_MOVED, cursor_);
+    writer.putSigned(transportId);
+    writer.putCoordinate(origin);
+    writer.putCoordinate(target);
+    writer.putSigned(movesLeft);
+    append(writer);
+}
+
+void GameLog::actorMoved(int actorId, CubeCoordinate origin,
+                         CubeCoordinate target, const std::string& moves)
+{
+    Writer writer(RecordType::ACTOR_MOVED, cursor_);
+    writer.putSigned(actorId);
+    writer.putCoordinate(origin);
+    writer.putCoordinate(target);
+    writer.putString(moves);
+    append(writer);
+}
+
+void GameLog::transportSpun(int transportId, CubeCoordinate origin,
+                            CubeCoordinate target, const std::string& moves,
+                            int movesLeft)
+{
+    Writer writer(RecordType::TRANSPORT_SPUN, cursor_);
+    writer.putSigned(transportId);
+    writer.putCoordinate(origin);
+    writer.putCoordinate(target);
+    writer.putSigned(movesLeft);
+    writer.putString(moves);
+    append(writer);
+}
+
+void GameLog::tileFlipped(CubeCoordinate coord, TypeId appearedType,
+                          int appearedId)
+{
+    nameType(appearedType);
+    Writer writer(RecordType::TILE_FLIPPED, cursor_);
+    writer.putCoordinate(coord);
+    writer.putUnsigned(appearedType);
+    writer.putSigned(appearedId);
+    append(writer);
+}
+
+void GameLog::wheelSpun(TypeId type, const std::string& moves)
+{
+    nameType(type);
+    Writer writer(RecordType::WHEEL_SPUN, cursor_);
+    writer.putUnsigned(type);
+    writer.putString(moves);
+    append(writer);
+}
+
+void GameLog::actorActed(int actorId, TypeId type, CubeCoordinate coord)
+{
+    nameType(type);
+    Writer writer(RecordType::ACTOR_ACTED, cursor_);
+    writer.putSigned(actorId);
+    writer.putUnsigned(type);
+    writer.putCoordinate(coord);
+    append(writer);
+}
+
+void GameLog::append(const Writer& writer)
+{
+    // Grows the vector before the first insert, so that a failed allocation
+    // leaves the log as it was
+    std::size_t needed = bytes_.size() + writer.size();
+    if (needed > bytes_.capacity()) {
+        bytes_.reserve(std::max(needed, 2 * bytes_.capacity()));
+    }
+    bytes_.insert(bytes_.end(), writer.begin(), writer.end());
+    if (writer.string() != nullptr) {
+        bytes_.insert(bytes_.end(), writer.string()->begin(),
+                      writer.string()->end());
+    }
+    cursor_ = writer.cursor();
+}
+
+void GameLog::nameType(TypeId type)
+{
+    if (type == NO_TYPE || (type < isNamed_.size() && isNamed_[type])) {
+        return;
+    }
+    Writer writer(RecordType::TYPE_NAMED, cursor_);
+    writer.putUnsigned(type);
+    writer.putString(TypeRegistry::getInstance().nameOf(type));
+    if (type >= isNamed_.size()) {
+        isNamed_.resize(type + 1u, false);
+    }
+    named_.reserve(named_.size() + 1);
+    append(writer);
+    isNamed_[type] = true;
+    named_.push_back(type);
+}
+
+}
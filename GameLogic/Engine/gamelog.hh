@@ -0,0 +1,267 @@
+#ifndef GAMELOG_HH
+#define GAMELOG_HH
+
+#include "cubecoordinate.hh"
+#include "typeregistry.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Append-only binary log of the operations that changed a game.
+ */
+
+namespace Common {
+
+/**
+ * @brief Records every operation that changes a game as a compact binary
+ * record, so that finished games can be audited and analysed.
+ * @details The game engine records its moves, flips and spins, the board
+ * records the pawns, actors and transports added and removed from outside
+ * the engine, and actors record their actions, see
+ * IGameRunner::setGameLog().
+ *
+ * The log starts with a header of LOG_MAGIC and LOG_VERSION. Each record is
+ * a RecordType byte followed by its fields as variable length integers,
+ * seven bits per byte with the highest bit telling that more bytes follow.
+ * Signed fields are zigzag encoded, so small negative numbers stay short.
+ * A coordinate is stored as its x and z: the first coordinate of a record
+ * as the difference to the last coordinate of the previous record, the
+ * target of a move as the difference to its origin. Moves between nearby
+ * hexes take one byte per component, a typical record takes five to eight
+ * bytes. Type ids depend on the order the program interned the names, so
+ * the log names each type id in a TYPE_NAMED record before its first use.
+ * Read the records back with Reader.
+ *
+ * Recording a record appends a few bytes to a vector, the cost is a few
+ * dozen nanoseconds and does not allocate once the vector has grown.
+ */
+class GameLog {
+
+  public:
+
+    //! First bytes of a log.
+    static const char LOG_MAGIC[4];
+
+    //! Version of the record format, the byte after LOG_MAGIC.
+    static const std::uint8_t LOG_VERSION = 1;
+
+    /**
+     * @brief The kinds of records, and the fields of Record they fill.
+     */
+    enum class RecordType : std::uint8_t {
+        //! The game runner got the log. value: seed, id: number of players.
+        GAME_STARTED = 1,
+        //! A pawn was added. id, owner, target.
+        PAWN_ADDED,
+        //! A pawn was removed from the board. id.
+        PAWN_REMOVED,
+        //! An actor was removed from the board. id.
+        ACTOR_REMOVED,
+        //! A transport was removed from the board. id.
+        TRANSPORT_REMOVED,
+        //! IGameRunner::movePawn. id, origin, target, value: moves left.
+        PAWN_MOVED,
+        //! IGameRunner::moveTransport. id, origin, target, value: moves left.
+        TRANSPORT_MOVED,
+        //! IGameRunner::moveActor. id, origin, target, moves.
+        ACTOR_MOVED,
+        //! IGameRunner::moveTransportWithSpinner. id, origin, target, moves,
+        //! value: moves left.
+        TRANSPORT_SPUN,
+        //! IGameRunner::flipTile. target: the tile, pieceType and id: the
+        //! actor or transport that appeared.
+        TILE_FLIPPED,
+        //! IGameRunner::spinWheel. pieceType, moves.
+        WHEEL_SPUN,
+        //! Actor::doAction. id, pieceType: type of the actor, target: its hex.
+        ACTOR_ACTED,
+        //! Name of a type id, written before the first record that uses
+        //! it. Reader reads these itself, next() never returns them.
+        TYPE_NAMED
+    };
+
+    /**
+     * @brief A decoded record. The fields a type doesn't use are zero. The
+     * pieceType is an id of the TypeRegistry of the reading program.
+     */
+    struct Record
+    {
+        RecordType type;
+        int id;
+        int owner;
+        TypeId pieceType;
+        CubeCoordinate origin;
+        CubeCoordinate target;
+        std::int64_t value;
+        std::string moves;
+    };
+
+    /**
+     * @brief Position in a log, see mark().
+     */
+    struct Mark
+    {
+        std::size_t size;
+        CubeCoordinate cursor;
+        std::size_t namedTypes;
+    };
+
+    /**
+     * @brief Decodes the records of a log in order.
+     */
+    class Reader {
+
+      public:
+
+        /**
+         * @brief Constructor, checks the header.
+         * @param data The bytes of a log, as returned by GameLog::data().
+         * Have to stay valid while the reader is used.
+         * @param size Number of bytes.
+         * @exception FormatException The header is missing or of another
+         * version.
+         */
+        Reader(const std::uint8_t* data, std::size_t size);
+
+        /**
+         * @brief Constructor, reads the records of a log.
+         * @param log The log, has to stay unchanged while the reader is used.
+         */
+        explicit Reader(const GameLog& log);
+
+        /**
+         * @brief next decodes the next record.
+         * @param record Set to the record.
+         * @exception FormatException The record is cut short or of an
+         * unknown type.
+         * @return true, if a record was read, false at the end of the log.
+         * @post Exception quarantee: basic
+         */
+        bool next(Record& record);
+
+        /**
+         * @brief position tells the offset of the next record.
+         * @return Offset from the start of the log.
+         */
+        std::size_t position() const { return position_; }
+
+      private:
+
+        std::uint64_t readUnsigned();
+        std::int64_t readSigned();
+        CubeCoordinate readCoordinate(CubeCoordinate from);
+        TypeId readType();
+        void readString(std::string& string);
+
+        const std::uint8_t* data_;
+        std::size_t size_;
+        std::size_t position_;
+        CubeCoordinate cursor_;
+
+        //! Ids of the reading program by the ids of the log.
+        std::vector<TypeId> types_;
+    };
+
+    /**
+     * @brief Constructor, creates a log with the header and no records.
+     * @post Exception quarantee: strong
+     */
+    GameLog();
+
+    GameLog(const GameLog&) = delete;
+    GameLog& operator=(const GameLog&) = delete;
+
+    /**
+     * @brief data returns the bytes of the log.
+     * @return size() bytes, the header first. Valid until the next record.
+     */
+    const std::uint8_t* data() const { return bytes_.data(); }
+
+    /**
+     * @brief size tells the number of bytes in the log.
+     * @return The size including the header.
+     */
+    std::size_t size() const { return bytes_.size(); }
+
+    /**
+     * @brief empty tells if the log has records.
+     * @return true, if only the header has been written.
+     */
+    bool empty() const;
+
+    /**
+     * @brief mark returns the current end of the log.
+     * @return Position for rewind().
+     * @post Exception quarantee: nothrow
+     */
+    Mark mark() const { return Mark{bytes_.size(), cursor_, named_.size()}; }
+
+    /**
+     * @brief rewind drops the records written after a mark.
+     * @details Used when a move is taken back, see IGameRunner::unmakeAction.
+     * @param mark A mark of this log, not older than an earlier rewind().
+     * @post Exception quarantee: nothrow
+     */
+    void rewind(const Mark& mark);
+
+    /**
+     * @brief save writes the log to a file.
+     * @param fileName Name of the file, replaced if it exists.
+     * @exception IoException The file can't be written.
+     * @post Exception quarantee: basic
+     */
+    void save(const std::string& fileName) const;
+
+    // Appending the records, see RecordType for the meaning of the fields.
+    // Exception quarantee of each: strong
+
+    void gameStarted(unsigned int seed, int players);
+    void pawnAdded(int pawnId, int playerId, CubeCoordinate coord);
+    void pawnRemoved(int pawnId);
+    void actorRemoved(int actorId);
+    void transportRemoved(int transportId);
+    void pawnMoved(int pawnId, CubeCoordinate origin, CubeCoordinate target,
+                   int movesLeft);
+    void transportMoved(int transportId, CubeCoordinate origin,
+                        CubeCoordinate target, int movesLeft);
+    void actorMoved(int actorId, CubeCoordinate origin, CubeCoordinate target,
+                    const std::string& moves);
+    void transportSpun(int transportId, CubeCoordinate origin,
+                       CubeCoordinate target, const std::string& moves,
+                       int movesLeft);
+    void tileFlipped(CubeCoordinate coord, TypeId appearedType,
+                     int appearedId);
+    void wheelSpun(TypeId type, const std::string& moves);
+    void actorActed(int actorId, TypeId type, CubeCoordinate coord);
+
+  private:
+
+    // Longest encoding of the fixed fields of a record
+    static const int MAX_RECORD_BYTES = 64;
+
+    // Builds one record on the stack and appends it with one insert
+    class Writer;
+
+    void append(const Writer& writer);
+
+    //! Writes a TYPE_NAMED record for type, if it hasn't been named yet.
+    void nameType(TypeId type);
+
+    std::vector<std::uint8_t> bytes_;
+
+    //! Last coordinate written, the next coordinate is stored relative to it.
+    CubeCoordinate cursor_;
+
+    //! Types named in the log, in the order of their TYPE_NAMED records,
+    //! and a flag for every type id that tells if it is named.
+    std::vector<TypeId> named_;
+    std::vector<bool> isNamed_;
+};
+
+}
+
+#endif // GAMELOG_HH
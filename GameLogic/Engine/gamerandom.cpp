@@ -0,0 +1,41 @@
+#include "gamerandom.hh"
+
+namespace Logic {
+
+GameRandom::GameRandom(unsigned int seed):
+    seed_(seed),
+    state_(0)
+{
+    // Spread the bits of the seed with SplitMix64, so that nearby seeds
+    // start from unrelated states
+    std::uint64_t mixed = seed + 0x9E3779B97F4A7C15ULL;
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+    mixed ^= mixed >> 31;
+
+    state_ = mixed + INCREMENT;
+    (*this)();
+}
+
+GameRandom::GameRandom(unsigned int seed, std::uint64_t state):
+    seed_(seed),
+    state_(state)
+{
+}
+
+GameRandom::result_type GameRandom::below(result_type bound)
+{
+    // Lemire's multiply-shift, the high word of the product is the result
+    std::uint64_t product = static_cast<std::uint64_t>((*this)()) * bound;
+    result_type low = static_cast<result_type>(product);
+    if (low < bound) {
+        result_type threshold = (-bound) % bound;
+        while (low < threshold) {
+            product = static_cast<std::uint64_t>((*this)()) * bound;
+            low = static_cast<result_type>(product);
+        }
+    }
+    return static_cast<result_type>(product >> 32);
+}
+
+}
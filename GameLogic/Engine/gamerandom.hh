@@ -0,0 +1,97 @@
+#ifndef GAMERANDOM_HH
+#define GAMERANDOM_HH
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @file
+ * @brief Random number generator of a single game.
+ */
+
+namespace Logic {
+
+/**
+ * @brief Small and fast generator for the random events of one game (PCG32).
+ * @details The whole state is two 64-bit words, so creating, copying and
+ * seeding a generator is cheap, and a draw is a multiply and a few shifts.
+ * The sequence is fully defined by the seed and does not depend on the
+ * standard library, so a game can be replayed from its seed on any platform.
+ * Satisfies UniformRandomBitGenerator, so it can be passed to the standard
+ * algorithms.
+ */
+class GameRandom
+{
+public:
+    using result_type = std::uint32_t;
+
+    /**
+     * @brief Constructor.
+     * @param seed Seed of the sequence.
+     */
+    explicit GameRandom(unsigned int seed = 0);
+
+    /**
+     * @brief Constructor, continues the sequence of another generator.
+     * @param seed Seed of the other generator, see seed().
+     * @param state State of the other generator, see state().
+     */
+    GameRandom(unsigned int seed, std::uint64_t state);
+
+    /**
+     * @brief seed tells the seed the generator was created with.
+     * @return The seed.
+     */
+    unsigned int seed() const { return seed_; }
+
+    /**
+     * @brief state tells where in its sequence the generator is.
+     * @return The state, for saving the generator to a file.
+     */
+    std::uint64_t state() const { return state_; }
+
+    /**
+     * @brief below draws an integer from [0, bound) with equal chances.
+     * @details Uses multiplication instead of division, and draws again only
+     * in the rare cases where the result would be biased.
+     * @param bound The number of possible results.
+     * @pre bound > 0
+     * @return The drawn number.
+     */
+    result_type below(result_type bound);
+
+    /**
+     * @brief Draws the next 32 random bits.
+     * @return The drawn bits.
+     */
+    result_type operator()()
+    {
+        std::uint64_t old = state_;
+        state_ = old * MULTIPLIER + INCREMENT;
+        result_type xorShifted =
+                static_cast<result_type>(((old >> 18u) ^ old) >> 27u);
+        result_type rotation = static_cast<result_type>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    static const std::uint64_t MULTIPLIER = 6364136223846793005ULL;
+    static const std::uint64_t INCREMENT = 1442695040888963407ULL;
+
+    unsigned int seed_;
+    std::uint64_t state_;
+};
+
+}
+
+#endif // GAMERANDOM_HH
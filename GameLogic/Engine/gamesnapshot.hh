@@ -0,0 +1,98 @@
+#ifndef GAMESNAPSHOT_HH
+#define GAMESNAPSHOT_HH
+
+#include "cubecoordinate.hh"
+#include "gamerandom.hh"
+#include "igamestate.hh"
+#include "typeregistry.hh"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief The whole state of a running game, as returned by
+ * IGameRunner::snapshot().
+ */
+
+namespace Common {
+
+/**
+ * @brief The state of a game at one moment in a few flat arrays, for forking
+ * the game with Initialization::forkGameRunner().
+ * @details A snapshot has the terrain of every hex, the pawns, actors and
+ * transports on the hexes, the passengers of the transports, the game phase,
+ * the player in turn and the actions left of every player, and the state
+ * of the engine: the island pieces left, the last spin, the random
+ * generator and the last ids of the created pieces.
+ *
+ * Snapshots are shared as pointers to const and never change, so any number
+ * of forks on any threads can read one without copying or locking it. The
+ * hex coordinates only depend on the island, so all the snapshots of a game
+ * share one array of them. Pieces that are not on any hex are left out,
+ * they can't take part in the game.
+ */
+struct GameSnapshot
+{
+    //! A pawn, actor or transport and the hex it is on.
+    struct Piece {
+        int id;
+        //! Type of an actor or a transport, NO_TYPE for pawns.
+        TypeId type;
+        //! Player of a pawn, 0 for actors and transports.
+        int owner;
+        //! Index of the hex in coordinates.
+        int hex;
+        //! Passengers of a transport in passengers, none for other pieces.
+        int firstPassenger;
+        int passengerCount;
+    };
+
+    //! A player and the actions it has left.
+    struct Player {
+        int id;
+        unsigned int actionsLeft;
+    };
+
+    //! Coordinates of the hexes in the order the island was laid out,
+    //! shared by the snapshots and forks of a game.
+    std::shared_ptr<const std::vector<CubeCoordinate>> coordinates;
+
+    //! Piece type of each hex, in the order of coordinates.
+    std::vector<TypeId> terrain;
+
+    //! Pieces in the order of the hexes, the pieces of a hex by id.
+    std::vector<Piece> pawns;
+    std::vector<Piece> actors;
+    std::vector<Piece> transports;
+
+    //! Pawn ids of the passengers of the transports, in boarding order.
+    std::vector<int> passengers;
+
+    std::vector<Player> players;
+    GamePhase phase;
+    int currentPlayer;
+
+    //! Island piece types left to flip and their counts, the next layer
+    //! last.
+    std::vector<std::pair<TypeId, int>> islandPieces;
+
+    //! Result of the last spin if the spun piece hasn't moved yet.
+    bool spun;
+    TypeId spinType;
+    std::string spinMoves;
+
+    //! Random events of the game from this moment on.
+    Logic::GameRandom rng;
+
+    //! Ids of the last actor and transport created, the next ones continue
+    //! from these.
+    int lastActorId;
+    int lastTransportId;
+};
+
+}
+
+#endif // GAMESNAPSHOT_HH
@@ -1,56 +1,108 @@
 #include "hex.hh"
+#include "cubekernels.hh"
+#include "hexbitboard.hh"
+#include "igameboard.hh"
 #include "pawn.hh"
 #include "actor.hh"
 #include "transport.hh"
+#include "undolog.hh"
 
 namespace Common {
 
-Hex::Hex(): piece_("")
+namespace {
+
+// Element holding the occupant with the given id, nullptr if there is none.
+// The occupants are sorted by id and there are only a few of them, so a
+// linear scan is the fastest search.
+template <class Occupants>
+const typename Occupants::value_type* findSlot(const Occupants& occupants,
+                                               int id)
 {
-    neighbourVector_ = { Common::CubeCoordinate(1,-1,0),
-                         Common::CubeCoordinate(1,0,-1),
-                         Common::CubeCoordinate(0,1,-1),
-                         Common::CubeCoordinate(-1,1,0),
-                         Common::CubeCoordinate(-1,0,1),
-                         Common::CubeCoordinate(0,-1,1)
-                       };
+    for (const auto& occupant : occupants) {
+        int occupantId = occupant->getId();
+        if (occupantId >= id) {
+            return occupantId == id ? &occupant : nullptr;
+        }
+    }
+    return nullptr;
 }
 
-void Hex::setCoordinates(Common::CubeCoordinate newCoordinates)
+// Adds the occupant in the order of ids, replaces one with the same id
+template <class Occupants>
+void insertOccupant(Occupants& occupants,
+                    const typename Occupants::value_type& occupant)
 {
-    coord_ = newCoordinates;
+    int id = occupant->getId();
+    auto it = occupants.begin();
+    while (it != occupants.end() && (*it)->getId() < id) {
+        ++it;
+    }
+    if (it != occupants.end() && (*it)->getId() == id) {
+        *it = occupant;
+    } else {
+        occupants.insert(it, occupant);
+    }
+}
 
-    setNeighbourVector();
+template <class Occupants>
+void eraseOccupant(Occupants& occupants, int id)
+{
+    for (auto it = occupants.begin(); it != occupants.end(); ++it) {
+        if ((*it)->getId() == id) {
+            occupants.erase(it);
+            return;
+        }
+    }
+}
+
+template <class Occupants>
+std::vector<typename Occupants::value_type> copyOccupants(
+        const Occupants& occupants)
+{
+    return std::vector<typename Occupants::value_type>(occupants.begin(),
+                                                       occupants.end());
+}
 
 }
 
-void Hex::setNeighbourVector()
+Hex::Hex(): piece_(NO_TYPE), board_(nullptr), listener_(nullptr)
 {
-    for(auto neighIt = neighbourVector_.begin();
-        neighIt != neighbourVector_.end();
-        ++neighIt){
-        neighIt->x = neighIt->x + coord_.x;
-        neighIt->y = neighIt->y + coord_.y;
-        neighIt->z = neighIt->z + coord_.z;
-    }
+}
+
+void Hex::setCoordinates(Common::CubeCoordinate newCoordinates)
+{
+    coord_ = newCoordinates;
 }
 
 void Hex::setPieceType(std::string piece)
 {
-    piece_ = piece;
+    saveToUndoLog();
+    piece_ = TypeRegistry::getInstance().intern(piece);
+    contentsChanged();
+}
+
+void Hex::setPieceTypeId(TypeId pieceType)
+{
+    saveToUndoLog();
+    piece_ = pieceType;
+    contentsChanged();
 }
 
-void Hex::addPawn( std::shared_ptr<Common::Pawn> pawn )
+void Hex::addPawn(const std::shared_ptr<Common::Pawn>& pawn)
 {
     if (pawn != nullptr) {
-        pawnMap_[pawn->getId()] = pawn;
+        saveToUndoLog();
+        insertOccupant(pawns_, pawn);
+        contentsChanged();
     }
 }
 
-void Hex::removePawn(std::shared_ptr<Pawn> pawn)
+void Hex::removePawn(const std::shared_ptr<Common::Pawn>& pawn)
 {
     if (pawn != nullptr) {
-        pawnMap_.erase(pawn->getId());
+        saveToUndoLog();
+        eraseOccupant(pawns_, pawn->getId());
+        contentsChanged();
     }
 }
 
@@ -62,167 +114,238 @@ Common::CubeCoordinate Hex::getCoordinates() const
 
 std::string Hex::getPieceType() const
 {
-    return piece_;
+    return TypeRegistry::getInstance().nameOf(piece_);
 }
 
 std::vector<std::string> Hex::getActorTypes() const
 {
     std::vector<std::string> actorTypes;
 
-    for (const auto& pair: actorMap_)
+    for (const auto& actor: actors_)
     {
-        actorTypes.push_back(pair.second->getActorType());
+        actorTypes.push_back(actor->getActorType());
     }
 
     return actorTypes;
 }
 
-void Hex::addActor( std::shared_ptr<Common::Actor> actor )
+void Hex::addActor(const std::shared_ptr<Common::Actor>& actor)
 {
     if (actor != nullptr) {
-        actorMap_[actor->getId()] = actor;
+        saveToUndoLog();
+        insertOccupant(actors_, actor);
+        contentsChanged();
     }
 }
 
-void Hex::removeActor( std::shared_ptr<Common::Actor> actor )
+void Hex::removeActor(const std::shared_ptr<Common::Actor>& actor)
 {
     if (actor != nullptr) {
-        actorMap_.erase(actor->getId());
+        saveToUndoLog();
+        eraseOccupant(actors_, actor->getId());
+        contentsChanged();
     }
 }
 
-void Hex::addTransport( std::shared_ptr<Common::Transport> transport )
+void Hex::addTransport(const std::shared_ptr<Common::Transport>& transport)
 {
     if (transport != nullptr) {
-        transportMap_[transport->getId()] = transport;
+        saveToUndoLog();
+        insertOccupant(transports_, transport);
+        contentsChanged();
     }
 }
 
-void Hex::removeTransport( std::shared_ptr<Common::Transport> transport )
+void Hex::removeTransport(const std::shared_ptr<Common::Transport>& transport)
 {
     if (transport != nullptr) {
-        transportMap_.erase(transport->getId());
+        saveToUndoLog();
+        eraseOccupant(transports_, transport->getId());
+        contentsChanged();
     }
 }
 
-int Hex::getPawnAmount() const
+std::vector<Common::CubeCoordinate> Hex::getNeighbourVector() const
 {
-    return pawnMap_.size();
+    std::vector<Common::CubeCoordinate> neighbours(HEX_NEIGHBOURS);
+    CubeKernels::neighboursOf(&coord_, 1, neighbours.data());
+    return neighbours;
 }
 
-bool Hex::isWaterTile() const
+std::shared_ptr<Common::Pawn> Hex::givePawn(int pawnId) const
 {
-    return piece_ == "Water";
+    auto slot = findSlot(pawns_, pawnId);
+    return slot == nullptr ? nullptr : *slot;
 }
 
-std::vector<Common::CubeCoordinate> Hex::getNeighbourVector() const
+std::shared_ptr<Common::Transport> Hex::giveTransport(int transportId) const
 {
-    return neighbourVector_;
+    auto slot = findSlot(transports_, transportId);
+    return slot == nullptr ? nullptr : *slot;
 }
 
-std::shared_ptr<Common::Pawn> Hex::givePawn(int pawnId) const
+std::shared_ptr<Common::Actor> Hex::giveActor(int actorId) const
 {
-    if (pawnMap_.find(pawnId) == pawnMap_.end()) {
-        return nullptr;
-    }
-    return pawnMap_[pawnId];
+    auto slot = findSlot(actors_, actorId);
+    return slot == nullptr ? nullptr : *slot;
 }
 
-std::shared_ptr<Common::Transport> Hex::giveTransport(int transportId) const
+Pawn* Hex::findPawn(int pawnId) const
 {
-    if (transportMap_.find(transportId) == transportMap_.end()) {
-        return nullptr;
-    }
-    return transportMap_[transportId];
+    auto slot = findSlot(pawns_, pawnId);
+    return slot == nullptr ? nullptr : slot->get();
 }
 
-std::shared_ptr<Common::Actor> Hex::giveActor(int actorId) const
+Transport* Hex::findTransport(int transportId) const
 {
-    if (actorMap_.find(actorId) == actorMap_.end()) {
-        return nullptr;
-    }
-    return actorMap_[actorId];
+    auto slot = findSlot(transports_, transportId);
+    return slot == nullptr ? nullptr : slot->get();
+}
+
+Actor* Hex::findActor(int actorId) const
+{
+    auto slot = findSlot(actors_, actorId);
+    return slot == nullptr ? nullptr : slot->get();
 }
 
 
 void Hex::clear(){
-    actorMap_.clear();
-    transportMap_.clear();
-    pawnMap_.clear();
+    saveToUndoLog();
+    actors_.clear();
+    transports_.clear();
+    pawns_.clear();
+    contentsChanged();
 }
 
 void Hex::clearPawnsFromTerrain()
 {
-    std::map<int, std::shared_ptr<Common::Pawn>>::iterator it;
-    std::map<int, std::shared_ptr<Common::Transport>>::iterator it2;
-    std::vector<std::shared_ptr<Common::Pawn>> removable;
-    bool pawnIsInTransport;
-    for( it = pawnMap_.begin(); it != pawnMap_.end(); ++it){
-        pawnIsInTransport = false;
-        for ( it2 = transportMap_.begin(); it2 != transportMap_.end(); ++it2){
-            if ( it2->second->isPawnInTransport(it->second) ){
+    saveToUndoLog();
+    auto it = pawns_.begin();
+    while (it != pawns_.end()) {
+        bool pawnIsInTransport = false;
+        for (const auto& transport : transports_) {
+            if (transport->isPawnInTransport(*it)) {
                 pawnIsInTransport = true;
+                break;
             }
         }
-        if ( !pawnIsInTransport ){
-            removable.push_back(it->second);
+        if (pawnIsInTransport) {
+            ++it;
+        } else {
+            it = pawns_.erase(it);
         }
     }
-    std::vector<std::shared_ptr<Common::Pawn>>::iterator it3;
-    for( it3 = removable.begin(); it3 != removable.end(); ++it3){
-        removePawn(*it3);
-    }
+    contentsChanged();
 }
 
 void Hex::clearTransports()
 {
-    transportMap_.clear();
+    saveToUndoLog();
+    transports_.clear();
+    contentsChanged();
 }
 
-void Hex::addNeighbour(std::shared_ptr<Common::Hex> hex)
+void Hex::addNeighbour(const std::shared_ptr<Common::Hex>& hex)
 {
     neighbourHexes_.push_back(hex);
 }
 
 void Hex::clearAllFromNeightbours()
 {
-    std::vector<std::shared_ptr<Common::Hex>>::const_iterator it;
-    for ( it = neighbourHexes_.begin(); it != neighbourHexes_.end(); ++it){
-        (*it)->clear();
+    if (board_ == nullptr) {
+        for (const auto& neighbour : neighbourHexes_) {
+            if (std::shared_ptr<Hex> hex = neighbour.lock()) {
+                hex->clear();
+            }
+        }
+        return;
+    }
+
+    // Clearing an empty hex changes nothing, the bitboards tell which
+    // neighbours have something on them without visiting the others
+    const BoardBitboards* bits = board_->getBitboards();
+    if (bits != nullptr) {
+        const BoardIndex& index = bits->occupied.getIndex();
+        for (const CubeCoordinate& offset : NEIGHBOUR_OFFSETS) {
+            CubeCoordinate coord(coord_.x + offset.x, coord_.y + offset.y,
+                                 coord_.z + offset.z);
+            int slot = index.slotOf(coord);
+            if (slot >= 0 && bits->occupied.test(slot)) {
+                board_->findHex(coord)->clear();
+            }
+        }
+        return;
+    }
+
+    Hex* neighbours[HEX_NEIGHBOURS];
+    board_->findNeighbours(coord_, neighbours);
+    for (Hex* neighbour : neighbours) {
+        if (neighbour != nullptr) {
+            neighbour->clear();
+        }
     }
 }
 
 std::vector<std::shared_ptr<Actor> > Hex::getActors()
 {
-    std::vector<std::shared_ptr<Actor> > actors;
+    return copyOccupants(actors_);
+}
 
-    for ( const auto& pair: actorMap_)
-    {
-        actors.push_back(pair.second);
-    }
+std::vector<std::shared_ptr<Pawn> > Hex::getPawns()
+{
+    return copyOccupants(pawns_);
+}
 
-    return actors;
+std::vector<std::shared_ptr<Transport> > Hex::getTransports()
+{
+    return copyOccupants(transports_);
 }
 
-std::vector<std::shared_ptr<Pawn> > Hex::getPawns()
+void Hex::setListener(IHexListener* listener)
 {
-    std::vector<std::shared_ptr<Pawn> > pawns;
-    for ( const auto& pair: pawnMap_)
-    {
-        pawns.push_back(pair.second);
+    listener_ = listener;
+}
+
+void Hex::setBoard(const IGameBoard* board)
+{
+    board_ = board;
+}
+
+const IGameBoard* Hex::getBoard() const
+{
+    return board_;
+}
+
+void Hex::contentsChanged() const
+{
+    if (listener_ != nullptr) {
+        listener_->hexChanged(*this);
     }
+}
 
-    return pawns;
+Hex::State Hex::saveState() const
+{
+    return State{piece_, pawns_, actors_, transports_};
 }
 
-std::vector<std::shared_ptr<Transport> > Hex::getTransports()
+void Hex::restoreState(const State& state)
 {
-    std::vector<std::shared_ptr<Transport> > transports;
-    for ( const auto& pair: transportMap_)
-    {
-        transports.push_back(pair.second);
+    piece_ = state.piece;
+    pawns_ = state.pawns;
+    actors_ = state.actors;
+    transports_ = state.transports;
+    for (const auto& pawn : pawns_) {
+        pawn->setCoordinates(coord_);
     }
+    contentsChanged();
+}
 
-    return transports;
+void Hex::saveToUndoLog()
+{
+    UndoLog* log = UndoLog::of(*this);
+    if (log != nullptr) {
+        log->saveHex(*this);
+    }
 }
+
 }
@@ -1,11 +1,15 @@
 #ifndef HEX_HH
 #define HEX_HH
 
+#include "boardindex.hh"
 #include "cubecoordinate.hh"
+#include "ihexlistener.hh"
+#include "rules.hh"
+#include "smallvector.hh"
+#include "typeregistry.hh"
 #include <memory>
 #include <string>
 #include <vector>
-#include <map>
 
 /**
  * @file
@@ -19,6 +23,7 @@ namespace Common {
 class Pawn;
 class Actor;
 class Transport;
+class IGameBoard;
 
 /**
  * @brief Represents a hex tile on the gameboard.
@@ -28,6 +33,17 @@ class Hex : public std::enable_shared_from_this<Hex> {
 
   public:
 
+    /**
+     * @brief The piece type and the occupants of a hex, see saveState().
+     */
+    struct State {
+        Common::TypeId piece;
+        SmallVector<std::shared_ptr<Common::Pawn>,
+                    Logic::MAX_PAWNS_PER_HEX> pawns;
+        SmallVector<std::shared_ptr<Common::Actor>, 1> actors;
+        SmallVector<std::shared_ptr<Common::Transport>, 1> transports;
+    };
+
     /**
      * @brief Constructor.
      */
@@ -45,18 +61,24 @@ class Hex : public std::enable_shared_from_this<Hex> {
      */
     void setPieceType(std::string piece);
 
+    /**
+     * @brief setPieceTypeId sets a new piece type for the hex.
+     * @param pieceType Identifier of the new piece type, see TypeRegistry.
+     */
+    void setPieceTypeId(Common::TypeId pieceType);
+
     /**
      * @brief addPawn adds the pawn to the hex
      * @param pawn a shared pointer to the pawn added
      * @post Exception quarantee: nothrow
      */
-    void addPawn( std::shared_ptr<Common::Pawn> pawn );
+    void addPawn( const std::shared_ptr<Common::Pawn>& pawn );
     /**
      * @brief removePawn removes an pawn from the hex
      * @param pawn a shared pointer to the pwn removed
      * @post Exception quarantee: nothrow
      */
-    void removePawn( std::shared_ptr<Common::Pawn> pawn );
+    void removePawn( const std::shared_ptr<Common::Pawn>& pawn );
 
     /**
      * @brief getCoordinates gets the location of the hex.
@@ -70,6 +92,16 @@ class Hex : public std::enable_shared_from_this<Hex> {
      */
     std::string getPieceType() const;
 
+    /**
+     * @brief getPieceTypeId gets the piece type of the hex without building
+     * its name.
+     * @return Identifier of the piece type, see TypeRegistry.
+     */
+    Common::TypeId getPieceTypeId() const
+    {
+        return piece_;
+    }
+
     /**
      * @brief getActorType gets the actor types of the hex.
      * @return The actor types of the hex.
@@ -81,21 +113,21 @@ class Hex : public std::enable_shared_from_this<Hex> {
      * @param actor a shared pointer to the actor added
      * @post Exception quarantee: nothrow
      */
-    void addActor( std::shared_ptr<Common::Actor> actor );
+    void addActor( const std::shared_ptr<Common::Actor>& actor );
 
     /**
      * @brief removeActor removes an actor from the hex
      * @param actor a shared pointer to the actor removed
      * @post Exception quarantee: nothrow
      */
-    void removeActor( std::shared_ptr<Common::Actor> actor );
+    void removeActor( const std::shared_ptr<Common::Actor>& actor );
 
     /**
      * @brief addTransport adds the transport to the hex
      * @param transport a shared pointer to the transport added
      * @post Exception quarantee: nothrow
      */
-    void addTransport( std::shared_ptr<Common::Transport> transport );
+    void addTransport( const std::shared_ptr<Common::Transport>& transport );
 
 
     /**
@@ -103,19 +135,25 @@ class Hex : public std::enable_shared_from_this<Hex> {
      * @param transport a shared pointer to the transport removed
      * @post Exception quarantee: nothrow
      */
-    void removeTransport( std::shared_ptr<Common::Transport> transport );
+    void removeTransport( const std::shared_ptr<Common::Transport>& transport );
 
     /**
      * @brief getPawnAmount tells the number of the pawns in the hex.
      * @return The number of the pawns in the hex.
      */
-    int getPawnAmount() const;
+    int getPawnAmount() const
+    {
+        return static_cast<int>(pawns_.size());
+    }
 
     /**
      * @brief isWaterTile checks if the hex is a water tile.
      * @return true, if the hex is a water tile, else false.
      */
-    bool isWaterTile() const;
+    bool isWaterTile() const
+    {
+        return piece_ == WATER_TYPE;
+    }
 
     /**
      * @brief getNeighbourVector returns the neighbour hexes.
@@ -145,6 +183,36 @@ class Hex : public std::enable_shared_from_this<Hex> {
      */
     std::shared_ptr<Common::Actor> giveActor(int actorId) const;
 
+    /**
+     * @brief findPawn returns the pawn with id pawnId without sharing its
+     * ownership.
+     * @param pawnId the id of the pawn needed
+     * @return pointer to the pawn or nullptr if pawn not found. The pawn is
+     * owned by the board, the pointer is valid until the pawn leaves the hex.
+     * @post Exception quarantee: nothrow
+     */
+    Common::Pawn* findPawn(int pawnId) const;
+
+    /**
+     * @brief findTransport returns the transport with id transportId without
+     * sharing its ownership.
+     * @param transportId the id of the transport needed
+     * @return pointer to the transport or nullptr if transport not found. The
+     * pointer is valid until the transport leaves the hex.
+     * @post Exception quarantee: nothrow
+     */
+    Common::Transport* findTransport(int transportId) const;
+
+    /**
+     * @brief findActor returns the actor with id actorId without sharing its
+     * ownership.
+     * @param actorId the id of the actor needed
+     * @return pointer to the actor or nullptr if actor not found. The pointer
+     * is valid until the actor leaves the hex.
+     * @post Exception quarantee: nothrow
+     */
+    Common::Actor* findActor(int actorId) const;
+
    /**
     * @brief clear clears the hex.
     * @post all actors, pawns and transports are removed from the hex
@@ -163,10 +231,15 @@ class Hex : public std::enable_shared_from_this<Hex> {
    /**
     * @brief addNeighbour adds neighbour hex to the hex
     * @param neightbour has been added to the hex
+    * @details Only used when the hex is not on a board, a hex on a board
+    * finds its neighbours through the board, see setBoard(). The hex doesn't
+    * keep the added neighbours alive.
     */
-   void addNeighbour(std::shared_ptr<Common::Hex> hex);
+   void addNeighbour(const std::shared_ptr<Common::Hex>& hex);
    /**
     * @brief clearAllFromNeightbours clears all from neightbour hexes
+    * @details The neighbours are asked from the board of the hex, a hex that
+    * is not on a board clears the ones given to addNeighbour().
     * @post everything is cleared from neightbour hexes
     */
    void clearAllFromNeightbours();
@@ -187,32 +260,115 @@ class Hex : public std::enable_shared_from_this<Hex> {
     */
    std::vector<std::shared_ptr<Common::Transport> > getTransports();
 
+   /**
+    * @brief getActorSpan returns Actors inside the Hex without copying them.
+    * @return view to the Actors in the order of their ids, valid until the
+    * actors of the Hex change.
+    * @post Exception quarantee: nothrow
+    */
+   Span<const std::shared_ptr<Common::Actor>> getActorSpan() const
+   {
+       return actors_.span();
+   }
+   /**
+    * @brief getPawnSpan returns Pawns inside the Hex without copying them.
+    * @return view to the Pawns in the order of their ids, valid until the
+    * pawns of the Hex change.
+    * @post Exception quarantee: nothrow
+    */
+   Span<const std::shared_ptr<Common::Pawn>> getPawnSpan() const
+   {
+       return pawns_.span();
+   }
+   /**
+    * @brief getTransportSpan returns Transports inside the Hex without
+    * copying them.
+    * @return view to the Transports in the order of their ids, valid until
+    * the transports of the Hex change.
+    * @post Exception quarantee: nothrow
+    */
+   Span<const std::shared_ptr<Common::Transport>> getTransportSpan() const
+   {
+       return transports_.span();
+   }
+
+   /**
+    * @brief setListener sets the object that is told about the changes of
+    * the hex.
+    * @param listener The listener, or nullptr for none. Copies of the hex
+    * have the same listener.
+    * @pre The listener outlives the hex or is removed before it is destroyed.
+    * @post Exception quarantee: nothrow
+    */
+   void setListener(Common::IHexListener* listener);
+   /**
+    * @brief setBoard sets the board the hex is on. Boards set themselves
+    * when the hex is added.
+    * @param board The board, or nullptr for none. Copies of the hex are on
+    * the same board until they are added to another.
+    * @pre The board outlives the hex or is removed before it is destroyed.
+    * @post Exception quarantee: nothrow
+    */
+   void setBoard(const Common::IGameBoard* board);
+   /**
+    * @brief getBoard returns the board the hex is on.
+    * @return The board, nullptr if the hex is not on a board.
+    */
+   const Common::IGameBoard* getBoard() const;
+   /**
+    * @brief contentsChanged tells the listener that the hex has changed.
+    * @details Called by the hex itself, and by transports when a pawn boards
+    * or leaves them.
+    * @post Exception quarantee: nothrow
+    */
+   void contentsChanged() const;
+
+   /**
+    * @brief saveState copies the piece type and the occupants of the hex.
+    * @return The state, the occupants are shared with the hex.
+    * @post Exception quarantee: strong
+    */
+   State saveState() const;
+   /**
+    * @brief restoreState puts back a state saved with saveState().
+    * @details The pawns of the state get the coordinates of the hex. The
+    * change is not saved to the undo log of the board.
+    * @param state The state.
+    * @post Exception quarantee: basic
+    */
+   void restoreState(const State& state);
+
   private:
 
+    //! Saves the state to the undo log of the board before a change.
+    void saveToUndoLog();
+
+    // The fields read by route searches come first, so that checking a hex
+    // touches a single cache line
+
     //! Coordinates of the hex.
     Common::CubeCoordinate coord_;
 
-    //! Actors on the hex, searchable by ID
-    mutable std::map<int, std::shared_ptr<Common::Actor>> actorMap_;
+    //! Piece type of the hex.
+    Common::TypeId piece_;
 
-    //! Transports on the hex, searchable by ID
-    mutable std::map<int, std::shared_ptr<Common::Transport>> transportMap_;
+    //! Pawns on the hex, sorted by ID. Room for a full hex inside the object.
+    SmallVector<std::shared_ptr<Common::Pawn>, Logic::MAX_PAWNS_PER_HEX> pawns_;
 
-    //! Pawns on the hex, searchable by ID
-    mutable std::map<int, std::shared_ptr<Common::Pawn>> pawnMap_;
+    //! Actors on the hex, sorted by ID. A hex rarely has more than one.
+    SmallVector<std::shared_ptr<Common::Actor>, 1> actors_;
 
-    //! Number of the pawns in the hex.
-    int pawns_;
+    //! Transports on the hex, sorted by ID. A hex rarely has more than one.
+    SmallVector<std::shared_ptr<Common::Transport>, 1> transports_;
 
-    //! Piece type of the hex.
-    std::string piece_;
+    //! Board the hex is on, answers the neighbour queries.
+    const Common::IGameBoard* board_;
 
-    //! Vector which contains coordinates of neighbour hexes
-    std::vector<Common::CubeCoordinate> neighbourVector_;
-    //! Vector which contains neighbour hexes
-    std::vector<std::shared_ptr<Common::Hex>> neighbourHexes_;
+    //! Told about the changes, nullptr if nobody follows the hex.
+    Common::IHexListener* listener_;
 
-    void setNeighbourVector();
+    //! Neighbours given to addNeighbour, for a hex that is not on a board.
+    std::vector<std::weak_ptr<Common::Hex>> neighbourHexes_;
 
 };
 
@@ -0,0 +1,412 @@
+#include "hexbitboard.hh"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+// As in cubekernels.cpp, the AVX2 version needs the intrinsics and the
+// function attributes of GCC and Clang and is chosen at run time
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HEXBITBOARD_X86_64
+#include <immintrin.h>
+#endif
+
+namespace Common {
+
+namespace {
+
+/**
+ * @brief What the spread kernels need to know about a radius.
+ * @details Moving to the neighbour (x+1, z) is a shift of one bit up, to
+ * (x, z+1) a shift of width bits up and to (x-1, z+1) a shift of width - 1
+ * bits up, the opposite sides shift down. Shifts that move a bit off the
+ * first or the last column of a row wrap to the other end of a row, the
+ * column masks clear those bits.
+ */
+struct Shifts
+{
+    std::size_t wordCount;
+
+    //! A shift of width bits, in whole words and the bits left over.
+    int rowWords;
+    int rowBits;
+
+    //! A shift of width - 1 bits.
+    int diagonalWords;
+    int diagonalBits;
+
+    //! wordCount words each, every slot but those of the first or the last
+    //! column of a row.
+    const std::uint64_t* notFirstColumn;
+    const std::uint64_t* notLastColumn;
+};
+
+using SpreadKernel = bool (*)(const std::uint64_t*, const std::uint64_t*,
+                              std::uint64_t*, std::uint64_t*, const Shifts&);
+
+// Bit j of the result is bit j - words * 64 - bits of the set
+std::uint64_t shiftedUp(const std::uint64_t* set, std::size_t i, int words,
+                        int bits)
+{
+    const std::uint64_t* source = set + (static_cast<std::ptrdiff_t>(i) -
+                                         words);
+    if (bits == 0) {
+        return source[0];
+    }
+    return (source[0] << bits) | (source[-1] >> (64 - bits));
+}
+
+// Bit j of the result is bit j + words * 64 + bits of the set
+std::uint64_t shiftedDown(const std::uint64_t* set, std::size_t i, int words,
+                          int bits)
+{
+    const std::uint64_t* source = set + i + words;
+    if (bits == 0) {
+        return source[0];
+    }
+    return (source[0] >> bits) | (source[1] << (64 - bits));
+}
+
+// reached may be nullptr, then nothing is left out
+bool spreadScalar(const std::uint64_t* from, const std::uint64_t* allowed,
+                  std::uint64_t* reached, std::uint64_t* to,
+                  const Shifts& shifts)
+{
+    std::uint64_t found = 0;
+    for (std::size_t i = 0; i < shifts.wordCount; ++i) {
+        std::uint64_t east = shiftedUp(from, i, 0, 1);
+        std::uint64_t west = shiftedDown(from, i, 0, 1);
+        std::uint64_t southWest = shiftedUp(from, i, shifts.diagonalWords,
+                                            shifts.diagonalBits);
+        std::uint64_t northEast = shiftedDown(from, i, shifts.diagonalWords,
+                                              shifts.diagonalBits);
+        std::uint64_t next =
+                ((east | northEast) & shifts.notFirstColumn[i]) |
+                ((west | southWest) & shifts.notLastColumn[i]) |
+                shiftedUp(from, i, shifts.rowWords, shifts.rowBits) |
+                shiftedDown(from, i, shifts.rowWords, shifts.rowBits);
+
+        next &= allowed[i];
+        if (reached != nullptr) {
+            next &= ~reached[i];
+            reached[i] |= next;
+        }
+        to[i] = next;
+        found |= next;
+    }
+    return found != 0;
+}
+
+#ifdef HEXBITBOARD_X86_64
+
+__attribute__((target("avx2")))
+__m256i load4(const std::uint64_t* words)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+}
+
+// Shifts by 64 bits or more give zeros, so a whole word shift needs no
+// special case here
+__attribute__((target("avx2")))
+__m256i shiftedUp4(const std::uint64_t* set, std::size_t i, int words,
+                   __m128i bits, __m128i carryBits)
+{
+    const std::uint64_t* source = set + (static_cast<std::ptrdiff_t>(i) -
+                                         words);
+    return _mm256_or_si256(_mm256_sll_epi64(load4(source), bits),
+                           _mm256_srl_epi64(load4(source - 1), carryBits));
+}
+
+__attribute__((target("avx2")))
+__m256i shiftedDown4(const std::uint64_t* set, std::size_t i, int words,
+                     __m128i bits, __m128i carryBits)
+{
+    const std::uint64_t* source = set + i + words;
+    return _mm256_or_si256(_mm256_srl_epi64(load4(source), bits),
+                           _mm256_sll_epi64(load4(source + 1), carryBits));
+}
+
+__attribute__((target("avx2")))
+bool spreadAvx2(const std::uint64_t* from, const std::uint64_t* allowed,
+                std::uint64_t* reached, std::uint64_t* to,
+                const Shifts& shifts)
+{
+    const __m128i one = _mm_cvtsi32_si128(1);
+    const __m128i oneCarry = _mm_cvtsi32_si128(63);
+    const __m128i row = _mm_cvtsi32_si128(shifts.rowBits);
+    const __m128i rowCarry = _mm_cvtsi32_si128(64 - shifts.rowBits);
+    const __m128i diagonal = _mm_cvtsi32_si128(shifts.diagonalBits);
+    const __m128i diagonalCarry = _mm_cvtsi32_si128(64 - shifts.diagonalBits);
+
+    __m256i found = _mm256_setzero_si256();
+    // wordCount is a multiple of four
+    for (std::size_t i = 0; i < shifts.wordCount; i += 4) {
+        __m256i east = shiftedUp4(from, i, 0, one, oneCarry);
+        __m256i west = shiftedDown4(from, i, 0, one, oneCarry);
+        __m256i southWest = shiftedUp4(from, i, shifts.diagonalWords,
+                                       diagonal, diagonalCarry);
+        __m256i northEast = shiftedDown4(from, i, shifts.diagonalWords,
+                                         diagonal, diagonalCarry);
+        __m256i rows = _mm256_or_si256(
+                    shiftedUp4(from, i, shifts.rowWords, row, rowCarry),
+                    shiftedDown4(from, i, shifts.rowWords, row, rowCarry));
+
+        __m256i next = _mm256_or_si256(
+                    _mm256_or_si256(
+                        _mm256_and_si256(_mm256_or_si256(east, northEast),
+                                         load4(shifts.notFirstColumn + i)),
+                        _mm256_and_si256(_mm256_or_si256(west, southWest),
+                                         load4(shifts.notLastColumn + i))),
+                    rows);
+
+        next = _mm256_and_si256(next, load4(allowed + i));
+        if (reached != nullptr) {
+            __m256i old = load4(reached + i);
+            next = _mm256_andnot_si256(old, next);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(reached + i),
+                                _mm256_or_si256(old, next));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i), next);
+        found = _mm256_or_si256(found, next);
+    }
+    return !_mm256_testz_si256(found, found);
+}
+
+#endif
+
+SpreadKernel spreadKernel(CubeKernels::KernelLevel level)
+{
+    CubeKernels::KernelLevel supported = CubeKernels::supportedLevel();
+    if (level > supported) {
+        level = supported;
+    }
+#ifdef HEXBITBOARD_X86_64
+    if (level == CubeKernels::KernelLevel::AVX2) {
+        return spreadAvx2;
+    }
+#endif
+    return spreadScalar;
+}
+
+int lowestBit(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+}
+
+struct HexBitboard::Layout
+{
+    explicit Layout(int radius);
+
+    static std::shared_ptr<const Layout> forRadius(int radius);
+
+    BoardIndex index;
+    std::size_t padding;
+    Shifts shifts;
+
+    std::vector<std::uint64_t> notFirstColumn;
+    std::vector<std::uint64_t> notLastColumn;
+
+    //! The slots within the radius.
+    std::vector<std::uint64_t> inside;
+};
+
+HexBitboard::Layout::Layout(int radius):
+    index(radius)
+{
+    int width = index.width();
+    std::size_t words = (index.slotCount() + 63) / 64;
+    shifts.wordCount = (words + 3) / 4 * 4;
+    shifts.rowWords = width / 64;
+    shifts.rowBits = width % 64;
+    shifts.diagonalWords = (width - 1) / 64;
+    shifts.diagonalBits = (width - 1) % 64;
+    // The shifts read one word past the whole words they skip
+    padding = shifts.rowWords + 1;
+
+    notFirstColumn.assign(shifts.wordCount, 0);
+    notLastColumn.assign(shifts.wordCount, 0);
+    inside.assign(shifts.wordCount, 0);
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+        int column = slot % width;
+        if (column != 0) {
+            notFirstColumn[slot / 64] |= bit;
+        }
+        if (column != width - 1) {
+            notLastColumn[slot / 64] |= bit;
+        }
+        if (index.contains(index.coordinateOf(slot))) {
+            inside[slot / 64] |= bit;
+        }
+    }
+    shifts.notFirstColumn = notFirstColumn.data();
+    shifts.notLastColumn = notLastColumn.data();
+}
+
+std::shared_ptr<const HexBitboard::Layout> HexBitboard::Layout::forRadius(
+        int radius)
+{
+    // Kept for the rest of the program, like the tables of BoardTopology
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const Layout>> layouts;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const Layout>& layout = layouts[radius];
+    if (layout == nullptr) {
+        layout = std::make_shared<const Layout>(radius);
+    }
+    return layout;
+}
+
+HexBitboard::HexBitboard(int radius):
+    padding_(0),
+    wordCount_(0)
+{
+    resize(radius);
+}
+
+void HexBitboard::resize(int radius)
+{
+    std::shared_ptr<const Layout> layout = Layout::forRadius(radius);
+    words_.assign(layout->shifts.wordCount + 2 * layout->padding, 0);
+    layout_ = layout;
+    padding_ = layout->padding;
+    wordCount_ = layout->shifts.wordCount;
+}
+
+int HexBitboard::radius() const
+{
+    return layout_->index.radius();
+}
+
+const BoardIndex& HexBitboard::getIndex() const
+{
+    return layout_->index;
+}
+
+void HexBitboard::clear()
+{
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+bool HexBitboard::any() const
+{
+    const std::uint64_t* set = words();
+    std::uint64_t found = 0;
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        found |= set[i];
+    }
+    return found != 0;
+}
+
+int HexBitboard::count() const
+{
+    const std::uint64_t* set = words();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        found += std::bitset<64>(set[i]).count();
+    }
+    return static_cast<int>(found);
+}
+
+HexBitboard& HexBitboard::operator&=(const HexBitboard& other)
+{
+    std::uint64_t* set = words();
+    const std::uint64_t* otherSet = other.words();
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        set[i] &= otherSet[i];
+    }
+    return *this;
+}
+
+HexBitboard& HexBitboard::operator|=(const HexBitboard& other)
+{
+    std::uint64_t* set = words();
+    const std::uint64_t* otherSet = other.words();
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        set[i] |= otherSet[i];
+    }
+    return *this;
+}
+
+HexBitboard& HexBitboard::andNot(const HexBitboard& other)
+{
+    std::uint64_t* set = words();
+    const std::uint64_t* otherSet = other.words();
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        set[i] &= ~otherSet[i];
+    }
+    return *this;
+}
+
+bool HexBitboard::operator==(const HexBitboard& other) const
+{
+    return radius() == other.radius() &&
+            std::equal(words(), words() + wordCount_, other.words());
+}
+
+void HexBitboard::appendCoordinates(
+        std::vector<CubeCoordinate>& coordinates) const
+{
+    const std::uint64_t* set = words();
+    for (std::size_t i = 0; i < wordCount_; ++i) {
+        std::uint64_t word = set[i];
+        while (word != 0) {
+            int slot = static_cast<int>(i * 64) + lowestBit(word);
+            coordinates.push_back(layout_->index.coordinateOf(slot));
+            word &= word - 1;
+        }
+    }
+}
+
+bool HexBitboard::spread(const HexBitboard& from, const HexBitboard& allowed,
+                         HexBitboard& reached, HexBitboard& to)
+{
+    static const SpreadKernel kernel =
+            spreadKernel(CubeKernels::supportedLevel());
+    return kernel(from.words(), allowed.words(), reached.words(), to.words(),
+                  from.layout_->shifts);
+}
+
+bool HexBitboard::spread(const HexBitboard& from, const HexBitboard& allowed,
+                         HexBitboard& reached, HexBitboard& to,
+                         CubeKernels::KernelLevel level)
+{
+    return spreadKernel(level)(from.words(), allowed.words(), reached.words(),
+                               to.words(), from.layout_->shifts);
+}
+
+void HexBitboard::neighbours(const HexBitboard& from, HexBitboard& to)
+{
+    static const SpreadKernel kernel =
+            spreadKernel(CubeKernels::supportedLevel());
+    kernel(from.words(), from.layout_->inside.data(), nullptr, to.words(),
+           from.layout_->shifts);
+}
+
+void BoardBitboards::resize(int radius)
+{
+    hexes.resize(radius);
+    land.resize(radius);
+    water.resize(radius);
+    full.resize(radius);
+    walkable.resize(radius);
+    occupied.resize(radius);
+    actors.resize(radius);
+    transports.resize(radius);
+}
+
+}
@@ -0,0 +1,238 @@
+#ifndef HEXBITBOARD_HH
+#define HEXBITBOARD_HH
+
+#include "boardindex.hh"
+#include "cubekernels.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief One bit per slot of a board, and the bitboards of the properties
+ * the rule checks read.
+ */
+
+namespace Common {
+
+/**
+ * @brief Set of the slots of a BoardIndex, one bit per slot in 64 bit words.
+ * @details Slot s is bit s % 64 of word s / 64. The slots of a row are next
+ * to each other, so the neighbours of every slot of the set are found by
+ * shifting the whole set by 1, width and width - 1 bits and masking off the
+ * bits that wrap to another row, see spread(). The standard island fits
+ * into eight words.
+ *
+ * The words are padded with zeros on both sides, so that the shifts read
+ * past the ends without bounds checks. Bits of slots outside the radius are
+ * never set by spread(). Sets of the same radius share the masks.
+ */
+class HexBitboard {
+
+  public:
+
+    /**
+     * @brief Constructor, creates an empty set.
+     * @param radius Radius of the board index.
+     * @post Exception quarantee: strong
+     */
+    explicit HexBitboard(int radius = 0);
+
+    /**
+     * @brief resize makes the set cover a board index of another radius.
+     * @param radius Radius of the board index.
+     * @post The set is empty. Exception quarantee: strong
+     */
+    void resize(int radius);
+
+    /**
+     * @brief radius tells the largest distance from the center the set
+     * covers.
+     * @return The radius of the index.
+     */
+    int radius() const;
+
+    /**
+     * @brief getIndex returns the mapping between coordinates and the slots
+     * of the set.
+     * @return The index of the set.
+     */
+    const BoardIndex& getIndex() const;
+
+    /**
+     * @brief wordCount tells the number of words of the set.
+     * @return The number of words, a multiple of four.
+     */
+    std::size_t wordCount() const { return wordCount_; }
+
+    /**
+     * @brief words returns the words of the set.
+     * @return wordCount() words, the bits past the last slot are zero.
+     */
+    const std::uint64_t* words() const { return words_.data() + padding_; }
+    std::uint64_t* words() { return words_.data() + padding_; }
+
+    /**
+     * @brief test tells if a slot is in the set.
+     * @param slot The slot.
+     * @pre 0 <= slot < getIndex().slotCount()
+     * @return true, if the slot is in the set, otherwise false.
+     */
+    bool test(int slot) const
+    {
+        return (words()[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    /**
+     * @brief assign adds a slot to or removes it from the set.
+     * @param slot The slot.
+     * @param value true to add the slot, false to remove it.
+     * @pre 0 <= slot < getIndex().slotCount()
+     */
+    void assign(int slot, bool value)
+    {
+        std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+        std::uint64_t& word = words()[slot / 64];
+        word = value ? word | bit : word & ~bit;
+    }
+
+    void set(int slot) { assign(slot, true); }
+    void reset(int slot) { assign(slot, false); }
+
+    /**
+     * @brief clear removes every slot from the set.
+     * @post Exception quarantee: nothrow
+     */
+    void clear();
+
+    /**
+     * @brief any tells if the set has slots.
+     * @return true, if at least one slot is in the set, otherwise false.
+     */
+    bool any() const;
+
+    /**
+     * @brief count tells the number of slots in the set.
+     * @return The number of slots.
+     */
+    int count() const;
+
+    /**
+     * @brief Intersection, union and difference with a set of the same
+     * radius.
+     * @pre other.radius() == radius()
+     */
+    HexBitboard& operator&=(const HexBitboard& other);
+    HexBitboard& operator|=(const HexBitboard& other);
+    HexBitboard& andNot(const HexBitboard& other);
+
+    bool operator==(const HexBitboard& other) const;
+    bool operator!=(const HexBitboard& other) const { return !(*this == other); }
+
+    /**
+     * @brief appendCoordinates appends the coordinates of the slots of the
+     * set.
+     * @param coordinates The coordinates are appended here in the order of
+     * the slots.
+     * @post Exception quarantee: basic
+     */
+    void appendCoordinates(std::vector<CubeCoordinate>& coordinates) const;
+
+    /**
+     * @brief spread finds the neighbours of a set that are allowed and not
+     * reached yet, and adds them to the reached set.
+     * @details One step of a flood fill:
+     * to = neighbours(from) & allowed & ~reached, then reached |= to.
+     * Costs a few dozen word operations per word of the set.
+     * @param from The set whose neighbours are found.
+     * @param allowed The slots the neighbours may be in.
+     * @param reached The slots left out of to, to is added to them.
+     * @param to Set to the found slots.
+     * @pre All the sets have the same radius, to is not from, allowed or
+     * reached.
+     * @return true, if any slot was found, otherwise false.
+     * @post Exception quarantee: nothrow
+     */
+    static bool spread(const HexBitboard& from, const HexBitboard& allowed,
+                       HexBitboard& reached, HexBitboard& to);
+
+    /**
+     * @brief spread with the given instruction set, see spread().
+     * @param level The instruction set. A level the processor doesn't
+     * support falls back to CubeKernels::supportedLevel(). The SSE2 level
+     * uses the scalar version.
+     */
+    static bool spread(const HexBitboard& from, const HexBitboard& allowed,
+                       HexBitboard& reached, HexBitboard& to,
+                       CubeKernels::KernelLevel level);
+
+    /**
+     * @brief neighbours finds the neighbours of a set.
+     * @param from The set whose neighbours are found.
+     * @param to Set to the slots next to a slot of from that are within the
+     * radius. May include slots of from.
+     * @pre to has the radius of from and is not from.
+     * @post Exception quarantee: nothrow
+     */
+    static void neighbours(const HexBitboard& from, HexBitboard& to);
+
+  private:
+
+    //! Masks and shifts of one radius, shared by its sets.
+    struct Layout;
+
+    std::shared_ptr<const Layout> layout_;
+
+    //! Zero words on each side of the set.
+    std::size_t padding_;
+
+    //! Words of the set between the paddings.
+    std::size_t wordCount_;
+
+    std::vector<std::uint64_t> words_;
+};
+
+/**
+ * @brief The bitboards of the hexes of a board, kept up to date by boards
+ * that offer them, see IGameBoard::getBitboards().
+ * @details All the sets have the radius of the board index.
+ */
+struct BoardBitboards
+{
+    //! Slots with a hex.
+    HexBitboard hexes;
+
+    //! Hexes that are not water.
+    HexBitboard land;
+
+    //! Water hexes.
+    HexBitboard water;
+
+    //! Hexes with Logic::MAX_PAWNS_PER_HEX pawns or more.
+    HexBitboard full;
+
+    //! Land hexes that are not full, a walking pawn can pass through them.
+    HexBitboard walkable;
+
+    //! Hexes with a pawn, an actor or a transport.
+    HexBitboard occupied;
+
+    //! Hexes with an actor.
+    HexBitboard actors;
+
+    //! Hexes with a transport.
+    HexBitboard transports;
+
+    /**
+     * @brief resize makes every set cover a board index of another radius.
+     * @param radius Radius of the board index.
+     * @post The sets are empty. Exception quarantee: basic
+     */
+    void resize(int radius);
+};
+
+}
+
+#endif // HEXBITBOARD_HH
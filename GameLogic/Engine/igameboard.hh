@@ -1,7 +1,9 @@
 #ifndef IGAMEBOARD_HH
 #define IGAMEBOARD_HH
 
+#include "boardindex.hh"
 #include "cubecoordinate.hh"
+#include "gamearena.hh"
 #include "hex.hh"
 
 #include <memory>
@@ -13,6 +15,10 @@
 
 namespace Common {
 
+struct BoardBitboards;
+class GameLog;
+class UndoLog;
+
 /**
  * @brief Interface for game board.
  */
@@ -56,6 +62,66 @@ class IGameBoard : public std::enable_shared_from_this<Common::IGameBoard> {
      */
     virtual std::shared_ptr<Common::Hex> getHex(Common::CubeCoordinate hexCoord) const = 0;
 
+    /**
+     * @brief findHex returns the hex gameboard tile without sharing its
+     * ownership.
+     * @details Used by the game engine when checking moves. Boards that own
+     * their hexes can override it to skip the reference counting of getHex.
+     * The default asks getHex.
+     * @param hexCoord The location of the hex in coordinates.
+     * @return Pointer to the hex or nullptr, if the hex not exists. The board
+     * owns the hex, the pointer is valid until the hex is replaced or the
+     * board is destroyed.
+     * @post Exception quarantee: nothrow
+     */
+    virtual Common::Hex* findHex(Common::CubeCoordinate hexCoord) const
+    {
+        return getHex(hexCoord).get();
+    }
+
+    /**
+     * @brief findNeighbours returns the neighbours of a hex without sharing
+     * their ownership.
+     * @details Used by Hex::clearAllFromNeightbours. Boards that keep a
+     * neighbour table can override it to skip the coordinate lookups. The
+     * default asks findHex for each side.
+     * @param hexCoord The location of the hex in coordinates.
+     * @param neighbours Filled with the neighbour on each side in the order
+     * of NEIGHBOUR_OFFSETS, nullptr where there is no hex. The board owns the
+     * hexes, as in findHex.
+     * @return The number of neighbours that exist.
+     * @post Exception quarantee: nothrow
+     */
+    virtual int findNeighbours(Common::CubeCoordinate hexCoord,
+                               Common::Hex* neighbours[HEX_NEIGHBOURS]) const
+    {
+        int found = 0;
+        for (int side = 0; side < HEX_NEIGHBOURS; ++side) {
+            const Common::CubeCoordinate& offset = NEIGHBOUR_OFFSETS[side];
+            neighbours[side] = findHex(Common::CubeCoordinate(
+                                           hexCoord.x + offset.x,
+                                           hexCoord.y + offset.y,
+                                           hexCoord.z + offset.z));
+            found += neighbours[side] != nullptr;
+        }
+        return found;
+    }
+
+    /**
+     * @brief getBitboards returns the bitboards of the hexes of the board.
+     * @details Used by the game engine to find the routes of pawns with
+     * word operations instead of visiting the hexes one by one. Boards that
+     * are told when their hexes change can keep the bitboards up to date
+     * and override this. The default has none.
+     * @return The bitboards, nullptr if the board doesn't keep them. The
+     * board owns them and updates them in place.
+     * @post Exception quarantee: nothrow
+     */
+    virtual const Common::BoardBitboards* getBitboards() const
+    {
+        return nullptr;
+    }
+
     /**
      * @brief addPawn adds a new pawn to the game
      * @param playerId. Id of player, whose pawn is added
@@ -141,6 +207,72 @@ class IGameBoard : public std::enable_shared_from_this<Common::IGameBoard> {
      */
     virtual void addHex(std::shared_ptr<Common::Hex> newHex) = 0;
 
+    /**
+     * @brief reserveRadius tells the board how far from the center hexes will
+     * be added.
+     * @details Called by the game engine before the board is filled. Boards can
+     * use it to allocate their storage once. The default does nothing.
+     * @param radius The largest distance from (0,0,0) any added hex will have.
+     * @post Exception quarantee: basic
+     */
+    virtual void reserveRadius(int radius) { (void)radius; }
+
+    /**
+     * @brief setArena tells the board the arena of the game.
+     * @details Called by the game engine before the board is filled. Boards
+     * can allocate the pawns they create from it with GameArena::make, so
+     * that the pieces of a game are freed together. The default does
+     * nothing.
+     * @param arena The arena of the game.
+     * @post Exception quarantee: nothrow
+     */
+    virtual void setArena(std::shared_ptr<Common::GameArena> arena)
+    {
+        (void)arena;
+    }
+
+    /**
+     * @brief setUndoLog tells the board the undo log of the game.
+     * @details Called by the game engine before the board is filled. While
+     * the log has an open level, the hexes and pieces of the board save
+     * their state to it before they change, and the board saves the entries
+     * of its own tables. The default does nothing, the moves on such a board
+     * can't be taken back.
+     * @param log The undo log of the game.
+     * @post Exception quarantee: nothrow
+     */
+    virtual void setUndoLog(std::shared_ptr<Common::UndoLog> log)
+    {
+        (void)log;
+    }
+
+    /**
+     * @brief getUndoLog returns the undo log set with setUndoLog().
+     * @return The log, nullptr if the board doesn't keep one.
+     * @post Exception quarantee: nothrow
+     */
+    virtual Common::UndoLog* getUndoLog() const { return nullptr; }
+
+    /**
+     * @brief setGameLog tells the board the log the game is recorded into.
+     * @details Called by IGameRunner::setGameLog(). The board records the
+     * pawns it adds and the pawns, actors and transports it removes, and the
+     * actors record their actions. The default does nothing.
+     * @param log The log of the game, nullptr stops the recording.
+     * @post Exception quarantee: nothrow
+     */
+    virtual void setGameLog(std::shared_ptr<Common::GameLog> log)
+    {
+        (void)log;
+    }
+
+    /**
+     * @brief getGameLog returns the log set with setGameLog().
+     * @return The log, nullptr if the board doesn't record the game.
+     * @post Exception quarantee: nothrow
+     */
+    virtual Common::GameLog* getGameLog() const { return nullptr; }
+
     /**
      * @brief addTransport adds a new transport to the game board
      * @param transport transport to be added
@@ -2,12 +2,17 @@
 #define IGAMERUNNER_HH
 
 #include "cubecoordinate.hh"
+#include "gameaction.hh"
+#include "gamelog.hh"
+#include "gamesnapshot.hh"
 #include "igamestate.hh"
 #include "iplayer.hh"
 #include "pawn.hh"
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -20,6 +25,9 @@
 namespace Common {
 
 using SpinnerLayout = std::map<std::string, std::map<std::string,unsigned>>;
+
+//! Legal destinations of a move and the actions left after moving there.
+using MoveTargets = std::map<CubeCoordinate, int>;
 /**
  * @brief Offers an interface, which is used to control the game logic.
  */
@@ -129,6 +137,22 @@ public:
                                   Common::CubeCoordinate target,
                                   int pawnId) = 0;
 
+    /**
+     * @brief reachablePawnTargets tells every hex the pawn can move to.
+     * @details Gives the same answers as calling checkPawnMovement for each
+     * hex of the board, but searches the board only once. The origin itself
+     * is not included. The answer is cached until a hex of the board or a
+     * piece on it changes, or the current player or their actions left
+     * change.
+     * @param origin The coordinates of the hex the pawn is on.
+     * @param pawnId The identifier of the pawn.
+     * @return The legal targets and the number of moves left after moving
+     * to each, empty if the pawn can't move.
+     * @post Exception quarantee: strong
+     */
+    virtual MoveTargets reachablePawnTargets(Common::CubeCoordinate origin,
+                                             int pawnId) = 0;
+
     /**
      * @brief checkActorMovement tells if the move is possible.
      * @details Actor move is illegal, if one of the following holds:\n
@@ -167,6 +191,71 @@ public:
                                     Common::CubeCoordinate target,
                                     int transportId,
                                     std::string moves) = 0;
+    /**
+     * @brief legalActions lists every action the game runner accepts in the
+     * current game phase.
+     * @details MOVEMENT: the pawn moves of the current player and the
+     * transport moves, as checkPawnMovement and checkTransportMovement
+     * accept them with the player's actions left.\n
+     * SINKING: flipping each tile flipTile accepts.\n
+     * SPINNING: the actor and transport moves with the result of the last
+     * spinWheel, as checkActorMovement and checkTransportMovement accept
+     * them. Empty until the wheel has been spun and after the spun piece
+     * has moved.\n
+     * Moves to the hex the piece is already on are left out. The board is
+     * searched once per call and the actions are only valid until the next
+     * change to the game.
+     * @param actions The actions are appended here. Reusing the vector
+     * between calls avoids allocating.
+     * @return The number of actions appended.
+     * @post Exception quarantee: basic
+     */
+    virtual std::size_t legalActions(std::vector<GameAction>& actions) = 0;
+
+    /**
+     * @brief makeAction performs an action so that it can be taken back with
+     * unmakeAction(), without copying the board.
+     * @details Every change to the board, its pieces, the game phase, the
+     * actions of the current player and the random events is recorded until
+     * the matching unmakeAction(), also the changes made by others in
+     * between, such as Actor::doAction() of the actor a flip revealed. Calls
+     * nest, each unmakeAction() takes back the newest makeAction(). The
+     * board must keep the undo log the engine gives it, see
+     * IGameBoard::setUndoLog().
+     * @param action The action, MOVE_ACTOR and MOVE_TRANSPORT_WITH_SPINNER
+     * use the result of the last spinWheel.
+     * @exception IllegalMoveException if the action is illegal.
+     * @exception GameException if the board doesn't keep the undo log.
+     * @return What the function that performs the action returns for moves
+     * that return actions left, otherwise 0.
+     * @post Exception quarantee: strong
+     */
+    virtual int makeAction(const GameAction& action) = 0;
+
+    /**
+     * @brief unmakeAction takes back the newest makeAction() and everything
+     * changed after it.
+     * @details The cost depends on the number of changes, not on the size
+     * of the board. The memory of the pieces created by a taken back flip
+     * is reused by the next flips, so they must not be kept after it.
+     * @pre makeAction() has been called more times than unmakeAction(). The
+     * caller doesn't hold the pieces created after the matching
+     * makeAction().
+     * @post The game is as it was before the matching makeAction().
+     * Exception quarantee: basic
+     */
+    virtual void unmakeAction() = 0;
+
+    /**
+     * @brief snapshot captures the whole state of the game.
+     * @details Reads the board once, in time linear in the number of hexes.
+     * The snapshot can be handed to other threads and forked any number of
+     * times with Initialization::forkGameRunner().
+     * @return The state of the game, it doesn't change with the game.
+     * @post Exception quarantee: strong
+     */
+    virtual std::shared_ptr<const GameSnapshot> snapshot() const = 0;
+
     /**
      * @brief flipTile sinks the tile if possible and tells the actor on the bottom of the tile.
      * @param tileCoord Coordinate of the selected tile.
@@ -185,7 +274,9 @@ public:
      * the game phase is set to 3 (SPINNING). The types of actors and transports
      * returnable by spinwheel are configurable with Assets/layout.json .
      * By-default the possible types are: "dolphin", "kraken", "seamunster",
-     * "shark", here also referred to as animals.
+     * "shark", here also referred to as animals. The chance of each animal
+     * and number of movements is its weight in Assets/layout.json divided by
+     * the sum of all the weights.
      * @note HOX: Unlike kraken, seamunster and shark (Common::Actor),
      * dolphin is of class Common::Transport
      * @return a pair <type of the actor/vehicle, number of movements>
@@ -229,6 +320,29 @@ public:
      */
     virtual Common::GamePhase currentGamePhase() const = 0;
 
+    /**
+     * @brief getSeed tells the seed of the game's random events.
+     * @details A runner created by Initialization::getGameRunner with the
+     * same seed, board and players, and given the same calls, flips up the
+     * same actors and spins the same results, so a game can be replayed.
+     * @return The seed of the game.
+     * @post Exception quarantee: nothrow
+     */
+    virtual unsigned int getSeed() const = 0;
+
+    /**
+     * @brief setGameLog starts recording the game into a log.
+     * @details From now on every move, flip and spin that succeeds, and
+     * every pawn, actor and transport the board adds or removes, is
+     * appended to the log, see GameLog. Writes a GAME_STARTED record first if
+     * the log is empty. Moves taken back with unmakeAction() are dropped
+     * from the log. The log is also given to the board with
+     * IGameBoard::setGameLog().
+     * @param log The log, nullptr stops the recording.
+     * @post Exception quarantee: strong
+     */
+    virtual void setGameLog(std::shared_ptr<GameLog> log) = 0;
+
 
 
 };
@@ -0,0 +1,37 @@
+#ifndef IHEXLISTENER_HH
+#define IHEXLISTENER_HH
+
+/**
+ * @file
+ * @brief Defines an interface for following the contents of hexes.
+ */
+
+namespace Common {
+
+class Hex;
+
+/**
+ * @brief Interface for objects that keep their own view of the contents of
+ * hexes, such as boards with flat copies of the hex data.
+ */
+class IHexListener
+{
+public:
+    /**
+     * @brief Default virtual destructor.
+     */
+    virtual ~IHexListener() = default;
+
+    /**
+     * @brief hexChanged is called after the piece type or the pawns, actors
+     * or transports of a hex have changed, or a pawn has boarded or left a
+     * transport on the hex.
+     * @param hex The changed hex.
+     * @post Exception quarantee: nothrow
+     */
+    virtual void hexChanged(const Hex& hex) = 0;
+};
+
+}
+
+#endif // IHEXLISTENER_HH
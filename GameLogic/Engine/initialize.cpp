@@ -9,53 +9,93 @@
 #include "seamunster.hh"
 #include "vortex.hh"
 
+#include <mutex>
+#include <random>
+
 namespace Common {
 namespace Initialization {
 
-std::shared_ptr<IGameRunner> getGameRunner(std::shared_ptr<IGameBoard> boardPtr,
-                                           std::shared_ptr<IGameState> statePtr,
-                                           std::vector<std::shared_ptr<IPlayer>> playerVector)
-{
+namespace {
 
+void registerBuiltinTypes()
+{
     auto& actorFactory = Logic::ActorFactory::getInstance();
     actorFactory.addActor("shark",
-                          [=] (int id) -> std::shared_ptr<Actor>
+                          [=] (int id, const std::shared_ptr<GameArena>& arena)
+                          -> std::shared_ptr<Actor>
     {
-        return std::make_shared<Shark>(id);
+        return GameArena::make<Shark>(arena, id);
     });
     actorFactory.addActor("kraken",
-                          [=] (int id) -> std::shared_ptr<Actor>
+                          [=] (int id, const std::shared_ptr<GameArena>& arena)
+                          -> std::shared_ptr<Actor>
     {
-        return std::make_shared<Kraken>(id);
+        return GameArena::make<Kraken>(arena, id);
     });
     actorFactory.addActor("seamunster",
-                          [=] (int id) -> std::shared_ptr<Actor>
+                          [=] (int id, const std::shared_ptr<GameArena>& arena)
+                          -> std::shared_ptr<Actor>
     {
-        return std::make_shared<Seamunster>(id);
+        return GameArena::make<Seamunster>(arena, id);
     });
     actorFactory.addActor("vortex",
-                          [=] (int id) -> std::shared_ptr<Actor>
+                          [=] (int id, const std::shared_ptr<GameArena>& arena)
+                          -> std::shared_ptr<Actor>
     {
-        return std::make_shared<Vortex>(id);
+        return GameArena::make<Vortex>(arena, id);
     });
 
     auto& transportFactory = Logic::TransportFactory::getInstance();
     transportFactory.addTransport("boat",
-                                  [=] (int id) -> std::shared_ptr<Transport>
+                                  [=] (int id, const std::shared_ptr<GameArena>& arena)
+                                  -> std::shared_ptr<Transport>
     {
-        return std::make_shared<Boat>(id);
+        return GameArena::make<Boat>(arena, id);
     });
     transportFactory.addTransport("dolphin",
-                                  [=] (int id) -> std::shared_ptr<Transport>
+                                  [=] (int id, const std::shared_ptr<GameArena>& arena)
+                                  -> std::shared_ptr<Transport>
     {
-        return std::make_shared<Dolphin>(id);
+        return GameArena::make<Dolphin>(arena, id);
     });
+}
+
+}
+
+std::shared_ptr<IGameRunner> getGameRunner(std::shared_ptr<IGameBoard> boardPtr,
+                                           std::shared_ptr<IGameState> statePtr,
+                                           std::vector<std::shared_ptr<IPlayer>> playerVector)
+{
+    return getGameRunner(boardPtr, statePtr, playerVector,
+                         std::random_device()());
+}
+
+std::shared_ptr<IGameRunner> getGameRunner(std::shared_ptr<IGameBoard> boardPtr,
+                                           std::shared_ptr<IGameState> statePtr,
+                                           std::vector<std::shared_ptr<IPlayer>> playerVector,
+                                           unsigned int seed)
+{
+    // The built in types are the same for every game, registering them
+    // again would take the locks of both factories on every new game
+    static std::once_flag builtinsRegistered;
+    std::call_once(builtinsRegistered, registerBuiltinTypes);
 
     std::shared_ptr <Logic::GameEngine> runner =
-            std::make_shared<Logic::GameEngine>(boardPtr, statePtr, playerVector);
+            std::make_shared<Logic::GameEngine>(boardPtr, statePtr, playerVector,
+                                                seed);
     return runner;
 
 }
+std::shared_ptr<IGameRunner> forkGameRunner(std::shared_ptr<IGameBoard> boardPtr,
+                                            std::shared_ptr<IGameState> statePtr,
+                                            std::vector<std::shared_ptr<IPlayer>> playerVector,
+                                            std::shared_ptr<const GameSnapshot> snapshot)
+{
+    // The types were registered when the game of the snapshot was created
+    return std::make_shared<Logic::GameEngine>(boardPtr, statePtr,
+                                               playerVector, snapshot);
+}
+
 void addNewActorType(std::string typeName, Logic::ActorBuildFunction buildFunction)
 {
     Logic::ActorFactory::getInstance().addActor(typeName, buildFunction);
@@ -66,6 +106,16 @@ void addNewTransportType(std::string typeName, Logic::TransportBuildFunction bui
     Logic::TransportFactory::getInstance().addTransport(typeName, buildFunction);
 }
 
+void addNewActorType(std::string typeName, Logic::ActorArenaBuildFunction buildFunction)
+{
+    Logic::ActorFactory::getInstance().addActor(typeName, buildFunction);
+}
+
+void addNewTransportType(std::string typeName, Logic::TransportArenaBuildFunction buildFunction)
+{
+    Logic::TransportFactory::getInstance().addTransport(typeName, buildFunction);
+}
+
 
 }
 }
@@ -40,6 +40,52 @@ std::shared_ptr<IGameRunner> getGameRunner(std::shared_ptr<IGameBoard> boardPtr,
                                            std::shared_ptr<IGameState> statePtr,
                                            std::vector<std::shared_ptr<IPlayer>> playerVector);
 
+/**
+ * @brief getGameRunner Creates an instance of the class that implements
+ * IGameRunner interface, with the random events drawn from the given seed.
+ * @details The same seed and the same calls to the runner play out the same
+ * game. Runners created by different threads don't share any state.
+ * @param boardPtr Shared pointer to the game board.
+ * @param statePtr Shared pointer to the game state.
+ * @param playerVector Vector that contains players.
+ * @param seed Seed of the random events of the game.
+ * @exception IOException Could not open file Assets/actors.json or Assets/pieces.json for reading.
+ * @exception FormatException Format of file Assets/actors.json or Assets/pieces.json is invalid.
+ * @return Created instance of IGameRunner.
+ * @note HOX! Custom actors and transports MUST be added before calling getGameRunner!
+ * The built in actors and transports are registered by the first call, and
+ * replace custom types of the same names added before it.
+ * @post GameBoard added
+ */
+std::shared_ptr<IGameRunner> getGameRunner(std::shared_ptr<IGameBoard> boardPtr,
+                                           std::shared_ptr<IGameState> statePtr,
+                                           std::vector<std::shared_ptr<IPlayer>> playerVector,
+                                           unsigned int seed);
+
+/**
+ * @brief forkGameRunner Creates an instance of the class that implements
+ * IGameRunner interface, continuing the game of a snapshot.
+ * @details The fork has its own board, pieces and random events, and plays
+ * out like the game of the snapshot would have from the moment it was
+ * taken. No files are read and the island is not laid out again, so a fork
+ * is about as cheap as copying the pieces. Forks of the same snapshot can
+ * be created and run concurrently from different threads.
+ * @param boardPtr Shared pointer to an empty game board.
+ * @param statePtr Shared pointer to the game state, set to the phase and the
+ * player in turn of the snapshot.
+ * @param playerVector Vector that contains players with the ids of the
+ * snapshot, their actions left are set.
+ * @param snapshot The game to continue, see IGameRunner::snapshot().
+ * @exception GameException The snapshot is of another island.
+ * @return Created instance of IGameRunner.
+ * @pre The snapshot was taken from a game of this program.
+ * @post GameBoard added
+ */
+std::shared_ptr<IGameRunner> forkGameRunner(std::shared_ptr<IGameBoard> boardPtr,
+                                            std::shared_ptr<IGameState> statePtr,
+                                            std::vector<std::shared_ptr<IPlayer>> playerVector,
+                                            std::shared_ptr<const GameSnapshot> snapshot);
+
 /**
  * @brief addNewActorType registers a new actor type to game
  * @param typeName Name of the new actor type
@@ -64,6 +110,26 @@ void addNewActorType(std::string typeName, Logic::ActorBuildFunction buildFuncti
  */
 void addNewTransportType(std::string typeName, Logic::TransportBuildFunction buildFunction);
 
+/**
+ * @brief addNewActorType registers a new actor type whose objects are
+ * allocated from the arena of the game
+ * @param typeName Name of the new actor type
+ * @param buildFunction Function that creates the actor with
+ * Common::GameArena::make from the given id and arena.
+ * @post The game can now use actors of the registered type
+ */
+void addNewActorType(std::string typeName, Logic::ActorArenaBuildFunction buildFunction);
+
+/**
+ * @brief addNewTransportType registers a new transport type whose objects are
+ * allocated from the arena of the game
+ * @param typeName Name of the new transport type
+ * @param buildFunction Function that creates the transport with
+ * Common::GameArena::make from the given id and arena.
+ * @post The game can now use transports of the registered type
+ */
+void addNewTransportType(std::string typeName, Logic::TransportArenaBuildFunction buildFunction);
+
 
 }
 }
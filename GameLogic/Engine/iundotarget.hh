@@ -0,0 +1,39 @@
+#ifndef IUNDOTARGET_HH
+#define IUNDOTARGET_HH
+
+#include <memory>
+
+/**
+ * @file
+ * @brief Defines an interface for objects whose tables are restored by an
+ * undo log.
+ */
+
+namespace Common {
+
+/**
+ * @brief Interface for objects that save the entries of their own tables in
+ * an UndoLog, such as boards with maps of pieces by id.
+ */
+class IUndoTarget
+{
+public:
+    /**
+     * @brief Default virtual destructor.
+     */
+    virtual ~IUndoTarget() = default;
+
+    /**
+     * @brief restoreEntry puts back an entry saved with UndoLog::saveEntry().
+     * @param table Table of the entry, defined by the target.
+     * @param key Key of the entry in the table.
+     * @param value The value the entry had, nullptr if there was no entry.
+     * @post Exception quarantee: basic
+     */
+    virtual void restoreEntry(int table, int key,
+                              const std::shared_ptr<void>& value) = 0;
+};
+
+}
+
+#endif // IUNDOTARGET_HH
@@ -9,7 +9,8 @@ Kraken::Kraken(int typeId):Actor(typeId)
 
 void Kraken::doAction()
 {
-    hex_->clearTransports();
+    recordAction();
+    getHex()->clearTransports();
 }
 
 std::string Kraken::getActorType() const
@@ -17,4 +18,9 @@ std::string Kraken::getActorType() const
     return "kraken";
 }
 
+TypeId Kraken::getActorTypeId() const
+{
+    return KRAKEN_TYPE;
+}
+
 }
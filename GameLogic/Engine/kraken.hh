@@ -31,6 +31,11 @@ public:
      */
     virtual std::string getActorType() const;
 
+    /**
+     * @copydoc Common::Actor::getActorTypeId()
+     */
+    virtual Common::TypeId getActorTypeId() const;
+
 };
 }
 #endif // KRAKEN_HH
@@ -0,0 +1,139 @@
+#ifndef PACKEDCOORDINATE_HH
+#define PACKEDCOORDINATE_HH
+
+#include "cubecoordinate.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @file
+ * @brief Cube coordinate packed into a single 64 bit word, for hashing.
+ */
+
+namespace Common {
+
+/**
+ * @brief Cube coordinate that stores x and z in one 64 bit word and derives
+ * y = -x - z.
+ * @details Comparing two coordinates is a single integer compare, and the
+ * word hashes well, so the coordinate can key unordered containers. Only
+ * valid cube coordinates, where x + y + z == 0, can be packed: y is not
+ * stored, so coordinates that only differ in y pack to the same value.
+ * The order of operator< is the order of the packed words, not the order
+ * of CubeCoordinate.
+ */
+class PackedCoordinate {
+
+  public:
+
+    /**
+     * @brief Default constructor, creates (0,0,0).
+     */
+    constexpr PackedCoordinate(): bits_(0) {}
+
+    /**
+     * @brief Constructor.
+     * @param x X-coordinate.
+     * @param z Z-coordinate, y is -x - z.
+     */
+    constexpr PackedCoordinate(int x, int z): bits_(pack(x, z)) {}
+
+    /**
+     * @brief Constructor, packs a cube coordinate. Explicit, so that an
+     * invalid coordinate can't silently find the hex of a valid one.
+     * @param coord The coordinate.
+     * @pre coord.x + coord.y + coord.z == 0
+     */
+    explicit PackedCoordinate(const CubeCoordinate& coord):
+        bits_(pack(coord.x, coord.z))
+    {}
+
+    constexpr int x() const { return unpack(bits_ >> 32); }
+    constexpr int y() const { return -x() - z(); }
+    constexpr int z() const { return unpack(bits_); }
+
+    /**
+     * @brief toCube unpacks the coordinate.
+     * @return The coordinate with all three components.
+     */
+    CubeCoordinate toCube() const { return CubeCoordinate(x(), y(), z()); }
+
+    /**
+     * @brief bits returns the packed word.
+     * @return x in the high 32 bits, z in the low 32 bits.
+     */
+    constexpr std::uint64_t bits() const { return bits_; }
+
+    /**
+     * @brief hash mixes the packed word so that neighbouring coordinates get
+     * unrelated hashes.
+     * @return The hash, the finalizer of MurmurHash3 applied to bits().
+     */
+    constexpr std::uint64_t hash() const
+    {
+        std::uint64_t h = bits_;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    constexpr bool operator==(const PackedCoordinate& other) const
+    {
+        return bits_ == other.bits_;
+    }
+
+    constexpr bool operator!=(const PackedCoordinate& other) const
+    {
+        return bits_ != other.bits_;
+    }
+
+    constexpr bool operator<(const PackedCoordinate& other) const
+    {
+        return bits_ < other.bits_;
+    }
+
+  private:
+
+    static constexpr std::uint64_t pack(int x, int z)
+    {
+        return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(z);
+    }
+
+    static constexpr int unpack(std::uint64_t half)
+    {
+        // Sign extends the low 32 bits without implementation defined
+        // conversions
+        return int(std::int64_t(half & 0xffffffffULL) -
+                   (half & 0x80000000ULL ? std::int64_t(1) << 32 : 0));
+    }
+
+    std::uint64_t bits_;
+};
+
+static_assert(sizeof(PackedCoordinate) == sizeof(std::uint64_t),
+              "A packed coordinate is a single word");
+
+}
+
+namespace std {
+
+/**
+ * @brief Hash of packed coordinates for unordered containers.
+ */
+template <>
+struct hash<Common::PackedCoordinate>
+{
+    std::size_t operator()(const Common::PackedCoordinate& coord) const
+    {
+        return static_cast<std::size_t>(coord.hash());
+    }
+};
+
+}
+
+#endif // PACKEDCOORDINATE_HH
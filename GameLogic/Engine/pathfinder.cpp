@@ -0,0 +1,236 @@
+#include "pathfinder.hh"
+#include "hex.hh"
+#include "rules.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace Logic {
+
+PathFinder::PathFinder(int radius)
+{
+    reserveRadius(radius);
+}
+
+void PathFinder::reserveRadius(int radius)
+{
+    if (radius <= index_.radius() && !queue_.empty()) {
+        return;
+    }
+    topology_ = Common::BoardTopology::forRadius(radius);
+    index_ = topology_->getIndex();
+    visited_.assign((index_.slotCount() + 63) / 64, 0);
+    queue_.resize(index_.slotCount());
+    depth_.resize(index_.slotCount());
+}
+
+bool PathFinder::isReachable(const Common::IGameBoard& board,
+                             Common::CubeCoordinate from,
+                             Common::CubeCoordinate to,
+                             unsigned int maxSteps)
+{
+    if (from == to) {
+        return true;
+    }
+    if (maxSteps == 0 || !isPassable(board.findHex(from), true)) {
+        return false;
+    }
+
+    const Common::BoardBitboards* bits = board.getBitboards();
+    if (bits != nullptr) {
+        const Common::BoardIndex& bitIndex = bits->hexes.getIndex();
+        int toSlot = bitIndex.slotOf(to);
+        return toSlot >= 0 && bits->hexes.test(toSlot) &&
+                flood(*bits, bitIndex.slotOf(from), maxSteps, toSlot,
+                      nullptr);
+    }
+
+    // Every hex a route can touch is within maxSteps of the origin
+    int neededRadius = Common::BoardIndex::distanceFromCenter(from) +
+            static_cast<int>(maxSteps);
+    if (neededRadius > index_.radius()) {
+        reserveRadius(neededRadius);
+    }
+
+    int head = 0;
+    int tail = 0;
+    bool found = false;
+
+    int fromSlot = index_.slotOf(from);
+    markVisited(fromSlot);
+    queue_[tail] = fromSlot;
+    depth_[tail] = 0;
+    ++tail;
+
+    while (head < tail && !found) {
+        Common::CubeCoordinate current = index_.coordinateOf(queue_[head]);
+        const int* neighbourSlots =
+                topology_->neighbourSlots(queue_[head]).data();
+        unsigned int nextDepth = depth_[head] + 1;
+        ++head;
+
+        for (int i = 0; i < Common::HEX_NEIGHBOURS; ++i) {
+            Common::CubeCoordinate neighbour(
+                        current.x + Common::NEIGHBOUR_OFFSETS[i].x,
+                        current.y + Common::NEIGHBOUR_OFFSETS[i].y,
+                        current.z + Common::NEIGHBOUR_OFFSETS[i].z);
+
+            if (neighbour == to) {
+                found = board.findHex(to) != nullptr;
+                break;
+            }
+
+            // Hexes on the last step can't be walked through
+            if (nextDepth >= maxSteps) {
+                continue;
+            }
+
+            int slot = neighbourSlots[i];
+            if (isPassable(board.findHex(neighbour), false) &&
+                    markVisited(slot)) {
+                queue_[tail] = slot;
+                depth_[tail] = nextDepth;
+                ++tail;
+            }
+        }
+    }
+
+    clearVisited(tail);
+    return found;
+}
+
+void PathFinder::reachableFrom(const Common::IGameBoard& board,
+                               Common::CubeCoordinate from,
+                               unsigned int maxSteps,
+                               std::vector<Common::CubeCoordinate>& reached)
+{
+    if (maxSteps == 0 || !isPassable(board.findHex(from), true)) {
+        return;
+    }
+
+    const Common::BoardBitboards* bits = board.getBitboards();
+    if (bits != nullptr) {
+        flood(*bits, bits->hexes.getIndex().slotOf(from), maxSteps, -1,
+              &reached);
+        return;
+    }
+
+    int neededRadius = Common::BoardIndex::distanceFromCenter(from) +
+            static_cast<int>(maxSteps);
+    if (neededRadius > index_.radius()) {
+        reserveRadius(neededRadius);
+    }
+
+    std::size_t firstReached = reached.size();
+    int head = 0;
+    int tail = 0;
+
+    int fromSlot = index_.slotOf(from);
+    markVisited(fromSlot);
+    queue_[tail] = fromSlot;
+    depth_[tail] = 0;
+    ++tail;
+
+    // A hex is marked the first time it is seen, which is also the shortest
+    // route to it, so whether it can be walked through is decided right away
+    while (head < tail) {
+        Common::CubeCoordinate current = index_.coordinateOf(queue_[head]);
+        const int* neighbourSlots =
+                topology_->neighbourSlots(queue_[head]).data();
+        unsigned int nextDepth = depth_[head] + 1;
+        ++head;
+
+        for (int i = 0; i < Common::HEX_NEIGHBOURS; ++i) {
+            Common::CubeCoordinate neighbour(
+                        current.x + Common::NEIGHBOUR_OFFSETS[i].x,
+                        current.y + Common::NEIGHBOUR_OFFSETS[i].y,
+                        current.z + Common::NEIGHBOUR_OFFSETS[i].z);
+
+            int slot = neighbourSlots[i];
+            const Common::Hex* hex = board.findHex(neighbour);
+            if (hex == nullptr || !markVisited(slot)) {
+                continue;
+            }
+            reached.push_back(neighbour);
+
+            if (nextDepth < maxSteps && isPassable(hex, false)) {
+                queue_[tail] = slot;
+                depth_[tail] = nextDepth;
+                ++tail;
+            }
+        }
+    }
+
+    // Targets that were not queued have their bit set too
+    visited_[fromSlot / 64] = 0;
+    for (std::size_t i = firstReached; i < reached.size(); ++i) {
+        visited_[index_.slotOf(reached[i]) / 64] = 0;
+    }
+}
+
+bool PathFinder::flood(const Common::BoardBitboards& bits, int fromSlot,
+                       unsigned int maxSteps, int toSlot,
+                       std::vector<Common::CubeCoordinate>* reached)
+{
+    if (frontier_.radius() != bits.hexes.radius()) {
+        frontier_.resize(bits.hexes.radius());
+        layer_.resize(bits.hexes.radius());
+        floodReached_.resize(bits.hexes.radius());
+    }
+
+    frontier_.clear();
+    floodReached_.clear();
+    frontier_.set(fromSlot);
+    floodReached_.set(fromSlot);
+
+    // Every hex reached on a step is a target, the walkable ones are passed
+    // through on the next step
+    for (unsigned int step = 1; step <= maxSteps; ++step) {
+        if (!Common::HexBitboard::spread(frontier_, bits.hexes,
+                                         floodReached_, layer_)) {
+            break;
+        }
+        if (toSlot >= 0) {
+            if (layer_.test(toSlot)) {
+                return true;
+            }
+        } else {
+            layer_.appendCoordinates(*reached);
+        }
+        if (step == maxSteps) {
+            break;
+        }
+        std::swap(frontier_, layer_);
+        frontier_ &= bits.walkable;
+    }
+    return false;
+}
+
+bool PathFinder::isPassable(const Common::Hex* hex, bool isOrigin)
+{
+    if (hex == nullptr || hex->isWaterTile()) {
+        return false;
+    }
+    return isOrigin || hex->getPawnAmount() < MAX_PAWNS_PER_HEX;
+}
+
+bool PathFinder::markVisited(int slot)
+{
+    std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+    std::uint64_t& word = visited_[slot / 64];
+    if (word & bit) {
+        return false;
+    }
+    word |= bit;
+    return true;
+}
+
+void PathFinder::clearVisited(int visitedCount)
+{
+    // Only the queued slots have their bit set
+    for (int i = 0; i < visitedCount; ++i) {
+        visited_[queue_[i] / 64] = 0;
+    }
+}
+
+}
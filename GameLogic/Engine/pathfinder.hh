@@ -0,0 +1,123 @@
+#ifndef PATHFINDER_HH
+#define PATHFINDER_HH
+
+#include "boardindex.hh"
+#include "boardtopology.hh"
+#include "cubecoordinate.hh"
+#include "hexbitboard.hh"
+#include "igameboard.hh"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Breadth first search over the land hexes of a game board.
+ */
+
+namespace Logic {
+
+/**
+ * @brief Finds routes for pawns walking on land.
+ * @details Searches are bounded by the number of steps the pawn may take, so
+ * the cost depends on the number of actions, not on the size of the board.
+ * The frontier, visited set and depths are kept in buffers indexed by the
+ * slots of a Common::BoardIndex and reused between searches; a search does
+ * not allocate once the buffers cover the board. The neighbour slots are
+ * read from the shared Common::BoardTopology of the radius.
+ *
+ * On boards that keep Common::BoardBitboards the search floods the
+ * bitboards instead, one step of every route at a time, without visiting
+ * the hexes.
+ */
+class PathFinder
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param radius Radius of the board the buffers are sized for.
+     */
+    explicit PathFinder(int radius = 0);
+
+    /**
+     * @brief reserveRadius sizes the buffers for a board of the given radius.
+     * @param radius Radius of the board.
+     * @post Exception quarantee: basic
+     */
+    void reserveRadius(int radius);
+
+    /**
+     * @brief isReachable tells if a pawn can walk from one hex to another.
+     * @details The route may only pass through existing land hexes that are
+     * not full. The origin may be full, but it has to be land. The target
+     * itself is not checked, it only has to exist.
+     * @param board The board to search.
+     * @param from The coordinates of the origin.
+     * @param to The coordinates of the target.
+     * @param maxSteps The largest number of steps the route may take.
+     * @return true, if a route of at most maxSteps steps exists, else false.
+     * @post Exception quarantee: basic
+     */
+    bool isReachable(const Common::IGameBoard& board,
+                     Common::CubeCoordinate from,
+                     Common::CubeCoordinate to,
+                     unsigned int maxSteps);
+
+    /**
+     * @brief reachableFrom finds every hex a pawn can walk to from a hex.
+     * @details Uses the same rules as isReachable, but visits every target
+     * in one search.
+     * @param board The board to search.
+     * @param from The coordinates of the origin.
+     * @param maxSteps The largest number of steps a route may take.
+     * @param reached The coordinates of the reachable hexes, origin excluded,
+     * are appended here in the order of their distance from the origin.
+     * Hexes at the same distance may come in any order.
+     * @post Exception quarantee: basic
+     */
+    void reachableFrom(const Common::IGameBoard& board,
+                       Common::CubeCoordinate from,
+                       unsigned int maxSteps,
+                       std::vector<Common::CubeCoordinate>& reached);
+
+private:
+    static bool isPassable(const Common::Hex* hex, bool isOrigin);
+
+    // Floods the bitboards from the origin. Stops at the target slot if it
+    // is given, otherwise appends the coordinates of every reached hex.
+    bool flood(const Common::BoardBitboards& bits, int fromSlot,
+               unsigned int maxSteps, int toSlot,
+               std::vector<Common::CubeCoordinate>* reached);
+
+    bool markVisited(int slot);
+    void clearVisited(int visitedCount);
+
+    //! Maps coordinates to the slots of the buffers.
+    Common::BoardIndex index_;
+
+    //! Neighbour slots of the slots of index_.
+    std::shared_ptr<const Common::BoardTopology> topology_;
+
+    //! One bit per slot, set when the slot has been queued.
+    std::vector<std::uint64_t> visited_;
+
+    //! Slots in the order they were queued. A slot is queued at most once,
+    //! so the queue never holds more than slotCount entries.
+    std::vector<int> queue_;
+
+    //! Steps from the origin, indexed like queue_.
+    std::vector<unsigned int> depth_;
+
+    //! Hexes a flood passes through on its next step.
+    Common::HexBitboard frontier_;
+
+    //! Hexes a flood reached on its last step.
+    Common::HexBitboard layer_;
+
+    //! Hexes a flood has reached.
+    Common::HexBitboard floodReached_;
+};
+
+}
+
+#endif // PATHFINDER_HH
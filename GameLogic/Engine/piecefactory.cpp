@@ -2,15 +2,32 @@
 #include "formatexception.hh"
 #include "piecefactory.hh"
 
-#include <QFile>
-#include <QJsonArray>
-#include <QJsonDocument>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QString>
+
+#include <utility>
 
 namespace Logic {
 
 QString const PIECEDATA = ("Assets/pieces.json");
+QString const LAYOUTDATA = ("Assets/layout.json");
+
+namespace {
+
+qint64 modificationTime(const QString& path)
+{
+    return QFileInfo(path).lastModified().toMSecsSinceEpoch();
+}
+
+}
 
-PieceFactory::PieceFactory() {}
+PieceFactory::PieceFactory():
+    hotReload_(false),
+    piecesModified_(0),
+    layoutModified_(0)
+{
+}
 
 PieceFactory& PieceFactory::getInstance()
 {
@@ -22,34 +39,57 @@ PieceFactory& PieceFactory::getInstance()
 
 void PieceFactory::readJSON()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load();
+}
 
-    QFile file (PIECEDATA);
-
-    if (!file.open(QFile::ReadOnly))
-    {
-        throw Common::IoException("Could not read file");
-    }
-
-    QJsonDocument json = QJsonDocument::fromJson(file.readAll());
-    if (json.isNull()) {
-        throw Common::FormatException("JSON parsing failed for input file");
+std::shared_ptr<const BoardRecipe> PieceFactory::getRecipe()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recipe_ == nullptr || (hotReload_ && filesChanged())) {
+        load();
     }
+    return recipe_;
+}
 
-    json_ = json.object();
+void PieceFactory::setRecipe(std::shared_ptr<const BoardRecipe> recipe)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recipe_ = std::move(recipe);
+}
 
+void PieceFactory::setHotReload(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    hotReload_ = enabled;
 }
 
 std::vector<std::pair<std::string,int>> PieceFactory::getGamePieces() const
 {
-
-    std::vector<std::pair<std::string,int>> gamePieces;
-    QJsonArray common = json_["Common"].toArray();
-    for (int i = 0; i < common.size(); ++i) {
-        auto piecesData = std::make_pair(common[i].toObject().value("name").toString().toStdString(),common[i].toObject().value("layers").toInt());
-        gamePieces.push_back(piecesData);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recipe_ == nullptr) {
+        return {};
     }
-    return gamePieces;
+    return recipe_->getPieces();
+}
+
+void PieceFactory::load()
+{
+    // Times are taken first, so a change made during the read is seen on
+    // the next check
+    qint64 piecesModified = modificationTime(PIECEDATA);
+    qint64 layoutModified = modificationTime(LAYOUTDATA);
+
+    recipe_ = BoardRecipe::readJSON(PIECEDATA.toStdString(),
+                                    LAYOUTDATA.toStdString());
+    piecesModified_ = piecesModified;
+    layoutModified_ = layoutModified;
+}
 
+bool PieceFactory::filesChanged() const
+{
+    return modificationTime(PIECEDATA) != piecesModified_ ||
+            modificationTime(LAYOUTDATA) != layoutModified_;
 }
 
 }
@@ -1,7 +1,11 @@
 #ifndef PIECEFACTORY_HH
 #define PIECEFACTORY_HH
 
-#include <QJsonObject>
+#include "boardrecipe.hh"
+
+#include <QtGlobal>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -15,8 +19,9 @@ namespace Logic {
 /**
  * @brief Singleton class for creating pieces.
  *
- * The factory is requested to read JSON file, after which it will requested to
- * return a data structure, which containts the read pieces.
+ * The factory reads the configuration files once and hands out the parsed
+ * BoardRecipe to every game, so starting a game does not touch the files.
+ * All the methods can be called from several threads.
  */
 class PieceFactory {
 
@@ -28,13 +33,45 @@ class PieceFactory {
     static PieceFactory& getInstance();
 
     /**
-     * @brief readJSON reads pieces a JSON file.
-     * @exception IOException Could not open the file Assets/pieces.json for reading.
-     * @exception FormatException Format of the file Assets/pieces.json is invalid.
-     * @post Exception quarantee: basic
+     * @brief readJSON reads Assets/pieces.json and Assets/layout.json again,
+     * replacing the recipe given to the games created after this.
+     * @exception IOException Could not open a file for reading.
+     * @exception FormatException Format of a file is invalid.
+     * @post Exception quarantee: strong
      */
     void readJSON();
 
+    /**
+     * @brief getRecipe gives the recipe the games are built from.
+     * @details The files are read on the first call. After that the same
+     * recipe is returned, unless hot reload is on and a file has changed.
+     * @exception IOException Could not open a file for reading.
+     * @exception FormatException Format of a file is invalid.
+     * @return The shared recipe.
+     * @post Exception quarantee: strong
+     */
+    std::shared_ptr<const BoardRecipe> getRecipe();
+
+    /**
+     * @brief setRecipe replaces the recipe given to the games created after
+     * this, for games on another island than the one of the files.
+     * @details The recipe is kept until readJSON is called or hot reload
+     * sees a file change.
+     * @param recipe The recipe, nullptr to read the files on the next
+     * getRecipe.
+     * @post Exception quarantee: nothrow
+     */
+    void setRecipe(std::shared_ptr<const BoardRecipe> recipe);
+
+    /**
+     * @brief setHotReload tells if getRecipe checks the files for changes.
+     * @details Checking costs a file system query per game, so it is off by
+     * default. Games already running keep the recipe they started with.
+     * @param enabled true to reread the files once they have changed.
+     * @post Exception quarantee: nothrow
+     */
+    void setHotReload(bool enabled);
+
     /**
      * @brief Gets the pieces used in the game
      * @return The pieces read from the JSON file. If the file is not read, or the actors did not exist, will return an empty vector.
@@ -46,7 +83,18 @@ class PieceFactory {
 
     PieceFactory();
 
-    QJsonObject json_;
+    void load();
+    bool filesChanged() const;
+
+    //! Guards everything below.
+    mutable std::mutex mutex_;
+
+    std::shared_ptr<const BoardRecipe> recipe_;
+    bool hotReload_;
+
+    //! Modification times of the files when the recipe was read.
+    qint64 piecesModified_;
+    qint64 layoutModified_;
 
 };
 
@@ -0,0 +1,746 @@
+#include "replay.hh"
+
+#include "formatexception.hh"
+#include "ioexception.hh"
+#include "varint.hh"
+
+#include <QFile>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+
+namespace Common {
+
+/**
+ * @brief The state of a turn with the pieces by id, so that two turns can be
+ * compared piece by piece.
+ */
+struct ReplayState
+{
+    struct Piece
+    {
+        TypeId type;
+        int owner;
+        int hex;
+        std::vector<int> passengers;
+
+        bool operator==(const Piece& other) const
+        {
+            return type == other.type && owner == other.owner &&
+                    hex == other.hex && passengers == other.passengers;
+        }
+    };
+
+    using Pieces = std::map<int, Piece>;
+
+    std::vector<TypeId> terrain;
+    Pieces pawns;
+    Pieces actors;
+    Pieces transports;
+
+    std::vector<GameSnapshot::Player> players;
+    GamePhase phase;
+    int currentPlayer;
+    std::vector<std::pair<TypeId, int>> islandPieces;
+    bool spun;
+    TypeId spinType;
+    std::string spinMoves;
+    unsigned int seed;
+    std::uint64_t rngState;
+    int lastActorId;
+    int lastTransportId;
+
+    explicit ReplayState(const GameSnapshot& snapshot);
+    ReplayState();
+
+    std::shared_ptr<GameSnapshot> toSnapshot(
+            std::shared_ptr<const std::vector<CubeCoordinate>> coordinates)
+            const;
+};
+
+namespace {
+
+enum FrameKind : std::uint8_t { KEYFRAME = 1, CHANGES = 2 };
+
+const std::size_t HEADER_SIZE = sizeof(ReplayWriter::REPLAY_MAGIC) + 1;
+
+// Offset of the index as 8 bytes, little endian, and REPLAY_MAGIC
+const std::size_t TRAILER_SIZE = 8 + sizeof(ReplayWriter::REPLAY_MAGIC);
+
+void readPieces(const GameSnapshot& snapshot,
+                const std::vector<GameSnapshot::Piece>& pieces,
+                ReplayState::Pieces& into)
+{
+    for (const auto& piece : pieces) {
+        ReplayState::Piece& state = into[piece.id];
+        state.type = piece.type;
+        state.owner = piece.owner;
+        state.hex = piece.hex;
+        state.passengers.assign(
+                    snapshot.passengers.begin() + piece.firstPassenger,
+                    snapshot.passengers.begin() + piece.firstPassenger +
+                    piece.passengerCount);
+    }
+}
+
+void writePieces(const ReplayState::Pieces& pieces,
+                 std::vector<GameSnapshot::Piece>& into,
+                 std::vector<int>& passengers)
+{
+    into.reserve(pieces.size());
+    for (const auto& piece : pieces) {
+        into.push_back(GameSnapshot::Piece{
+                           piece.first, piece.second.type, piece.second.owner,
+                           piece.second.hex, 0, 0});
+    }
+    // Snapshots have the pieces by hex, then by id
+    std::sort(into.begin(), into.end(),
+              [](const GameSnapshot::Piece& a, const GameSnapshot::Piece& b)
+    {
+        return std::tie(a.hex, a.id) < std::tie(b.hex, b.id);
+    });
+    for (auto& piece : into) {
+        const auto& riding = pieces.at(piece.id).passengers;
+        piece.firstPassenger = static_cast<int>(passengers.size());
+        piece.passengerCount = static_cast<int>(riding.size());
+        passengers.insert(passengers.end(), riding.begin(), riding.end());
+    }
+}
+
+}
+
+ReplayState::ReplayState():
+    phase(GamePhase::MOVEMENT), currentPlayer(0), spun(false),
+    spinType(NO_TYPE), seed(0), rngState(0), lastActorId(0),
+    lastTransportId(0)
+{
+}
+
+ReplayState::ReplayState(const GameSnapshot& snapshot):
+    terrain(snapshot.terrain), players(snapshot.players),
+    phase(snapshot.phase), currentPlayer(snapshot.currentPlayer),
+    islandPieces(snapshot.islandPieces), spun(snapshot.spun),
+    spinType(snapshot.spinType), spinMoves(snapshot.spinMoves),
+    seed(snapshot.rng.seed()), rngState(snapshot.rng.state()),
+    lastActorId(snapshot.lastActorId),
+    lastTransportId(snapshot.lastTransportId)
+{
+    readPieces(snapshot, snapshot.pawns, pawns);
+    readPieces(snapshot, snapshot.actors, actors);
+    readPieces(snapshot, snapshot.transports, transports);
+}
+
+std::shared_ptr<GameSnapshot> ReplayState::toSnapshot(
+        std::shared_ptr<const std::vector<CubeCoordinate>> coordinates) const
+{
+    auto snapshot = std::make_shared<GameSnapshot>();
+    snapshot->coordinates = std::move(coordinates);
+    snapshot->terrain = terrain;
+    writePieces(pawns, snapshot->pawns, snapshot->passengers);
+    writePieces(actors, snapshot->actors, snapshot->passengers);
+    writePieces(transports, snapshot->transports, snapshot->passengers);
+    snapshot->players = players;
+    snapshot->phase = phase;
+    snapshot->currentPlayer = currentPlayer;
+    snapshot->islandPieces = islandPieces;
+    snapshot->spun = spun;
+    snapshot->spinType = spinType;
+    snapshot->spinMoves = spinMoves;
+    snapshot->rng = Logic::GameRandom(seed, rngState);
+    snapshot->lastActorId = lastActorId;
+    snapshot->lastTransportId = lastTransportId;
+    return snapshot;
+}
+
+/**
+ * @brief Encodes the parts of a turn into the buffer of the writer, giving
+ * the types their indices in the file as they are first used.
+ */
+class ReplayWriter::FrameWriter {
+
+  public:
+
+    explicit FrameWriter(ReplayWriter& writer):
+        writer_(writer), bytes_(writer.buffer_)
+    {
+    }
+
+    void putUnsigned(std::uint64_t value)
+    {
+        Varint::append(bytes_, value);
+    }
+
+    void putSigned(std::int64_t value)
+    {
+        putUnsigned(Varint::zigzag(value));
+    }
+
+    void putString(const std::string& string)
+    {
+        putUnsigned(string.size());
+        bytes_.insert(bytes_.end(), string.begin(), string.end());
+    }
+
+    void putType(TypeId type)
+    {
+        if (type == NO_TYPE) {
+            putUnsigned(0);
+            return;
+        }
+        auto& indices = writer_.typeIndices_;
+        if (type >= indices.size()) {
+            indices.resize(type + 1u, 0);
+        }
+        if (indices[type] == 0) {
+            writer_.types_.push_back(type);
+            indices[type] = static_cast<std::uint32_t>(writer_.types_.size());
+        }
+        putUnsigned(indices[type]);
+    }
+
+    //! Ids of a list grow, each is written as the gap to the one before.
+    void putPiece(int& lastId, int id, const ReplayState::Piece& piece)
+    {
+        putSigned(static_cast<std::int64_t>(id) - lastId);
+        lastId = id;
+        putType(piece.type);
+        putSigned(piece.owner);
+        putUnsigned(static_cast<unsigned int>(piece.hex));
+        putUnsigned(piece.passengers.size());
+        for (int passenger : piece.passengers) {
+            putSigned(passenger);
+        }
+    }
+
+    void putPieces(const ReplayState::Pieces& pieces)
+    {
+        putUnsigned(pieces.size());
+        int lastId = 0;
+        for (const auto& piece : pieces) {
+            putPiece(lastId, piece.first, piece.second);
+        }
+    }
+
+    //! The pieces that appeared or changed, then the ids of the ones gone.
+    void putPieceChanges(const ReplayState::Pieces& before,
+                         const ReplayState::Pieces& after)
+    {
+        std::vector<ReplayState::Pieces::const_iterator> changed;
+        for (auto piece = after.begin(); piece != after.end(); ++piece) {
+            auto old = before.find(piece->first);
+            if (old == before.end() || !(old->second == piece->second)) {
+                changed.push_back(piece);
+            }
+        }
+        putUnsigned(changed.size());
+        int lastId = 0;
+        for (const auto& piece : changed) {
+            putPiece(lastId, piece->first, piece->second);
+        }
+
+        std::vector<int> removed;
+        for (const auto& piece : before) {
+            if (after.find(piece.first) == after.end()) {
+                removed.push_back(piece.first);
+            }
+        }
+        putUnsigned(removed.size());
+        lastId = 0;
+        for (int id : removed) {
+            putSigned(static_cast<std::int64_t>(id) - lastId);
+            lastId = id;
+        }
+    }
+
+    void putKeyframe(const ReplayState& state)
+    {
+        bytes_.push_back(KEYFRAME);
+        putUnsigned(state.terrain.size());
+        for (TypeId type : state.terrain) {
+            putType(type);
+        }
+        putPieces(state.pawns);
+        putPieces(state.actors);
+        putPieces(state.transports);
+        putScalars(state);
+    }
+
+    void putChanges(const ReplayState& before, const ReplayState& after)
+    {
+        bytes_.push_back(CHANGES);
+        std::size_t changes = 0;
+        for (std::size_t i = 0; i < after.terrain.size(); ++i) {
+            changes += after.terrain[i] != before.terrain[i];
+        }
+        putUnsigned(changes);
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < after.terrain.size(); ++i) {
+            if (after.terrain[i] != before.terrain[i]) {
+                putUnsigned(i - next);
+                putType(after.terrain[i]);
+                next = i + 1;
+            }
+        }
+        putPieceChanges(before.pawns, after.pawns);
+        putPieceChanges(before.actors, after.actors);
+        putPieceChanges(before.transports, after.transports);
+        putScalars(after);
+    }
+
+  private:
+
+    //! The state that is small enough to write in every turn.
+    void putScalars(const ReplayState& state)
+    {
+        putUnsigned(state.players.size());
+        for (const auto& player : state.players) {
+            putSigned(player.id);
+            putUnsigned(player.actionsLeft);
+        }
+        putUnsigned(static_cast<unsigned int>(state.phase));
+        putSigned(state.currentPlayer);
+        putUnsigned(state.islandPieces.size());
+        for (const auto& pieces : state.islandPieces) {
+            putType(pieces.first);
+            putSigned(pieces.second);
+        }
+        putUnsigned(state.spun ? 1 : 0);
+        putType(state.spinType);
+        putString(state.spinMoves);
+        putUnsigned(state.seed);
+        putUnsigned(state.rngState);
+        putSigned(state.lastActorId);
+        putSigned(state.lastTransportId);
+    }
+
+    ReplayWriter& writer_;
+    std::vector<std::uint8_t>& bytes_;
+};
+
+/**
+ * @brief Decodes the parts of a turn from the mapped file.
+ */
+class ReplayReader::FrameReader {
+
+  public:
+
+    FrameReader(const ReplayReader& reader, std::size_t position,
+                std::size_t end):
+        reader_(reader), position_(position), end_(end)
+    {
+    }
+
+    std::size_t position() const { return position_; }
+
+    std::uint8_t getByte()
+    {
+        if (position_ >= end_) {
+            throw FormatException("Replay cut short");
+        }
+        return reader_.data_[position_++];
+    }
+
+    std::uint64_t getUnsigned()
+    {
+        std::uint64_t value;
+        if (!Varint::get(reader_.data_, end_, position_, value)) {
+            throw FormatException("Replay cut short");
+        }
+        return value;
+    }
+
+    std::int64_t getSigned()
+    {
+        return Varint::unzigzag(getUnsigned());
+    }
+
+    int getInt()
+    {
+        return static_cast<int>(getSigned());
+    }
+
+    //! A count of items that take at least a byte each.
+    std::size_t getCount()
+    {
+        std::uint64_t count = getUnsigned();
+        if (count > end_ - position_) {
+            throw FormatException("Replay cut short");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    void getString(std::string& string)
+    {
+        std::size_t length = getCount();
+        string.assign(reinterpret_cast<const char*>(reader_.data_ + position_),
+                      length);
+        position_ += length;
+    }
+
+    TypeId getType()
+    {
+        std::uint64_t index = getUnsigned();
+        if (index >= reader_.types_.size()) {
+            throw FormatException("Unknown replay type " +
+                                  std::to_string(index));
+        }
+        return reader_.types_[index];
+    }
+
+    int getHex()
+    {
+        std::uint64_t hex = getUnsigned();
+        if (hex >= reader_.coordinates_->size()) {
+            throw FormatException("Replay hex " + std::to_string(hex) +
+                                  " is not on the island");
+        }
+        return static_cast<int>(hex);
+    }
+
+    void getPiece(int& lastId, ReplayState::Pieces& pieces)
+    {
+        lastId += getInt();
+        ReplayState::Piece& piece = pieces[lastId];
+        piece.type = getType();
+        piece.owner = getInt();
+        piece.hex = getHex();
+        piece.passengers.resize(getCount());
+        for (int& passenger : piece.passengers) {
+            passenger = getInt();
+        }
+    }
+
+    void getPieces(ReplayState::Pieces& pieces)
+    {
+        pieces.clear();
+        std::size_t count = getCount();
+        int lastId = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            getPiece(lastId, pieces);
+        }
+    }
+
+    void getPieceChanges(ReplayState::Pieces& pieces)
+    {
+        std::size_t changed = getCount();
+        int lastId = 0;
+        for (std::size_t i = 0; i < changed; ++i) {
+            getPiece(lastId, pieces);
+        }
+        std::size_t removed = getCount();
+        lastId = 0;
+        for (std::size_t i = 0; i < removed; ++i) {
+            lastId += getInt();
+            pieces.erase(lastId);
+        }
+    }
+
+    void getKeyframe(ReplayState& state)
+    {
+        if (getByte() != KEYFRAME) {
+            throw FormatException("Replay turn is not a keyframe");
+        }
+        std::size_t hexes = getCount();
+        if (hexes != reader_.coordinates_->size()) {
+            throw FormatException("Replay terrain doesn't match the island");
+        }
+        state.terrain.resize(hexes);
+        for (TypeId& type : state.terrain) {
+            type = getType();
+        }
+        getPieces(state.pawns);
+        getPieces(state.actors);
+        getPieces(state.transports);
+        getScalars(state);
+    }
+
+    void getChanges(ReplayState& state)
+    {
+        if (getByte() != CHANGES) {
+            throw FormatException("Unknown replay frame");
+        }
+        std::size_t changes = getCount();
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < changes; ++i) {
+            std::uint64_t hex = next + getUnsigned();
+            if (hex >= state.terrain.size()) {
+                throw FormatException("Replay hex " + std::to_string(hex) +
+                                      " is not on the island");
+            }
+            state.terrain[hex] = getType();
+            next = static_cast<std::size_t>(hex) + 1;
+        }
+        getPieceChanges(state.pawns);
+        getPieceChanges(state.actors);
+        getPieceChanges(state.transports);
+        getScalars(state);
+    }
+
+  private:
+
+    void getScalars(ReplayState& state)
+    {
+        state.players.resize(getCount());
+        for (auto& player : state.players) {
+            player.id = getInt();
+            player.actionsLeft = static_cast<unsigned int>(getUnsigned());
+        }
+        std::uint64_t phase = getUnsigned();
+        if (phase < static_cast<std::uint64_t>(GamePhase::MOVEMENT) ||
+                phase > static_cast<std::uint64_t>(GamePhase::SPINNING)) {
+            throw FormatException("Unknown replay game phase " +
+                                  std::to_string(phase));
+        }
+        state.phase = static_cast<GamePhase>(phase);
+        state.currentPlayer = getInt();
+        state.islandPieces.resize(getCount());
+        for (auto& pieces : state.islandPieces) {
+            pieces.first = getType();
+            pieces.second = getInt();
+        }
+        state.spun = getUnsigned() != 0;
+        state.spinType = getType();
+        getString(state.spinMoves);
+        state.seed = static_cast<unsigned int>(getUnsigned());
+        state.rngState = getUnsigned();
+        state.lastActorId = getInt();
+        state.lastTransportId = getInt();
+    }
+
+    const ReplayReader& reader_;
+    std::size_t position_;
+    std::size_t end_;
+};
+
+const char ReplayWriter::REPLAY_MAGIC[4] = {'I', 'G', 'R', 'P'};
+const std::uint8_t ReplayWriter::REPLAY_VERSION;
+const int ReplayWriter::DEFAULT_KEYFRAME_INTERVAL;
+
+ReplayWriter::ReplayWriter(const std::string& fileName, int keyframeInterval):
+    fileName_(fileName),
+    file_(fileName, std::ios::binary | std::ios::trunc),
+    keyframeInterval_(std::max(keyframeInterval, 1)),
+    finished_(false),
+    size_(0)
+{
+    buffer_.assign(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    buffer_.push_back(REPLAY_VERSION);
+    Varint::append(buffer_, static_cast<unsigned int>(keyframeInterval_));
+    file_.write(reinterpret_cast<const char*>(buffer_.data()),
+                static_cast<std::streamsize>(buffer_.size()));
+    if (!file_) {
+        throw IoException("Could not write file " + fileName_);
+    }
+    size_ = buffer_.size();
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    try {
+        finish();
+    } catch (const GameException&) {
+    }
+}
+
+void ReplayWriter::addTurn(const GameSnapshot& snapshot)
+{
+    if (finished_) {
+        throw GameException("The replay " + fileName_ + " is finished");
+    }
+    if (coordinates_ == nullptr) {
+        coordinates_ = snapshot.coordinates;
+    } else if (snapshot.coordinates != coordinates_ &&
+               (snapshot.coordinates == nullptr ||
+                *snapshot.coordinates != *coordinates_)) {
+        throw GameException("The snapshot is of another island");
+    }
+    if (coordinates_ == nullptr ||
+            snapshot.terrain.size() != coordinates_->size()) {
+        throw GameException("The snapshot has no terrain for every hex");
+    }
+
+    std::unique_ptr<ReplayState> state(new ReplayState(snapshot));
+    buffer_.clear();
+    FrameWriter writer(*this);
+    if (previous_ == nullptr || turnCount() % keyframeInterval_ == 0) {
+        writer.putKeyframe(*state);
+    } else {
+        writer.putChanges(*previous_, *state);
+    }
+
+    file_.write(reinterpret_cast<const char*>(buffer_.data()),
+                static_cast<std::streamsize>(buffer_.size()));
+    if (!file_) {
+        throw IoException("Could not write file " + fileName_);
+    }
+    turnOffsets_.push_back(size_);
+    size_ += buffer_.size();
+    previous_ = std::move(state);
+}
+
+void ReplayWriter::finish()
+{
+    if (finished_) {
+        return;
+    }
+    // A failed finish leaves a file that can't be read, don't retry it
+    finished_ = true;
+    previous_.reset();
+
+    buffer_.clear();
+    FrameWriter writer(*this);
+    writer.putUnsigned(turnOffsets_.size());
+    std::uint64_t lastOffset = 0;
+    for (std::uint64_t offset : turnOffsets_) {
+        writer.putUnsigned(offset - lastOffset);
+        lastOffset = offset;
+    }
+
+    writer.putUnsigned(types_.size());
+    for (TypeId type : types_) {
+        writer.putString(TypeRegistry::getInstance().nameOf(type));
+    }
+
+    std::size_t hexes = coordinates_ == nullptr ? 0 : coordinates_->size();
+    writer.putUnsigned(hexes);
+    CubeCoordinate cursor(0, 0, 0);
+    for (std::size_t i = 0; i < hexes; ++i) {
+        const CubeCoordinate& coord = (*coordinates_)[i];
+        writer.putSigned(static_cast<std::int64_t>(coord.x) - cursor.x);
+        writer.putSigned(static_cast<std::int64_t>(coord.z) - cursor.z);
+        cursor = coord;
+    }
+
+    for (int byte = 0; byte < 8; ++byte) {
+        buffer_.push_back(static_cast<std::uint8_t>(size_ >> (8 * byte)));
+    }
+    buffer_.insert(buffer_.end(), REPLAY_MAGIC,
+                   REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+
+    file_.write(reinterpret_cast<const char*>(buffer_.data()),
+                static_cast<std::streamsize>(buffer_.size()));
+    file_.close();
+    if (!file_) {
+        throw IoException("Could not write file " + fileName_);
+    }
+}
+
+ReplayReader::ReplayReader(const std::string& fileName):
+    file_(new QFile(QString::fromStdString(fileName))),
+    data_(nullptr),
+    size_(0),
+    keyframeInterval_(1),
+    coordinates_(std::make_shared<std::vector<CubeCoordinate>>())
+{
+    if (!file_->open(QIODevice::ReadOnly)) {
+        throw IoException("Could not read file " + fileName);
+    }
+    size_ = static_cast<std::size_t>(file_->size());
+    if (size_ < HEADER_SIZE + TRAILER_SIZE) {
+        throw FormatException("Not a replay");
+    }
+    data_ = file_->map(0, file_->size());
+    if (data_ == nullptr) {
+        throw IoException("Could not map file " + fileName);
+    }
+
+    const char* magic = reinterpret_cast<const char*>(data_);
+    const char* endMagic = magic + size_ - sizeof(ReplayWriter::REPLAY_MAGIC);
+    if (!std::equal(magic, magic + sizeof(ReplayWriter::REPLAY_MAGIC),
+                    ReplayWriter::REPLAY_MAGIC) ||
+            !std::equal(endMagic, endMagic +
+                        sizeof(ReplayWriter::REPLAY_MAGIC),
+                        ReplayWriter::REPLAY_MAGIC)) {
+        throw FormatException("Not a finished replay");
+    }
+    if (data_[sizeof(ReplayWriter::REPLAY_MAGIC)] !=
+            ReplayWriter::REPLAY_VERSION) {
+        throw FormatException("Unsupported replay version");
+    }
+
+    std::uint64_t indexOffset = 0;
+    for (int byte = 0; byte < 8; ++byte) {
+        indexOffset |= static_cast<std::uint64_t>(
+                    data_[size_ - TRAILER_SIZE + byte]) << (8 * byte);
+    }
+    if (indexOffset < HEADER_SIZE || indexOffset > size_ - TRAILER_SIZE) {
+        throw FormatException("Replay index out of the file");
+    }
+
+    FrameReader header(*this, HEADER_SIZE, static_cast<std::size_t>(
+                           indexOffset));
+    std::uint64_t interval = header.getUnsigned();
+    if (interval < 1 || interval > static_cast<std::uint64_t>(
+            std::numeric_limits<int>::max())) {
+        throw FormatException("Invalid replay keyframe interval");
+    }
+    keyframeInterval_ = static_cast<int>(interval);
+
+    FrameReader index(*this, static_cast<std::size_t>(indexOffset),
+                      size_ - TRAILER_SIZE);
+    std::size_t turns = index.getCount();
+    turnOffsets_.reserve(turns);
+    std::uint64_t offset = 0;
+    for (std::size_t turn = 0; turn < turns; ++turn) {
+        offset += index.getUnsigned();
+        if (offset < header.position() || offset >= indexOffset ||
+                (turn > 0 && offset <= turnOffsets_.back())) {
+            throw FormatException("Replay turn out of the file");
+        }
+        turnOffsets_.push_back(static_cast<std::size_t>(offset));
+    }
+    // The end of the last turn
+    turnOffsets_.push_back(static_cast<std::size_t>(indexOffset));
+
+    std::string name;
+    types_.assign(1, NO_TYPE);
+    for (std::size_t i = index.getCount(); i > 0; --i) {
+        index.getString(name);
+        types_.push_back(TypeRegistry::getInstance().intern(name));
+    }
+
+    auto coordinates = std::make_shared<std::vector<CubeCoordinate>>(
+                index.getCount());
+    CubeCoordinate cursor(0, 0, 0);
+    for (auto& coord : *coordinates) {
+        int x = cursor.x + index.getInt();
+        int z = cursor.z + index.getInt();
+        coord = CubeCoordinate(x, -x - z, z);
+        cursor = coord;
+    }
+    coordinates_ = coordinates;
+}
+
+ReplayReader::~ReplayReader()
+{
+    if (data_ != nullptr) {
+        file_->unmap(const_cast<uchar*>(data_));
+    }
+}
+
+std::shared_ptr<const GameSnapshot> ReplayReader::snapshotAt(int turn) const
+{
+    if (turn < 0 || turn >= turnCount()) {
+        return nullptr;
+    }
+    int keyframe = turn;
+    while (data_[turnOffsets_[keyframe]] != KEYFRAME) {
+        if (keyframe == 0 || turn - keyframe >= keyframeInterval_) {
+            throw FormatException("Replay keyframe missing");
+        }
+        --keyframe;
+    }
+
+    ReplayState state;
+    FrameReader(*this, turnOffsets_[keyframe], turnOffsets_[keyframe + 1])
+            .getKeyframe(state);
+    for (int next = keyframe + 1; next <= turn; ++next) {
+        FrameReader(*this, turnOffsets_[next], turnOffsets_[next + 1])
+                .getChanges(state);
+    }
+    return state.toSnapshot(coordinates_);
+}
+
+}
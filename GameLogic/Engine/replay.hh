@@ -0,0 +1,202 @@
+#ifndef REPLAY_HH
+#define REPLAY_HH
+
+#include "gamesnapshot.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+class QFile;
+
+/**
+ * @file
+ * @brief Replay files, the state of every turn of a game for jumping to any
+ * turn.
+ */
+
+namespace Common {
+
+//! The state of one turn as it is encoded, defined in replay.cpp.
+struct ReplayState;
+
+/**
+ * @brief Writes the state of a game at the start of every turn to a replay
+ * file, for ReplayReader.
+ * @details Every keyframeInterval turns the whole state is written as a
+ * keyframe, the turns between them as the changes since the turn before:
+ * the hexes whose terrain changed, the pawns, actors and transports that
+ * appeared, moved or changed passengers and the ones that disappeared, and
+ * the small state of the players and the engine. A turn is read by decoding
+ * the keyframe before it and applying at most keyframeInterval - 1 changes.
+ *
+ * The file starts with REPLAY_MAGIC, REPLAY_VERSION and the keyframe
+ * interval, then come the turns as they are added. finish() appends an
+ * index of the turns, the names of the piece types, the hex coordinates and
+ * a trailer with the offset of the index. The numbers are variable length
+ * integers, see Varint. A file that was not finished can't be read.
+ */
+class ReplayWriter {
+
+  public:
+
+    //! First bytes of a replay file, and its last bytes.
+    static const char REPLAY_MAGIC[4];
+
+    //! Version of the file format, the byte after REPLAY_MAGIC.
+    static const std::uint8_t REPLAY_VERSION = 1;
+
+    //! Turns from one keyframe to the next by default.
+    static const int DEFAULT_KEYFRAME_INTERVAL = 8;
+
+    /**
+     * @brief Constructor, creates the file.
+     * @param fileName Name of the file, replaced if it exists.
+     * @param keyframeInterval Turns from one keyframe to the next, at least
+     * 1. Longer intervals make smaller files and slower jumps.
+     * @exception IoException The file can't be written.
+     */
+    explicit ReplayWriter(const std::string& fileName,
+                          int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    /**
+     * @brief Destructor, finishes the file if finish() wasn't called. Errors
+     * are ignored.
+     */
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    /**
+     * @brief addTurn appends the state of the next turn.
+     * @param snapshot The state, see IGameRunner::snapshot().
+     * @exception IoException The file can't be written.
+     * @exception GameException The snapshot is of another island than the
+     * earlier ones, or the file is finished.
+     * @post Exception quarantee: basic
+     */
+    void addTurn(const GameSnapshot& snapshot);
+
+    /**
+     * @brief turnCount tells the number of turns added.
+     * @return The number of turns.
+     */
+    int turnCount() const { return static_cast<int>(turnOffsets_.size()); }
+
+    /**
+     * @brief finish writes the index and closes the file.
+     * @details Calling it again does nothing.
+     * @exception IoException The file can't be written.
+     * @post Exception quarantee: basic
+     */
+    void finish();
+
+  private:
+
+    class FrameWriter;
+
+    std::string fileName_;
+    std::ofstream file_;
+    int keyframeInterval_;
+    bool finished_;
+
+    //! Offsets of the turns in the file.
+    std::vector<std::uint64_t> turnOffsets_;
+    std::uint64_t size_;
+
+    //! Coordinates of the hexes, shared by all the turns.
+    std::shared_ptr<const std::vector<CubeCoordinate>> coordinates_;
+
+    //! The turn before, the next turn is written as the changes to it.
+    std::unique_ptr<ReplayState> previous_;
+
+    //! Index in the file of every TypeId used, 0 if not used yet, and the
+    //! TypeIds in the order of their indices.
+    std::vector<std::uint32_t> typeIndices_;
+    std::vector<TypeId> types_;
+
+    //! Encoded turn, reused between the turns.
+    std::vector<std::uint8_t> buffer_;
+};
+
+/**
+ * @brief Reads the turns of a replay file written by ReplayWriter.
+ * @details The file is mapped to memory and only the index is read when it
+ * is opened, so opening a replay of any length is quick. snapshotAt()
+ * decodes the keyframe before the turn and at most keyframeInterval() - 1
+ * changes after it, the cost doesn't depend on the number of the turn.
+ * Turns can be read from several threads at the same time.
+ */
+class ReplayReader {
+
+  public:
+
+    /**
+     * @brief Constructor, opens a replay file.
+     * @param fileName Name of the file.
+     * @exception IoException The file can't be read or mapped.
+     * @exception FormatException The file is not a finished replay of this
+     * version.
+     */
+    explicit ReplayReader(const std::string& fileName);
+
+    /**
+     * @brief Destructor, unmaps the file.
+     */
+    ~ReplayReader();
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    /**
+     * @brief turnCount tells the number of turns in the file.
+     * @return The number of turns.
+     */
+    int turnCount() const
+    {
+        return static_cast<int>(turnOffsets_.size()) - 1;
+    }
+
+    /**
+     * @brief keyframeInterval tells the turns from one keyframe to the next.
+     * @return The interval the file was written with.
+     */
+    int keyframeInterval() const { return keyframeInterval_; }
+
+    /**
+     * @brief snapshotAt reconstructs the state at the start of a turn.
+     * @details Fork the turn with Initialization::forkGameRunner() to show
+     * or continue it.
+     * @param turn Number of the turn, from 0.
+     * @exception FormatException The file is damaged.
+     * @return The state of the turn, nullptr if there is no such turn. The
+     * snapshots of a reader share their coordinates.
+     * @post Exception quarantee: strong
+     */
+    std::shared_ptr<const GameSnapshot> snapshotAt(int turn) const;
+
+  private:
+
+    class FrameReader;
+
+    std::unique_ptr<QFile> file_;
+    const std::uint8_t* data_;
+    std::size_t size_;
+    int keyframeInterval_;
+
+    //! Offsets of the turns in the file, and of the end of the last turn.
+    std::vector<std::size_t> turnOffsets_;
+
+    //! TypeIds of this program by the indices of the file.
+    std::vector<TypeId> types_;
+
+    std::shared_ptr<const std::vector<CubeCoordinate>> coordinates_;
+};
+
+}
+
+#endif // REPLAY_HH
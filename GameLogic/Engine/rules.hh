@@ -0,0 +1,18 @@
+#ifndef RULES_HH
+#define RULES_HH
+
+/**
+ * @file
+ * @brief Constants of the game rules shared by the engine modules.
+ */
+
+namespace Logic {
+
+//! Rule for max pawns per tile
+int const MAX_PAWNS_PER_HEX = 3;
+//! Actions a player has at the start of a turn
+int const MAX_ACTIONS_PER_TURN = 3;
+
+}
+
+#endif // RULES_HH
@@ -9,8 +9,10 @@ Seamunster::Seamunster(int typeId): Actor(typeId)
 
 void Seamunster::doAction()
 {
-    hex_->clearTransports();
-    hex_->clearPawnsFromTerrain();
+    recordAction();
+    std::shared_ptr<Hex> hex = getHex();
+    hex->clearTransports();
+    hex->clearPawnsFromTerrain();
 }
 
 std::string Seamunster::getActorType() const
@@ -18,5 +20,10 @@ std::string Seamunster::getActorType() const
     return "seamunster";
 }
 
+TypeId Seamunster::getActorTypeId() const
+{
+    return SEAMUNSTER_TYPE;
+}
+
 
 }
@@ -8,7 +8,8 @@ Shark::Shark(int typeId):Actor(typeId){
 
 void Shark::doAction()
 {
-    hex_->clearPawnsFromTerrain();
+    recordAction();
+    getHex()->clearPawnsFromTerrain();
 }
 
 std::string Shark::getActorType() const
@@ -16,4 +17,9 @@ std::string Shark::getActorType() const
     return "shark";
 }
 
+TypeId Shark::getActorTypeId() const
+{
+    return SHARK_TYPE;
+}
+
 }
@@ -0,0 +1,287 @@
+#ifndef SMALLVECTOR_HH
+#define SMALLVECTOR_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file
+ * @brief Vector with room for a few elements inside the object, and a view
+ * to contiguous elements.
+ */
+
+namespace Common {
+
+/**
+ * @brief Non-owning view to contiguous elements.
+ * @details Cheap to copy. Valid until the container it views changes.
+ */
+template <class T>
+class Span
+{
+public:
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    Span(): data_(nullptr), size_(0) {}
+    Span(T* data, std::size_t size): data_(data), size_(size) {}
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](std::size_t index) const { return data_[index]; }
+
+    /**
+     * @brief at returns an element with bounds checking.
+     * @param index Index of the element.
+     * @exception std::out_of_range index >= size()
+     * @return The element.
+     */
+    T& at(std::size_t index) const
+    {
+        if (index >= size_) {
+            throw std::out_of_range("Span::at");
+        }
+        return data_[index];
+    }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
+
+/**
+ * @brief Vector that keeps up to N elements inside the object.
+ * @details Only allocates when it grows past N, so copying, filling and
+ * clearing a small vector that stays within its inline capacity never touches
+ * the heap. Elements are contiguous and keep their order.
+ */
+template <class T, std::size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs room for at least one element");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector(): size_(0), capacity_(N) {}
+
+    SmallVector(const SmallVector& other): SmallVector()
+    {
+        reserve(other.size_);
+        for (const T& value : other) {
+            new (data() + size_) T(value);
+            ++size_;
+        }
+    }
+
+    SmallVector(SmallVector&& other) noexcept: SmallVector()
+    {
+        moveFrom(other);
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        release();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            SmallVector copy(other);
+            clear();
+            moveFrom(copy);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    T* data() { return isInline() ? inlineData() : storage_.heap; }
+    const T* data() const
+    {
+        return isInline() ? inlineData() : storage_.heap;
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](std::size_t index) { return data()[index]; }
+    const T& operator[](std::size_t index) const { return data()[index]; }
+
+    /**
+     * @brief span returns a view to the elements.
+     * @return View valid until the vector changes.
+     */
+    Span<const T> span() const { return Span<const T>(data(), size_); }
+
+    /**
+     * @brief reserve makes room for at least the given number of elements.
+     * @param capacity Number of elements.
+     * @post Exception quarantee: strong
+     */
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= capacity_) {
+            return;
+        }
+        T* oldData = data();
+        T* newData = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        for (std::size_t i = 0; i < size_; ++i) {
+            new (newData + i) T(std::move(oldData[i]));
+            oldData[i].~T();
+        }
+        release();
+        storage_.heap = newData;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    /**
+     * @brief insert inserts an element before the given position.
+     * @param position Position of the new element.
+     * @param value The element.
+     * @return Iterator to the inserted element.
+     * @post Exception quarantee: strong, if moving T doesn't throw
+     */
+    iterator insert(const_iterator position, const T& value)
+    {
+        std::size_t index = position - begin();
+        T copy(value);
+        if (size_ == capacity_) {
+            reserve(2 * capacity_);
+        }
+
+        T* elements = data();
+        if (index == size_) {
+            new (elements + size_) T(std::move(copy));
+        } else {
+            new (elements + size_) T(std::move(elements[size_ - 1]));
+            for (std::size_t i = size_ - 1; i > index; --i) {
+                elements[i] = std::move(elements[i - 1]);
+            }
+            elements[index] = std::move(copy);
+        }
+        ++size_;
+        return elements + index;
+    }
+
+    /**
+     * @brief push_back adds an element to the end.
+     * @param value The element.
+     * @post Exception quarantee: strong, if moving T doesn't throw
+     */
+    void push_back(const T& value)
+    {
+        insert(end(), value);
+    }
+
+    /**
+     * @brief erase removes an element.
+     * @param position Position of the element.
+     * @return Iterator to the element after the removed one.
+     * @post Exception quarantee: nothrow, if moving T doesn't throw
+     */
+    iterator erase(const_iterator position)
+    {
+        T* elements = data();
+        std::size_t index = position - elements;
+        for (std::size_t i = index; i + 1 < size_; ++i) {
+            elements[i] = std::move(elements[i + 1]);
+        }
+        --size_;
+        elements[size_].~T();
+        return elements + index;
+    }
+
+    /**
+     * @brief clear removes all the elements, keeps the capacity.
+     * @post Exception quarantee: nothrow
+     */
+    void clear()
+    {
+        T* elements = data();
+        for (std::size_t i = 0; i < size_; ++i) {
+            elements[i].~T();
+        }
+        size_ = 0;
+    }
+
+private:
+    // The heap is only used past N elements, so the capacity tells where the
+    // elements are
+    bool isInline() const { return capacity_ == N; }
+
+    T* inlineData()
+    {
+        return reinterpret_cast<T*>(&storage_.inlined);
+    }
+
+    const T* inlineData() const
+    {
+        return reinterpret_cast<const T*>(&storage_.inlined);
+    }
+
+    // Takes the elements of other, which is left empty. Expects this to be
+    // empty.
+    void moveFrom(SmallVector& other)
+    {
+        if (other.isInline()) {
+            T* elements = data();
+            for (std::size_t i = 0; i < other.size_; ++i) {
+                new (elements + i) T(std::move(other.inlineData()[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            release();
+            storage_.heap = other.storage_.heap;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+    void release()
+    {
+        if (!isInline()) {
+            ::operator delete(storage_.heap);
+            capacity_ = N;
+        }
+    }
+
+    std::uint32_t size_;
+    std::uint32_t capacity_;
+    union Storage {
+        typename std::aligned_storage<N * sizeof(T), alignof(T)>::type inlined;
+        T* heap;
+    } storage_;
+};
+
+}
+
+#endif // SMALLVECTOR_HH
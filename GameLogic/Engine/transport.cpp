@@ -1,5 +1,6 @@
 #include "transport.hh"
 #include "hex.hh"
+#include "undolog.hh"
 #include <memory>
 #include <algorithm>
 
@@ -7,25 +8,36 @@ namespace Common{
 
 Transport::Transport( int id ):
     capacity_(0),
-    hex_(nullptr),
     id_(id)
 {}
 
 Transport::~Transport(){}
 
-void Transport::addPawn(std::shared_ptr<Pawn> pawn )
+TypeId Transport::getTransportTypeId()
+{
+    if (typeId_ == NO_TYPE) {
+        typeId_ = TypeRegistry::getInstance().intern(getTransportType());
+    }
+    return typeId_;
+}
+
+void Transport::addPawn(const std::shared_ptr<Pawn>& pawn)
 {
     if ( getCapacity() > 0 ){
+        saveToUndoLog(hex_.lock().get());
         pawns_.push_back(pawn);
+        passengersChanged();
     }
 }
 
-void Transport::removePawn(std::shared_ptr<Pawn> pawn)
+void Transport::removePawn(const std::shared_ptr<Pawn>& pawn)
 {
     if (pawn != nullptr) {
         auto foundPawn = std::find(pawns_.begin(),pawns_.end(),pawn);
         if (foundPawn != pawns_.end()) {
+            saveToUndoLog(hex_.lock().get());
             pawns_.erase(foundPawn);
+            passengersChanged();
         }
     }
 }
@@ -42,16 +54,19 @@ int Transport::getMaxCapacity() const
 
 void Transport::addHex( std::shared_ptr<Common::Hex> hex )
 {
-    hex->addTransport(shared_from_this());
-    if (hex_ != nullptr) {
-        hex_->removeTransport(shared_from_this());
+    saveToUndoLog(hex.get());
+    std::shared_ptr<Transport> self = shared_from_this();
+    hex->addTransport(self);
+    std::shared_ptr<Common::Hex> oldHex = hex_.lock();
+    if (oldHex != nullptr) {
+        oldHex->removeTransport(self);
     }
     hex_ = hex;
 }
 
 std::shared_ptr<Hex> Transport::getHex()
 {
-    return hex_;
+    return hex_.lock();
 }
 
 std::vector<std::shared_ptr<Pawn> > Transport::getPawnsInTransport()
@@ -59,7 +74,7 @@ std::vector<std::shared_ptr<Pawn> > Transport::getPawnsInTransport()
     return pawns_;
 }
 
-bool Transport::isPawnInTransport(std::shared_ptr<Pawn> pawn)
+bool Transport::isPawnInTransport(const std::shared_ptr<Pawn>& pawn) const
 {
     return (std::find(pawns_.begin(),pawns_.end(),pawn) != pawns_.end());
 }
@@ -71,7 +86,42 @@ int Transport::getId()
 
 void Transport::removePawns()
 {
+    saveToUndoLog(hex_.lock().get());
     pawns_.clear();
+    passengersChanged();
+}
+
+void Transport::passengersChanged() const
+{
+    std::shared_ptr<Common::Hex> hex = hex_.lock();
+    if (hex != nullptr) {
+        hex->contentsChanged();
+    }
+}
+
+Transport::State Transport::saveState() const
+{
+    State state;
+    state.hex = hex_;
+    for (const auto& pawn : pawns_) {
+        state.pawns.push_back(pawn);
+    }
+    return state;
+}
+
+void Transport::restoreState(const State& state)
+{
+    hex_ = state.hex;
+    pawns_.assign(state.pawns.begin(), state.pawns.end());
+    passengersChanged();
+}
+
+void Transport::saveToUndoLog(const Hex* hex)
+{
+    UndoLog* log = hex == nullptr ? nullptr : UndoLog::of(*hex);
+    if (log != nullptr) {
+        log->saveTransport(*this);
+    }
 }
 
 }
@@ -22,6 +22,16 @@ namespace Common {
 class Transport : public std::enable_shared_from_this<Transport>
 {
 public:
+    /**
+     * @brief The location and the passengers of a transport, see
+     * saveState().
+     */
+    struct State {
+        std::weak_ptr<Common::Hex> hex;
+        SmallVector<std::shared_ptr<Common::Pawn>,
+                    Logic::MAX_PAWNS_PER_HEX> pawns;
+    };
+
     /**
      * @brief default constructor
      */
@@ -45,6 +55,15 @@ public:
      */
     virtual std::string getTransportType() = 0;
 
+    /**
+     * @brief getTransportTypeId returns the type of the transport without
+     * building its name.
+     * @details By default the name from getTransportType is interned on the
+     * first call.
+     * @return Identifier of the transport type, see TypeRegistry.
+     */
+    virtual Common::TypeId getTransportTypeId();
+
     /**
      * @brief Adds pawn to transport
      * @param pawn
@@ -52,14 +71,14 @@ public:
      * @note note: Pawn is not removed from the hex
      * @post If transport is full, pawn is not added
      */
-    void addPawn( std::shared_ptr<Common::Pawn> pawn );
+    void addPawn( const std::shared_ptr<Common::Pawn>& pawn );
 
     /**
      * @brief removePawn removes a pawn from transport
      * @param pawn Pawn to be removed.
      * @post If pawn is in transport, it will be removed from it
      */
-    void removePawn( std::shared_ptr<Common::Pawn> pawn );
+    void removePawn( const std::shared_ptr<Common::Pawn>& pawn );
 
     /**
      * @brief Moves the transport from the current hex to another hex
@@ -119,7 +138,7 @@ public:
      * @param pawn the pawn we want to check for
      * @return true if pawn is in transport, otherwise false
      */
-    bool isPawnInTransport(std::shared_ptr<Common::Pawn> pawn);
+    bool isPawnInTransport(const std::shared_ptr<Common::Pawn>& pawn) const;
 
     /**
      * @brief getId returns id of the transport
@@ -132,15 +151,43 @@ public:
      */
     void removePawns();
 
+    /**
+     * @brief saveState copies the location and the passengers of the
+     * transport.
+     * @return The state, the passengers are shared with the transport.
+     * @post Exception quarantee: strong
+     */
+    State saveState() const;
+
+    /**
+     * @brief restoreState puts back a state saved with saveState().
+     * @details Only the transport is changed, the hexes and the pawns are
+     * restored on their own.
+     * @param state The state.
+     * @post Exception quarantee: basic
+     */
+    void restoreState(const State& state);
+
 protected:
     using PawnVector = std::vector<std::shared_ptr<Common::Pawn>>;
     int capacity_;
     PawnVector pawns_;
-    std::shared_ptr<Common::Hex> hex_;
+    //! The hex the transport is on, owned by the board. Subclasses lock() it,
+    //! the hex may be gone.
+    std::weak_ptr<Common::Hex> hex_;
 
 private:
+    //! Tells the hex that the pawns on board have changed.
+    void passengersChanged() const;
+
+    //! Saves the state to the undo log of the board of hex before a change.
+    void saveToUndoLog(const Common::Hex* hex);
+
     int id_;
 
+    //! Interned getTransportType(), NO_TYPE until it is needed.
+    Common::TypeId typeId_ = NO_TYPE;
+
 };
 
 }
@@ -8,11 +8,22 @@ using std::vector;
 
 TransportFactory::TransportFactory():
     transportDefinitions_(),
-    idCounter_(0)
+    idCounter_(0),
+    arena_(nullptr)
 {
 
 }
 
+TransportFactory::TransportFactory(const TransportFactory& other):
+    transportDefinitions_(),
+    idCounter_(0)
+{
+    std::lock_guard<std::mutex> lock(other.mutex_);
+    transportDefinitions_ = other.transportDefinitions_;
+    idCounter_ = other.idCounter_;
+    arena_ = other.arena_;
+}
+
 TransportFactory& TransportFactory::getInstance()
 {
 
@@ -23,11 +34,32 @@ TransportFactory& TransportFactory::getInstance()
 
 void TransportFactory::addTransport(string type, TransportBuildFunction buildFunction)
 {
+    Common::TypeRegistry::getInstance().intern(type);
+    std::lock_guard<std::mutex> lock(mutex_);
+    transportDefinitions_[type] =
+            [buildFunction] (int id,
+                             const std::shared_ptr<Common::GameArena>&)
+    {
+        return buildFunction(id);
+    };
+}
+
+void TransportFactory::addTransport(string type, TransportArenaBuildFunction buildFunction)
+{
+    Common::TypeRegistry::getInstance().intern(type);
+    std::lock_guard<std::mutex> lock(mutex_);
     transportDefinitions_[type] = buildFunction;
 }
 
+void TransportFactory::setArena(std::shared_ptr<Common::GameArena> arena)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    arena_ = std::move(arena);
+}
+
 std::vector<std::string> TransportFactory::getAvailableTransports() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto types = vector<string>();
     for (auto it = transportDefinitions_.begin();
          it != transportDefinitions_.end();
@@ -40,8 +72,27 @@ std::vector<std::string> TransportFactory::getAvailableTransports() const
 
 TransportPointer TransportFactory::createTransport(string type)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     ++idCounter_;
-    return transportDefinitions_[type](idCounter_);
+    return transportDefinitions_[type](idCounter_, arena_);
+}
+
+TransportPointer TransportFactory::createTransport(string type, int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transportDefinitions_[type](id, arena_);
+}
+
+int TransportFactory::lastId() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idCounter_;
+}
+
+void TransportFactory::rewindIds(int lastId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    idCounter_ = lastId;
 }
 
 }
@@ -2,8 +2,10 @@
 #define TRANSPORTFACTORY_HH
 
 #include "transport.hh"
+#include "gamearena.hh"
 
 #include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <map>
@@ -18,6 +20,8 @@ namespace Logic {
 
 using TransportPointer = std::shared_ptr<Common::Transport>;
 using TransportBuildFunction = std::function<TransportPointer (int)>;
+using TransportArenaBuildFunction = std::function<TransportPointer (
+        int, const std::shared_ptr<Common::GameArena>&)>;
 
 /**
  * @brief Singleton factory for creating Transports.
@@ -32,13 +36,38 @@ public:
      */
     static TransportFactory& getInstance();
 
+    /**
+     * @brief Copy constructor.
+     * @details Copies the registered types, so that a game can create
+     * transports with ids of its own while other games use the shared
+     * factory. Safe to call while other threads register types.
+     * @param other The factory to copy.
+     */
+    TransportFactory(const TransportFactory& other);
+
+    TransportFactory& operator=(const TransportFactory&) = delete;
+
     /**
      * @brief Adds a buildable transport
-     * @param type transport type identifier
+     * @param type transport type identifier, also interned in TypeRegistry
      * @param buildFunction function that performs the building
      */
     void addTransport(std::string type, TransportBuildFunction buildFunction);
 
+    /**
+     * @brief Adds a build function that allocates from the arena of the game
+     * @param type Transport type identifier, also interned in TypeRegistry
+     * @param buildFunction function that performs the building, gets the id
+     * and the arena, which may be nullptr. See Common::GameArena::make.
+     */
+    void addTransport(std::string type, TransportArenaBuildFunction buildFunction);
+
+    /**
+     * @brief setArena sets the arena the created transports are allocated from
+     * @param arena arena of the game, nullptr for the heap
+     */
+    void setArena(std::shared_ptr<Common::GameArena> arena);
+
     /**
      * @brief getAvailableTransports
      * @return vector containing the type identifiers of available transports
@@ -52,12 +81,38 @@ public:
      */
     TransportPointer createTransport(std::string type);
 
+    /**
+     * @brief createTransport creates a transport with the given id, used when a game is
+     * forked. The ids of the next created transports are not changed.
+     * @param type
+     * @param id
+     * @return the created transport. Ownership is transferred to caller
+     */
+    TransportPointer createTransport(std::string type, int id);
+
+    /**
+     * @brief lastId tells the id of the last created transport
+     * @return the id, 0 if no transport has been created
+     */
+    int lastId() const;
+
+    /**
+     * @brief rewindIds makes the next created transport get the id after lastId,
+     * used when created transports are taken back
+     * @param lastId the id of the last transport that still exists
+     */
+    void rewindIds(int lastId);
+
 private:
 
     TransportFactory();
 
-    std::map<std::string, TransportBuildFunction> transportDefinitions_;
+    std::map<std::string, TransportArenaBuildFunction> transportDefinitions_;
     int idCounter_;
+    std::shared_ptr<Common::GameArena> arena_;
+
+    //! Guards the definitions and the counter.
+    mutable std::mutex mutex_;
 };
 
 }
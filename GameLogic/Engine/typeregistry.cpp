@@ -0,0 +1,58 @@
+#include "typeregistry.hh"
+
+#include <limits>
+#include <stdexcept>
+
+namespace Common {
+
+TypeRegistry::TypeRegistry()
+{
+    // Same order as the constants in the header
+    for (const char* name : {"", "Water", "Coral", "shark", "kraken",
+                             "seamunster", "vortex", "dolphin", "boat"}) {
+        intern(name);
+    }
+}
+
+TypeRegistry& TypeRegistry::getInstance()
+{
+    static TypeRegistry instance;
+    return instance;
+}
+
+TypeId TypeRegistry::intern(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ids_.find(name);
+    if (found != ids_.end()) {
+        return found->second;
+    }
+    if (names_.size() > std::numeric_limits<TypeId>::max()) {
+        throw std::length_error("Too many type names");
+    }
+
+    TypeId id = static_cast<TypeId>(names_.size());
+    names_.push_back(name);
+    try {
+        ids_.emplace(name, id);
+    } catch (...) {
+        names_.pop_back();
+        throw;
+    }
+    return id;
+}
+
+TypeId TypeRegistry::find(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ids_.find(name);
+    return found == ids_.end() ? NO_TYPE : found->second;
+}
+
+const std::string& TypeRegistry::nameOf(TypeId id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < names_.size() ? names_[id] : names_[NO_TYPE];
+}
+
+}
@@ -0,0 +1,90 @@
+#ifndef TYPEREGISTRY_HH
+#define TYPEREGISTRY_HH
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file
+ * @brief Compact identifiers for the names of piece, actor and transport
+ * types.
+ */
+
+namespace Common {
+
+//! Identifier of an interned type name.
+using TypeId = std::uint16_t;
+
+//! Identifier of the empty name, for hexes and actors without a type.
+TypeId const NO_TYPE = 0;
+
+//! The types the rules refer to, interned in this order before any other.
+TypeId const WATER_TYPE = 1;
+TypeId const CORAL_TYPE = 2;
+TypeId const SHARK_TYPE = 3;
+TypeId const KRAKEN_TYPE = 4;
+TypeId const SEAMUNSTER_TYPE = 5;
+TypeId const VORTEX_TYPE = 6;
+TypeId const DOLPHIN_TYPE = 7;
+TypeId const BOAT_TYPE = 8;
+
+/**
+ * @brief Singleton that maps type names to small integers and back.
+ * @details The factories and the pieces intern their names when they are
+ * registered or read, so rule checks compare integers instead of strings.
+ * The names are only needed for input and output. Identifiers are never
+ * removed or reused, and all the methods can be called from several threads.
+ */
+class TypeRegistry {
+
+  public:
+
+    /**
+     * @return A reference to the registry.
+     */
+    static TypeRegistry& getInstance();
+
+    /**
+     * @brief intern gives the identifier of a name, registering it first if
+     * needed.
+     * @param name The name of the type.
+     * @exception std::length_error All the identifiers are in use.
+     * @return The identifier of the name.
+     * @post Exception quarantee: strong
+     */
+    TypeId intern(const std::string& name);
+
+    /**
+     * @brief find gives the identifier of a name without registering it.
+     * @param name The name of the type.
+     * @return The identifier of the name, NO_TYPE if it is not registered.
+     * @post Exception quarantee: nothrow
+     */
+    TypeId find(const std::string& name) const;
+
+    /**
+     * @brief nameOf gives the name of an identifier.
+     * @param id The identifier.
+     * @return The name, empty if the identifier is not in use.
+     * @post Exception quarantee: nothrow
+     */
+    const std::string& nameOf(TypeId id) const;
+
+  private:
+
+    TypeRegistry();
+
+    mutable std::mutex mutex_;
+
+    //! Names by identifier, a deque so that the references stay valid.
+    std::deque<std::string> names_;
+    std::unordered_map<std::string, TypeId> ids_;
+
+};
+
+}
+
+#endif // TYPEREGISTRY_HH
@@ -0,0 +1,118 @@
+#include "undolog.hh"
+
+#include "igameboard.hh"
+
+#include <algorithm>
+
+namespace Common {
+
+namespace {
+
+// Records of the same object are looked for among this many of the newest
+// records. A move changes a hex a few times in a row, for example when a
+// transport and its passengers leave it, so a short look back catches most
+// repeats in constant time. A repeat that is missed only costs a record.
+const std::size_t REPEAT_LOOKBACK = 8;
+
+// True if one of the newest records of the open level is about object
+template <class Records, class Object, class Get>
+bool isSaved(const Records& records, std::size_t levelStart,
+             const Object* object, Get get)
+{
+    std::size_t first = records.size() - std::min(
+                records.size() - levelStart, REPEAT_LOOKBACK);
+    for (std::size_t i = records.size(); i > first; --i) {
+        if (get(records[i - 1]) == object) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+UndoLog* UndoLog::of(const Hex& hex)
+{
+    const IGameBoard* board = hex.getBoard();
+    if (board == nullptr) {
+        return nullptr;
+    }
+    UndoLog* log = board->getUndoLog();
+    if (log == nullptr) {
+        return nullptr;
+    }
+    ++log->generation_;
+    return log->isRecording() ? log : nullptr;
+}
+
+void UndoLog::begin()
+{
+    levels_.push_back(Level{hexes_.size(), actors_.size(), transports_.size(),
+                            entries_.size()});
+}
+
+void UndoLog::undo()
+{
+    Level level = levels_.back();
+    levels_.pop_back();
+    ++generation_;
+
+    // Transports before hexes, so that the listeners of the hexes are last
+    // told about the hexes with their passengers restored
+    while (entries_.size() > level.entries) {
+        const EntryRecord& record = entries_.back();
+        record.target->restoreEntry(record.table, record.key, record.value);
+        entries_.pop_back();
+    }
+    while (actors_.size() > level.actors) {
+        actors_.back().actor->restoreState(actors_.back().state);
+        actors_.pop_back();
+    }
+    while (transports_.size() > level.transports) {
+        transports_.back().transport->restoreState(transports_.back().state);
+        transports_.pop_back();
+    }
+    while (hexes_.size() > level.hexes) {
+        hexes_.back().hex->restoreState(hexes_.back().state);
+        hexes_.pop_back();
+    }
+}
+
+void UndoLog::saveHex(Hex& hex)
+{
+    if (isSaved(hexes_, levels_.back().hexes, &hex,
+                [](const HexRecord& record) { return record.hex; })) {
+        return;
+    }
+    hexes_.push_back(HexRecord{&hex, hex.saveState()});
+}
+
+void UndoLog::saveActor(Actor& actor)
+{
+    if (isSaved(actors_, levels_.back().actors, &actor,
+                [](const ActorRecord& record) { return record.actor.get(); })) {
+        return;
+    }
+    actors_.push_back(ActorRecord{actor.shared_from_this(),
+                                  actor.saveState()});
+}
+
+void UndoLog::saveTransport(Transport& transport)
+{
+    if (isSaved(transports_, levels_.back().transports, &transport,
+                [](const TransportRecord& record) {
+                    return record.transport.get();
+                })) {
+        return;
+    }
+    transports_.push_back(TransportRecord{transport.shared_from_this(),
+                                          transport.saveState()});
+}
+
+void UndoLog::saveEntry(IUndoTarget& target, int table, int key,
+                        std::shared_ptr<void> value)
+{
+    entries_.push_back(EntryRecord{&target, table, key, std::move(value)});
+}
+
+}
@@ -0,0 +1,173 @@
+#ifndef UNDOLOG_HH
+#define UNDOLOG_HH
+
+#include "actor.hh"
+#include "hex.hh"
+#include "iundotarget.hh"
+#include "transport.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @file
+ * @brief Log of the changes to a board, for taking moves back.
+ */
+
+namespace Common {
+
+/**
+ * @brief Records the state of hexes, pieces and board tables before they
+ * change, so that a sequence of changes can be taken back.
+ * @details The log is organized in levels opened with begin(). While a level
+ * is open, each hex, actor and transport saves its state to the log of its
+ * board before it changes, and undo() puts the saved states back in reverse
+ * order. The cost of an undo depends on the number of changes, not on the
+ * size of the board. Levels nest, so a search can take back one move at a
+ * time. The records are kept in vectors that are reused between levels, so
+ * recording doesn't allocate once they have grown.
+ *
+ * Pawns are not saved on their own: a pawn on a hex has the coordinates of
+ * the hex, so restoring a hex restores the coordinates of its pawns.
+ */
+class UndoLog {
+
+  public:
+
+    /**
+     * @brief Default constructor, creates a log with no open levels.
+     */
+    UndoLog() = default;
+
+    UndoLog(const UndoLog&) = delete;
+    UndoLog& operator=(const UndoLog&) = delete;
+
+    /**
+     * @brief of returns the log that records the changes of a hex.
+     * @details Called by the hex and its pieces before they change, so it
+     * also counts the change in the generation of the log of the board.
+     * @param hex The hex.
+     * @return The log of the board of the hex, nullptr if the hex is not on
+     * a board, the board has no log or the log has no open level.
+     * @post Exception quarantee: nothrow
+     */
+    static UndoLog* of(const Hex& hex);
+
+    /**
+     * @brief generation tells how many times the hexes of the boards of the
+     * log have changed, whether a level was open or not.
+     * @details An undo() counts as a change. Answers computed from the
+     * board stay valid while the generation is the same.
+     * @return The number of changes so far.
+     */
+    std::uint64_t generation() const { return generation_; }
+
+    /**
+     * @brief begin opens a level, the changes made after it are taken back
+     * by the matching undo().
+     * @post Exception quarantee: strong
+     */
+    void begin();
+
+    /**
+     * @brief undo takes back the changes made after the last begin() and
+     * closes its level.
+     * @pre depth() > 0
+     * @post The hexes, pieces and tables are as they were at the last
+     * begin(). Exception quarantee: basic
+     */
+    void undo();
+
+    /**
+     * @brief depth tells the number of open levels.
+     * @return The number of begin() calls without an undo().
+     */
+    std::size_t depth() const { return levels_.size(); }
+
+    /**
+     * @brief isRecording tells if changes are saved.
+     * @return true if a level is open.
+     */
+    bool isRecording() const { return !levels_.empty(); }
+
+    /**
+     * @brief saveHex saves the piece type and the pawns, actors and
+     * transports of a hex. Called by the hex before it changes.
+     * @param hex The hex, owned by a board that outlives the level.
+     * @post Exception quarantee: strong
+     */
+    void saveHex(Hex& hex);
+
+    /**
+     * @brief saveActor saves the hex of an actor. Called by the actor
+     * before it changes hex.
+     * @param actor The actor.
+     * @post Exception quarantee: strong
+     */
+    void saveActor(Actor& actor);
+
+    /**
+     * @brief saveTransport saves the hex and the passengers of a transport.
+     * Called by the transport before they change.
+     * @param transport The transport.
+     * @post Exception quarantee: strong
+     */
+    void saveTransport(Transport& transport);
+
+    /**
+     * @brief saveEntry saves an entry of a table of a target, undo() gives
+     * it back to IUndoTarget::restoreEntry().
+     * @param target The owner of the table, outlives the level.
+     * @param table Table of the entry, defined by the target.
+     * @param key Key of the entry in the table.
+     * @param value The value of the entry, nullptr if there is none.
+     * @post Exception quarantee: strong
+     */
+    void saveEntry(IUndoTarget& target, int table, int key,
+                   std::shared_ptr<void> value);
+
+  private:
+
+    //! Number of records of each kind when a level was opened.
+    struct Level {
+        std::size_t hexes;
+        std::size_t actors;
+        std::size_t transports;
+        std::size_t entries;
+    };
+
+    struct HexRecord {
+        Hex* hex;
+        Hex::State state;
+    };
+
+    struct ActorRecord {
+        std::shared_ptr<Actor> actor;
+        Actor::State state;
+    };
+
+    struct TransportRecord {
+        std::shared_ptr<Transport> transport;
+        Transport::State state;
+    };
+
+    struct EntryRecord {
+        IUndoTarget* target;
+        int table;
+        int key;
+        std::shared_ptr<void> value;
+    };
+
+    std::uint64_t generation_ = 0;
+    std::vector<Level> levels_;
+    std::vector<HexRecord> hexes_;
+    std::vector<ActorRecord> actors_;
+    std::vector<TransportRecord> transports_;
+    std::vector<EntryRecord> entries_;
+};
+
+}
+
+#endif // UNDOLOG_HH
@@ -0,0 +1,101 @@
+#ifndef VARINT_HH
+#define VARINT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Variable length integers of the binary formats, see GameLog and
+ * ReplayWriter.
+ */
+
+namespace Common {
+
+/**
+ * @brief Encoding of integers in seven bits per byte, the highest bit of a
+ * byte telling that more bytes follow. Small values take one byte.
+ */
+namespace Varint {
+
+//! Longest encoding of a 64 bit integer.
+const int MAX_BYTES = 10;
+
+/**
+ * @brief zigzag maps small negative numbers to small unsigned ones:
+ * 0, -1, 1, -2... to 0, 1, 2, 3...
+ */
+inline std::uint64_t zigzag(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^
+            static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief unzigzag undoes zigzag().
+ */
+inline std::int64_t unzigzag(std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1) ^
+            -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * @brief put encodes a value into a buffer.
+ * @param out The buffer, has room for MAX_BYTES bytes.
+ * @param value The value.
+ * @return The number of bytes written.
+ */
+inline int put(std::uint8_t* out, std::uint64_t value)
+{
+    int size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<std::uint8_t>(value);
+    return size;
+}
+
+/**
+ * @brief append encodes a value to the end of a vector.
+ * @param bytes The vector.
+ * @param value The value.
+ * @post Exception quarantee: strong
+ */
+inline void append(std::vector<std::uint8_t>& bytes, std::uint64_t value)
+{
+    std::uint8_t buffer[MAX_BYTES];
+    bytes.insert(bytes.end(), buffer, buffer + put(buffer, value));
+}
+
+/**
+ * @brief get decodes a value.
+ * @param data The encoded bytes.
+ * @param size Number of bytes.
+ * @param position Offset of the value, moved past it.
+ * @param value Set to the value.
+ * @return false, if the value is cut short or longer than MAX_BYTES bytes.
+ * @post Exception quarantee: nothrow
+ */
+inline bool get(const std::uint8_t* data, std::size_t size,
+                std::size_t& position, std::uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 7 * MAX_BYTES && position < size;
+         shift += 7) {
+        std::uint8_t byte = data[position++];
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+}
+
+#endif // VARINT_HH
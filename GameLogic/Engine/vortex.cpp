@@ -14,8 +14,10 @@ void Vortex::move(std::shared_ptr<Hex> to)
 
 void Vortex::doAction()
 {
-    hex_->clearAllFromNeightbours();
-    hex_->clear();
+    recordAction();
+    std::shared_ptr<Hex> hex = getHex();
+    hex->clearAllFromNeightbours();
+    hex->clear();
 }
 
 std::string Vortex::getActorType() const
@@ -23,4 +25,9 @@ std::string Vortex::getActorType() const
     return "vortex";
 }
 
+TypeId Vortex::getActorTypeId() const
+{
+    return VORTEX_TYPE;
+}
+
 }
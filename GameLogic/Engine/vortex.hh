@@ -32,6 +32,11 @@ public:
      * @copydoc Common::Actor::getActorType()
      */
     virtual std::string getActorType() const;
+
+    /**
+     * @copydoc Common::Actor::getActorTypeId()
+     */
+    virtual Common::TypeId getActorTypeId() const;
 };
 }
 #endif // VORTEX_HH
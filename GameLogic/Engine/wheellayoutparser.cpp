@@ -1,3 +1,4 @@
+
 #include "wheellayoutparser.hh"
 
 #include "ioexception.hh"
@@ -5,6 +6,7 @@
 
 #include <QFile>
 #include <QString>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 namespace Logic {
@@ -29,40 +31,126 @@ void WheelLayoutParser::readJSON(std::string filePath)
         throw Common::FormatException("JSON parsing failed for input file");
     }
 
-    lastRead_ = json.array();
+    // Everything is converted here once, the spins never touch the JSON
+    WheelLayoutParser read;
+    QJsonArray layout = json.array();
+    for (auto i = 0; i < layout.size(); ++i) {
+        QJsonObject section = layout[i].toObject();
+        read.sections_.push_back(section.value("name").toString().toStdString());
+
+        ChanceVector chances;
+        QJsonObject chancesObject = section.value("chances").toObject();
+        for (auto key: chancesObject.keys()) {
+            int value = chancesObject.value(key).toInt();
+            if (value < 0) {
+                throw Common::FormatException("Negative chance in the"
+                                              " spinner layout");
+            }
+            chances.push_back(std::make_pair(key.toStdString(),
+                                             static_cast<unsigned>(value)));
+        }
+        read.chances_.push_back(chances);
+    }
+    read.compile();
 
+    *this = std::move(read);
 }
 
-std::vector<std::string> WheelLayoutParser::getSections() const
+void WheelLayoutParser::compile()
 {
-    std::vector<std::string> sections;
+    std::vector<std::uint64_t> weights;
+    std::uint64_t total = 0;
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    for (std::size_t section = 0; section < sections_.size(); ++section) {
+        Common::TypeId type = registry.intern(sections_[section]);
+        for (const auto& chance : chances_[section]) {
+            resultTypes_.push_back(type);
+            results_.push_back(SpinResult(sections_[section], chance.first));
+            weights.push_back(chance.second);
+            total += chance.second;
+        }
+    }
+    if (total == 0) {
+        throw Common::FormatException("The spinner layout has no chances");
+    }
+    // Keeps the thresholds below exact in 64 bits
+    if (total > UINT32_MAX) {
+        throw Common::FormatException("The chances of the spinner layout"
+                                      " are too large");
+    }
+
+    // Vose's alias method in integers: every column holds total units, a
+    // result with weight w brings w * count units
+    std::uint64_t count = results_.size();
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        weights[i] *= count;
+        (weights[i] < total ? small : large).push_back(i);
+    }
 
-    for (auto i = 0; i < lastRead_.size(); ++i){
-        sections.push_back(lastRead_[i].toObject().value("name").toString().toStdString());
+    aliasTable_.assign(count, AliasSlot{0, 0});
+    while (!small.empty() && !large.empty()) {
+        std::uint32_t less = small.back();
+        small.pop_back();
+        std::uint32_t more = large.back();
+
+        // The rest of the column of less is filled from more
+        aliasTable_[less].threshold = (weights[less] << 32) / total;
+        aliasTable_[less].alias = more;
+        weights[more] -= total - weights[less];
+        if (weights[more] < total) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // The columns left over are exactly full
+    for (std::uint32_t i : large) {
+        aliasTable_[i] = AliasSlot{std::uint64_t(1) << 32, i};
     }
-    return sections;
+    for (std::uint32_t i : small) {
+        aliasTable_[i] = AliasSlot{std::uint64_t(1) << 32, i};
+    }
+}
+
+std::vector<std::string> WheelLayoutParser::getSections() const
+{
+    return sections_;
 }
 
 ChanceVector WheelLayoutParser::getChancesForSection(std::string section) const
 {
-    std::vector<std::pair<std::string, unsigned>> chances;
-
-    for (auto i = 0; i < lastRead_.size(); ++i) {
-        auto currentSection = lastRead_[i].toObject().value("name").toString().toStdString();
-        if ( currentSection == section ) {
-            auto chancesObject = lastRead_[i].toObject().value("chances").toObject();
-            for(auto key: chancesObject.keys()){
-                auto value = chancesObject.value(key);
-                chances.push_back(std::make_pair<std::string, unsigned>(key.toStdString(),
-                                                                        (unsigned) value.toInt()));
-            }
+    for (std::size_t i = 0; i < sections_.size(); ++i) {
+        if (sections_[i] == section) {
+            return chances_[i];
         }
     }
-    return chances;
+    return ChanceVector();
+}
+
+const WheelLayoutParser::SpinResult& WheelLayoutParser::spin(
+        GameRandom& rng) const
+{
+    return results_[draw(rng)];
+}
+
+const WheelLayoutParser::SpinResult& WheelLayoutParser::spin(
+        GameRandom& rng, Common::TypeId& type) const
+{
+    std::size_t index = draw(rng);
+    type = resultTypes_[index];
+    return results_[index];
+}
+
+std::size_t WheelLayoutParser::draw(GameRandom& rng) const
+{
+    std::uint32_t column = rng.below(aliasTable_.size());
+    const AliasSlot& slot = aliasTable_[column];
+    return rng() < slot.threshold ? column : slot.alias;
 }
 
 bool WheelLayoutParser::isFileRead()
 {
-    return !lastRead_.empty();
+    return !sections_.empty();
 }
 }
@@ -2,16 +2,25 @@
 #define WHEELLAYOUTPARSER_HH
 
 
-#include <QJsonArray>
+#include "gamerandom.hh"
+#include "typeregistry.hh"
+
+#include <cstdint>
 #include <string>
 #include <vector>
 namespace Logic {
 /**
  * @brief JSON parser for reading the spin wheel layout
+ * @details The layout is compiled into an alias table when it is read, so a
+ * spin costs two random numbers and two array reads, and the chance of every
+ * result is its weight in the layout divided by the sum of all the weights.
  */
 class WheelLayoutParser
 {
 public:
+    //! A section and its move amount, e.g. ("shark", "2").
+    using SpinResult = std::pair<std::string, std::string>;
+
     WheelLayoutParser() = default;
     /**
      * @brief WheelLayoutParser
@@ -25,7 +34,8 @@ public:
      * @brief Reads the file in given string
      * @param filePath file path to layout file
      * @exception IOException Could not open the given json for reading.
-     * @exception FormatException Format of the given json is invalid.
+     * @exception FormatException Format of the given json is invalid, a
+     * chance is negative or all the chances are zero.
      * @post The contents of read file can be queried.
      * @post Exception quarantee: strog
      */
@@ -41,16 +51,54 @@ public:
      * @return the chances of a specific section
      */
     std::vector<std::pair<std::string, unsigned>> getChancesForSection(std::string section) const;
+    /**
+     * @brief spin draws a section and its move amount by their weights.
+     * @param rng The generator to draw from.
+     * @pre isFileRead()
+     * @return The drawn result, valid until the next readJSON.
+     * @post Exception quarantee: nothrow
+     */
+    const SpinResult& spin(GameRandom& rng) const;
+    /**
+     * @brief spin draws a section and its move amount by their weights.
+     * @param rng The generator to draw from.
+     * @param type Set to the interned type of the drawn section.
+     * @pre isFileRead()
+     * @return The drawn result, valid until the next readJSON.
+     * @post Draws the same as spin(rng).
+     * @post Exception quarantee: nothrow
+     */
+    const SpinResult& spin(GameRandom& rng, Common::TypeId& type) const;
     /**
      * @brief isFileRead
      * @return true if a file has been read.
      */
     bool isFileRead();
 private:
-    QJsonArray lastRead_;
+    //! One column of the alias table.
+    struct AliasSlot {
+        //! The column's own result is taken if a 32-bit draw is below this.
+        std::uint64_t threshold;
+        //! Index of the result taken otherwise.
+        std::uint32_t alias;
+    };
+
+    void compile();
+
+    //! Index of a result drawn by the weights.
+    std::size_t draw(GameRandom& rng) const;
+
+    std::vector<std::string> sections_;
+    std::vector<std::vector<std::pair<std::string, unsigned>>> chances_;
+
+    //! Every (section, amount) pair and the alias table over them.
+    std::vector<SpinResult> results_;
+    //! The section of every result interned when the layout is read, so
+    //! that a spin doesn't look it up.
+    std::vector<Common::TypeId> resultTypes_;
+    std::vector<AliasSlot> aliasTable_;
 
 };
 
 }
 #endif // WHEELLAYOUTPARSER_HH
-
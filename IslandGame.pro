@@ -2,7 +2,10 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     Tests \
+    Benchmarks \
     UI \
+    Simulator \
     GameLogic
 
 UI.depends = GameLogic
+Simulator.depends = GameLogic
@@ -0,0 +1,62 @@
+QT       -= gui
+
+TARGET = Simulator
+TEMPLATE = app
+CONFIG += console c++14 thread
+CONFIG -= app_bundle
+
+SOURCES += main.cpp \
+    simulation.cpp \
+    headlessgame.cpp \
+    simplayer.cpp \
+    simstate.cpp \
+    simstats.cpp \
+    randompolicy.cpp \
+    cautiouspolicy.cpp \
+    workstealingpool.cpp \
+    gamerecorder.cpp \
+    recordedpolicy.cpp \
+    verification.cpp \
+    ../UI/gameboardbase.cpp \
+    ../UI/gameboard.cpp \
+    ../UI/flatgameboard.cpp
+
+HEADERS += \
+    simulation.hh \
+    headlessgame.hh \
+    simplayer.hh \
+    simstate.hh \
+    simstats.hh \
+    ipolicy.hh \
+    randompolicy.hh \
+    cautiouspolicy.hh \
+    workstealingpool.hh \
+    gamerecorder.hh \
+    recordedpolicy.hh \
+    verification.hh \
+    ../UI/gameboardbase.hh \
+    ../UI/gameboard.hh \
+    ../UI/flatgameboard.hh
+
+INCLUDEPATH += $$PWD/../GameLogic/Engine \
+                $$PWD/../UI
+DEPENDPATH += $$PWD/../GameLogic/Engine \
+                $$PWD/../UI
+
+CONFIG(release, debug|release) {
+   DESTDIR = release
+}
+
+CONFIG(debug, debug|release) {
+   DESTDIR = debug
+}
+
+LIBS += -L$$OUT_PWD/../GameLogic/Engine
+LIBS += -L$$OUT_PWD/../GameLogic/Engine/$${DESTDIR}/ -lEngine
+
+# The engine reads its configuration from Assets/ in the working directory
+unix {
+    copyfiles.commands += cp -r $$_PRO_FILE_PWD_/../GameLogic/Assets $$DESTDIR
+    QMAKE_EXTRA_TARGETS += copyfiles
+    POST_TARGETDEPS += copyfiles
+}
@@ -0,0 +1,96 @@
+#include "cautiouspolicy.hh"
+#include "boardindex.hh"
+#include "hex.hh"
+#include "pawn.hh"
+
+#include <algorithm>
+#include <climits>
+
+namespace Simulation {
+
+namespace {
+
+int distance(Common::CubeCoordinate a, Common::CubeCoordinate b)
+{
+    return Common::BoardIndex::distanceFromCenter(
+                Common::CubeCoordinate(a.x - b.x, a.y - b.y, a.z - b.z));
+}
+
+}
+
+CautiousPolicy::CautiousPolicy(unsigned int seed):
+    rng_(seed)
+{
+}
+
+std::size_t CautiousPolicy::chooseMove(const PolicyContext& context,
+                                       const std::vector<Move>& moves)
+{
+    int bestScore = INT_MIN;
+    std::size_t best = 0;
+    unsigned int ties = 0;
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        int moveScore = score(context, moves[i]);
+        if (moveScore > bestScore) {
+            bestScore = moveScore;
+            best = i;
+            ties = 1;
+        } else if (moveScore == bestScore) {
+            // Reservoir sampling keeps every tied move equally likely
+            ++ties;
+            if (std::uniform_int_distribution<unsigned int>(1, ties)(rng_) == 1) {
+                best = i;
+            }
+        }
+    }
+    return best;
+}
+
+int CautiousPolicy::score(const PolicyContext& context, const Move& move) const
+{
+    Common::CubeCoordinate center(0, 0, 0);
+
+    switch (move.type) {
+    case Move::PAWN: {
+        // Water is dangerous and the island sinks from the shore inwards
+        bool water = context.board->isWaterTile(move.target);
+        return (water ? -100 : 0) - distance(move.target, center);
+    }
+    case Move::PASS: {
+        // Staying put is as good as moving to the current hex
+        if (context.phase != Common::GamePhase::MOVEMENT ||
+                context.pawns.empty()) {
+            return 0;
+        }
+        int best = INT_MIN;
+        for (const auto& pawn : context.pawns) {
+            bool water = context.board->isWaterTile(pawn);
+            best = std::max(best, (water ? -100 : 0) - distance(pawn, center));
+        }
+        return best;
+    }
+    case Move::FLIP: {
+        int nearest = INT_MAX;
+        for (const auto& pawn : context.pawns) {
+            nearest = std::min(nearest, distance(pawn, move.target));
+        }
+        return nearest == INT_MAX ? 0 : nearest;
+    }
+    case Move::ACTOR: {
+        int victims = 0;
+        std::shared_ptr<Common::Hex> hex = context.board->getHex(move.target);
+        if (hex != nullptr) {
+            for (const auto& pawn : hex->getPawnSpan()) {
+                victims += pawn->getPlayerId() != context.playerId ? 1 : -1;
+            }
+        }
+        return victims;
+    }
+    case Move::TRANSPORT:
+        return 0;
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef CAUTIOUSPOLICY_HH
+#define CAUTIOUSPOLICY_HH
+
+#include "ipolicy.hh"
+
+#include <random>
+
+/**
+ * @file
+ * @brief Policy that keeps its pawns on the high ground.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Moves pawns towards the center of the island, sinks tiles far from
+ * its own pawns and sends the sea creatures after the pawns of others.
+ * @details Moves with equal scores are chosen at random.
+ */
+class CautiousPolicy : public IPolicy
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param seed Seed of the tie breaks.
+     */
+    explicit CautiousPolicy(unsigned int seed);
+
+    /**
+     * @copydoc IPolicy::chooseMove()
+     */
+    virtual std::size_t chooseMove(const PolicyContext& context,
+                                   const std::vector<Move>& moves);
+
+private:
+    int score(const PolicyContext& context, const Move& move) const;
+
+    std::mt19937 rng_;
+};
+
+}
+
+#endif // CAUTIOUSPOLICY_HH
@@ -0,0 +1,424 @@
+#include "gamerecorder.hh"
+#include "formatexception.hh"
+#include "varint.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace Simulation {
+
+namespace {
+
+const std::size_t HEADER_SIZE = sizeof(GameRecorder::RECORDING_MAGIC) + 1;
+
+const std::uint64_t HASH_START = 0xcbf29ce484222325ull;
+const std::uint64_t HASH_PRIME = 0x100000001b3ull;
+
+std::uint64_t hashBytes(const std::string& bytes)
+{
+    std::uint64_t hash = HASH_START;
+    for (char byte : bytes) {
+        hash = (hash ^ static_cast<std::uint8_t>(byte)) * HASH_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Mixes the numbers of a state into one hash, a word at a time.
+ */
+class StateHash
+{
+public:
+    StateHash(): hash_(HASH_START) {}
+
+    void add(std::uint64_t value)
+    {
+        hash_ = (hash_ ^ value) * HASH_PRIME;
+        hash_ ^= hash_ >> 29;
+    }
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_;
+};
+
+/**
+ * @brief Reads the fields of the records.
+ */
+class Decoder
+{
+public:
+    Decoder(const std::uint8_t* data, std::size_t size):
+        data_(data), size_(size), position_(0)
+    {
+    }
+
+    std::size_t position() const { return position_; }
+
+    std::uint64_t get()
+    {
+        std::uint64_t value;
+        if (!Common::Varint::get(data_, size_, position_, value)) {
+            throw Common::FormatException("Recording cut short");
+        }
+        return value;
+    }
+
+    int getSigned()
+    {
+        return static_cast<int>(Common::Varint::unzigzag(get()));
+    }
+
+    std::string getString()
+    {
+        std::uint64_t length = get();
+        if (length > size_ - position_) {
+            throw Common::FormatException("Recording cut short");
+        }
+        std::string string(reinterpret_cast<const char*>(data_ + position_),
+                           static_cast<std::size_t>(length));
+        position_ += static_cast<std::size_t>(length);
+        return string;
+    }
+
+    Common::CubeCoordinate getCoordinate()
+    {
+        int x = getSigned();
+        int z = getSigned();
+        return Common::CubeCoordinate(x, -x - z, z);
+    }
+
+    Move getMove()
+    {
+        Move move{static_cast<Move::Type>(get()), Common::CubeCoordinate(),
+                  Common::CubeCoordinate(), 0};
+        if (move.type != Move::PASS) {
+            move.origin = getCoordinate();
+            move.target = getCoordinate();
+            move.id = getSigned();
+        }
+        return move;
+    }
+
+private:
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t position_;
+};
+
+const char* const MOVE_NAMES[] = {"pass", "pawn", "transport", "actor", "flip"};
+
+}
+
+DivergenceError::DivergenceError(const std::string& msg):
+    std::runtime_error(msg)
+{
+}
+
+const char GameRecorder::RECORDING_MAGIC[4] = {'I', 'G', 'R', 'C'};
+const std::uint8_t GameRecorder::RECORDING_VERSION;
+
+GameRecorder::GameRecorder(unsigned int game, unsigned int seed,
+                           unsigned int players, unsigned int maxTurns):
+    data_(nullptr),
+    size_(0),
+    position_(0),
+    game_(game),
+    seed_(seed),
+    players_(players),
+    maxTurns_(maxTurns),
+    rounds_(0),
+    turns_(0)
+{
+    record_.clear();
+    put(game_);
+    put(seed_);
+    put(players_);
+    put(maxTurns_);
+    bytes_ = record_;
+}
+
+GameRecorder::GameRecorder(const std::uint8_t* data, std::size_t size):
+    data_(data),
+    size_(size),
+    position_(0),
+    rounds_(0),
+    turns_(0)
+{
+    Decoder decoder(data_, size_);
+    game_ = static_cast<unsigned int>(decoder.get());
+    seed_ = static_cast<unsigned int>(decoder.get());
+    players_ = static_cast<unsigned int>(decoder.get());
+    maxTurns_ = static_cast<unsigned int>(decoder.get());
+    position_ = decoder.position();
+}
+
+std::string GameRecorder::position() const
+{
+    std::ostringstream text;
+    text << "game " << game_ << ", round " << rounds_ << ", turn "
+         << turns_ + 1;
+    return text.str();
+}
+
+Move GameRecorder::recordedMove() const
+{
+    try {
+        Decoder decoder(data_ + position_, size_ - position_);
+        if (decoder.get() ==
+                static_cast<std::uint8_t>(RecordType::MOVE_CHOSEN)) {
+            return decoder.getMove();
+        }
+    } catch (const Common::FormatException&) {
+    }
+    throw DivergenceError(position() + ": recorded " +
+                          describe(data_ + position_, size_ - position_) +
+                          ", the game asks for a move");
+}
+
+std::string GameRecorder::describeMove(const Move& move)
+{
+    std::ostringstream text;
+    if (move.type < Move::PASS || move.type > Move::FLIP) {
+        text << "move of unknown type " << move.type;
+        return text.str();
+    }
+    text << MOVE_NAMES[move.type] << " move";
+    if (move.type != Move::PASS) {
+        text << " of " << move.id << " from " << move.origin.x << ","
+             << move.origin.y << "," << move.origin.z << " to "
+             << move.target.x << "," << move.target.y << "," << move.target.z;
+    }
+    return text.str();
+}
+
+void GameRecorder::roundStarted(int firstPlayer, unsigned int engineSeed)
+{
+    record_.clear();
+    record_.push_back(static_cast<std::uint8_t>(RecordType::ROUND_STARTED));
+    putSigned(firstPlayer);
+    put(engineSeed);
+    commit();
+    ++rounds_;
+    turns_ = 0;
+}
+
+void GameRecorder::moveChosen(const Move& move)
+{
+    record_.clear();
+    record_.push_back(static_cast<std::uint8_t>(RecordType::MOVE_CHOSEN));
+    put(move.type);
+    if (move.type != Move::PASS) {
+        putSigned(move.origin.x);
+        putSigned(move.origin.z);
+        putSigned(move.target.x);
+        putSigned(move.target.z);
+        putSigned(move.id);
+    }
+    commit();
+}
+
+void GameRecorder::commandAnswered(int result, const std::string& text)
+{
+    record_.clear();
+    record_.push_back(static_cast<std::uint8_t>(RecordType::COMMAND_ANSWERED));
+    putSigned(result);
+    putString(text);
+    commit();
+}
+
+void GameRecorder::turnEnded(const Common::GameSnapshot& snapshot)
+{
+    StateHash hash;
+    hash.add(snapshot.terrain.size());
+    for (Common::TypeId type : snapshot.terrain) {
+        hash.add(typeHash(type));
+    }
+    for (const auto* pieces : {&snapshot.pawns, &snapshot.actors,
+                               &snapshot.transports}) {
+        hash.add(pieces->size());
+        for (const auto& piece : *pieces) {
+            hash.add(static_cast<std::uint64_t>(piece.id));
+            hash.add(typeHash(piece.type));
+            hash.add(static_cast<std::uint64_t>(piece.owner));
+            hash.add(static_cast<std::uint64_t>(piece.hex));
+            hash.add(static_cast<std::uint64_t>(piece.passengerCount));
+            for (int i = 0; i < piece.passengerCount; ++i) {
+                hash.add(static_cast<std::uint64_t>(
+                             snapshot.passengers[piece.firstPassenger + i]));
+            }
+        }
+    }
+    hash.add(snapshot.players.size());
+    for (const auto& player : snapshot.players) {
+        hash.add(static_cast<std::uint64_t>(player.id));
+        hash.add(player.actionsLeft);
+    }
+    hash.add(snapshot.phase);
+    hash.add(static_cast<std::uint64_t>(snapshot.currentPlayer));
+    hash.add(snapshot.islandPieces.size());
+    for (const auto& pieces : snapshot.islandPieces) {
+        hash.add(typeHash(pieces.first));
+        hash.add(static_cast<std::uint64_t>(pieces.second));
+    }
+    hash.add(snapshot.spun);
+    hash.add(typeHash(snapshot.spinType));
+    hash.add(hashBytes(snapshot.spinMoves));
+    hash.add(static_cast<std::uint64_t>(snapshot.lastActorId));
+    hash.add(static_cast<std::uint64_t>(snapshot.lastTransportId));
+
+    record_.clear();
+    record_.push_back(static_cast<std::uint8_t>(RecordType::TURN_ENDED));
+    put(hash.value());
+    put(snapshot.rng.state());
+    commit();
+    ++turns_;
+}
+
+void GameRecorder::gameEnded(int winner)
+{
+    record_.clear();
+    record_.push_back(static_cast<std::uint8_t>(RecordType::GAME_ENDED));
+    putSigned(winner);
+    commit();
+}
+
+void GameRecorder::finish() const
+{
+    if (verifying() && position_ != size_) {
+        throw DivergenceError(position() + ": the game ended, recorded " +
+                              describe(data_ + position_, size_ - position_));
+    }
+}
+
+void GameRecorder::writeHeader(std::ostream& out)
+{
+    out.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    out.put(static_cast<char>(RECORDING_VERSION));
+}
+
+void GameRecorder::writeGame(std::ostream& out) const
+{
+    std::uint8_t size[Common::Varint::MAX_BYTES];
+    out.write(reinterpret_cast<const char*>(size),
+              Common::Varint::put(size, bytes_.size()));
+    out.write(reinterpret_cast<const char*>(bytes_.data()),
+              static_cast<std::streamsize>(bytes_.size()));
+}
+
+void GameRecorder::findGames(const std::uint8_t* data, std::size_t size,
+                             std::vector<std::pair<std::size_t, std::size_t>>&
+                             games)
+{
+    if (size < HEADER_SIZE ||
+            !std::equal(RECORDING_MAGIC,
+                        RECORDING_MAGIC + sizeof(RECORDING_MAGIC),
+                        reinterpret_cast<const char*>(data))) {
+        throw Common::FormatException("Not a recordings file");
+    }
+    if (data[sizeof(RECORDING_MAGIC)] != RECORDING_VERSION) {
+        throw Common::FormatException("Unsupported recordings version");
+    }
+
+    std::size_t position = HEADER_SIZE;
+    while (position < size) {
+        std::uint64_t gameSize;
+        if (!Common::Varint::get(data, size, position, gameSize) ||
+                gameSize > size - position) {
+            throw Common::FormatException("Recordings file cut short");
+        }
+        games.emplace_back(position, static_cast<std::size_t>(gameSize));
+        position += static_cast<std::size_t>(gameSize);
+    }
+}
+
+void GameRecorder::put(std::uint64_t value)
+{
+    Common::Varint::append(record_, value);
+}
+
+void GameRecorder::putSigned(std::int64_t value)
+{
+    put(Common::Varint::zigzag(value));
+}
+
+void GameRecorder::putString(const std::string& string)
+{
+    put(string.size());
+    record_.insert(record_.end(), string.begin(), string.end());
+}
+
+std::uint64_t GameRecorder::typeHash(Common::TypeId type)
+{
+    if (type >= typeHashes_.size()) {
+        typeHashes_.resize(type + 1u, 0);
+    }
+    if (typeHashes_[type] == 0) {
+        typeHashes_[type] = hashBytes(
+                    Common::TypeRegistry::getInstance().nameOf(type));
+    }
+    return typeHashes_[type];
+}
+
+void GameRecorder::commit()
+{
+    if (!verifying()) {
+        bytes_.insert(bytes_.end(), record_.begin(), record_.end());
+        return;
+    }
+    if (record_.size() > size_ - position_ ||
+            !std::equal(record_.begin(), record_.end(), data_ + position_)) {
+        throw DivergenceError(position() + ": recorded " +
+                              describe(data_ + position_, size_ - position_) +
+                              ", played " +
+                              describe(record_.data(), record_.size()));
+    }
+    position_ += record_.size();
+}
+
+std::string GameRecorder::describe(const std::uint8_t* data,
+                                   std::size_t size) const
+{
+    if (size == 0) {
+        return "the end of the game";
+    }
+    std::ostringstream text;
+    try {
+        Decoder decoder(data, size);
+        switch (static_cast<RecordType>(decoder.get())) {
+        case RecordType::ROUND_STARTED: {
+            int firstPlayer = decoder.getSigned();
+            text << "round started by player " << firstPlayer
+                 << " with engine seed " << decoder.get();
+            break;
+        }
+        case RecordType::MOVE_CHOSEN:
+            text << describeMove(decoder.getMove());
+            break;
+        case RecordType::COMMAND_ANSWERED: {
+            int result = decoder.getSigned();
+            text << "answer " << result << " \"" << decoder.getString()
+                 << "\"";
+            break;
+        }
+        case RecordType::TURN_ENDED: {
+            std::uint64_t stateHash = decoder.get();
+            text << std::hex << "turn ended with state hash " << stateHash
+                 << " and random state " << decoder.get();
+            break;
+        }
+        case RecordType::GAME_ENDED:
+            text << "game ended with winner " << decoder.getSigned();
+            break;
+        default:
+            text << "a record of unknown type " << static_cast<int>(data[0]);
+            break;
+        }
+    } catch (const Common::FormatException&) {
+        text << "a record cut short";
+    }
+    return text.str();
+}
+
+}
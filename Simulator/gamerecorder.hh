@@ -0,0 +1,205 @@
+#ifndef GAMERECORDER_HH
+#define GAMERECORDER_HH
+
+#include "gamesnapshot.hh"
+#include "ipolicy.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Records headless games and checks them against the engine again.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Thrown when a verified game doesn't go as it was recorded.
+ */
+class DivergenceError : public std::runtime_error
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param msg Where the game diverged and how.
+     */
+    explicit DivergenceError(const std::string& msg);
+};
+
+/**
+ * @brief Records one headless game, or checks a game against its recording.
+ * @details The recording has the random draws of the game, every move the
+ * players chose, the answer of the engine to every command and a hash of
+ * the whole state at the end of every turn with the state of the random
+ * generator of the engine. A game played again with the recorded moves has
+ * to make exactly the same records, so a verifying recorder encodes each
+ * record the same way and compares it to the recorded bytes. The first
+ * record that differs throws a DivergenceError.
+ *
+ * The records are a type byte and variable length integers, see
+ * Common::Varint. The state hash names the piece types instead of using
+ * their ids, the ids depend on the order a program interns the names.
+ */
+class GameRecorder
+{
+public:
+    //! First bytes of a recordings file.
+    static const char RECORDING_MAGIC[4];
+
+    //! Version of the recordings file, the byte after RECORDING_MAGIC.
+    static const std::uint8_t RECORDING_VERSION = 1;
+
+    /**
+     * @brief The kinds of records.
+     */
+    enum class RecordType : std::uint8_t {
+        //! A round started. The first player and the seed of the engine.
+        ROUND_STARTED = 1,
+        //! A player chose a move.
+        MOVE_CHOSEN,
+        //! The engine answered a command. Its result and its text result.
+        COMMAND_ANSWERED,
+        //! A turn ended. The state hash and the random state of the engine.
+        TURN_ENDED,
+        //! The game ended. The winner.
+        GAME_ENDED
+    };
+
+    /**
+     * @brief Constructor, starts recording a game.
+     * @param game Index of the game in its batch.
+     * @param seed Seed of the game.
+     * @param players Number of players.
+     * @param maxTurns Turns after which a round is a draw.
+     */
+    GameRecorder(unsigned int game, unsigned int seed, unsigned int players,
+                 unsigned int maxTurns);
+
+    /**
+     * @brief Constructor, checks a game against its recording.
+     * @param data The recorded game, as returned by bytes(). Has to stay
+     * valid while the recorder is used.
+     * @param size Number of bytes.
+     * @exception FormatException The settings of the game are cut short.
+     */
+    GameRecorder(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief verifying tells if the game is checked against a recording.
+     * @return true, if the recorder was constructed from a recording.
+     */
+    bool verifying() const { return data_ != nullptr; }
+
+    // Settings of the recorded game
+    unsigned int game() const { return game_; }
+    unsigned int seed() const { return seed_; }
+    unsigned int players() const { return players_; }
+    unsigned int maxTurns() const { return maxTurns_; }
+
+    /**
+     * @brief bytes returns the recorded game.
+     * @return The settings and the records, empty when verifying.
+     */
+    const std::vector<std::uint8_t>& bytes() const { return bytes_; }
+
+    /**
+     * @brief position tells where in the game the recorder is.
+     * @return The number of the game, round and turn as text.
+     */
+    std::string position() const;
+
+    /**
+     * @brief recordedMove decodes the move the player chose next.
+     * @details Only when verifying. The move is consumed by moveChosen().
+     * @exception DivergenceError The next record is not a move.
+     * @return The recorded move.
+     */
+    Move recordedMove() const;
+
+    /**
+     * @brief describeMove tells a move in words, for divergence reports.
+     * @param move The move.
+     * @return The type of the move, and its piece and hexes.
+     */
+    static std::string describeMove(const Move& move);
+
+    // The records, see RecordType. Each one throws DivergenceError if it
+    // differs from the recorded one.
+
+    void roundStarted(int firstPlayer, unsigned int engineSeed);
+    void moveChosen(const Move& move);
+    void commandAnswered(int result, const std::string& text);
+    void turnEnded(const Common::GameSnapshot& snapshot);
+    void gameEnded(int winner);
+
+    /**
+     * @brief finish checks that the whole recording was played.
+     * @exception DivergenceError The recording has more records.
+     */
+    void finish() const;
+
+    /**
+     * @brief writeHeader starts a recordings file.
+     * @param out The file.
+     */
+    static void writeHeader(std::ostream& out);
+
+    /**
+     * @brief writeGame appends a recorded game to a recordings file.
+     * @param out The file, started with writeHeader().
+     */
+    void writeGame(std::ostream& out) const;
+
+    /**
+     * @brief findGames finds the games of a recordings file.
+     * @param data The contents of the file.
+     * @param size Number of bytes.
+     * @param games The offset and size of every game is added here.
+     * @exception FormatException The file is not a recordings file of this
+     * version, or it is cut short.
+     */
+    static void findGames(const std::uint8_t* data, std::size_t size,
+                          std::vector<std::pair<std::size_t, std::size_t>>&
+                          games);
+
+private:
+    void put(std::uint64_t value);
+    void putSigned(std::int64_t value);
+    void putString(const std::string& string);
+
+    //! Hash of the name of a type.
+    std::uint64_t typeHash(Common::TypeId type);
+
+    //! Appends the record when recording, compares it when verifying.
+    void commit();
+
+    std::string describe(const std::uint8_t* data, std::size_t size) const;
+
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t position_;
+
+    unsigned int game_;
+    unsigned int seed_;
+    unsigned int players_;
+    unsigned int maxTurns_;
+    unsigned int rounds_;
+    unsigned int turns_;
+
+    std::vector<std::uint8_t> bytes_;
+
+    //! The record being made.
+    std::vector<std::uint8_t> record_;
+
+    //! Hashes of the names of the types by their ids, 0 if not hashed yet.
+    std::vector<std::uint64_t> typeHashes_;
+};
+
+}
+
+#endif // GAMERECORDER_HH
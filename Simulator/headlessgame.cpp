@@ -0,0 +1,549 @@
+#include "headlessgame.hh"
+#include "actor.hh"
+#include "gamerecorder.hh"
+#include "hex.hh"
+#include "initialize.hh"
+#include "pawn.hh"
+#include "rules.hh"
+#include "transport.hh"
+#include "typeregistry.hh"
+
+#include <algorithm>
+
+namespace Simulation {
+
+namespace {
+
+// MainWindow::validPawnMove
+bool validPawnMove(const Common::Hex& hex)
+{
+    Common::Span<const std::shared_ptr<Common::Actor>> actors =
+            hex.getActorSpan();
+    Common::Span<const std::shared_ptr<Common::Transport>> transports =
+            hex.getTransportSpan();
+    return actors.empty() ||
+            actors.at(0)->getActorTypeId() == Common::KRAKEN_TYPE ||
+            transports.empty() || transports.at(0)->getCapacity() != 0;
+}
+
+// MainWindow::validTransportMove
+bool validTransportMove(const Common::Hex& hex)
+{
+    if (!hex.getTransportSpan().empty()) {
+        return false;
+    }
+    Common::Span<const std::shared_ptr<Common::Actor>> actors =
+            hex.getActorSpan();
+    return actors.empty() ||
+            actors.at(0)->getActorTypeId() == Common::SHARK_TYPE;
+}
+
+// MainWindow::validActorMove
+bool validActorMove(const Common::Hex& hex)
+{
+    return hex.getActorSpan().empty();
+}
+
+}
+
+HeadlessGame::HeadlessGame(std::vector<std::shared_ptr<IPolicy>> policies,
+                           unsigned int seed,
+                           unsigned int maxTurns):
+    policies_(policies),
+    players_(),
+    rng_(seed),
+    maxTurns_(maxTurns),
+    board_(nullptr),
+    state_(nullptr),
+    runner_(nullptr),
+    stats_(nullptr),
+    recorder_(nullptr),
+    roundTurns_(0),
+    winner_(0),
+    spinType_(Common::NO_TYPE),
+    spinMoves_()
+{
+    for (std::size_t i = 0; i < policies_.size(); ++i) {
+        players_.push_back(std::make_shared<SimPlayer>(i + 1));
+    }
+}
+
+int HeadlessGame::play(SimStats& stats)
+{
+    stats_ = &stats;
+    winner_ = 0;
+
+    for (unsigned int round = 0; round < MAX_ROUNDS; ++round) {
+        newRound();
+
+        Status status = Status::CONTINUE;
+        while (status == Status::CONTINUE) {
+            status = playTurn();
+            if (recorder_ != nullptr) {
+                recorder_->turnEnded(*runner_->snapshot());
+            }
+        }
+        if (status == Status::GAME_OVER) {
+            break;
+        }
+    }
+
+    if (recorder_ != nullptr) {
+        recorder_->gameEnded(winner_);
+    }
+    ++stats_->games;
+    stats_ = nullptr;
+    return winner_;
+}
+
+void HeadlessGame::newRound()
+{
+    PhaseTimer timer(*stats_, SETUP);
+
+    std::uniform_int_distribution<int> firstPlayer(1, players_.size());
+    int firstPlayerId = firstPlayer(rng_);
+    unsigned int engineSeed = rng_();
+    if (recorder_ != nullptr) {
+        recorder_->roundStarted(firstPlayerId, engineSeed);
+    }
+
+    board_ = std::make_shared<Student::FlatGameBoard>();
+    state_ = std::make_shared<SimState>(firstPlayerId);
+
+    // Unlike the MainWindow, eliminations don't carry over to the next round
+    std::vector<std::shared_ptr<Common::IPlayer>> players;
+    for (const auto& player : players_) {
+        player->setActionsLeft(Logic::MAX_ACTIONS_PER_TURN);
+        player->setEliminated(false);
+        players.push_back(player);
+    }
+    runner_ = Common::Initialization::getGameRunner(board_, state_, players,
+                                                    engineSeed);
+
+    // Pawns start in the center, as in MainWindow::drawPawns
+    Common::CubeCoordinate center(0, 0, 0);
+    for (const auto& player : players_) {
+        for (int pawn = 0; pawn < PAWNS_PER_PLAYER; ++pawn) {
+            board_->addPawn(player->getPlayerId(),
+                            pawnIdOf(player->getPlayerId(), pawn), center);
+        }
+    }
+    roundTurns_ = 0;
+}
+
+HeadlessGame::Status HeadlessGame::playTurn()
+{
+    std::shared_ptr<SimPlayer> player = currentPlayer();
+
+    {
+        PhaseTimer timer(*stats_, MOVEMENT);
+        movementPhase();
+    }
+    {
+        PhaseTimer timer(*stats_, SINKING);
+        Status status = sinkingPhase();
+        if (status != Status::CONTINUE) {
+            return status;
+        }
+    }
+    {
+        PhaseTimer timer(*stats_, SPINNING);
+        spinningPhase();
+    }
+
+    // As in MainWindow::continueFromSpinning
+    Status status = checkGameStatus();
+    if (status != Status::CONTINUE) {
+        return status;
+    }
+    ++stats_->turns;
+    ++roundTurns_;
+    player->addTurn();
+    state_->changeGamePhase(Common::GamePhase::MOVEMENT);
+    state_->changePlayerTurn(nextPlayerId());
+
+    if (roundTurns_ >= maxTurns_) {
+        ++stats_->rounds;
+        ++stats_->drawnRounds;
+        return Status::ROUND_OVER;
+    }
+    return Status::CONTINUE;
+}
+
+void HeadlessGame::movementPhase()
+{
+    while (state_->currentGamePhase() == Common::GamePhase::MOVEMENT) {
+        moves_.clear();
+        moves_.push_back(Move{Move::PASS, {}, {}, 0});
+        addLegalMoves(moves_);
+
+        const Move& move = choose(moves_);
+        int movesLeft = 0;
+        switch (move.type) {
+        case Move::PAWN:
+            movesLeft = runner_->movePawn(move.origin, move.target, move.id);
+            answered(movesLeft);
+            leaveTransport(move.origin, move.id);
+            if (!board_->getHex(move.target)->getTransportSpan().empty()) {
+                boardTransport(move.target, move.id);
+            }
+            ++stats_->moves;
+            break;
+        case Move::TRANSPORT:
+            movesLeft = runner_->moveTransport(move.origin, move.target,
+                                               move.id);
+            answered(movesLeft);
+            ++stats_->moves;
+            break;
+        default:
+            break;
+        }
+
+        if (movesLeft == 0) {
+            moveToSinking();
+        }
+    }
+}
+
+HeadlessGame::Status HeadlessGame::sinkingPhase()
+{
+    moves_.clear();
+    addLegalMoves(moves_);
+
+    // Nothing left to sink, the MainWindow would wait here forever
+    if (!moves_.empty()) {
+        const Move& move = choose(moves_);
+        std::string actorType = runner_->flipTile(move.target);
+        answered(0, actorType);
+        ++stats_->moves;
+
+        std::shared_ptr<Common::Hex> hex = board_->getHex(move.target);
+
+        // As in MainWindow::flipHexFollowUp. A vortex doesn't move, so it is
+        // never on the hex and only the answer tells that it appeared
+        if (Common::TypeRegistry::getInstance().find(actorType) ==
+                Common::VORTEX_TYPE) {
+            vortexAction(move.target);
+        } else if (!hex->getActorSpan().empty()) {
+            doActorAction(move.target, hex->getActorSpan().at(0)->getId());
+        }
+    }
+
+    state_->changeGamePhase(Common::GamePhase::SPINNING);
+    return checkGameStatus();
+}
+
+void HeadlessGame::spinningPhase()
+{
+    std::pair<std::string, std::string> spin = runner_->spinWheel();
+    answered(0, spin.first + " " + spin.second);
+    ++stats_->spins;
+    spinType_ = Common::TypeRegistry::getInstance().find(spin.first);
+    spinMoves_ = spin.second;
+
+    moves_.clear();
+    moves_.push_back(Move{Move::PASS, {}, {}, 0});
+    addLegalMoves(moves_);
+
+    const Move& move = choose(moves_);
+    switch (move.type) {
+    case Move::ACTOR:
+        runner_->moveActor(move.origin, move.target, move.id, spin.second);
+        answered(0);
+        doActorAction(move.target, move.id);
+        ++stats_->moves;
+        break;
+    case Move::TRANSPORT:
+        answered(runner_->moveTransportWithSpinner(move.origin, move.target,
+                                                   move.id, spin.second));
+        ++stats_->moves;
+        break;
+    default:
+        break;
+    }
+}
+
+void HeadlessGame::addLegalMoves(std::vector<Move>& moves)
+{
+    // The sinking phase ends without a move when nothing can be flipped, so
+    // a verified game lists the flips as well
+    if (recorder_ != nullptr && recorder_->verifying() &&
+            state_->currentGamePhase() != Common::GamePhase::SINKING) {
+        addRecordedMove(moves);
+        return;
+    }
+
+    // The engine searches the board once per piece, checking each target
+    // with checkTransportMovement or checkActorMovement searched it again for
+    // every target. The MainWindow refuses some moves the engine accepts.
+    actions_.clear();
+    runner_->legalActions(actions_);
+    moves.reserve(moves.size() + actions_.size());
+    for (const auto& action : actions_) {
+        const Common::Hex* target = board_->findHex(action.target);
+        switch (action.type) {
+        case Common::GameAction::MOVE_PAWN:
+            if (validPawnMove(*target)) {
+                moves.push_back(Move{Move::PAWN, action.origin, action.target,
+                                     action.id});
+            }
+            break;
+        case Common::GameAction::MOVE_TRANSPORT:
+        case Common::GameAction::MOVE_TRANSPORT_WITH_SPINNER:
+            if (validTransportMove(*target)) {
+                moves.push_back(Move{Move::TRANSPORT, action.origin,
+                                     action.target, action.id});
+            }
+            break;
+        case Common::GameAction::MOVE_ACTOR:
+            if (validActorMove(*target)) {
+                moves.push_back(Move{Move::ACTOR, action.origin, action.target,
+                                     action.id});
+            }
+            break;
+        case Common::GameAction::FLIP_TILE:
+            moves.push_back(Move{Move::FLIP, action.origin, action.target, 0});
+            break;
+        }
+    }
+}
+
+void HeadlessGame::addRecordedMove(std::vector<Move>& moves)
+{
+    // Listing every legal move took most of the time of a verification,
+    // only the recorded one has to be checked
+    Move recorded = recorder_->recordedMove();
+    if (!isLegalMove(recorded)) {
+        throw DivergenceError(recorder_->position() + ": recorded " +
+                              GameRecorder::describeMove(recorded) +
+                              " is not a legal move");
+    }
+    if (recorded.type != Move::PASS) {
+        moves.push_back(recorded);
+    }
+}
+
+bool HeadlessGame::isLegalMove(const Move& move) const
+{
+    // The rules of legalActions and the MainWindow checks of addLegalMoves
+    // for one move, with the checks of the engine. A pass is always offered
+    // outside the sinking phase.
+    if (move.type == Move::PASS) {
+        return true;
+    }
+    const Common::Hex* target = board_->findHex(move.target);
+    const Common::Hex* origin = board_->findHex(move.origin);
+    if (target == nullptr || origin == nullptr ||
+            move.origin == move.target) {
+        return false;
+    }
+
+    bool spinning =
+            state_->currentGamePhase() == Common::GamePhase::SPINNING;
+    switch (move.type) {
+    case Move::PAWN:
+        return !spinning &&
+                runner_->checkPawnMovement(move.origin, move.target,
+                                           move.id) >= 0 &&
+                validPawnMove(*target);
+    case Move::TRANSPORT:
+        if (!spinning) {
+            std::string actionsLeft =
+                    std::to_string(currentPlayer()->getActionsLeft());
+            return runner_->checkTransportMovement(
+                        move.origin, move.target, move.id, actionsLeft) >= 0 &&
+                    validTransportMove(*target);
+        }
+        return origin->findTransport(move.id) != nullptr &&
+                origin->findTransport(move.id)->getTransportTypeId() ==
+                spinType_ &&
+                runner_->checkTransportMovement(move.origin, move.target,
+                                                move.id, spinMoves_) >= 0 &&
+                validTransportMove(*target);
+    case Move::ACTOR:
+        return spinning &&
+                origin->findActor(move.id) != nullptr &&
+                origin->findActor(move.id)->getActorTypeId() == spinType_ &&
+                runner_->checkActorMovement(move.origin, move.target,
+                                            move.id, spinMoves_) &&
+                validActorMove(*target);
+    default:
+        return false;
+    }
+}
+
+const Move& HeadlessGame::choose(const std::vector<Move>& moves)
+{
+    int playerId = state_->currentPlayer();
+
+    PolicyContext context;
+    context.board = board_.get();
+    context.phase = state_->currentGamePhase();
+    context.playerId = playerId;
+    for (int pawn = 0; pawn < PAWNS_PER_PLAYER; ++pawn) {
+        std::shared_ptr<Common::Pawn> pawnPtr =
+                board_->getPawn(pawnIdOf(playerId, pawn));
+        if (pawnPtr != nullptr) {
+            context.pawns.push_back(pawnPtr->getCoordinates());
+        }
+    }
+
+    const Move& move =
+            moves.at(policies_.at(playerId - 1)->chooseMove(context, moves));
+    if (recorder_ != nullptr) {
+        recorder_->moveChosen(move);
+    }
+    return move;
+}
+
+void HeadlessGame::answered(int result, const std::string& text)
+{
+    if (recorder_ != nullptr) {
+        recorder_->commandAnswered(result, text);
+    }
+}
+
+void HeadlessGame::boardTransport(Common::CubeCoordinate target, int pawnId)
+{
+    // As in MainWindow::movePawnWithTransport
+    std::shared_ptr<Common::Transport> transport =
+            board_->getHex(target)->getTransports().at(0);
+
+    // A full dolphin drops its rider for the new one
+    if (transport->getTransportTypeId() == Common::DOLPHIN_TYPE &&
+            transport->getCapacity() == 0) {
+        transport->removePawn(transport->getPawnsInTransport().at(0));
+    }
+    transport->addPawn(board_->getPawn(pawnId));
+}
+
+void HeadlessGame::leaveTransport(Common::CubeCoordinate origin, int pawnId)
+{
+    // The MainWindow leaves the pawn in the transport, which then carries it
+    // along on its next move
+    std::shared_ptr<Common::Pawn> pawn = board_->getPawn(pawnId);
+    std::shared_ptr<Common::Hex> hex = board_->getHex(origin);
+    for (const auto& transport : hex->getTransportSpan()) {
+        if (transport->isPawnInTransport(pawn)) {
+            transport->removePawn(pawn);
+        }
+    }
+}
+
+void HeadlessGame::doActorAction(Common::CubeCoordinate coord, int actorId)
+{
+    // As in MainWindow::doActorAction
+    std::shared_ptr<Common::Hex> hex = board_->getHex(coord);
+    std::vector<std::shared_ptr<Common::Pawn>> pawnsBefore = hex->getPawns();
+    std::shared_ptr<Common::Transport> transportBefore = nullptr;
+    if (!hex->getTransports().empty()) {
+        transportBefore = hex->getTransports().at(0);
+    }
+
+    board_->getActor(actorId)->doAction();
+
+    if (transportBefore != nullptr && hex->getTransports().empty()) {
+        board_->removeTransport(transportBefore->getId());
+    }
+
+    std::vector<std::shared_ptr<Common::Pawn>> pawnsAfter = hex->getPawns();
+    for (const auto& pawn : pawnsBefore) {
+        if (std::find(pawnsAfter.begin(), pawnsAfter.end(), pawn) ==
+                pawnsAfter.end()) {
+            board_->removePawn(pawn->getId());
+        }
+    }
+}
+
+void HeadlessGame::vortexAction(Common::CubeCoordinate coord)
+{
+    // As in MainWindow::vortexAction
+    Common::Hex* hexes[Common::HEX_NEIGHBOURS + 1];
+    board_->findNeighbours(coord, hexes);
+    hexes[Common::HEX_NEIGHBOURS] = board_->findHex(coord);
+
+    for (Common::Hex* hex : hexes) {
+        if (hex == nullptr) {
+            continue;
+        }
+        for (const auto& transport : hex->getTransports()) {
+            board_->removeTransport(transport->getId());
+        }
+        for (const auto& pawn : hex->getPawns()) {
+            board_->removePawn(pawn->getId());
+        }
+        for (const auto& actor : hex->getActors()) {
+            board_->removeActor(actor->getId());
+        }
+    }
+}
+
+void HeadlessGame::moveToSinking()
+{
+    currentPlayer()->setActionsLeft(Logic::MAX_ACTIONS_PER_TURN);
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+}
+
+HeadlessGame::Status HeadlessGame::checkGameStatus()
+{
+    // As in MainWindow::checkGameStatus
+    unsigned int pawnsLeft = board_->pawnsLeft();
+
+    if (pawnsLeft > 1) {
+        for (const auto& player : players_) {
+            bool hasPawns = false;
+            for (int pawn = 0; pawn < PAWNS_PER_PLAYER; ++pawn) {
+                if (board_->getPawn(pawnIdOf(player->getPlayerId(), pawn))) {
+                    hasPawns = true;
+                }
+            }
+            if (!hasPawns) {
+                player->setEliminated(true);
+            }
+        }
+        return Status::CONTINUE;
+    }
+
+    ++stats_->rounds;
+    if (pawnsLeft == 0) {
+        ++stats_->drawnRounds;
+        return Status::ROUND_OVER;
+    }
+
+    int winnerId = board_->getWinner();
+    std::shared_ptr<SimPlayer> winner = players_.at(winnerId - 1);
+    winner->givePoint();
+    if (winner->getPoints() >= POINTS_FOR_WIN) {
+        winner_ = winnerId;
+        return Status::GAME_OVER;
+    }
+    return Status::ROUND_OVER;
+}
+
+int HeadlessGame::nextPlayerId() const
+{
+    // As in MainWindow::getNextPlayerId, eliminated players are skipped
+    int playerId = state_->currentPlayer();
+    int playerAmount = players_.size();
+    for (int i = 0; i < playerAmount; ++i) {
+        playerId = playerId % playerAmount + 1;
+        if (!players_.at(playerId - 1)->isEliminated()) {
+            break;
+        }
+    }
+    return playerId;
+}
+
+int HeadlessGame::pawnIdOf(int playerId, int pawn) const
+{
+    // With one pawn per player the pawn shares the id of its player, as in
+    // the MainWindow
+    return (playerId - 1) * PAWNS_PER_PLAYER + pawn + 1;
+}
+
+std::shared_ptr<SimPlayer> HeadlessGame::currentPlayer() const
+{
+    return players_.at(state_->currentPlayer() - 1);
+}
+
+}
@@ -0,0 +1,126 @@
+#ifndef HEADLESSGAME_HH
+#define HEADLESSGAME_HH
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "igamerunner.hh"
+#include "ipolicy.hh"
+#include "simplayer.hh"
+#include "simstate.hh"
+#include "simstats.hh"
+#include "typeregistry.hh"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Plays complete games without the user interface.
+ */
+
+namespace Simulation {
+
+class GameRecorder;
+
+//! Round wins needed to win the game, as in the UI.
+const unsigned int POINTS_FOR_WIN = 3;
+
+//! Pawns each player starts a round with, as in the UI.
+const int PAWNS_PER_PLAYER = 1;
+
+//! Rounds after which a game ends without a winner.
+const unsigned int MAX_ROUNDS = 20;
+
+/**
+ * @brief Runs the turn, phase and round loop of the MainWindow against the
+ * engine, asking policies for the moves instead of the user.
+ * @details The moves are the legal actions of the engine that the
+ * MainWindow also accepts, so the policies only ever see legal moves. The outcome
+ * depends only on the seed and the policies.
+ */
+class HeadlessGame
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param policies One policy for each player, the first one plays
+     * player 1.
+     * @param seed Seed of the engine and of the starting players.
+     * @param maxTurns Turns after which a round is declared a draw.
+     */
+    HeadlessGame(std::vector<std::shared_ptr<IPolicy>> policies,
+                 unsigned int seed,
+                 unsigned int maxTurns);
+
+    /**
+     * @brief play plays the game until a player has won enough rounds.
+     * @param stats Counters and timings are added here.
+     * @return The identifier of the winner, 0 if the game hit MAX_ROUNDS.
+     */
+    int play(SimStats& stats);
+
+    /**
+     * @brief setRecorder records the next game, or checks it against a
+     * recording.
+     * @param recorder The recorder, nullptr for none. Has to outlive play().
+     */
+    void setRecorder(GameRecorder* recorder) { recorder_ = recorder; }
+
+private:
+    enum class Status { CONTINUE, ROUND_OVER, GAME_OVER };
+
+    void newRound();
+    Status playTurn();
+
+    void movementPhase();
+    Status sinkingPhase();
+    void spinningPhase();
+
+    void addLegalMoves(std::vector<Move>& moves);
+    void addRecordedMove(std::vector<Move>& moves);
+    bool isLegalMove(const Move& move) const;
+
+    const Move& choose(const std::vector<Move>& moves);
+    void answered(int result, const std::string& text = std::string());
+
+    void boardTransport(Common::CubeCoordinate target, int pawnId);
+    void leaveTransport(Common::CubeCoordinate origin, int pawnId);
+    void doActorAction(Common::CubeCoordinate coord, int actorId);
+    void vortexAction(Common::CubeCoordinate coord);
+
+    void moveToSinking();
+    Status checkGameStatus();
+    int nextPlayerId() const;
+    int pawnIdOf(int playerId, int pawn) const;
+    std::shared_ptr<SimPlayer> currentPlayer() const;
+
+    std::vector<std::shared_ptr<IPolicy>> policies_;
+    std::vector<std::shared_ptr<SimPlayer>> players_;
+    std::mt19937 rng_;
+    unsigned int maxTurns_;
+
+    std::shared_ptr<Student::FlatGameBoard> board_;
+    std::shared_ptr<SimState> state_;
+    std::shared_ptr<Common::IGameRunner> runner_;
+
+    SimStats* stats_;
+    GameRecorder* recorder_;
+    unsigned int roundTurns_;
+    int winner_;
+
+    //! The last spin of the wheel, the type and the moves.
+    Common::TypeId spinType_;
+    std::string spinMoves_;
+
+    //! Scratch space for the legal actions of the engine.
+    std::vector<Common::GameAction> actions_;
+    //! Scratch space for the moves of the player in turn, kept between the
+    //! phases so that its memory is reused.
+    std::vector<Move> moves_;
+};
+
+}
+
+#endif // HEADLESSGAME_HH
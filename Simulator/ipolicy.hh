@@ -0,0 +1,67 @@
+#ifndef IPOLICY_HH
+#define IPOLICY_HH
+
+#include "cubecoordinate.hh"
+#include "igameboard.hh"
+#include "igamestate.hh"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file
+ * @brief Interface for the players of a headless game.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief One legal choice of the player in turn.
+ */
+struct Move
+{
+    enum Type { PASS, PAWN, TRANSPORT, ACTOR, FLIP };
+
+    Type type;
+    Common::CubeCoordinate origin;
+    Common::CubeCoordinate target;
+    //! Identifier of the moved pawn, transport or actor.
+    int id;
+};
+
+/**
+ * @brief What a policy knows about the game when choosing a move.
+ */
+struct PolicyContext
+{
+    const Common::IGameBoard* board;
+    Common::GamePhase phase;
+    int playerId;
+    //! Coordinates of the pawns of the player in turn.
+    std::vector<Common::CubeCoordinate> pawns;
+};
+
+/**
+ * @brief Decides the moves of a player.
+ */
+class IPolicy
+{
+public:
+    /**
+     * @brief Virtual destructor. Does nothing, since this is an interface class.
+     */
+    virtual ~IPolicy() = default;
+
+    /**
+     * @brief chooseMove picks one of the legal moves.
+     * @param context The situation the move is chosen in.
+     * @param moves The legal moves, never empty.
+     * @return Index of the chosen move in moves.
+     */
+    virtual std::size_t chooseMove(const PolicyContext& context,
+                                   const std::vector<Move>& moves) = 0;
+};
+
+}
+
+#endif // IPOLICY_HH
@@ -0,0 +1,210 @@
+#include "simulation.hh"
+#include "formatexception.hh"
+#include "gameexception.hh"
+#include "ioexception.hh"
+#include "verification.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "Plays games without the user interface and reports"
+                 " the throughput.\n"
+              << "Assets/ is read from the working directory.\n\n"
+              << "  --games N        games to play (default 1000)\n"
+              << "  --seed N         seed of the whole batch (default 1)\n"
+              << "  --max-turns N    turns before a round is a draw"
+                 " (default 500)\n"
+              << "  --policies A,B   policy of each player, random or"
+                 " cautious\n"
+              << "                   (default cautious,random,random)\n"
+              << "  --threads N      worker threads (default: one per core)\n"
+              << "  --scaling        play the batch on 1, 2, 4... threads up"
+                 " to --threads\n"
+              << "                   and report the speedup\n"
+              << "  --record DIR     record the games to DIR\n"
+              << "  --verify DIR     play the games recorded to DIR again and"
+                 " check they\n"
+              << "                   go as recorded, on --threads threads\n";
+}
+
+unsigned int parseNumber(const std::string& option, const char* value)
+{
+    try {
+        return std::stoul(value);
+    } catch (...) {
+        throw std::invalid_argument("Invalid value for " + option + ": " +
+                                    value);
+    }
+}
+
+/**
+ * Plays the same batch with a doubling number of threads and prints the
+ * speedup over a single thread.
+ */
+void reportScaling(Simulation::SimulationConfig config)
+{
+    unsigned int maxThreads = config.threads;
+    double baseSeconds = 0.0;
+
+    std::cout << std::setw(8) << "threads"
+              << std::setw(12) << "wall s"
+              << std::setw(12) << "games/s"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "efficiency" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (unsigned int threads = 1; ; threads *= 2) {
+        config.threads = std::min(threads, maxThreads);
+
+        auto start = std::chrono::steady_clock::now();
+        Simulation::SimStats stats = Simulation::runSimulation(config);
+        double seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+        if (config.threads == 1) {
+            baseSeconds = seconds;
+        }
+        double speedup = seconds > 0 ? baseSeconds / seconds : 0.0;
+
+        std::cout << std::setw(8) << config.threads
+                  << std::setw(12) << seconds
+                  << std::setw(12) << (seconds > 0 ? stats.games / seconds : 0.0)
+                  << std::setw(10) << speedup
+                  << std::setw(11) << 100.0 * speedup / config.threads << "%\n";
+
+        if (config.threads == maxThreads) {
+            break;
+        }
+    }
+}
+
+/**
+ * Checks the recorded games and prints where the ones that diverged went
+ * wrong. Returns the exit code.
+ */
+int reportVerification(const Simulation::VerificationConfig& config)
+{
+    auto start = std::chrono::steady_clock::now();
+    Simulation::VerificationResult result =
+            Simulation::verifyRecordings(config);
+    auto wallTime = std::chrono::steady_clock::now() - start;
+    result.stats.report(std::cout, wallTime);
+
+    std::cout << "verified " << result.games << " games in " << result.files
+              << " files, " << result.divergentGames << " diverged\n";
+    for (const std::string& divergence : result.divergences) {
+        std::cout << "  " << divergence << "\n";
+    }
+    if (result.divergentGames > result.divergences.size()) {
+        std::cout << "  and "
+                  << result.divergentGames - result.divergences.size()
+                  << " more\n";
+    }
+    return result.divergentGames == 0 && result.games > 0 ? EXIT_SUCCESS
+                                                          : EXIT_FAILURE;
+}
+
+std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Simulation::SimulationConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    bool scaling = false;
+    Simulation::VerificationConfig verification;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--help" || option == "-h") {
+                printUsage(argv[0]);
+                return EXIT_SUCCESS;
+            }
+            if (option == "--scaling") {
+                scaling = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + option);
+            }
+            const char* value = argv[++i];
+            if (option == "--games") {
+                config.games = parseNumber(option, value);
+            } else if (option == "--seed") {
+                config.seed = parseNumber(option, value);
+            } else if (option == "--max-turns") {
+                config.maxTurns = parseNumber(option, value);
+            } else if (option == "--policies") {
+                config.policies = splitList(value);
+            } else if (option == "--threads") {
+                config.threads = parseNumber(option, value);
+            } else if (option == "--record") {
+                config.recordDirectory = value;
+            } else if (option == "--verify") {
+                verification.directory = value;
+            } else {
+                throw std::invalid_argument("Unknown option " + option);
+            }
+        }
+        if (config.policies.size() < 2 || config.policies.size() > 3) {
+            throw std::invalid_argument("The game is for 2-3 players");
+        }
+        if (config.threads == 0) {
+            throw std::invalid_argument("At least one thread is needed");
+        }
+    } catch (std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (!verification.directory.empty()) {
+            verification.threads = config.threads;
+            return reportVerification(verification);
+        }
+        if (scaling) {
+            reportScaling(config);
+            return EXIT_SUCCESS;
+        }
+        auto start = std::chrono::steady_clock::now();
+        Simulation::SimStats stats = Simulation::runSimulation(config);
+        auto wallTime = std::chrono::steady_clock::now() - start;
+        stats.report(std::cout, wallTime);
+    } catch (Common::IoException& e) {
+        std::cerr << e.msg() << "\n";
+        return EXIT_FAILURE;
+    } catch (Common::FormatException& e) {
+        std::cerr << e.msg() << "\n";
+        return EXIT_FAILURE;
+    } catch (Common::GameException& e) {
+        // A move the engine refused or a broken asset, not worth a crash
+        std::cerr << e.msg() << "\n";
+        return EXIT_FAILURE;
+    } catch (std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
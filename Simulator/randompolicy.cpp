@@ -0,0 +1,18 @@
+#include "randompolicy.hh"
+
+namespace Simulation {
+
+RandomPolicy::RandomPolicy(unsigned int seed):
+    rng_(seed)
+{
+}
+
+std::size_t RandomPolicy::chooseMove(const PolicyContext& context,
+                                     const std::vector<Move>& moves)
+{
+    (void)context;
+    std::uniform_int_distribution<std::size_t> pick(0, moves.size() - 1);
+    return pick(rng_);
+}
+
+}
@@ -0,0 +1,39 @@
+#ifndef RANDOMPOLICY_HH
+#define RANDOMPOLICY_HH
+
+#include "ipolicy.hh"
+
+#include <random>
+
+/**
+ * @file
+ * @brief Policy choosing uniformly among the legal moves.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Chooses every move at random.
+ */
+class RandomPolicy : public IPolicy
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param seed Seed of the random choices.
+     */
+    explicit RandomPolicy(unsigned int seed);
+
+    /**
+     * @copydoc IPolicy::chooseMove()
+     */
+    virtual std::size_t chooseMove(const PolicyContext& context,
+                                   const std::vector<Move>& moves);
+
+private:
+    std::mt19937 rng_;
+};
+
+}
+
+#endif // RANDOMPOLICY_HH
@@ -0,0 +1,43 @@
+#include "recordedpolicy.hh"
+#include "gamerecorder.hh"
+
+#include <string>
+
+namespace Simulation {
+
+namespace {
+
+bool sameMove(const Move& a, const Move& b)
+{
+    // The coordinates of a pass are not set
+    if (a.type != b.type) {
+        return false;
+    }
+    return a.type == Move::PASS ||
+            (a.origin == b.origin && a.target == b.target && a.id == b.id);
+}
+
+}
+
+RecordedPolicy::RecordedPolicy(const GameRecorder& recorder):
+    recorder_(recorder)
+{
+}
+
+std::size_t RecordedPolicy::chooseMove(const PolicyContext& context,
+                                       const std::vector<Move>& moves)
+{
+    (void)context;
+    Move recorded = recorder_.recordedMove();
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        if (sameMove(moves[i], recorded)) {
+            return i;
+        }
+    }
+    throw DivergenceError(recorder_.position() + ": recorded " +
+                          GameRecorder::describeMove(recorded) +
+                          " is not one of the " +
+                          std::to_string(moves.size()) + " legal moves");
+}
+
+}
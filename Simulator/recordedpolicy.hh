@@ -0,0 +1,42 @@
+#ifndef RECORDEDPOLICY_HH
+#define RECORDEDPOLICY_HH
+
+#include "ipolicy.hh"
+
+/**
+ * @file
+ * @brief Policy playing the moves of a recorded game.
+ */
+
+namespace Simulation {
+
+class GameRecorder;
+
+/**
+ * @brief Chooses the moves a recording says the player chose.
+ */
+class RecordedPolicy : public IPolicy
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param recorder The recorder checking the game, see
+     * GameRecorder::recordedMove(). Has to outlive the policy.
+     */
+    explicit RecordedPolicy(const GameRecorder& recorder);
+
+    /**
+     * @copydoc IPolicy::chooseMove()
+     * @exception DivergenceError The recorded move is not one of the legal
+     * moves.
+     */
+    virtual std::size_t chooseMove(const PolicyContext& context,
+                                   const std::vector<Move>& moves);
+
+private:
+    const GameRecorder& recorder_;
+};
+
+}
+
+#endif // RECORDEDPOLICY_HH
@@ -0,0 +1,60 @@
+#include "simplayer.hh"
+#include "rules.hh"
+
+namespace Simulation {
+
+SimPlayer::SimPlayer(int id):
+    id_(id),
+    actionsLeft_(Logic::MAX_ACTIONS_PER_TURN),
+    points_(0),
+    totalTurns_(0),
+    eliminated_(false)
+{
+}
+
+int SimPlayer::getPlayerId() const
+{
+    return id_;
+}
+
+void SimPlayer::setActionsLeft(unsigned int actionsLeft)
+{
+    actionsLeft_ = actionsLeft;
+}
+
+unsigned int SimPlayer::getActionsLeft() const
+{
+    return actionsLeft_;
+}
+
+void SimPlayer::givePoint()
+{
+    ++points_;
+}
+
+unsigned int SimPlayer::getPoints() const
+{
+    return points_;
+}
+
+void SimPlayer::addTurn()
+{
+    ++totalTurns_;
+}
+
+unsigned int SimPlayer::getTotalTurns() const
+{
+    return totalTurns_;
+}
+
+void SimPlayer::setEliminated(bool eliminated)
+{
+    eliminated_ = eliminated;
+}
+
+bool SimPlayer::isEliminated() const
+{
+    return eliminated_;
+}
+
+}
@@ -0,0 +1,85 @@
+#ifndef SIMPLAYER_HH
+#define SIMPLAYER_HH
+
+#include "iplayer.hh"
+
+/**
+ * @file
+ * @brief Player of a headless game.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Player that keeps the round and game bookkeeping the MainWindow
+ * keeps in Student::Player, without the Qt dependencies.
+ */
+class SimPlayer : public Common::IPlayer
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param id The identifier of the player.
+     */
+    explicit SimPlayer(int id);
+
+    /**
+     * @copydoc Common::IPlayer::getPlayerId()
+     */
+    virtual int getPlayerId() const;
+
+    /**
+     * @copydoc Common::IPlayer::setActionsLeft()
+     */
+    virtual void setActionsLeft(unsigned int actionsLeft);
+
+    /**
+     * @copydoc Common::IPlayer::getActionsLeft()
+     */
+    virtual unsigned int getActionsLeft() const;
+
+    /**
+     * @brief givePoint gives the player a point for winning a round.
+     */
+    void givePoint();
+
+    /**
+     * @brief getPoints tells the number of rounds the player has won.
+     * @return The points of the player.
+     */
+    unsigned int getPoints() const;
+
+    /**
+     * @brief addTurn adds a turn to the total turn count of the player.
+     */
+    void addTurn();
+
+    /**
+     * @brief getTotalTurns tells the number of turns played in the game.
+     * @return The number of turns.
+     */
+    unsigned int getTotalTurns() const;
+
+    /**
+     * @brief setEliminated sets whether the player is out of the round.
+     * @param eliminated true, if the player has no pawns left.
+     */
+    void setEliminated(bool eliminated);
+
+    /**
+     * @brief isEliminated tells whether the player is out of the round.
+     * @return true, if the player is out of the round.
+     */
+    bool isEliminated() const;
+
+private:
+    int id_;
+    unsigned int actionsLeft_;
+    unsigned int points_;
+    unsigned int totalTurns_;
+    bool eliminated_;
+};
+
+}
+
+#endif // SIMPLAYER_HH
@@ -0,0 +1,31 @@
+#include "simstate.hh"
+
+namespace Simulation {
+
+SimState::SimState(int firstPlayer):
+    phase_(Common::GamePhase::MOVEMENT),
+    player_(firstPlayer)
+{
+}
+
+Common::GamePhase SimState::currentGamePhase() const
+{
+    return phase_;
+}
+
+int SimState::currentPlayer() const
+{
+    return player_;
+}
+
+void SimState::changeGamePhase(Common::GamePhase nextPhase)
+{
+    phase_ = nextPhase;
+}
+
+void SimState::changePlayerTurn(int nextPlayer)
+{
+    player_ = nextPlayer;
+}
+
+}
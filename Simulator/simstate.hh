@@ -0,0 +1,52 @@
+#ifndef SIMSTATE_HH
+#define SIMSTATE_HH
+
+#include "igamestate.hh"
+
+/**
+ * @file
+ * @brief Game state of a headless game.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Stores the game phase and the player in turn.
+ */
+class SimState : public Common::IGameState
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param firstPlayer The identifier of the player starting the round.
+     */
+    explicit SimState(int firstPlayer);
+
+    /**
+     * @copydoc Common::IGameState::currentGamePhase()
+     */
+    virtual Common::GamePhase currentGamePhase() const;
+
+    /**
+     * @copydoc Common::IGameState::currentPlayer()
+     */
+    virtual int currentPlayer() const;
+
+    /**
+     * @copydoc Common::IGameState::changeGamePhase()
+     */
+    virtual void changeGamePhase(Common::GamePhase nextPhase);
+
+    /**
+     * @copydoc Common::IGameState::changePlayerTurn()
+     */
+    virtual void changePlayerTurn(int nextPlayer);
+
+private:
+    Common::GamePhase phase_;
+    int player_;
+};
+
+}
+
+#endif // SIMSTATE_HH
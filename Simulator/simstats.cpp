@@ -0,0 +1,81 @@
+#include "simstats.hh"
+
+#include <iomanip>
+
+namespace Simulation {
+
+namespace {
+
+const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "setup", "movement", "sinking", "spinning"
+};
+
+double perSecond(unsigned long count, std::chrono::nanoseconds time)
+{
+    double seconds = std::chrono::duration<double>(time).count();
+    return seconds > 0 ? count / seconds : 0.0;
+}
+
+}
+
+void SimStats::merge(const SimStats& other)
+{
+    games += other.games;
+    unfinishedGames += other.unfinishedGames;
+    rounds += other.rounds;
+    drawnRounds += other.drawnRounds;
+    turns += other.turns;
+    moves += other.moves;
+    spins += other.spins;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        phaseTime[phase] += other.phaseTime[phase];
+        phaseCalls[phase] += other.phaseCalls[phase];
+    }
+}
+
+void SimStats::report(std::ostream& out,
+                      std::chrono::nanoseconds wallTime) const
+{
+    double seconds = std::chrono::duration<double>(wallTime).count();
+
+    out << std::fixed << std::setprecision(1);
+    out << "games    " << games << " in " << seconds << " s, "
+        << perSecond(games, wallTime) << " games/s, "
+        << unfinishedGames << " unfinished\n";
+    out << "rounds   " << rounds << " (" << drawnRounds << " drawn)\n";
+    out << "turns    " << turns << ", " << perSecond(turns, wallTime)
+        << " turns/s\n";
+    out << "moves    " << moves << ", " << perSecond(moves, wallTime)
+        << " moves/s\n";
+    out << "spins    " << spins << "\n";
+
+    out << std::left << std::setw(10) << "phase" << std::right
+        << std::setw(12) << "calls"
+        << std::setw(14) << "total ms"
+        << std::setw(12) << "mean us" << "\n";
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        double totalMs = std::chrono::duration<double, std::milli>(
+                    phaseTime[phase]).count();
+        double meanUs = phaseCalls[phase] > 0 ?
+                    totalMs * 1000.0 / phaseCalls[phase] : 0.0;
+        out << std::left << std::setw(10) << PHASE_NAMES[phase] << std::right
+            << std::setw(12) << phaseCalls[phase]
+            << std::setw(14) << totalMs
+            << std::setw(12) << meanUs << "\n";
+    }
+}
+
+PhaseTimer::PhaseTimer(SimStats& stats, Phase phase):
+    stats_(stats),
+    phase_(phase),
+    start_(std::chrono::steady_clock::now())
+{
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    stats_.phaseTime[phase_] += std::chrono::steady_clock::now() - start_;
+    ++stats_.phaseCalls[phase_];
+}
+
+}
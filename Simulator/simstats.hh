@@ -0,0 +1,72 @@
+#ifndef SIMSTATS_HH
+#define SIMSTATS_HH
+
+#include <chrono>
+#include <ostream>
+
+/**
+ * @file
+ * @brief Counters and phase timings of headless games.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Parts of a game that are timed separately.
+ */
+enum Phase { SETUP, MOVEMENT, SINKING, SPINNING, PHASE_COUNT };
+
+/**
+ * @brief Totals collected while playing games.
+ */
+struct SimStats
+{
+    unsigned long games = 0;
+    //! Games that hit the round limit without a winner.
+    unsigned long unfinishedGames = 0;
+    unsigned long rounds = 0;
+    //! Rounds that ended with no pawns left or hit the turn limit.
+    unsigned long drawnRounds = 0;
+    unsigned long turns = 0;
+    //! Pawn, transport and actor moves and tile flips.
+    unsigned long moves = 0;
+    unsigned long spins = 0;
+
+    std::chrono::nanoseconds phaseTime[PHASE_COUNT] = {};
+    unsigned long phaseCalls[PHASE_COUNT] = {};
+
+    /**
+     * @brief merge adds the totals of another run to these.
+     * @param other The totals to add.
+     */
+    void merge(const SimStats& other);
+
+    /**
+     * @brief report writes the totals and rates in a human readable form.
+     * @param out The stream to write to.
+     * @param wallTime Wall clock time the games took.
+     */
+    void report(std::ostream& out, std::chrono::nanoseconds wallTime) const;
+};
+
+/**
+ * @brief Adds the time from its construction to its destruction to a phase.
+ */
+class PhaseTimer
+{
+public:
+    PhaseTimer(SimStats& stats, Phase phase);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    SimStats& stats_;
+    Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}
+
+#endif // SIMSTATS_HH
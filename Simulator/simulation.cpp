@@ -0,0 +1,140 @@
+#include "simulation.hh"
+#include "cautiouspolicy.hh"
+#include "gamerecorder.hh"
+#include "headlessgame.hh"
+#include "ioexception.hh"
+#include "randompolicy.hh"
+#include "workstealingpool.hh"
+
+#include <QDir>
+
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace Simulation {
+
+std::shared_ptr<IPolicy> createPolicy(const std::string& name,
+                                      unsigned int seed)
+{
+    if (name == "random") {
+        return std::make_shared<RandomPolicy>(seed);
+    } else if (name == "cautious") {
+        return std::make_shared<CautiousPolicy>(seed);
+    }
+    throw std::invalid_argument("Unknown policy: " + name);
+}
+
+unsigned int deriveSeed(unsigned int seed, unsigned int game, int player)
+{
+    std::seed_seq sequence{seed, game, static_cast<unsigned int>(player)};
+    unsigned int derived = 0;
+    sequence.generate(&derived, &derived + 1);
+    return derived;
+}
+
+std::string recordingFileName(const std::string& directory,
+                              unsigned int worker)
+{
+    return directory + "/recording-" + std::to_string(worker) + ".rec";
+}
+
+namespace {
+
+/**
+ * Creates the recordings directory and starts the file of every worker.
+ */
+std::vector<std::unique_ptr<std::ofstream>> openRecordings(
+        const std::string& directory, unsigned int workers)
+{
+    QDir dir(QString::fromStdString(directory));
+    if (!dir.mkpath(".")) {
+        throw Common::IoException("Could not create directory " + directory);
+    }
+    // A batch on more threads before would leave its extra files behind
+    for (const QString& name : dir.entryList(QStringList() << "recording-*.rec",
+                                             QDir::Files)) {
+        dir.remove(name);
+    }
+
+    std::vector<std::unique_ptr<std::ofstream>> files;
+    for (unsigned int worker = 0; worker < workers; ++worker) {
+        std::string fileName = recordingFileName(directory, worker);
+        files.emplace_back(new std::ofstream(
+                               fileName, std::ios::binary | std::ios::trunc));
+        GameRecorder::writeHeader(*files.back());
+        if (!*files.back()) {
+            throw Common::IoException("Could not write file " + fileName);
+        }
+    }
+    return files;
+}
+
+}
+
+SimStats runSimulation(const SimulationConfig& config)
+{
+    WorkStealingPool pool(config.threads);
+
+    std::vector<std::unique_ptr<std::ofstream>> recordings;
+    if (!config.recordDirectory.empty()) {
+        recordings = openRecordings(config.recordDirectory,
+                                    pool.threadCount());
+    }
+
+    // One set of totals per worker, merged once all the games are over
+    std::vector<SimStats> workerStats(pool.threadCount());
+    pool.run(config.games, [&config, &workerStats, &recordings](
+             unsigned int worker, unsigned int game) {
+        std::vector<std::shared_ptr<IPolicy>> policies;
+        for (std::size_t i = 0; i < config.policies.size(); ++i) {
+            int playerId = i + 1;
+            policies.push_back(createPolicy(
+                        config.policies.at(i),
+                        deriveSeed(config.seed, game, playerId)));
+        }
+
+        // The timers write to the totals all the time, keep them off the
+        // cache lines the other workers write to
+        SimStats stats;
+        unsigned int seed = deriveSeed(config.seed, game, 0);
+        HeadlessGame headlessGame(policies, seed, config.maxTurns);
+        std::unique_ptr<GameRecorder> recorder;
+        if (!recordings.empty()) {
+            recorder.reset(new GameRecorder(game, seed, policies.size(),
+                                            config.maxTurns));
+            headlessGame.setRecorder(recorder.get());
+        }
+        if (headlessGame.play(stats) == 0) {
+            ++stats.unfinishedGames;
+        }
+        workerStats.at(worker).merge(stats);
+
+        if (recorder != nullptr) {
+            std::ofstream& file = *recordings.at(worker);
+            recorder->writeGame(file);
+            if (!file) {
+                throw Common::IoException(
+                            "Could not write file " +
+                            recordingFileName(config.recordDirectory, worker));
+            }
+        }
+    });
+
+    for (unsigned int worker = 0; worker < recordings.size(); ++worker) {
+        recordings.at(worker)->close();
+        if (!*recordings.at(worker)) {
+            throw Common::IoException(
+                        "Could not write file " +
+                        recordingFileName(config.recordDirectory, worker));
+        }
+    }
+
+    SimStats stats;
+    for (const SimStats& other : workerStats) {
+        stats.merge(other);
+    }
+    return stats;
+}
+
+}
@@ -0,0 +1,84 @@
+#ifndef SIMULATION_HH
+#define SIMULATION_HH
+
+#include "ipolicy.hh"
+#include "simstats.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Plays a batch of headless games.
+ */
+
+/**
+ * @brief Contains the headless game runner and its player policies.
+ */
+namespace Simulation {
+
+/**
+ * @brief Settings of a batch of games.
+ */
+struct SimulationConfig
+{
+    unsigned int games = 1000;
+    unsigned int seed = 1;
+    //! Turns after which a round is declared a draw.
+    unsigned int maxTurns = 500;
+    //! Policy names, one for each player.
+    std::vector<std::string> policies = {"cautious", "random", "random"};
+    //! Worker threads the games are spread over.
+    unsigned int threads = 1;
+    //! Directory the games are recorded to for verifyRecordings(), empty
+    //! for not recording.
+    std::string recordDirectory;
+};
+
+/**
+ * @brief createPolicy creates a policy by its name.
+ * @param name "random" or "cautious".
+ * @param seed Seed of the policy's random choices.
+ * @return The created policy.
+ * @exception std::invalid_argument The name is unknown.
+ */
+std::shared_ptr<IPolicy> createPolicy(const std::string& name,
+                                      unsigned int seed);
+
+/**
+ * @brief deriveSeed mixes the seed of the batch with the numbers of a game
+ * and a player, so that every game and policy gets its own random sequence.
+ * @param seed Seed of the batch.
+ * @param game Index of the game in the batch.
+ * @param player Identifier of the player, 0 for the game itself.
+ * @return The derived seed.
+ */
+unsigned int deriveSeed(unsigned int seed, unsigned int game, int player);
+
+/**
+ * @brief recordingFileName names the recordings file of a worker.
+ * @param directory The directory of the recordings.
+ * @param worker Index of the worker.
+ * @return The path of the file.
+ */
+std::string recordingFileName(const std::string& directory,
+                              unsigned int worker);
+
+/**
+ * @brief runSimulation plays the games on config.threads threads.
+ * @details Every game has its own engine, board and random generators, so
+ * the counters don't depend on the number of threads, only the phase
+ * timings do. With config.recordDirectory every worker records its games to
+ * a file of its own, see recordingFileName(), replacing the recordings of
+ * earlier batches.
+ * @param config Settings of the batch.
+ * @return Counters and timings of all the games.
+ * @exception std::invalid_argument A policy name is unknown.
+ * @exception IoException The recordings can't be written.
+ */
+SimStats runSimulation(const SimulationConfig& config);
+
+}
+
+#endif // SIMULATION_HH
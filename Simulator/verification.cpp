@@ -0,0 +1,138 @@
+#include "verification.hh"
+#include "formatexception.hh"
+#include "gamerecorder.hh"
+#include "headlessgame.hh"
+#include "ioexception.hh"
+#include "recordedpolicy.hh"
+#include "workstealingpool.hh"
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace Simulation {
+
+namespace {
+
+/**
+ * A recorded game in a mapped file.
+ */
+struct RecordedGame
+{
+    std::string fileName;
+    const std::uint8_t* data;
+    std::size_t size;
+};
+
+/**
+ * Plays a recorded game again, returns an empty string if it went as
+ * recorded and the divergence otherwise.
+ */
+std::string verifyGame(const RecordedGame& recorded, SimStats& stats)
+{
+    GameRecorder recorder(recorded.data, recorded.size);
+    std::vector<std::shared_ptr<IPolicy>> policies;
+    for (unsigned int i = 0; i < recorder.players(); ++i) {
+        policies.push_back(std::make_shared<RecordedPolicy>(recorder));
+    }
+    HeadlessGame headlessGame(policies, recorder.seed(), recorder.maxTurns());
+    headlessGame.setRecorder(&recorder);
+
+    try {
+        if (headlessGame.play(stats) == 0) {
+            ++stats.unfinishedGames;
+        }
+        recorder.finish();
+    } catch (const DivergenceError& e) {
+        return recorded.fileName + ": " + e.what();
+    } catch (const Common::GameException& e) {
+        // A move the recording has but the engine refuses
+        return recorded.fileName + ": " + recorder.position() + ": " +
+                e.msg();
+    }
+    return std::string();
+}
+
+}
+
+VerificationResult verifyRecordings(const VerificationConfig& config)
+{
+    QDir dir(QString::fromStdString(config.directory));
+    if (!dir.exists()) {
+        throw Common::IoException("Could not read directory " +
+                                  config.directory);
+    }
+
+    VerificationResult result;
+    std::vector<std::unique_ptr<QFile>> files;
+    std::vector<RecordedGame> games;
+    for (const QString& name : dir.entryList(QStringList() << "*.rec",
+                                             QDir::Files, QDir::Name)) {
+        std::string fileName = dir.filePath(name).toStdString();
+        files.emplace_back(new QFile(dir.filePath(name)));
+        QFile& file = *files.back();
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw Common::IoException("Could not read file " + fileName);
+        }
+        const std::uint8_t* data = nullptr;
+        if (file.size() > 0) {
+            data = file.map(0, file.size());
+            if (data == nullptr) {
+                throw Common::IoException("Could not map file " + fileName);
+            }
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> offsets;
+        try {
+            GameRecorder::findGames(data, file.size(), offsets);
+        } catch (const Common::FormatException& e) {
+            throw Common::FormatException(fileName + ": " + e.msg());
+        }
+        for (const auto& offset : offsets) {
+            games.push_back(RecordedGame{fileName, data + offset.first,
+                                         offset.second});
+        }
+        ++result.files;
+    }
+    result.games = games.size();
+
+    WorkStealingPool pool(config.threads);
+    std::vector<SimStats> workerStats(pool.threadCount());
+    std::mutex divergenceMutex;
+    std::vector<std::pair<unsigned int, std::string>> divergences;
+    pool.run(games.size(), [&](unsigned int worker, unsigned int game) {
+        SimStats stats;
+        std::string divergence;
+        try {
+            divergence = verifyGame(games.at(game), stats);
+        } catch (const Common::FormatException& e) {
+            divergence = games.at(game).fileName + ": " + e.msg();
+        }
+        workerStats.at(worker).merge(stats);
+
+        if (!divergence.empty()) {
+            std::lock_guard<std::mutex> lock(divergenceMutex);
+            divergences.emplace_back(game, divergence);
+        }
+    });
+
+    for (const SimStats& stats : workerStats) {
+        result.stats.merge(stats);
+    }
+    // The workers find the divergences in any order
+    std::sort(divergences.begin(), divergences.end());
+    result.divergentGames = divergences.size();
+    for (const auto& divergence : divergences) {
+        if (result.divergences.size() == MAX_REPORTED_DIVERGENCES) {
+            break;
+        }
+        result.divergences.push_back(divergence.second);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,61 @@
+#ifndef VERIFICATION_HH
+#define VERIFICATION_HH
+
+#include "simstats.hh"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Plays recorded games again and checks they go as recorded.
+ */
+
+namespace Simulation {
+
+//! Divergences reported in full, the rest are only counted.
+const unsigned int MAX_REPORTED_DIVERGENCES = 10;
+
+/**
+ * @brief Settings of a verification.
+ */
+struct VerificationConfig
+{
+    //! Directory of the recordings, see SimulationConfig::recordDirectory.
+    std::string directory;
+    //! Worker threads the games are spread over.
+    unsigned int threads = 1;
+};
+
+/**
+ * @brief Outcome of a verification.
+ */
+struct VerificationResult
+{
+    //! Counters and timings of the games played again. A game that
+    //! diverged is not counted in stats.games.
+    SimStats stats;
+    unsigned long files = 0;
+    unsigned long games = 0;
+    unsigned long divergentGames = 0;
+    //! Where the first MAX_REPORTED_DIVERGENCES games diverged, in the order
+    //! of the files and the games in them.
+    std::vector<std::string> divergences;
+};
+
+/**
+ * @brief verifyRecordings plays every game recorded in a directory again
+ * with the recorded seed and moves, and checks every random draw, answer of
+ * the engine and state at the end of every turn against the recording.
+ * @details The recordings files are mapped to memory and their games spread
+ * over config.threads threads, each game with its own engine.
+ * @param config Settings of the verification.
+ * @return The games checked and the ones that diverged.
+ * @exception IoException The directory or a file can't be read.
+ * @exception FormatException A file is not a recordings file.
+ */
+VerificationResult verifyRecordings(const VerificationConfig& config);
+
+}
+
+#endif // VERIFICATION_HH
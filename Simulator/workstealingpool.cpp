@@ -0,0 +1,104 @@
+#include "workstealingpool.hh"
+
+#include <thread>
+
+namespace Simulation {
+
+WorkStealingPool::WorkStealingPool(unsigned int threads)
+{
+    if (threads == 0) {
+        threads = 1;
+    }
+    for (unsigned int i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+}
+
+unsigned int WorkStealingPool::threadCount() const
+{
+    return queues_.size();
+}
+
+void WorkStealingPool::run(unsigned int tasks, const Task& task)
+{
+    error_ = nullptr;
+
+    // Deal the tasks out in blocks, the last queues get one less if the
+    // tasks don't divide evenly
+    unsigned int threads = threadCount();
+    unsigned int next = 0;
+    for (unsigned int worker = 0; worker < threads; ++worker) {
+        unsigned int share = tasks / threads + (worker < tasks % threads);
+        std::deque<unsigned int>& queue = queues_.at(worker)->tasks;
+        queue.clear();
+        for (unsigned int i = 0; i < share; ++i) {
+            queue.push_back(next++);
+        }
+    }
+
+    // The calling thread is the first worker
+    std::vector<std::thread> workers;
+    for (unsigned int worker = 1; worker < threads; ++worker) {
+        workers.emplace_back(&WorkStealingPool::work, this, worker,
+                             std::cref(task));
+    }
+    work(0, task);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void WorkStealingPool::work(unsigned int worker, const Task& task)
+{
+    unsigned int next = 0;
+    while (popOwn(worker, next) || steal(worker, next)) {
+        try {
+            task(worker, next);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            // Drop the rest of the batch so that every worker stops soon
+            for (auto& queue : queues_) {
+                std::lock_guard<std::mutex> queueLock(queue->mutex);
+                queue->tasks.clear();
+            }
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::popOwn(unsigned int worker, unsigned int& task)
+{
+    WorkQueue& queue = *queues_.at(worker);
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned int worker, unsigned int& task)
+{
+    // Start from the neighbour, so that thieves spread over the victims
+    unsigned int threads = threadCount();
+    for (unsigned int i = 1; i < threads; ++i) {
+        WorkQueue& queue = *queues_.at((worker + i) % threads);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,73 @@
+#ifndef WORKSTEALINGPOOL_HH
+#define WORKSTEALINGPOOL_HH
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @brief Spreads independent tasks over worker threads.
+ */
+
+namespace Simulation {
+
+/**
+ * @brief Runs a batch of numbered tasks on a fixed number of threads.
+ * @details Every worker starts with a contiguous block of the tasks in a
+ * queue of its own, takes work from the back of it and, once it runs dry,
+ * steals from the front of the other queues. Long games therefore don't
+ * leave the other threads idle at the end of a batch.
+ */
+class WorkStealingPool
+{
+public:
+    //! Runs one task. Gets the index of the worker and of the task.
+    using Task = std::function<void(unsigned int worker, unsigned int task)>;
+
+    /**
+     * @brief Constructor.
+     * @param threads Number of worker threads, at least 1.
+     */
+    explicit WorkStealingPool(unsigned int threads);
+
+    /**
+     * @brief threadCount tells the number of worker threads.
+     * @return The number of worker threads.
+     */
+    unsigned int threadCount() const;
+
+    /**
+     * @brief run runs the tasks 0...tasks-1 and waits for all of them.
+     * @details A task may run on any worker, but never on two at once.
+     * The calls with the same worker index are made from one thread.
+     * @param tasks Number of tasks.
+     * @param task The task to run.
+     * @exception Rethrows the first exception thrown by a task, after the
+     * workers have stopped. The remaining tasks are skipped.
+     * @post Exception quarantee: basic
+     */
+    void run(unsigned int tasks, const Task& task);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<unsigned int> tasks;
+    };
+
+    void work(unsigned int worker, const Task& task);
+    bool popOwn(unsigned int worker, unsigned int& task);
+    bool steal(unsigned int worker, unsigned int& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+}
+
+#endif // WORKSTEALINGPOOL_HH
@@ -0,0 +1,28 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_cubekernelstest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_cubekernelstest.cpp \
+    ../../../GameLogic/Engine/cubekernels.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/boardindex.hh \
+    ../../../GameLogic/Engine/cubecoordinate.hh \
+    ../../../GameLogic/Engine/cubekernels.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
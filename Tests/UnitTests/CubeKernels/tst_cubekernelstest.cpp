@@ -0,0 +1,218 @@
+#include <QString>
+#include <QtTest>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "boardindex.hh"
+#include "cubekernels.hh"
+
+const unsigned TST_SEED = 20181121;
+
+// Batches of every length up to this cover the tails of the vector kernels,
+// which handle up to eight coordinates at a time.
+const std::size_t TST_MAX_TAIL = 17;
+
+// A batch long enough to go through the vector loops many times.
+const std::size_t TST_LONG_BATCH = 1000;
+
+// Batches start this many coordinates into their arrays, so that they are
+// not aligned to the vector registers.
+const std::size_t TST_MAX_SHIFT = 7;
+
+// Written around the outputs, the kernels must leave it alone.
+const int TST_GUARD = 0x5a5a5a5a;
+
+// Coordinates are spread over a board of this radius, and far from it.
+const int TST_RADIUS = 20;
+const int TST_FAR = 1 << 20;
+
+using Common::CubeKernels::KernelLevel;
+
+class CubeKernelsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CubeKernelsTest() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testLevelNames();
+    void testUnsupportedLevelFallsBack();
+
+    // Every level gives the distances and neighbours the formulas give
+    void testDistancesMatchScalar();
+    void testNeighboursMatchScalar();
+    void testFarCoordinates();
+
+private:
+    void checkDistances(const std::vector<Common::CubeCoordinate>& coords,
+                        Common::CubeCoordinate origin, std::size_t shift,
+                        std::size_t count, KernelLevel level);
+    void checkNeighbours(const std::vector<Common::CubeCoordinate>& coords,
+                         std::size_t shift, std::size_t count,
+                         KernelLevel level);
+
+    std::vector<Common::CubeCoordinate> randomCoordinates(
+            std::size_t count, int radius, std::mt19937& rng) const;
+
+    std::vector<KernelLevel> levels_;
+    std::vector<Common::CubeCoordinate> coords_;
+};
+
+namespace {
+
+int distance(Common::CubeCoordinate a, Common::CubeCoordinate b)
+{
+    return (std::abs(a.x - b.x) + std::abs(a.y - b.y) +
+            std::abs(a.z - b.z)) / 2;
+}
+
+bool sameCoordinate(Common::CubeCoordinate a, Common::CubeCoordinate b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+}
+
+std::vector<Common::CubeCoordinate> CubeKernelsTest::randomCoordinates(
+        std::size_t count, int radius, std::mt19937& rng) const
+{
+    std::uniform_int_distribution<int> axis(-radius, radius);
+    std::vector<Common::CubeCoordinate> coords;
+    while (coords.size() < count) {
+        int x = axis(rng);
+        int z = axis(rng);
+        coords.push_back(Common::CubeCoordinate(x, -x - z, z));
+    }
+    return coords;
+}
+
+void CubeKernelsTest::initTestCase()
+{
+    levels_ = {KernelLevel::SCALAR, KernelLevel::SSE2, KernelLevel::AVX2};
+    std::mt19937 rng(TST_SEED);
+    coords_ = randomCoordinates(TST_LONG_BATCH + TST_MAX_SHIFT, TST_RADIUS,
+                                rng);
+
+    qDebug("Kernels use %s", Common::CubeKernels::levelName(
+               Common::CubeKernels::supportedLevel()));
+}
+
+void CubeKernelsTest::checkDistances(
+        const std::vector<Common::CubeCoordinate>& coords,
+        Common::CubeCoordinate origin, std::size_t shift, std::size_t count,
+        KernelLevel level)
+{
+    // The output is shifted as well, with a guard on both sides
+    std::vector<int> distances(count + 2 * (TST_MAX_SHIFT + 1), TST_GUARD);
+    int* out = distances.data() + shift + 1;
+    Common::CubeKernels::distancesFrom(origin, coords.data() + shift, count,
+                                       out, level);
+
+    for (std::size_t i = 0; i < distances.size(); ++i) {
+        const int* at = distances.data() + i;
+        if (at < out || at >= out + count) {
+            QCOMPARE(*at, TST_GUARD);
+        } else {
+            QCOMPARE(*at, distance(origin, coords[shift + (at - out)]));
+        }
+    }
+}
+
+void CubeKernelsTest::checkNeighbours(
+        const std::vector<Common::CubeCoordinate>& coords, std::size_t shift,
+        std::size_t count, KernelLevel level)
+{
+    const Common::CubeCoordinate guard(TST_GUARD, TST_GUARD, TST_GUARD);
+    std::vector<Common::CubeCoordinate> neighbours(
+                (count + 2) * Common::HEX_NEIGHBOURS, guard);
+    Common::CubeCoordinate* out = neighbours.data() + Common::HEX_NEIGHBOURS;
+    Common::CubeKernels::neighboursOf(coords.data() + shift, count, out,
+                                      level);
+
+    for (std::size_t i = 0; i < Common::HEX_NEIGHBOURS; ++i) {
+        QVERIFY(sameCoordinate(neighbours[i], guard));
+        QVERIFY(sameCoordinate(neighbours[neighbours.size() - 1 - i], guard));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        Common::CubeCoordinate coord = coords[shift + i];
+        for (int side = 0; side < Common::HEX_NEIGHBOURS; ++side) {
+            const Common::CubeCoordinate& offset =
+                    Common::NEIGHBOUR_OFFSETS[side];
+            QVERIFY(sameCoordinate(
+                        out[i * Common::HEX_NEIGHBOURS + side],
+                        Common::CubeCoordinate(coord.x + offset.x,
+                                               coord.y + offset.y,
+                                               coord.z + offset.z)));
+        }
+    }
+}
+
+void CubeKernelsTest::testLevelNames()
+{
+    QCOMPARE(QString(Common::CubeKernels::levelName(KernelLevel::SCALAR)),
+             QString("scalar"));
+    QCOMPARE(QString(Common::CubeKernels::levelName(KernelLevel::SSE2)),
+             QString("sse2"));
+    QCOMPARE(QString(Common::CubeKernels::levelName(KernelLevel::AVX2)),
+             QString("avx2"));
+}
+
+void CubeKernelsTest::testUnsupportedLevelFallsBack()
+{
+    // Asking for every level works whatever the processor supports, the
+    // levels above supportedLevel run the supported one
+    const Common::CubeCoordinate origin(2, -1, -1);
+    for (KernelLevel level : levels_) {
+        checkDistances(coords_, origin, 0, TST_MAX_TAIL, level);
+        checkNeighbours(coords_, 0, TST_MAX_TAIL, level);
+    }
+}
+
+void CubeKernelsTest::testDistancesMatchScalar()
+{
+    const Common::CubeCoordinate origin(3, -5, 2);
+    for (KernelLevel level : levels_) {
+        for (std::size_t shift = 0; shift <= TST_MAX_SHIFT; ++shift) {
+            for (std::size_t count = 0; count <= TST_MAX_TAIL; ++count) {
+                checkDistances(coords_, origin, shift, count, level);
+            }
+            checkDistances(coords_, origin, shift, TST_LONG_BATCH, level);
+        }
+    }
+}
+
+void CubeKernelsTest::testNeighboursMatchScalar()
+{
+    for (KernelLevel level : levels_) {
+        for (std::size_t shift = 0; shift <= TST_MAX_SHIFT; ++shift) {
+            for (std::size_t count = 0; count <= TST_MAX_TAIL; ++count) {
+                checkNeighbours(coords_, shift, count, level);
+            }
+            checkNeighbours(coords_, shift, TST_LONG_BATCH, level);
+        }
+    }
+}
+
+void CubeKernelsTest::testFarCoordinates()
+{
+    // Large and negative components, as far apart as the distances stay
+    // within an int
+    std::mt19937 rng(TST_SEED);
+    std::vector<Common::CubeCoordinate> coords = randomCoordinates(
+                TST_MAX_TAIL + TST_MAX_SHIFT, TST_FAR, rng);
+    const Common::CubeCoordinate origin(-TST_FAR, TST_FAR, 0);
+    for (KernelLevel level : levels_) {
+        for (std::size_t shift = 0; shift <= TST_MAX_SHIFT; ++shift) {
+            checkDistances(coords, origin, shift, TST_MAX_TAIL, level);
+            checkNeighbours(coords, shift, TST_MAX_TAIL, level);
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(CubeKernelsTest)
+
+#include "tst_cubekernelstest.moc"
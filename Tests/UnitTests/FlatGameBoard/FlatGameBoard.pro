@@ -0,0 +1,106 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_flatgameboardtest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which as been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    ../GameBoard/tst_gameboardtest.cpp \
+    ../../../GameLogic/Engine/actorfactory.cpp \
+    ../../../GameLogic/Engine/hex.cpp \
+    ../../../GameLogic/Engine/cubekernels.cpp \
+    ../../../GameLogic/Engine/hexbitboard.cpp \
+    ../../../GameLogic/Engine/boardtopology.cpp \
+    ../../../GameLogic/Engine/undolog.cpp \
+    ../../../GameLogic/Engine/gamelog.cpp \
+    ../../../GameLogic/Engine/typeregistry.cpp \
+    ../../../GameLogic/Engine/gamearena.cpp \
+    ../../../GameLogic/Engine/piecefactory.cpp \
+    ../../../GameLogic/Engine/boardrecipe.cpp \
+    ../../../GameLogic/Engine/boardtemplate.cpp \
+    ../../../GameLogic/Engine/wheellayoutparser.cpp \
+    ../../../GameLogic/Engine/gamerandom.cpp \
+    ../../../GameLogic/Engine/ioexception.cpp \
+    ../../../GameLogic/Engine/formatexception.cpp \
+    ../../../GameLogic/Engine/gameexception.cpp \
+    ../../../UI/gameboardbase.cpp \
+    ../../../UI/gameboard.cpp \
+    ../../../UI/flatgameboard.cpp \
+    ../../../GameLogic/Engine/pawn.cpp \
+    ../../../GameLogic/Engine/transport.cpp \
+    ../../../GameLogic/Engine/dolphin.cpp \
+    ../../../GameLogic/Engine/boat.cpp \
+    ../../../GameLogic/Engine/actor.cpp \
+    ../../../GameLogic/Engine/kraken.cpp \
+    ../../../GameLogic/Engine/seamunster.cpp \
+    ../../../GameLogic/Engine/shark.cpp \
+    ../../../GameLogic/Engine/vortex.cpp
+
+
+
+
+HEADERS += \
+    ../../../GameLogic/Engine/piecefactory.hh \
+    ../../../GameLogic/Engine/boardrecipe.hh \
+    ../../../GameLogic/Engine/boardtemplate.hh \
+    ../../../GameLogic/Engine/wheellayoutparser.hh \
+    ../../../GameLogic/Engine/gamerandom.hh \
+    ../../../GameLogic/Engine/hex.hh \
+    ../../../GameLogic/Engine/ihexlistener.hh \
+    ../../../GameLogic/Engine/smallvector.hh \
+    ../../../GameLogic/Engine/typeregistry.hh \
+    ../../../GameLogic/Engine/gamearena.hh \
+    ../../../GameLogic/Engine/actorfactory.hh \
+    ../../../GameLogic/Engine/ioexception.hh \
+    ../../../GameLogic/Engine/formatexception.hh \
+    ../../../GameLogic/Engine/gameexception.hh \
+    ../../../GameLogic/Engine/igameboard.hh \
+    ../../../UI/gameboardbase.hh \
+    ../../../UI/gameboard.hh \
+    ../../../UI/flatgameboard.hh \
+    ../../../GameLogic/Engine/boardindex.hh \
+    ../../../GameLogic/Engine/boardtopology.hh \
+    ../../../GameLogic/Engine/hexbitboard.hh \
+    ../../../GameLogic/Engine/iundotarget.hh \
+    ../../../GameLogic/Engine/undolog.hh \
+    ../../../GameLogic/Engine/gamelog.hh \
+    ../../../GameLogic/Engine/varint.hh \
+    ../../../GameLogic/Engine/pawn.hh \
+    ../../../GameLogic/Engine/transport.hh \
+    ../../../GameLogic/Engine/dolphin.hh \
+    ../../../GameLogic/Engine/boat.hh \
+    ../../../GameLogic/Engine/actor.hh \
+    ../../../GameLogic/Engine/kraken.hh \
+    ../../../GameLogic/Engine/seamunster.hh \
+    ../../../GameLogic/Engine/shark.hh \
+    ../../../GameLogic/Engine/vortex.hh \
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+# Run the GameBoard tests against the array-backed board
+DEFINES += TST_GAMEBOARD=Student::FlatGameBoard
+
+INCLUDEPATH += ../../../UI \
+                ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../UI \
+                ../../../GameLogic/Engine/
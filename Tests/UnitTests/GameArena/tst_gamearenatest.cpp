@@ -0,0 +1,319 @@
+#include <QString>
+#include <QtTest>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gamearena.hh"
+
+// Chunk size of the test arenas, small so that the tests fill several.
+const std::size_t TST_CHUNK_SIZE = 1024;
+
+// Allocations of each test.
+const int TST_ALLOCATIONS = 1000;
+
+namespace {
+
+// Counts the objects alive, to see that the destructors run.
+struct Counted
+{
+    explicit Counted(int value, int& alive):
+        value(value),
+        alive(alive)
+    {
+        ++alive;
+    }
+
+    ~Counted()
+    {
+        --alive;
+    }
+
+    int value;
+    int& alive;
+};
+
+bool isAligned(const void* memory, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(memory) % alignment == 0;
+}
+
+}
+
+class GameArenaTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameArenaTest() = default;
+
+private Q_SLOTS:
+    void testNoChunkBeforeUse();
+    void testAlignment();
+    void testBlocksDontOverlap();
+    void testLargeBlocks();
+
+    // mark and rewind
+    void testRewindReusesMemory();
+    void testRewindFreesChunks();
+    void testRewindToEmpty();
+
+    // Objects made in the arena
+    void testMakeRunsDestructors();
+    void testBlocksOutliveArena();
+    void testMakeWithoutArena();
+    void testAllocatorInContainer();
+};
+
+void GameArenaTest::testNoChunkBeforeUse()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    QCOMPARE(arena.chunkCount(), std::size_t(0));
+    QCOMPARE(arena.bytesAllocated(), std::size_t(0));
+
+    arena.allocate(1, 1);
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+    QCOMPARE(arena.bytesAllocated(), std::size_t(1));
+}
+
+void GameArenaTest::testAlignment()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        // Odd sizes leave the pointer unaligned for the next block
+        for (std::size_t alignment = 1;
+             alignment <= alignof(std::max_align_t); alignment *= 2) {
+            void* memory = arena.allocate(i % 13 + 1, alignment);
+            QVERIFY(isAligned(memory, alignment));
+        }
+    }
+}
+
+void GameArenaTest::testBlocksDontOverlap()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    std::vector<unsigned char*> blocks;
+    std::size_t total = 0;
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        std::size_t size = i % 29 + 1;
+        auto block = static_cast<unsigned char*>(arena.allocate(size, 1));
+        for (std::size_t byte = 0; byte < size; ++byte) {
+            block[byte] = static_cast<unsigned char>(i);
+        }
+        blocks.push_back(block);
+        total += size;
+    }
+    QCOMPARE(arena.bytesAllocated(), total);
+
+    // Writing a block didn't change any of the others
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        for (std::size_t byte = 0; byte < std::size_t(i % 29 + 1); ++byte) {
+            QCOMPARE(blocks[i][byte], static_cast<unsigned char>(i));
+        }
+    }
+
+    // Only full chunks were left behind
+    QVERIFY(arena.chunkCount() <= total / (TST_CHUNK_SIZE - 29) + 1);
+}
+
+void GameArenaTest::testLargeBlocks()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    auto before = static_cast<char*>(arena.allocate(8, 8));
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+
+    // A block larger than a quarter chunk gets a chunk of its own when the
+    // current one can't hold it, and the current chunk stays in use
+    auto large = static_cast<char*>(arena.allocate(TST_CHUNK_SIZE * 4, 8));
+    QVERIFY(isAligned(large, 8));
+    QCOMPARE(arena.chunkCount(), std::size_t(2));
+    auto after = static_cast<char*>(arena.allocate(8, 8));
+    QVERIFY(after == before + 8);
+    QCOMPARE(arena.chunkCount(), std::size_t(2));
+
+    // The large block is usable to its end
+    large[TST_CHUNK_SIZE * 4 - 1] = 1;
+    QCOMPARE(arena.bytesAllocated(), std::size_t(TST_CHUNK_SIZE * 4 + 16));
+}
+
+void GameArenaTest::testRewindReusesMemory()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    arena.allocate(24, 8);
+    const Common::GameArena::Mark mark = arena.mark();
+    const std::size_t bytes = arena.bytesAllocated();
+
+    std::vector<void*> first;
+    for (int i = 0; i < 16; ++i) {
+        first.push_back(arena.allocate(i + 1, 8));
+    }
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+
+    // The same allocations after a rewind get the same memory
+    arena.rewind(mark);
+    QCOMPARE(arena.bytesAllocated(), bytes);
+    for (int i = 0; i < 16; ++i) {
+        QVERIFY(arena.allocate(i + 1, 8) == first[i]);
+    }
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+
+    // Rewinding over and over doesn't grow the arena
+    for (int round = 0; round < TST_ALLOCATIONS; ++round) {
+        arena.rewind(mark);
+        for (int i = 0; i < 16; ++i) {
+            arena.allocate(i + 1, 8);
+        }
+    }
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+    arena.rewind(mark);
+    QCOMPARE(arena.bytesAllocated(), bytes);
+}
+
+void GameArenaTest::testRewindFreesChunks()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    arena.allocate(16, 8);
+    const Common::GameArena::Mark mark = arena.mark();
+    void* next = arena.allocate(16, 8);
+
+    // Fill several chunks and a large block after the mark
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        arena.allocate(64, 8);
+    }
+    arena.allocate(TST_CHUNK_SIZE * 2, 8);
+    QVERIFY(arena.chunkCount() > 2);
+
+    // The chunks taken after the mark go back to the heap, the chunk of the
+    // mark is used again from the mark on
+    arena.rewind(mark);
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+    QCOMPARE(arena.bytesAllocated(), std::size_t(16));
+    QVERIFY(arena.allocate(16, 8) == next);
+
+    // The arena grows again as before
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        arena.allocate(64, 8);
+    }
+    QVERIFY(arena.chunkCount() > 2);
+}
+
+void GameArenaTest::testRewindToEmpty()
+{
+    Common::GameArena arena(TST_CHUNK_SIZE);
+    const Common::GameArena::Mark mark = arena.mark();
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        arena.allocate(32, 8);
+    }
+    arena.rewind(mark);
+    QCOMPARE(arena.chunkCount(), std::size_t(0));
+    QCOMPARE(arena.bytesAllocated(), std::size_t(0));
+
+    // A rewound arena is like a new one
+    QVERIFY(isAligned(arena.allocate(8, alignof(std::max_align_t)),
+                      alignof(std::max_align_t)));
+    QCOMPARE(arena.chunkCount(), std::size_t(1));
+}
+
+void GameArenaTest::testMakeRunsDestructors()
+{
+    int alive = 0;
+    auto arena = std::make_shared<Common::GameArena>(TST_CHUNK_SIZE);
+    {
+        std::vector<std::shared_ptr<Counted>> objects;
+        for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+            objects.push_back(
+                        Common::GameArena::make<Counted>(arena, i, alive));
+        }
+        QCOMPARE(alive, TST_ALLOCATIONS);
+        QVERIFY(arena->chunkCount() > 1);
+
+        for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+            QCOMPARE(objects[i]->value, i);
+        }
+        objects.resize(TST_ALLOCATIONS / 2);
+        QCOMPARE(alive, TST_ALLOCATIONS / 2);
+    }
+    QCOMPARE(alive, 0);
+}
+
+void GameArenaTest::testBlocksOutliveArena()
+{
+    int alive = 0;
+    auto arena = std::make_shared<Common::GameArena>(TST_CHUNK_SIZE);
+    std::weak_ptr<Common::GameArena> weakArena = arena;
+
+    std::shared_ptr<Counted> first =
+            Common::GameArena::make<Counted>(arena, 1, alive);
+    std::vector<std::shared_ptr<Counted>> others;
+    for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+        others.push_back(Common::GameArena::make<Counted>(arena, i, alive));
+    }
+
+    // The game lets go of its arena, the objects keep it and their memory
+    arena.reset();
+    QVERIFY(!weakArena.expired());
+    QCOMPARE(first->value, 1);
+    first->value = 2;
+    QCOMPARE(first->value, 2);
+
+    others.clear();
+    QVERIFY(!weakArena.expired());
+    QCOMPARE(first->value, 2);
+    QCOMPARE(alive, 1);
+
+    std::weak_ptr<Counted> weakFirst = first;
+    first.reset();
+    QVERIFY(weakFirst.expired());
+    QCOMPARE(alive, 0);
+
+    // A weak pointer holds the control block and so the arena, the arena
+    // is freed with the last control block
+    QVERIFY(!weakArena.expired());
+    weakFirst.reset();
+    QVERIFY(weakArena.expired());
+}
+
+void GameArenaTest::testMakeWithoutArena()
+{
+    int alive = 0;
+    std::shared_ptr<Counted> object =
+            Common::GameArena::make<Counted>(nullptr, 7, alive);
+    QCOMPARE(object->value, 7);
+    QCOMPARE(alive, 1);
+    object.reset();
+    QCOMPARE(alive, 0);
+}
+
+void GameArenaTest::testAllocatorInContainer()
+{
+    auto arena = std::make_shared<Common::GameArena>(TST_CHUNK_SIZE);
+    Common::ArenaAllocator<int> allocator(arena);
+    QVERIFY(allocator == Common::ArenaAllocator<double>(arena));
+    QVERIFY(allocator != Common::ArenaAllocator<int>());
+    QVERIFY(allocator != Common::ArenaAllocator<int>(
+                std::make_shared<Common::GameArena>(TST_CHUNK_SIZE)));
+
+    std::weak_ptr<Common::GameArena> weakArena = arena;
+    {
+        std::vector<int, Common::ArenaAllocator<int>> values(allocator);
+        for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+            values.push_back(i);
+        }
+        for (int i = 0; i < TST_ALLOCATIONS; ++i) {
+            QCOMPARE(values[i], i);
+        }
+        QVERIFY(arena->bytesAllocated() >= TST_ALLOCATIONS * sizeof(int));
+
+        // The container keeps the arena after the game lets go of it
+        arena.reset();
+        allocator = Common::ArenaAllocator<int>();
+        QVERIFY(!weakArena.expired());
+        values.push_back(TST_ALLOCATIONS);
+        QCOMPARE(values.back(), TST_ALLOCATIONS);
+    }
+    QVERIFY(weakArena.expired());
+}
+
+QTEST_APPLESS_MAIN(GameArenaTest)
+
+#include "tst_gamearenatest.moc"
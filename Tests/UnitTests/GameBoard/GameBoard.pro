@@ -34,10 +34,22 @@ SOURCES += \
     tst_gameboardtest.cpp \
     ../../../GameLogic/Engine/actorfactory.cpp \
     ../../../GameLogic/Engine/hex.cpp \
+    ../../../GameLogic/Engine/cubekernels.cpp \
+    ../../../GameLogic/Engine/hexbitboard.cpp \
+    ../../../GameLogic/Engine/boardtopology.cpp \
+    ../../../GameLogic/Engine/undolog.cpp \
+    ../../../GameLogic/Engine/gamelog.cpp \
+    ../../../GameLogic/Engine/typeregistry.cpp \
+    ../../../GameLogic/Engine/gamearena.cpp \
     ../../../GameLogic/Engine/piecefactory.cpp \
+    ../../../GameLogic/Engine/boardrecipe.cpp \
+    ../../../GameLogic/Engine/boardtemplate.cpp \
+    ../../../GameLogic/Engine/wheellayoutparser.cpp \
+    ../../../GameLogic/Engine/gamerandom.cpp \
     ../../../GameLogic/Engine/ioexception.cpp \
     ../../../GameLogic/Engine/formatexception.cpp \
     ../../../GameLogic/Engine/gameexception.cpp \
+    ../../../UI/gameboardbase.cpp \
     ../../../UI/gameboard.cpp \
     ../../../GameLogic/Engine/pawn.cpp \
     ../../../GameLogic/Engine/transport.cpp \
@@ -54,12 +66,21 @@ SOURCES += \
 
 HEADERS += \
     ../../../GameLogic/Engine/piecefactory.hh \
+    ../../../GameLogic/Engine/boardrecipe.hh \
+    ../../../GameLogic/Engine/boardtemplate.hh \
+    ../../../GameLogic/Engine/wheellayoutparser.hh \
+    ../../../GameLogic/Engine/gamerandom.hh \
     ../../../GameLogic/Engine/hex.hh \
+    ../../../GameLogic/Engine/ihexlistener.hh \
+    ../../../GameLogic/Engine/smallvector.hh \
+    ../../../GameLogic/Engine/typeregistry.hh \
+    ../../../GameLogic/Engine/gamearena.hh \
     ../../../GameLogic/Engine/actorfactory.hh \
     ../../../GameLogic/Engine/ioexception.hh \
     ../../../GameLogic/Engine/formatexception.hh \
     ../../../GameLogic/Engine/gameexception.hh \
     ../../../GameLogic/Engine/igameboard.hh \
+    ../../../UI/gameboardbase.hh \
     ../../../UI/gameboard.hh \
     ../../../GameLogic/Engine/pawn.hh \
     ../../../GameLogic/Engine/transport.hh \
@@ -3,6 +3,9 @@
 #include <vector>
 
 #include "gameboard.hh"
+#include "flatgameboard.hh"
+#include "columngameboard.hh"
+#include "gameexception.hh"
 #include "hex.hh"
 #include "pawn.hh"
 #include "transport.hh"
@@ -23,6 +26,12 @@ const std::string TST_HEXTYPE = "None";
 const std::string TST_DEFAULT_ACTOR_TYPE = "Shark";
 const std::string TST_DEFAULT_TRANSPORT_TYPE = "Boat";
 
+// The same tests are run against every GameBoard implementation, the project
+// file selects the one under test.
+#ifndef TST_GAMEBOARD
+#define TST_GAMEBOARD Student::GameBoard
+#endif
+
 class GameBoardTest : public QObject
 {
     Q_OBJECT
@@ -37,6 +46,8 @@ private Q_SLOTS:
     // Hex additions
     void testAddHex();
     void testAddHexReplace();
+    void testAddHexInvalidCoordinate();
+    void testGetHexInvalidCoordinate();
 
     // Tiletype
     void testIsWaterTile();
@@ -106,7 +117,7 @@ GameBoardTest::GameBoardTest():
 void GameBoardTest::init()
 {
     board_.reset();
-    board_= std::make_shared<Student::GameBoard>();
+    board_= std::make_shared<TST_GAMEBOARD>();
 }
 
 void GameBoardTest::testConsturctor()
@@ -139,6 +150,25 @@ void GameBoardTest::testAddHexReplace()
     QVERIFY(board_->getHex(center_) == replacehex);
 }
 
+void GameBoardTest::testAddHexInvalidCoordinate()
+{
+    std::shared_ptr<Common::Hex> newhex(new Common::Hex);
+    newhex->setCoordinates(Common::CubeCoordinate(1, 1, -1));
+    QVERIFY_EXCEPTION_THROWN(board_->addHex(newhex), Common::GameException);
+    QVERIFY(board_->getHex(Common::CubeCoordinate(1, 0, -1)) == nullptr);
+}
+
+void GameBoardTest::testGetHexInvalidCoordinate()
+{
+    // x and z of the center, but not a cube coordinate
+    addHex(center_, TST_HEXTYPE);
+    Common::CubeCoordinate invalid(center_.x, center_.y + 1, center_.z);
+    QVERIFY(board_->getHex(invalid) == nullptr);
+    QVERIFY(board_->findHex(invalid) == nullptr);
+    QVERIFY(board_->checkTileOccupation(invalid) == -1);
+    QVERIFY(not board_->isWaterTile(invalid));
+}
+
 void GameBoardTest::testIsWaterTile()
 {
     addHex(center_, TST_HEXTYPE);
@@ -0,0 +1,36 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_gamelogtest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_gamelogtest.cpp \
+    ../../../GameLogic/Engine/gamelog.cpp \
+    ../../../GameLogic/Engine/typeregistry.cpp \
+    ../../../GameLogic/Engine/ioexception.cpp \
+    ../../../GameLogic/Engine/formatexception.cpp \
+    ../../../GameLogic/Engine/gameexception.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/gamelog.hh \
+    ../../../GameLogic/Engine/varint.hh \
+    ../../../GameLogic/Engine/typeregistry.hh \
+    ../../../GameLogic/Engine/cubecoordinate.hh \
+    ../../../GameLogic/Engine/ioexception.hh \
+    ../../../GameLogic/Engine/formatexception.hh \
+    ../../../GameLogic/Engine/gameexception.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
@@ -0,0 +1,338 @@
+#include <QString>
+#include <QtTest>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gamelog.hh"
+#include "formatexception.hh"
+#include "typeregistry.hh"
+
+// Bytes of the header, GameLog::LOG_MAGIC and GameLog::LOG_VERSION.
+const std::size_t TST_HEADER_SIZE = 5;
+
+// Type name that no other piece uses, so that its id in this program is
+// known to differ from the id written in the hand made logs.
+const std::string TST_TYPE_NAME = "GameLogTestType";
+
+// Type id of TST_TYPE_NAME in the hand made logs, two bytes as a varint.
+const std::uint8_t TST_LOG_TYPE = 200;
+
+class GameLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameLogTest();
+
+private Q_SLOTS:
+
+    // Every record type reads back as it was written
+    void testRoundTrip();
+    void testRoundTripAfterRewind();
+
+    // Damaged logs
+    void testMissingHeader();
+    void testOtherVersion();
+    void testUnknownRecord();
+    void testCutShort();
+
+    // Type ids of the log are mapped to the ids of the reading program
+    void testTypeNamedRemapping();
+    void testTypeUsedBeforeNamed();
+    void testInvalidTypeNamed();
+
+private:
+    // Writes one record of every type to log
+    void writeEveryRecord(Common::GameLog& log);
+
+    // Reads every record of bytes, throws as Reader::next does
+    std::vector<Common::GameLog::Record> readAll(
+            const std::vector<std::uint8_t>& bytes);
+
+    // A header followed by TYPE_NAMED of TST_LOG_TYPE
+    std::vector<std::uint8_t> namedTypeLog();
+
+    Common::TypeId sharkType_;
+    Common::TypeId boatType_;
+};
+
+GameLogTest::GameLogTest():
+    sharkType_(Common::TypeRegistry::getInstance().intern("shark")),
+    boatType_(Common::TypeRegistry::getInstance().intern("boat"))
+{
+}
+
+void GameLogTest::writeEveryRecord(Common::GameLog& log)
+{
+    log.gameStarted(20181121, 3);
+    log.pawnAdded(7, 2, Common::CubeCoordinate(1, -3, 2));
+    log.pawnMoved(7, Common::CubeCoordinate(1, -3, 2),
+                  Common::CubeCoordinate(2, -3, 1), 2);
+    log.transportMoved(4, Common::CubeCoordinate(-5, 5, 0),
+                       Common::CubeCoordinate(-4, 5, -1), 1);
+    log.actorMoved(11, Common::CubeCoordinate(0, 6, -6),
+                   Common::CubeCoordinate(-3, 6, -3), "3");
+    log.transportSpun(4, Common::CubeCoordinate(-4, 5, -1),
+                      Common::CubeCoordinate(-4, 9, -5), "D", 0);
+    log.tileFlipped(Common::CubeCoordinate(8, -8, 0), sharkType_, 12);
+    log.wheelSpun(boatType_, "2");
+    log.actorActed(12, sharkType_, Common::CubeCoordinate(8, -8, 0));
+    log.pawnRemoved(7);
+    log.actorRemoved(12);
+    log.transportRemoved(4);
+}
+
+std::vector<Common::GameLog::Record> GameLogTest::readAll(
+        const std::vector<std::uint8_t>& bytes)
+{
+    std::vector<Common::GameLog::Record> records;
+    Common::GameLog::Reader reader(bytes.data(), bytes.size());
+    Common::GameLog::Record record;
+    while (reader.next(record)) {
+        records.push_back(record);
+    }
+    return records;
+}
+
+std::vector<std::uint8_t> GameLogTest::namedTypeLog()
+{
+    std::vector<std::uint8_t> bytes(
+                Common::GameLog::LOG_MAGIC,
+                Common::GameLog::LOG_MAGIC + sizeof(Common::GameLog::LOG_MAGIC));
+    bytes.push_back(Common::GameLog::LOG_VERSION);
+
+    bytes.push_back(
+                static_cast<std::uint8_t>(
+                    Common::GameLog::RecordType::TYPE_NAMED));
+    bytes.push_back(0x80 | (TST_LOG_TYPE & 0x7f));
+    bytes.push_back(TST_LOG_TYPE >> 7);
+    bytes.push_back(static_cast<std::uint8_t>(TST_TYPE_NAME.size()));
+    bytes.insert(bytes.end(), TST_TYPE_NAME.begin(), TST_TYPE_NAME.end());
+    return bytes;
+}
+
+void GameLogTest::testRoundTrip()
+{
+    using Type = Common::GameLog::RecordType;
+
+    Common::GameLog log;
+    QVERIFY(log.empty());
+    writeEveryRecord(log);
+    QVERIFY(!log.empty());
+
+    std::vector<Common::GameLog::Record> records =
+            readAll(std::vector<std::uint8_t>(log.data(),
+                                              log.data() + log.size()));
+    QCOMPARE(records.size(), std::size_t(12));
+
+    QVERIFY(records.at(0).type == Type::GAME_STARTED);
+    QCOMPARE(records.at(0).value, std::int64_t(20181121));
+    QCOMPARE(records.at(0).id, 3);
+
+    QVERIFY(records.at(1).type == Type::PAWN_ADDED);
+    QCOMPARE(records.at(1).id, 7);
+    QCOMPARE(records.at(1).owner, 2);
+    QVERIFY(records.at(1).target == Common::CubeCoordinate(1, -3, 2));
+
+    QVERIFY(records.at(2).type == Type::PAWN_MOVED);
+    QCOMPARE(records.at(2).id, 7);
+    QVERIFY(records.at(2).origin == Common::CubeCoordinate(1, -3, 2));
+    QVERIFY(records.at(2).target == Common::CubeCoordinate(2, -3, 1));
+    QCOMPARE(records.at(2).value, std::int64_t(2));
+
+    QVERIFY(records.at(3).type == Type::TRANSPORT_MOVED);
+    QCOMPARE(records.at(3).id, 4);
+    QVERIFY(records.at(3).origin == Common::CubeCoordinate(-5, 5, 0));
+    QVERIFY(records.at(3).target == Common::CubeCoordinate(-4, 5, -1));
+    QCOMPARE(records.at(3).value, std::int64_t(1));
+
+    QVERIFY(records.at(4).type == Type::ACTOR_MOVED);
+    QCOMPARE(records.at(4).id, 11);
+    QVERIFY(records.at(4).origin == Common::CubeCoordinate(0, 6, -6));
+    QVERIFY(records.at(4).target == Common::CubeCoordinate(-3, 6, -3));
+    QCOMPARE(records.at(4).moves, std::string("3"));
+
+    QVERIFY(records.at(5).type == Type::TRANSPORT_SPUN);
+    QCOMPARE(records.at(5).id, 4);
+    QVERIFY(records.at(5).origin == Common::CubeCoordinate(-4, 5, -1));
+    QVERIFY(records.at(5).target == Common::CubeCoordinate(-4, 9, -5));
+    QCOMPARE(records.at(5).moves, std::string("D"));
+    QCOMPARE(records.at(5).value, std::int64_t(0));
+
+    QVERIFY(records.at(6).type == Type::TILE_FLIPPED);
+    QVERIFY(records.at(6).target == Common::CubeCoordinate(8, -8, 0));
+    QCOMPARE(records.at(6).pieceType, sharkType_);
+    QCOMPARE(records.at(6).id, 12);
+
+    QVERIFY(records.at(7).type == Type::WHEEL_SPUN);
+    QCOMPARE(records.at(7).pieceType, boatType_);
+    QCOMPARE(records.at(7).moves, std::string("2"));
+
+    QVERIFY(records.at(8).type == Type::ACTOR_ACTED);
+    QCOMPARE(records.at(8).id, 12);
+    QCOMPARE(records.at(8).pieceType, sharkType_);
+    QVERIFY(records.at(8).target == Common::CubeCoordinate(8, -8, 0));
+
+    QVERIFY(records.at(9).type == Type::PAWN_REMOVED);
+    QCOMPARE(records.at(9).id, 7);
+    QVERIFY(records.at(10).type == Type::ACTOR_REMOVED);
+    QCOMPARE(records.at(10).id, 12);
+    QVERIFY(records.at(11).type == Type::TRANSPORT_REMOVED);
+    QCOMPARE(records.at(11).id, 4);
+}
+
+void GameLogTest::testRoundTripAfterRewind()
+{
+    // The records after a rewind are relative to the coordinates and named
+    // types before the mark, not to the dropped records
+    Common::GameLog log;
+    log.pawnAdded(1, 1, Common::CubeCoordinate(3, -3, 0));
+    Common::GameLog::Mark mark = log.mark();
+    std::size_t size = log.size();
+
+    log.tileFlipped(Common::CubeCoordinate(-6, 6, 0), sharkType_, 5);
+    log.rewind(mark);
+    QCOMPARE(log.size(), size);
+
+    log.tileFlipped(Common::CubeCoordinate(4, -2, -2), sharkType_, 6);
+
+    std::vector<Common::GameLog::Record> records =
+            readAll(std::vector<std::uint8_t>(log.data(),
+                                              log.data() + log.size()));
+    QCOMPARE(records.size(), std::size_t(2));
+    QVERIFY(records.at(1).type == Common::GameLog::RecordType::TILE_FLIPPED);
+    QVERIFY(records.at(1).target == Common::CubeCoordinate(4, -2, -2));
+    QCOMPARE(records.at(1).pieceType, sharkType_);
+    QCOMPARE(records.at(1).id, 6);
+}
+
+void GameLogTest::testMissingHeader()
+{
+    std::vector<std::uint8_t> empty;
+    QVERIFY_EXCEPTION_THROWN(readAll(empty), Common::FormatException);
+
+    Common::GameLog log;
+    log.pawnRemoved(1);
+    std::vector<std::uint8_t> bytes(log.data(), log.data() + log.size());
+    bytes.at(0) = 'X';
+    QVERIFY_EXCEPTION_THROWN(readAll(bytes), Common::FormatException);
+
+    bytes.resize(TST_HEADER_SIZE - 1);
+    QVERIFY_EXCEPTION_THROWN(readAll(bytes), Common::FormatException);
+}
+
+void GameLogTest::testOtherVersion()
+{
+    Common::GameLog log;
+    log.pawnRemoved(1);
+    std::vector<std::uint8_t> bytes(log.data(), log.data() + log.size());
+    bytes.at(TST_HEADER_SIZE - 1) = Common::GameLog::LOG_VERSION + 1;
+    QVERIFY_EXCEPTION_THROWN(readAll(bytes), Common::FormatException);
+}
+
+void GameLogTest::testUnknownRecord()
+{
+    Common::GameLog log;
+    log.pawnRemoved(1);
+    std::vector<std::uint8_t> bytes(log.data(), log.data() + log.size());
+
+    std::vector<std::uint8_t> zero = bytes;
+    zero.push_back(0);
+    QVERIFY_EXCEPTION_THROWN(readAll(zero), Common::FormatException);
+
+    std::vector<std::uint8_t> past = bytes;
+    past.push_back(
+                static_cast<std::uint8_t>(
+                    Common::GameLog::RecordType::TYPE_NAMED) + 1);
+    QVERIFY_EXCEPTION_THROWN(readAll(past), Common::FormatException);
+}
+
+void GameLogTest::testCutShort()
+{
+    Common::GameLog log;
+    writeEveryRecord(log);
+    std::vector<std::uint8_t> whole(log.data(), log.data() + log.size());
+    std::size_t recordCount = readAll(whole).size();
+
+    // Cut at a record boundary the reader stops early, anywhere else it
+    // throws. It never reads past the cut.
+    for (std::size_t size = TST_HEADER_SIZE; size < whole.size(); ++size) {
+        std::vector<std::uint8_t> cut(whole.begin(), whole.begin() + size);
+        try {
+            QVERIFY(readAll(cut).size() < recordCount);
+        } catch (Common::FormatException&) {
+        }
+    }
+
+    // The moves of the last record are cut
+    Common::GameLog spinLog;
+    spinLog.actorMoved(1, Common::CubeCoordinate(0, 0, 0),
+                       Common::CubeCoordinate(1, -1, 0), "123");
+    std::vector<std::uint8_t> spin(spinLog.data(),
+                                   spinLog.data() + spinLog.size() - 1);
+    QVERIFY_EXCEPTION_THROWN(readAll(spin), Common::FormatException);
+}
+
+void GameLogTest::testTypeNamedRemapping()
+{
+    std::vector<std::uint8_t> bytes = namedTypeLog();
+    bytes.push_back(
+                static_cast<std::uint8_t>(
+                    Common::GameLog::RecordType::WHEEL_SPUN));
+    bytes.push_back(0x80 | (TST_LOG_TYPE & 0x7f));
+    bytes.push_back(TST_LOG_TYPE >> 7);
+    bytes.push_back(1);
+    bytes.push_back('D');
+
+    std::vector<Common::GameLog::Record> records = readAll(bytes);
+    QCOMPARE(records.size(), std::size_t(1));
+    QVERIFY(records.at(0).type == Common::GameLog::RecordType::WHEEL_SPUN);
+    QCOMPARE(records.at(0).pieceType,
+             Common::TypeRegistry::getInstance().intern(TST_TYPE_NAME));
+    QVERIFY(records.at(0).pieceType != TST_LOG_TYPE);
+    QCOMPARE(records.at(0).moves, std::string("D"));
+
+    // A log of only type names has no records
+    QVERIFY(readAll(namedTypeLog()).empty());
+}
+
+void GameLogTest::testTypeUsedBeforeNamed()
+{
+    Common::GameLog log;
+    std::vector<std::uint8_t> bytes(log.data(), log.data() + log.size());
+    bytes.push_back(
+                static_cast<std::uint8_t>(
+                    Common::GameLog::RecordType::WHEEL_SPUN));
+    bytes.push_back(0x80 | (TST_LOG_TYPE & 0x7f));
+    bytes.push_back(TST_LOG_TYPE >> 7);
+    bytes.push_back(1);
+    bytes.push_back('D');
+    QVERIFY_EXCEPTION_THROWN(readAll(bytes), Common::FormatException);
+}
+
+void GameLogTest::testInvalidTypeNamed()
+{
+    // NO_TYPE can't be named
+    std::vector<std::uint8_t> bytes = namedTypeLog();
+    bytes.at(TST_HEADER_SIZE + 1) = Common::NO_TYPE;
+    bytes.erase(bytes.begin() + TST_HEADER_SIZE + 2);
+    QVERIFY_EXCEPTION_THROWN(readAll(bytes), Common::FormatException);
+
+    // Neither can an id too large for a TypeId
+    Common::GameLog log;
+    std::vector<std::uint8_t> large(log.data(), log.data() + log.size());
+    large.push_back(
+                static_cast<std::uint8_t>(
+                    Common::GameLog::RecordType::TYPE_NAMED));
+    large.push_back(0x80);
+    large.push_back(0x80);
+    large.push_back(0x04);
+    large.push_back(1);
+    large.push_back('x');
+    QVERIFY_EXCEPTION_THROWN(readAll(large), Common::FormatException);
+}
+
+QTEST_APPLESS_MAIN(GameLogTest)
+
+#include "tst_gamelogtest.moc"
@@ -0,0 +1,26 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_gamerandomtest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_gamerandomtest.cpp \
+    ../../../GameLogic/Engine/gamerandom.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/gamerandom.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
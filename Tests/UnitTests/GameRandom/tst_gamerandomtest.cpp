@@ -0,0 +1,142 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "gamerandom.hh"
+
+// Seed the first draws are known for.
+const unsigned int TST_SEED = 20181121;
+
+// First draws of TST_SEED. Recorded games are replayed from their seed, so
+// these must never change.
+const std::vector<Logic::GameRandom::result_type> TST_FIRST_DRAWS = {
+    2838141253u, 1375717408u, 3158808496u, 857229023u
+};
+
+// Draws per result when checking that below() is even.
+const int TST_DRAWS_PER_RESULT = 10000;
+
+class GameRandomTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameRandomTest() = default;
+
+private Q_SLOTS:
+    void testKnownSequence();
+    void testSameSeedSameSequence();
+    void testNearbySeedsDiffer();
+    void testContinueFromState();
+    void testBelowInRange();
+    void testBelowEven();
+    void testStandardAlgorithms();
+};
+
+void GameRandomTest::testKnownSequence()
+{
+    Logic::GameRandom random(TST_SEED);
+    QCOMPARE(random.seed(), TST_SEED);
+    for (const auto& draw : TST_FIRST_DRAWS) {
+        QCOMPARE(random(), draw);
+    }
+}
+
+void GameRandomTest::testSameSeedSameSequence()
+{
+    Logic::GameRandom first(7);
+    Logic::GameRandom second(7);
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(first(), second());
+    }
+
+    // A copy continues the same sequence
+    Logic::GameRandom copy = first;
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(first.below(100), copy.below(100));
+    }
+}
+
+void GameRandomTest::testNearbySeedsDiffer()
+{
+    std::vector<Logic::GameRandom::result_type> firstDraws;
+    for (unsigned int seed = 0; seed < 100; ++seed) {
+        Logic::GameRandom random(seed);
+        firstDraws.push_back(random());
+    }
+    std::sort(firstDraws.begin(), firstDraws.end());
+    QVERIFY(std::adjacent_find(firstDraws.begin(), firstDraws.end()) ==
+            firstDraws.end());
+}
+
+void GameRandomTest::testContinueFromState()
+{
+    Logic::GameRandom random(TST_SEED);
+    for (int i = 0; i < 10; ++i) {
+        random();
+    }
+
+    Logic::GameRandom restored(random.seed(), random.state());
+    QCOMPARE(restored.seed(), random.seed());
+    QCOMPARE(restored.state(), random.state());
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(restored(), random());
+    }
+}
+
+void GameRandomTest::testBelowInRange()
+{
+    Logic::GameRandom random(TST_SEED);
+    const std::vector<Logic::GameRandom::result_type> bounds = {
+        1, 2, 3, 6, 7, 1000, 0x80000001u, Logic::GameRandom::max()
+    };
+    for (const auto& bound : bounds) {
+        for (int i = 0; i < 1000; ++i) {
+            QVERIFY(random.below(bound) < bound);
+        }
+    }
+}
+
+void GameRandomTest::testBelowEven()
+{
+    // Each result of a die comes up within 5 % of its share
+    const Logic::GameRandom::result_type sides = 6;
+    Logic::GameRandom random(TST_SEED);
+    std::vector<int> counts(sides, 0);
+    for (int i = 0; i < TST_DRAWS_PER_RESULT * static_cast<int>(sides); ++i) {
+        ++counts.at(random.below(sides));
+    }
+    for (const auto& count : counts) {
+        QVERIFY(count > TST_DRAWS_PER_RESULT * 95 / 100);
+        QVERIFY(count < TST_DRAWS_PER_RESULT * 105 / 100);
+    }
+}
+
+void GameRandomTest::testStandardAlgorithms()
+{
+    QCOMPARE(Logic::GameRandom::min(), Logic::GameRandom::result_type(0));
+    QCOMPARE(Logic::GameRandom::max(),
+             Logic::GameRandom::result_type(0xffffffffu));
+
+    // Shuffling with the same seed gives the same permutation
+    std::vector<int> first(52);
+    std::iota(first.begin(), first.end(), 0);
+    std::vector<int> second = first;
+
+    Logic::GameRandom firstRandom(TST_SEED);
+    Logic::GameRandom secondRandom(TST_SEED);
+    std::shuffle(first.begin(), first.end(), firstRandom);
+    std::shuffle(second.begin(), second.end(), secondRandom);
+    QVERIFY(first == second);
+
+    std::vector<int> sorted = first;
+    std::sort(sorted.begin(), sorted.end());
+    QVERIFY(first != sorted);
+}
+
+QTEST_APPLESS_MAIN(GameRandomTest)
+
+#include "tst_gamerandomtest.moc"
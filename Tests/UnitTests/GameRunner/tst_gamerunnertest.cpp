@@ -0,0 +1,523 @@
+#include <QString>
+#include <QFile>
+#include <QtTest>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "flatgameboard.hh"
+#include "gameaction.hh"
+#include "gamelog.hh"
+#include "gamesnapshot.hh"
+#include "initialize.hh"
+#include "igamerunner.hh"
+#include "hex.hh"
+#include "rules.hh"
+#include "shark.hh"
+#include "vortex.hh"
+
+// Seed of the tested games, fixed so that every run plays the same game.
+const unsigned TST_SEED = 20181121;
+const int TST_PLAYERS = 3;
+const int TST_PAWNS_PER_PLAYER = 3;
+
+// Spins tried before giving up on finding a piece the wheel can move.
+const int TST_MAX_SPINS = 50;
+
+// Turns played before a game is forked, and by the game and the fork after.
+const int TST_TURNS_BEFORE_FORK = 6;
+const int TST_TURNS_AFTER_FORK = 12;
+
+namespace {
+
+/**
+ * @brief Minimal game state for driving the engine without the UI.
+ */
+class TestState : public Common::IGameState
+{
+public:
+    TestState(): phase_(Common::GamePhase::MOVEMENT), player_(1) {}
+    virtual Common::GamePhase currentGamePhase() const { return phase_; }
+    virtual int currentPlayer() const { return player_; }
+    virtual void changeGamePhase(Common::GamePhase nextPhase) { phase_ = nextPhase; }
+    virtual void changePlayerTurn(int nextPlayer) { player_ = nextPlayer; }
+private:
+    Common::GamePhase phase_;
+    int player_;
+};
+
+/**
+ * @brief Minimal player for driving the engine without the UI.
+ */
+class TestPlayer : public Common::IPlayer
+{
+public:
+    explicit TestPlayer(int id): id_(id), actions_(3) {}
+    virtual int getPlayerId() const { return id_; }
+    virtual void setActionsLeft(unsigned int actionsLeft) { actions_ = actionsLeft; }
+    virtual unsigned int getActionsLeft() const { return actions_; }
+private:
+    int id_;
+    unsigned int actions_;
+};
+
+/**
+ * @brief Board that doesn't set itself as the board of the hexes it is
+ * given, as an IGameBoard doesn't have to.
+ */
+class PlainBoard : public Student::FlatGameBoard
+{
+public:
+    virtual void addHex(std::shared_ptr<Common::Hex> newHex)
+    {
+        Student::FlatGameBoard::addHex(newHex);
+        newHex->setBoard(nullptr);
+    }
+};
+
+bool samePieces(const std::vector<Common::GameSnapshot::Piece>& a,
+                const std::vector<Common::GameSnapshot::Piece>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].type != b[i].type ||
+                a[i].owner != b[i].owner || a[i].hex != b[i].hex ||
+                a[i].firstPassenger != b[i].firstPassenger ||
+                a[i].passengerCount != b[i].passengerCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameState(const Common::GameSnapshot& a, const Common::GameSnapshot& b)
+{
+    if (a.players.size() != b.players.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.players.size(); ++i) {
+        if (a.players[i].id != b.players[i].id ||
+                a.players[i].actionsLeft != b.players[i].actionsLeft) {
+            return false;
+        }
+    }
+    return *a.coordinates == *b.coordinates && a.terrain == b.terrain &&
+            samePieces(a.pawns, b.pawns) && samePieces(a.actors, b.actors) &&
+            samePieces(a.transports, b.transports) &&
+            a.passengers == b.passengers && a.phase == b.phase &&
+            a.currentPlayer == b.currentPlayer &&
+            a.islandPieces == b.islandPieces && a.spun == b.spun &&
+            a.spinType == b.spinType && a.spinMoves == b.spinMoves &&
+            a.rng.seed() == b.rng.seed() && a.rng.state() == b.rng.state() &&
+            a.lastActorId == b.lastActorId &&
+            a.lastTransportId == b.lastTransportId;
+}
+
+}
+
+class GameRunnerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    GameRunnerTest() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    // makeAction and unmakeAction
+    void testMakeUnmakePawnMoves();
+    void testMakeUnmakeTransportMoves();
+    void testMakeUnmakeFlips();
+    void testMakeUnmakeLastFlipOfLayer();
+    void testMakeUnmakeSpinnerMoves();
+    void testMakeUnmakeNested();
+
+    // Actor actions on the board of the engine
+    void testVortexClearsNeighbours();
+    void testReachableAfterSharkEmptiesHex();
+
+    // The hexes the engine created
+    void testHexesShareOwnership();
+
+    // A fork plays the same game as the game it was forked from
+    void testForkPlaysLikeOriginal();
+
+private:
+    // Makes and takes back every legal action of the current phase, the
+    // snapshot after each unmake has to equal the one before the make.
+    // Returns the number of actions of the type made.
+    std::size_t makeUnmakeAll(Common::GameAction::Type type);
+
+    // Flips tiles until the wheel lands on a piece that can move, returns
+    // false if it never did.
+    bool spinUntilMovable();
+
+    // Plays turns of one action in each phase, the actions are picked with
+    // choices.
+    void playTurns(Common::IGameRunner& runner, TestState& state, int turns,
+                   std::mt19937& choices) const;
+
+    std::shared_ptr<Student::FlatGameBoard> board_;
+    std::shared_ptr<TestState> state_;
+    std::vector<std::shared_ptr<Common::IPlayer>> players_;
+    std::shared_ptr<Common::IGameRunner> runner_;
+};
+
+void GameRunnerTest::initTestCase()
+{
+    if (!QFile::exists("Assets/pieces.json") ||
+            !QFile::exists("Assets/layout.json")) {
+        QSKIP("Assets/pieces.json or Assets/layout.json missing, "
+              "see GameLogic/README.md");
+    }
+}
+
+void GameRunnerTest::init()
+{
+    board_ = std::make_shared<Student::FlatGameBoard>();
+    state_ = std::make_shared<TestState>();
+    players_.clear();
+    for (int id = 1; id <= TST_PLAYERS; ++id) {
+        players_.push_back(std::make_shared<TestPlayer>(id));
+    }
+    runner_ = Common::Initialization::getGameRunner(board_, state_, players_,
+                                                    TST_SEED);
+
+    // Pawns of every player on the land hexes around the center
+    int pawnId = 0;
+    for (const auto& hex : board_->returnHexes()) {
+        if (pawnId == TST_PLAYERS * TST_PAWNS_PER_PLAYER) {
+            break;
+        }
+        if (!board_->isWaterTile(hex.first)) {
+            board_->addPawn(pawnId % TST_PLAYERS + 1, pawnId, hex.first);
+            ++pawnId;
+        }
+    }
+}
+
+std::size_t GameRunnerTest::makeUnmakeAll(Common::GameAction::Type type)
+{
+    std::vector<Common::GameAction> actions;
+    runner_->legalActions(actions);
+    std::shared_ptr<const Common::GameSnapshot> before = runner_->snapshot();
+
+    std::size_t made = 0;
+    for (const auto& action : actions) {
+        if (action.type != type) {
+            continue;
+        }
+        runner_->makeAction(action);
+        runner_->unmakeAction();
+        if (!sameState(*before, *runner_->snapshot())) {
+            qWarning("Action %d to %d,%d,%d was not taken back", action.type,
+                     action.target.x, action.target.y, action.target.z);
+            return 0;
+        }
+        ++made;
+    }
+
+    std::vector<Common::GameAction> after;
+    runner_->legalActions(after);
+    return after.size() == actions.size() ? made : 0;
+}
+
+bool GameRunnerTest::spinUntilMovable()
+{
+    std::vector<Common::GameAction> actions;
+    for (int spin = 0; spin < TST_MAX_SPINS; ++spin) {
+        // Every flip reveals another actor or transport for the wheel
+        state_->changeGamePhase(Common::GamePhase::SINKING);
+        actions.clear();
+        runner_->legalActions(actions);
+        if (!actions.empty()) {
+            runner_->flipTile(actions.front().target);
+        }
+
+        runner_->spinWheel();
+        actions.clear();
+        if (runner_->legalActions(actions) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameRunnerTest::testMakeUnmakePawnMoves()
+{
+    QVERIFY(makeUnmakeAll(Common::GameAction::MOVE_PAWN) > 0);
+}
+
+void GameRunnerTest::testMakeUnmakeTransportMoves()
+{
+    // Moving a pawn onto a transport lets the player move it
+    std::vector<Common::GameAction> actions;
+    runner_->legalActions(actions);
+    for (const auto& action : actions) {
+        if (action.type == Common::GameAction::MOVE_TRANSPORT) {
+            break;
+        }
+        if (action.type == Common::GameAction::MOVE_PAWN &&
+                !board_->getHex(action.target)->getTransports().empty()) {
+            runner_->movePawn(action.origin, action.target, action.id);
+            break;
+        }
+    }
+    QVERIFY(makeUnmakeAll(Common::GameAction::MOVE_TRANSPORT) > 0);
+}
+
+void GameRunnerTest::testMakeUnmakeFlips()
+{
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+    QVERIFY(makeUnmakeAll(Common::GameAction::FLIP_TILE) > 0);
+}
+
+void GameRunnerTest::testMakeUnmakeLastFlipOfLayer()
+{
+    // Flip the top layer down to its last tile, the flip of that removes
+    // the layer
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+    std::vector<Common::GameAction> actions;
+    runner_->legalActions(actions);
+    QVERIFY(!actions.empty());
+    for (std::size_t i = 1; i < actions.size(); ++i) {
+        runner_->flipTile(actions[i].target);
+    }
+    std::size_t layers = runner_->snapshot()->islandPieces.size();
+    QCOMPARE(runner_->snapshot()->islandPieces.back().second, 1);
+
+    runner_->makeAction(actions.front());
+    QCOMPARE(runner_->snapshot()->islandPieces.size(), layers - 1);
+    runner_->unmakeAction();
+    QCOMPARE(runner_->snapshot()->islandPieces.size(), layers);
+
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+    QCOMPARE(makeUnmakeAll(Common::GameAction::FLIP_TILE), std::size_t(1));
+}
+
+void GameRunnerTest::testMakeUnmakeSpinnerMoves()
+{
+    QVERIFY(spinUntilMovable());
+    std::size_t made =
+            makeUnmakeAll(Common::GameAction::MOVE_ACTOR) +
+            makeUnmakeAll(Common::GameAction::MOVE_TRANSPORT_WITH_SPINNER);
+    QVERIFY(made > 0);
+}
+
+void GameRunnerTest::testMakeUnmakeNested()
+{
+    std::shared_ptr<const Common::GameSnapshot> start = runner_->snapshot();
+
+    // A pawn move, a flip and a spinner move on top of each other
+    std::vector<Common::GameAction> actions;
+    runner_->legalActions(actions);
+    QVERIFY(!actions.empty());
+    runner_->makeAction(actions.front());
+
+    state_->changeGamePhase(Common::GamePhase::SINKING);
+    actions.clear();
+    runner_->legalActions(actions);
+    QVERIFY(!actions.empty());
+    runner_->makeAction(actions.front());
+
+    // The spin between the makes is taken back with the flip
+    runner_->spinWheel();
+    actions.clear();
+    int made = 2;
+    if (runner_->legalActions(actions) != 0) {
+        runner_->makeAction(actions.front());
+        ++made;
+    }
+    for (; made > 0; --made) {
+        runner_->unmakeAction();
+    }
+    QVERIFY(sameState(*start, *runner_->snapshot()));
+}
+
+void GameRunnerTest::testVortexClearsNeighbours()
+{
+    std::shared_ptr<PlainBoard> board = std::make_shared<PlainBoard>();
+    std::shared_ptr<Common::IGameRunner> runner =
+            Common::Initialization::getGameRunner(
+                board, std::make_shared<TestState>(), players_, TST_SEED);
+    Common::CubeCoordinate center(0, 0, 0);
+    QVERIFY(board->getHex(center)->getBoard() ==
+            static_cast<Common::IGameBoard*>(board.get()));
+
+    // A pawn on every neighbour and a shark next to the vortex
+    std::vector<Common::CubeCoordinate> neighbours =
+            board->getHex(center)->getNeighbourVector();
+    for (std::size_t i = 0; i < neighbours.size(); ++i) {
+        QVERIFY(board->getHex(neighbours[i]) != nullptr);
+        board->addPawn(1, static_cast<int>(i), neighbours[i]);
+    }
+    board->addActor(std::make_shared<Common::Shark>(1001), neighbours.front());
+    std::shared_ptr<Common::Vortex> vortex =
+            std::make_shared<Common::Vortex>(1002);
+    board->addActor(vortex, center);
+    // Vortex::move does nothing, the vortex is put on its hex directly
+    vortex->addHex(board->getHex(center));
+
+    vortex->doAction();
+    for (const auto& coord : neighbours) {
+        QCOMPARE(board->getHex(coord)->getPawnAmount(), 0);
+        QVERIFY(board->getHex(coord)->getActors().empty());
+    }
+    QVERIFY(board->getHex(center)->getActors().empty());
+}
+
+void GameRunnerTest::testReachableAfterSharkEmptiesHex()
+{
+    // Three empty land hexes in a row, the only route of two steps to the
+    // last one goes through the middle one
+    Common::CubeCoordinate origin;
+    Common::CubeCoordinate middle;
+    Common::CubeCoordinate target;
+    bool found = false;
+    for (const auto& hex : board_->returnHexes()) {
+        for (const auto& offset : Common::NEIGHBOUR_OFFSETS) {
+            origin = hex.first;
+            middle = Common::CubeCoordinate(origin.x + offset.x,
+                                            origin.y + offset.y,
+                                            origin.z + offset.z);
+            target = Common::CubeCoordinate(middle.x + offset.x,
+                                            middle.y + offset.y,
+                                            middle.z + offset.z);
+            found = true;
+            for (const auto& coord : {origin, middle, target}) {
+                found = found && board_->getHex(coord) != nullptr &&
+                        !board_->isWaterTile(coord) &&
+                        board_->checkTileOccupation(coord) == 0;
+            }
+            if (found) {
+                break;
+            }
+        }
+        if (found) {
+            break;
+        }
+    }
+    QVERIFY(found);
+
+    // Pawns of another player fill the middle hex
+    board_->addPawn(state_->currentPlayer(), 100, origin);
+    for (int pawn = 0; pawn < Logic::MAX_PAWNS_PER_HEX; ++pawn) {
+        board_->addPawn(2, 101 + pawn, middle);
+    }
+    runner_->getCurrentPlayer()->setActionsLeft(2);
+    QVERIFY(runner_->reachablePawnTargets(origin, 100).count(target) == 0);
+
+    // The shark clears the pawns of its hex without the game runner knowing
+    std::shared_ptr<Common::Shark> shark =
+            std::make_shared<Common::Shark>(1001);
+    board_->addActor(shark, middle);
+    shark->doAction();
+    QCOMPARE(board_->checkTileOccupation(middle), 0);
+
+    Common::MoveTargets targets = runner_->reachablePawnTargets(origin, 100);
+    QVERIFY(targets.count(middle) == 1);
+    QVERIFY(targets.count(target) == 1);
+    QVERIFY(runner_->reachablePawnTargets(origin, 100) == targets);
+
+    // Filling the target through the board is seen as well
+    for (int pawn = 0; pawn < Logic::MAX_PAWNS_PER_HEX; ++pawn) {
+        board_->addPawn(2, 111 + pawn, target);
+    }
+    targets = runner_->reachablePawnTargets(origin, 100);
+    QVERIFY(targets.count(middle) == 1);
+    QVERIFY(targets.count(target) == 0);
+
+    runner_->getCurrentPlayer()->setActionsLeft(1);
+    QCOMPARE(runner_->reachablePawnTargets(origin, 100).at(middle), 0);
+}
+
+void GameRunnerTest::testHexesShareOwnership()
+{
+    // Every hex owns itself, shared_from_this gives the board's pointer
+    auto hexes = board_->returnHexes();
+    QVERIFY(!hexes.empty());
+    for (const auto& hex : hexes) {
+        QVERIFY(hex.second->shared_from_this() == hex.second);
+    }
+}
+
+void GameRunnerTest::playTurns(Common::IGameRunner& runner, TestState& state,
+                               int turns, std::mt19937& choices) const
+{
+    std::vector<Common::GameAction> actions;
+    for (int turn = 0; turn < turns; ++turn) {
+        for (Common::GamePhase phase : {Common::GamePhase::MOVEMENT,
+                                        Common::GamePhase::SINKING,
+                                        Common::GamePhase::SPINNING}) {
+            state.changeGamePhase(phase);
+            if (phase == Common::GamePhase::SPINNING) {
+                runner.spinWheel();
+            }
+            actions.clear();
+            if (runner.legalActions(actions) > 0) {
+                runner.makeAction(actions[choices() % actions.size()]);
+            }
+        }
+        state.changePlayerTurn(state.currentPlayer() % TST_PLAYERS + 1);
+        runner.getCurrentPlayer()->setActionsLeft(3);
+    }
+    state.changeGamePhase(Common::GamePhase::MOVEMENT);
+}
+
+void GameRunnerTest::testForkPlaysLikeOriginal()
+{
+    std::mt19937 choices(TST_SEED);
+    playTurns(*runner_, *state_, TST_TURNS_BEFORE_FORK, choices);
+
+    auto forkBoard = std::make_shared<Student::FlatGameBoard>();
+    auto forkState = std::make_shared<TestState>();
+    std::vector<std::shared_ptr<Common::IPlayer>> forkPlayers;
+    for (int id = 1; id <= TST_PLAYERS; ++id) {
+        forkPlayers.push_back(std::make_shared<TestPlayer>(id));
+    }
+    std::shared_ptr<Common::IGameRunner> fork =
+            Common::Initialization::forkGameRunner(
+                forkBoard, forkState, forkPlayers, runner_->snapshot());
+    QVERIFY(sameState(*runner_->snapshot(), *fork->snapshot()));
+    QCOMPARE(forkState->currentPlayer(), state_->currentPlayer());
+
+    // From here on both are recorded and pick the same actions
+    auto log = std::make_shared<Common::GameLog>();
+    auto forkLog = std::make_shared<Common::GameLog>();
+    runner_->setGameLog(log);
+    fork->setGameLog(forkLog);
+    std::mt19937 forkChoices = choices;
+    for (int turn = 0; turn < TST_TURNS_AFTER_FORK; ++turn) {
+        playTurns(*runner_, *state_, 1, choices);
+        playTurns(*fork, *forkState, 1, forkChoices);
+        QVERIFY(sameState(*runner_->snapshot(), *fork->snapshot()));
+    }
+
+    // Every turn spins the wheel at least
+    int spins = 0;
+    Common::GameLog::Reader reader(*log);
+    Common::GameLog::Record record;
+    while (reader.next(record)) {
+        if (record.type == Common::GameLog::RecordType::WHEEL_SPUN) {
+            ++spins;
+        }
+    }
+    QCOMPARE(spins, TST_TURNS_AFTER_FORK);
+    QCOMPARE(forkLog->size(), log->size());
+    QVERIFY(std::equal(log->data(), log->data() + log->size(),
+                       forkLog->data()));
+
+    // The fork is a game of its own, the original doesn't see its moves
+    std::shared_ptr<const Common::GameSnapshot> before = runner_->snapshot();
+    playTurns(*fork, *forkState, 1, forkChoices);
+    QVERIFY(sameState(*before, *runner_->snapshot()));
+}
+
+QTEST_APPLESS_MAIN(GameRunnerTest)
+
+#include "tst_gamerunnertest.moc"
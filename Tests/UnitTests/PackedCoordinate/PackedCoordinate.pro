@@ -0,0 +1,27 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_packedcoordinatetest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_packedcoordinatetest.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/boardindex.hh \
+    ../../../GameLogic/Engine/cubecoordinate.hh \
+    ../../../GameLogic/Engine/packedcoordinate.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
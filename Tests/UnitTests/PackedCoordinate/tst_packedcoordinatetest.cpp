@@ -0,0 +1,185 @@
+#include <QString>
+#include <QtTest>
+#include <climits>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "boardindex.hh"
+#include "packedcoordinate.hh"
+
+// Every coordinate of a board of this radius is packed and hashed.
+const int TST_RADIUS = 30;
+
+namespace {
+
+// Components that sit on the edges of the 32 bit halves.
+const std::vector<int> TST_EXTREMES = {
+    0, 1, -1, 2, -2, 255, -256, 65535, -65536, INT_MAX / 2, INT_MIN / 2,
+    INT_MAX / 2 + 1, INT_MIN / 2 + 1
+};
+
+}
+
+class PackedCoordinateTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PackedCoordinateTest() = default;
+
+private Q_SLOTS:
+    void testDefaultIsOrigin();
+    void testPackUnpack();
+    void testDerivedY();
+    void testSameAsCubeCoordinate();
+    void testBitsLayout();
+    void testUnorderedContainers();
+    void testNeighbourHashesDiffer();
+};
+
+void PackedCoordinateTest::testDefaultIsOrigin()
+{
+    Common::PackedCoordinate origin;
+    QCOMPARE(origin.x(), 0);
+    QCOMPARE(origin.y(), 0);
+    QCOMPARE(origin.z(), 0);
+    QVERIFY(origin == Common::PackedCoordinate(0, 0));
+    QVERIFY(origin.toCube() == Common::CubeCoordinate(0, 0, 0));
+}
+
+void PackedCoordinateTest::testPackUnpack()
+{
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            Common::PackedCoordinate packed(x, z);
+            QCOMPARE(packed.x(), x);
+            QCOMPARE(packed.z(), z);
+        }
+    }
+
+    // The halves hold any int, even where y would overflow
+    for (int x : {INT_MIN, INT_MAX}) {
+        for (int z : {INT_MIN, INT_MAX, 0, -1}) {
+            Common::PackedCoordinate packed(x, z);
+            QCOMPARE(packed.x(), x);
+            QCOMPARE(packed.z(), z);
+        }
+    }
+}
+
+void PackedCoordinateTest::testDerivedY()
+{
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            Common::PackedCoordinate packed(x, z);
+            QCOMPARE(packed.y(), -x - z);
+            QCOMPARE(packed.x() + packed.y() + packed.z(), 0);
+        }
+    }
+}
+
+void PackedCoordinateTest::testSameAsCubeCoordinate()
+{
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            Common::CubeCoordinate cube(x, -x - z, z);
+            Common::PackedCoordinate packed(cube);
+            QVERIFY(packed.toCube() == cube);
+            QVERIFY(packed == Common::PackedCoordinate(x, z));
+            QVERIFY(Common::PackedCoordinate(packed.toCube()) == packed);
+        }
+    }
+
+    // Packed coordinates are equal exactly when the cube coordinates are
+    Common::CubeCoordinate a(3, -5, 2);
+    Common::CubeCoordinate b(2, -5, 3);
+    QVERIFY(!(Common::PackedCoordinate(a) == Common::PackedCoordinate(b)));
+    QVERIFY(Common::PackedCoordinate(a) != Common::PackedCoordinate(b));
+    QVERIFY(!(Common::PackedCoordinate(a) != Common::PackedCoordinate(a)));
+}
+
+void PackedCoordinateTest::testBitsLayout()
+{
+    QCOMPARE(Common::PackedCoordinate(1, 2).bits(),
+             (std::uint64_t(1) << 32) | 2u);
+    QCOMPARE(Common::PackedCoordinate(-1, 0).bits(),
+             std::uint64_t(0xffffffff00000000ULL));
+    QCOMPARE(Common::PackedCoordinate(0, -1).bits(),
+             std::uint64_t(0x00000000ffffffffULL));
+
+    // operator< is the order of the words, a strict weak order
+    std::set<Common::PackedCoordinate> ordered;
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            ordered.insert(Common::PackedCoordinate(x, z));
+        }
+    }
+    QCOMPARE(ordered.size(), TST_EXTREMES.size() * TST_EXTREMES.size());
+}
+
+void PackedCoordinateTest::testUnorderedContainers()
+{
+    // Every hex of a board finds its own value
+    std::unordered_map<Common::PackedCoordinate, int> slotsByHex;
+    const Common::BoardIndex index(TST_RADIUS);
+    int hexes = 0;
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (index.contains(coord)) {
+            slotsByHex[Common::PackedCoordinate(coord)] = slot;
+            ++hexes;
+        }
+    }
+    QCOMPARE(slotsByHex.size(), std::size_t(hexes));
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        auto found = slotsByHex.find(Common::PackedCoordinate(coord));
+        if (index.contains(coord)) {
+            QVERIFY(found != slotsByHex.end());
+            QCOMPARE(found->second, slot);
+        } else {
+            QVERIFY(found == slotsByHex.end());
+        }
+    }
+
+    // The extremes are distinct keys as well
+    std::unordered_set<Common::PackedCoordinate> extremes;
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            QVERIFY(extremes.insert(Common::PackedCoordinate(x, z)).second);
+        }
+    }
+    for (int x : TST_EXTREMES) {
+        for (int z : TST_EXTREMES) {
+            QCOMPARE(extremes.count(Common::PackedCoordinate(x, z)),
+                     std::size_t(1));
+        }
+    }
+}
+
+void PackedCoordinateTest::testNeighbourHashesDiffer()
+{
+    // The hash mixes the word, neighbours don't collide in the low bits a
+    // hash table uses
+    const Common::BoardIndex index(TST_RADIUS);
+    std::unordered_set<std::uint64_t> lowBits;
+    int hexes = 0;
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (index.contains(coord)) {
+            Common::PackedCoordinate packed(coord);
+            QCOMPARE(std::hash<Common::PackedCoordinate>()(packed),
+                     static_cast<std::size_t>(packed.hash()));
+            lowBits.insert(packed.hash() & 0xffffu);
+            ++hexes;
+        }
+    }
+    // A few collisions in 16 bits are expected, not many
+    QVERIFY(lowBits.size() > std::size_t(hexes) * 9 / 10);
+}
+
+QTEST_APPLESS_MAIN(PackedCoordinateTest)
+
+#include "tst_packedcoordinatetest.moc"
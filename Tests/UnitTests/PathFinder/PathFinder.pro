@@ -0,0 +1,58 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_pathfindertest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_pathfindertest.cpp \
+    ../../../GameLogic/Engine/pathfinder.cpp \
+    ../../../GameLogic/Engine/hex.cpp \
+    ../../../GameLogic/Engine/cubekernels.cpp \
+    ../../../GameLogic/Engine/hexbitboard.cpp \
+    ../../../GameLogic/Engine/boardtopology.cpp \
+    ../../../GameLogic/Engine/undolog.cpp \
+    ../../../GameLogic/Engine/gamelog.cpp \
+    ../../../GameLogic/Engine/typeregistry.cpp \
+    ../../../GameLogic/Engine/gamearena.cpp \
+    ../../../GameLogic/Engine/pawn.cpp \
+    ../../../GameLogic/Engine/actor.cpp \
+    ../../../GameLogic/Engine/transport.cpp \
+    ../../../GameLogic/Engine/gameexception.cpp \
+    ../../../GameLogic/Engine/formatexception.cpp \
+    ../../../GameLogic/Engine/ioexception.cpp \
+    ../../../UI/gameboardbase.cpp \
+    ../../../UI/gameboard.cpp \
+    ../../../UI/flatgameboard.cpp \
+    ../../../UI/columngameboard.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/boardindex.hh \
+    ../../../GameLogic/Engine/boardtopology.hh \
+    ../../../GameLogic/Engine/hexbitboard.hh \
+    ../../../GameLogic/Engine/iundotarget.hh \
+    ../../../GameLogic/Engine/undolog.hh \
+    ../../../GameLogic/Engine/gamelog.hh \
+    ../../../GameLogic/Engine/varint.hh \
+    ../../../GameLogic/Engine/pathfinder.hh \
+    ../../../GameLogic/Engine/rules.hh \
+    ../../../UI/gameboardbase.hh \
+    ../../../UI/gameboard.hh \
+    ../../../UI/flatgameboard.hh \
+    ../../../UI/columngameboard.hh
+
+INCLUDEPATH += ../../../UI \
+                ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../UI \
+                ../../../GameLogic/Engine/
@@ -0,0 +1,333 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "columngameboard.hh"
+#include "flatgameboard.hh"
+#include "hex.hh"
+#include "pathfinder.hh"
+#include "rules.hh"
+
+// Radius of the test islands.
+const int TST_RADIUS = 4;
+
+// Seed and share of water of the random islands.
+const unsigned TST_SEED = 20181121;
+const double TST_WATER_SHARE = 0.3;
+
+// Hexes of a straight line from the center, the first one is the center.
+const std::vector<Common::CubeCoordinate> TST_LINE = {
+    Common::CubeCoordinate(0, 0, 0),
+    Common::CubeCoordinate(1, -1, 0),
+    Common::CubeCoordinate(2, -2, 0),
+    Common::CubeCoordinate(3, -3, 0)
+};
+
+/**
+ * @brief The same tests are run against a board that is searched hex by hex
+ * (FlatGameBoard) and one that is flooded through its bitboards
+ * (ColumnGameBoard).
+ */
+class PathFinderTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PathFinderTest() = default;
+
+private Q_SLOTS:
+    void testStepLimit();
+    void testWaterBlocks();
+    void testFullHexBlocks();
+    void testOriginMustBeLand();
+    void testMissingTarget();
+    void testReachableFromMatchesIsReachable();
+    void testBoardsAgree();
+
+private:
+    template <class Board>
+    std::shared_ptr<Board> createLine() const;
+
+    template <class Board>
+    std::shared_ptr<Board> createIsland() const;
+
+    template <class Board>
+    void checkStepLimit();
+
+    template <class Board>
+    void checkWaterBlocks();
+
+    template <class Board>
+    void checkFullHexBlocks();
+
+    template <class Board>
+    void checkOriginMustBeLand();
+
+    template <class Board>
+    void checkMissingTarget();
+
+    template <class Board>
+    void checkReachableFromMatchesIsReachable();
+
+    // Fills a hex with pawns of player 1
+    void fill(Common::IGameBoard& board, Common::CubeCoordinate coord,
+              int firstPawnId) const;
+
+    // Every target of every land hex, sorted per origin
+    std::vector<std::vector<Common::CubeCoordinate>> everyTarget(
+            const Common::IGameBoard& board, unsigned int maxSteps) const;
+};
+
+template <class Board>
+std::shared_ptr<Board> PathFinderTest::createLine() const
+{
+    auto board = std::make_shared<Board>(TST_RADIUS);
+    for (const auto& coord : TST_LINE) {
+        auto hex = std::make_shared<Common::Hex>();
+        hex->setCoordinates(coord);
+        hex->setPieceType("Forest");
+        board->addHex(hex);
+    }
+    return board;
+}
+
+template <class Board>
+std::shared_ptr<Board> PathFinderTest::createIsland() const
+{
+    auto board = std::make_shared<Board>(TST_RADIUS);
+    std::mt19937 rng(TST_SEED);
+    std::bernoulli_distribution water(TST_WATER_SHARE);
+
+    const Common::BoardIndex& index = board->getIndex();
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (!index.contains(coord)) {
+            continue;
+        }
+        auto hex = std::make_shared<Common::Hex>();
+        hex->setCoordinates(coord);
+        hex->setPieceType(water(rng) ? "Water" : "Forest");
+        board->addHex(hex);
+    }
+
+    // Some land hexes full of pawns
+    int pawnId = 0;
+    std::bernoulli_distribution full(0.2);
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate coord = index.coordinateOf(slot);
+        if (index.contains(coord) && !board->isWaterTile(coord) &&
+                full(rng)) {
+            fill(*board, coord, pawnId);
+            pawnId += Logic::MAX_PAWNS_PER_HEX;
+        }
+    }
+    return board;
+}
+
+void PathFinderTest::fill(Common::IGameBoard& board,
+                          Common::CubeCoordinate coord,
+                          int firstPawnId) const
+{
+    for (int i = 0; i < Logic::MAX_PAWNS_PER_HEX; ++i) {
+        board.addPawn(1, firstPawnId + i, coord);
+    }
+}
+
+std::vector<std::vector<Common::CubeCoordinate>> PathFinderTest::everyTarget(
+        const Common::IGameBoard& board, unsigned int maxSteps) const
+{
+    Logic::PathFinder pathFinder(TST_RADIUS);
+    std::vector<std::vector<Common::CubeCoordinate>> targets;
+
+    const Common::BoardIndex index(TST_RADIUS);
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        Common::CubeCoordinate from = index.coordinateOf(slot);
+        if (!index.contains(from) || board.isWaterTile(from)) {
+            continue;
+        }
+        std::vector<Common::CubeCoordinate> reached;
+        pathFinder.reachableFrom(board, from, maxSteps, reached);
+        std::sort(reached.begin(), reached.end(),
+                  [](Common::CubeCoordinate a, Common::CubeCoordinate b) {
+            return a.x != b.x ? a.x < b.x : a.y < b.y;
+        });
+        targets.push_back(reached);
+    }
+    return targets;
+}
+
+template <class Board>
+void PathFinderTest::checkStepLimit()
+{
+    std::shared_ptr<Board> board = createLine<Board>();
+    Logic::PathFinder pathFinder;
+
+    QVERIFY(pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(1), 1));
+    QVERIFY(pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(3), 3));
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(3), 2));
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(1), 0));
+
+    std::vector<Common::CubeCoordinate> reached;
+    pathFinder.reachableFrom(*board, TST_LINE.at(0), 2, reached);
+    QCOMPARE(reached.size(), std::size_t(2));
+    QVERIFY(reached.at(0) == TST_LINE.at(1));
+    QVERIFY(reached.at(1) == TST_LINE.at(2));
+
+    reached.clear();
+    pathFinder.reachableFrom(*board, TST_LINE.at(0), 0, reached);
+    QVERIFY(reached.empty());
+}
+
+template <class Board>
+void PathFinderTest::checkWaterBlocks()
+{
+    std::shared_ptr<Board> board = createLine<Board>();
+    board->getHex(TST_LINE.at(1))->setPieceType("Water");
+    Logic::PathFinder pathFinder;
+
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(2), 3));
+
+    // The water hex itself is a target, a pawn may walk into the sea
+    QVERIFY(pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(1), 1));
+
+    std::vector<Common::CubeCoordinate> reached;
+    pathFinder.reachableFrom(*board, TST_LINE.at(2), 3, reached);
+    QCOMPARE(reached.size(), std::size_t(2));
+    QVERIFY(std::find(reached.begin(), reached.end(), TST_LINE.at(1)) !=
+            reached.end());
+    QVERIFY(std::find(reached.begin(), reached.end(), TST_LINE.at(3)) !=
+            reached.end());
+}
+
+template <class Board>
+void PathFinderTest::checkFullHexBlocks()
+{
+    std::shared_ptr<Board> board = createLine<Board>();
+    fill(*board, TST_LINE.at(1), 0);
+    Logic::PathFinder pathFinder;
+
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(2), 3));
+
+    // A pawn may leave a full hex
+    fill(*board, TST_LINE.at(2), Logic::MAX_PAWNS_PER_HEX);
+    QVERIFY(pathFinder.isReachable(*board, TST_LINE.at(2), TST_LINE.at(3), 1));
+}
+
+template <class Board>
+void PathFinderTest::checkOriginMustBeLand()
+{
+    std::shared_ptr<Board> board = createLine<Board>();
+    board->getHex(TST_LINE.at(0))->setPieceType("Water");
+    Logic::PathFinder pathFinder;
+
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0), TST_LINE.at(1), 3));
+
+    std::vector<Common::CubeCoordinate> reached;
+    pathFinder.reachableFrom(*board, TST_LINE.at(0), 3, reached);
+    QVERIFY(reached.empty());
+
+    // Neither can a pawn start outside the board
+    Common::CubeCoordinate outside(-1, 1, 0);
+    QVERIFY(!pathFinder.isReachable(*board, outside, TST_LINE.at(0), 3));
+}
+
+template <class Board>
+void PathFinderTest::checkMissingTarget()
+{
+    std::shared_ptr<Board> board = createLine<Board>();
+    Logic::PathFinder pathFinder;
+
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0),
+                                    Common::CubeCoordinate(-1, 1, 0), 3));
+    QVERIFY(!pathFinder.isReachable(*board, TST_LINE.at(0),
+                                    Common::CubeCoordinate(40, -40, 0), 3));
+}
+
+template <class Board>
+void PathFinderTest::checkReachableFromMatchesIsReachable()
+{
+    std::shared_ptr<Board> board = createIsland<Board>();
+    Logic::PathFinder pathFinder;
+    const Common::BoardIndex& index = board->getIndex();
+
+    for (unsigned int maxSteps = 1; maxSteps <= 3; ++maxSteps) {
+        for (int fromSlot = 0; fromSlot < index.slotCount(); ++fromSlot) {
+            Common::CubeCoordinate from = index.coordinateOf(fromSlot);
+            if (!index.contains(from) || board->isWaterTile(from)) {
+                continue;
+            }
+            std::vector<Common::CubeCoordinate> reached;
+            pathFinder.reachableFrom(*board, from, maxSteps, reached);
+
+            for (int toSlot = 0; toSlot < index.slotCount(); ++toSlot) {
+                Common::CubeCoordinate to = index.coordinateOf(toSlot);
+                if (!index.contains(to) || to == from) {
+                    continue;
+                }
+                bool isReached = std::find(reached.begin(), reached.end(),
+                                           to) != reached.end();
+                QCOMPARE(isReached,
+                         pathFinder.isReachable(*board, from, to, maxSteps));
+            }
+        }
+    }
+}
+
+void PathFinderTest::testStepLimit()
+{
+    checkStepLimit<Student::FlatGameBoard>();
+    checkStepLimit<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testWaterBlocks()
+{
+    checkWaterBlocks<Student::FlatGameBoard>();
+    checkWaterBlocks<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testFullHexBlocks()
+{
+    checkFullHexBlocks<Student::FlatGameBoard>();
+    checkFullHexBlocks<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testOriginMustBeLand()
+{
+    checkOriginMustBeLand<Student::FlatGameBoard>();
+    checkOriginMustBeLand<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testMissingTarget()
+{
+    checkMissingTarget<Student::FlatGameBoard>();
+    checkMissingTarget<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testReachableFromMatchesIsReachable()
+{
+    checkReachableFromMatchesIsReachable<Student::FlatGameBoard>();
+    checkReachableFromMatchesIsReachable<Student::ColumnGameBoard>();
+}
+
+void PathFinderTest::testBoardsAgree()
+{
+    // The search and the flood find the same targets
+    std::shared_ptr<Student::FlatGameBoard> flat =
+            createIsland<Student::FlatGameBoard>();
+    std::shared_ptr<Student::ColumnGameBoard> column =
+            createIsland<Student::ColumnGameBoard>();
+    QVERIFY(flat->getBitboards() == nullptr);
+    QVERIFY(column->getBitboards() != nullptr);
+
+    for (unsigned int maxSteps = 1; maxSteps <= 3; ++maxSteps) {
+        QVERIFY(everyTarget(*flat, maxSteps) ==
+                everyTarget(*column, maxSteps));
+    }
+}
+
+QTEST_APPLESS_MAIN(PathFinderTest)
+
+#include "tst_pathfindertest.moc"
@@ -0,0 +1,39 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_replaytest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_replaytest.cpp \
+    ../../../GameLogic/Engine/replay.cpp \
+    ../../../GameLogic/Engine/gamerandom.cpp \
+    ../../../GameLogic/Engine/typeregistry.cpp \
+    ../../../GameLogic/Engine/ioexception.cpp \
+    ../../../GameLogic/Engine/formatexception.cpp \
+    ../../../GameLogic/Engine/gameexception.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/replay.hh \
+    ../../../GameLogic/Engine/gamesnapshot.hh \
+    ../../../GameLogic/Engine/gamerandom.hh \
+    ../../../GameLogic/Engine/varint.hh \
+    ../../../GameLogic/Engine/typeregistry.hh \
+    ../../../GameLogic/Engine/cubecoordinate.hh \
+    ../../../GameLogic/Engine/ioexception.hh \
+    ../../../GameLogic/Engine/formatexception.hh \
+    ../../../GameLogic/Engine/gameexception.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
@@ -0,0 +1,387 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "formatexception.hh"
+#include "gamesnapshot.hh"
+#include "ioexception.hh"
+#include "replay.hh"
+#include "typeregistry.hh"
+
+// Turns written to the replays and the turns between their keyframes.
+const int TST_TURNS = 21;
+const int TST_KEYFRAME_INTERVAL = 4;
+
+const unsigned int TST_SEED = 20181121;
+const int TST_PLAYERS = 3;
+
+const char TST_REPLAY_FILE[] = "tst_replaytest.replay";
+const char TST_DAMAGED_FILE[] = "tst_replaytest_damaged.replay";
+
+// Offset of the frame kind of the first turn: REPLAY_MAGIC, REPLAY_VERSION
+// and a keyframe interval of one byte come before it.
+const std::size_t TST_FIRST_TURN = sizeof(Common::ReplayWriter::REPLAY_MAGIC)
+        + 2;
+
+// Frame kind of a turn written as the changes to the turn before.
+const std::uint8_t TST_CHANGES_FRAME = 2;
+
+namespace {
+
+bool samePieces(const std::vector<Common::GameSnapshot::Piece>& a,
+                const std::vector<Common::GameSnapshot::Piece>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].type != b[i].type ||
+                a[i].owner != b[i].owner || a[i].hex != b[i].hex ||
+                a[i].firstPassenger != b[i].firstPassenger ||
+                a[i].passengerCount != b[i].passengerCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameState(const Common::GameSnapshot& a, const Common::GameSnapshot& b)
+{
+    if (a.players.size() != b.players.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.players.size(); ++i) {
+        if (a.players[i].id != b.players[i].id ||
+                a.players[i].actionsLeft != b.players[i].actionsLeft) {
+            return false;
+        }
+    }
+    return *a.coordinates == *b.coordinates && a.terrain == b.terrain &&
+            samePieces(a.pawns, b.pawns) && samePieces(a.actors, b.actors) &&
+            samePieces(a.transports, b.transports) &&
+            a.passengers == b.passengers && a.phase == b.phase &&
+            a.currentPlayer == b.currentPlayer &&
+            a.islandPieces == b.islandPieces && a.spun == b.spun &&
+            a.spinType == b.spinType && a.spinMoves == b.spinMoves &&
+            a.rng.seed() == b.rng.seed() && a.rng.state() == b.rng.state() &&
+            a.lastActorId == b.lastActorId &&
+            a.lastTransportId == b.lastTransportId;
+}
+
+// Pieces are listed by hex, the pieces of a hex by id
+void sortPieces(std::vector<Common::GameSnapshot::Piece>& pieces)
+{
+    std::sort(pieces.begin(), pieces.end(),
+              [](const Common::GameSnapshot::Piece& a,
+                 const Common::GameSnapshot::Piece& b) {
+        return a.hex != b.hex ? a.hex < b.hex : a.id < b.id;
+    });
+}
+
+std::vector<char> readBytes(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& fileName, const std::vector<char>& bytes)
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+}
+
+/**
+ * @brief Writes a made up game of a small island to a replay and reads it
+ * back. Every turn moves the pieces, so that both keyframes and changes
+ * carry terrain, pieces, passengers and the small state.
+ */
+class ReplayTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReplayTest();
+
+private Q_SLOTS:
+    void init();
+    void cleanupTestCase();
+
+    // Every turn reads back as it was written
+    void testRoundTrip();
+    void testSeekToKeyframe();
+    void testKeyframeEveryTurn();
+    void testMissingTurn();
+
+    // Damaged files
+    void testTruncated();
+    void testCorruptedHeader();
+    void testCorruptedKeyframe();
+    void testCorruptedAnyByte();
+
+private:
+    // The state of the made up game at the start of a turn
+    std::shared_ptr<Common::GameSnapshot> makeTurn(int turn) const;
+
+    void writeReplay(const std::string& fileName, int keyframeInterval) const;
+
+    // Reads every turn of a damaged file, a FormatException is expected
+    // from the damage
+    void readDamaged(const std::vector<char>& bytes) const;
+
+    std::shared_ptr<const std::vector<Common::CubeCoordinate>> coordinates_;
+    Common::TypeId landType_;
+    Common::TypeId waterType_;
+    Common::TypeId sharkType_;
+    Common::TypeId boatType_;
+};
+
+ReplayTest::ReplayTest():
+    coordinates_(std::make_shared<std::vector<Common::CubeCoordinate>>(
+                     std::vector<Common::CubeCoordinate>{
+                         Common::CubeCoordinate(0, 0, 0),
+                         Common::CubeCoordinate(1, -1, 0),
+                         Common::CubeCoordinate(1, 0, -1),
+                         Common::CubeCoordinate(0, 1, -1),
+                         Common::CubeCoordinate(-1, 1, 0),
+                         Common::CubeCoordinate(-1, 0, 1),
+                         Common::CubeCoordinate(0, -1, 1)})),
+    landType_(Common::TypeRegistry::getInstance().intern("Forest")),
+    waterType_(Common::WATER_TYPE),
+    sharkType_(Common::SHARK_TYPE),
+    boatType_(Common::BOAT_TYPE)
+{
+}
+
+std::shared_ptr<Common::GameSnapshot> ReplayTest::makeTurn(int turn) const
+{
+    auto snapshot = std::make_shared<Common::GameSnapshot>();
+    int hexes = static_cast<int>(coordinates_->size());
+    snapshot->coordinates = coordinates_;
+
+    // The island sinks a hex a turn
+    for (int hex = 0; hex < hexes; ++hex) {
+        snapshot->terrain.push_back(hex < turn % hexes ? waterType_
+                                                       : landType_);
+    }
+
+    // A pawn of every player walks around the island, the first one is
+    // gone after a while
+    for (int id = turn < TST_TURNS / 2 ? 0 : 1; id < TST_PLAYERS; ++id) {
+        snapshot->pawns.push_back(Common::GameSnapshot::Piece{
+                id, Common::NO_TYPE, id + 1, (id + turn) % hexes, 0, 0});
+    }
+    sortPieces(snapshot->pawns);
+
+    // A shark appears on the third turn and swims
+    if (turn >= 2) {
+        snapshot->actors.push_back(Common::GameSnapshot::Piece{
+                1, sharkType_, 0, (turn * 3) % hexes, 0, 0});
+    }
+
+    // A boat picks up the last pawn on every other turn
+    int passengers = turn % 2;
+    snapshot->transports.push_back(Common::GameSnapshot::Piece{
+            1, boatType_, 0, turn % hexes, 0, passengers});
+    if (passengers != 0) {
+        snapshot->passengers.push_back(TST_PLAYERS - 1);
+    }
+
+    for (int id = 1; id <= TST_PLAYERS; ++id) {
+        snapshot->players.push_back(Common::GameSnapshot::Player{
+                id, static_cast<unsigned int>((turn + id) % 4)});
+    }
+    snapshot->phase = static_cast<Common::GamePhase>(turn % 3 + 1);
+    snapshot->currentPlayer = turn % TST_PLAYERS + 1;
+    snapshot->islandPieces.push_back(std::make_pair(landType_,
+                                                    TST_TURNS - turn));
+    snapshot->spun = turn % 3 == 2;
+    snapshot->spinType = snapshot->spun ? sharkType_ : Common::NO_TYPE;
+    snapshot->spinMoves = snapshot->spun ? (turn % 2 == 0 ? "D" : "2") : "";
+
+    Logic::GameRandom rng(TST_SEED);
+    for (int draw = 0; draw < turn * 5; ++draw) {
+        rng();
+    }
+    snapshot->rng = rng;
+    snapshot->lastActorId = turn >= 2 ? 1 : 0;
+    snapshot->lastTransportId = 1;
+    return snapshot;
+}
+
+void ReplayTest::writeReplay(const std::string& fileName,
+                             int keyframeInterval) const
+{
+    Common::ReplayWriter writer(fileName, keyframeInterval);
+    for (int turn = 0; turn < TST_TURNS; ++turn) {
+        writer.addTurn(*makeTurn(turn));
+    }
+    writer.finish();
+}
+
+void ReplayTest::readDamaged(const std::vector<char>& bytes) const
+{
+    writeBytes(TST_DAMAGED_FILE, bytes);
+    try {
+        Common::ReplayReader reader(TST_DAMAGED_FILE);
+        for (int turn = 0; turn < reader.turnCount(); ++turn) {
+            reader.snapshotAt(turn);
+        }
+    } catch (Common::FormatException&) {
+    }
+}
+
+void ReplayTest::init()
+{
+    writeReplay(TST_REPLAY_FILE, TST_KEYFRAME_INTERVAL);
+}
+
+void ReplayTest::cleanupTestCase()
+{
+    std::remove(TST_REPLAY_FILE);
+    std::remove(TST_DAMAGED_FILE);
+}
+
+void ReplayTest::testRoundTrip()
+{
+    Common::ReplayReader reader(TST_REPLAY_FILE);
+    QCOMPARE(reader.turnCount(), TST_TURNS);
+    QCOMPARE(reader.keyframeInterval(), TST_KEYFRAME_INTERVAL);
+
+    for (int turn = 0; turn < TST_TURNS; ++turn) {
+        std::shared_ptr<const Common::GameSnapshot> read =
+                reader.snapshotAt(turn);
+        QVERIFY(read != nullptr);
+        QVERIFY(sameState(*read, *makeTurn(turn)));
+    }
+}
+
+void ReplayTest::testSeekToKeyframe()
+{
+    // Jumping backwards and straight to a keyframe or the turn before one
+    // reads the same states as reading in order
+    Common::ReplayReader reader(TST_REPLAY_FILE);
+    for (int turn = TST_TURNS - 1; turn >= 0; --turn) {
+        QVERIFY(sameState(*reader.snapshotAt(turn), *makeTurn(turn)));
+    }
+    for (int keyframe = 0; keyframe < TST_TURNS;
+         keyframe += TST_KEYFRAME_INTERVAL) {
+        QVERIFY(sameState(*reader.snapshotAt(keyframe), *makeTurn(keyframe)));
+        if (keyframe > 0) {
+            QVERIFY(sameState(*reader.snapshotAt(keyframe - 1),
+                              *makeTurn(keyframe - 1)));
+        }
+    }
+
+    // The snapshots of a reader share the coordinates
+    QVERIFY(reader.snapshotAt(0)->coordinates ==
+            reader.snapshotAt(TST_TURNS - 1)->coordinates);
+}
+
+void ReplayTest::testKeyframeEveryTurn()
+{
+    writeReplay(TST_DAMAGED_FILE, 1);
+    Common::ReplayReader reader(TST_DAMAGED_FILE);
+    QCOMPARE(reader.keyframeInterval(), 1);
+    for (int turn = 0; turn < TST_TURNS; ++turn) {
+        QVERIFY(sameState(*reader.snapshotAt(turn), *makeTurn(turn)));
+    }
+
+    // Keyframes take more room than changes
+    QVERIFY(readBytes(TST_DAMAGED_FILE).size() >
+            readBytes(TST_REPLAY_FILE).size());
+}
+
+void ReplayTest::testMissingTurn()
+{
+    Common::ReplayReader reader(TST_REPLAY_FILE);
+    QVERIFY(reader.snapshotAt(-1) == nullptr);
+    QVERIFY(reader.snapshotAt(TST_TURNS) == nullptr);
+
+    QVERIFY_EXCEPTION_THROWN(Common::ReplayReader{"tst_replaytest.missing"},
+                             Common::IoException);
+}
+
+void ReplayTest::testTruncated()
+{
+    // A file cut anywhere has lost its trailer
+    std::vector<char> bytes = readBytes(TST_REPLAY_FILE);
+    QVERIFY(bytes.size() > TST_FIRST_TURN);
+    for (std::size_t size : {std::size_t(0), TST_FIRST_TURN,
+                             bytes.size() / 2, bytes.size() - 1}) {
+        writeBytes(TST_DAMAGED_FILE, std::vector<char>(
+                       bytes.begin(), bytes.begin() + size));
+        QVERIFY_EXCEPTION_THROWN(Common::ReplayReader{TST_DAMAGED_FILE},
+                                 Common::FormatException);
+    }
+}
+
+void ReplayTest::testCorruptedHeader()
+{
+    std::vector<char> bytes = readBytes(TST_REPLAY_FILE);
+
+    // Another version
+    std::vector<char> damaged = bytes;
+    ++damaged[sizeof(Common::ReplayWriter::REPLAY_MAGIC)];
+    writeBytes(TST_DAMAGED_FILE, damaged);
+    QVERIFY_EXCEPTION_THROWN(Common::ReplayReader{TST_DAMAGED_FILE},
+                             Common::FormatException);
+
+    // An index past the end of the file, its offset is before the last
+    // REPLAY_MAGIC
+    damaged = bytes;
+    damaged[damaged.size() - sizeof(Common::ReplayWriter::REPLAY_MAGIC) - 1] =
+            0x7f;
+    writeBytes(TST_DAMAGED_FILE, damaged);
+    QVERIFY_EXCEPTION_THROWN(Common::ReplayReader{TST_DAMAGED_FILE},
+                             Common::FormatException);
+
+    // No magic at the start
+    damaged = bytes;
+    damaged[0] = 'X';
+    writeBytes(TST_DAMAGED_FILE, damaged);
+    QVERIFY_EXCEPTION_THROWN(Common::ReplayReader{TST_DAMAGED_FILE},
+                             Common::FormatException);
+}
+
+void ReplayTest::testCorruptedKeyframe()
+{
+    // The first turn claims to be changes, there is no keyframe before it
+    std::vector<char> bytes = readBytes(TST_REPLAY_FILE);
+    bytes[TST_FIRST_TURN] = static_cast<char>(TST_CHANGES_FRAME);
+    writeBytes(TST_DAMAGED_FILE, bytes);
+
+    Common::ReplayReader reader(TST_DAMAGED_FILE);
+    QVERIFY_EXCEPTION_THROWN(reader.snapshotAt(0), Common::FormatException);
+    QVERIFY_EXCEPTION_THROWN(reader.snapshotAt(TST_KEYFRAME_INTERVAL - 1),
+                             Common::FormatException);
+
+    // The turns of the next keyframes don't need it
+    QVERIFY(sameState(*reader.snapshotAt(TST_KEYFRAME_INTERVAL),
+                      *makeTurn(TST_KEYFRAME_INTERVAL)));
+}
+
+void ReplayTest::testCorruptedAnyByte()
+{
+    // Damage to any byte is either harmless or reported, the reader never
+    // reads outside the file
+    std::vector<char> bytes = readBytes(TST_REPLAY_FILE);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        std::vector<char> damaged = bytes;
+        damaged[i] = static_cast<char>(~damaged[i]);
+        readDamaged(damaged);
+    }
+}
+
+QTEST_APPLESS_MAIN(ReplayTest)
+
+#include "tst_replaytest.moc"
@@ -0,0 +1,184 @@
+#include <QDir>
+#include <QString>
+#include <QtTest>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "simulation.hh"
+#include "verification.hh"
+#include "workstealingpool.hh"
+
+const unsigned int TST_SEED = 20181121;
+
+// Games of each batch, enough for the workers to steal from each other.
+const unsigned int TST_GAMES = 24;
+
+// Thread counts compared to a single thread, more than the games of a
+// queue so that some workers start with nothing.
+const std::vector<unsigned int> TST_THREADS = {2, 3, 8};
+
+const char TST_RECORD_DIRECTORY[] = "tst_simulationtest.rec";
+
+namespace {
+
+// Compares the counters of two batches, the timings depend on the machine
+bool sameCounters(const Simulation::SimStats& lhs,
+                  const Simulation::SimStats& rhs)
+{
+    return lhs.games == rhs.games &&
+            lhs.unfinishedGames == rhs.unfinishedGames &&
+            lhs.rounds == rhs.rounds &&
+            lhs.drawnRounds == rhs.drawnRounds &&
+            lhs.turns == rhs.turns &&
+            lhs.moves == rhs.moves &&
+            lhs.spins == rhs.spins;
+}
+
+}
+
+class SimulationTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SimulationTest() = default;
+
+private Q_SLOTS:
+    void cleanupTestCase();
+
+    // WorkStealingPool
+    void testPoolRunsEveryTaskOnce();
+    void testPoolRethrows();
+
+    // The outcome of a seeded batch doesn't depend on the threads
+    void testSameStatsOnAnyThreadCount();
+    void testRecordingsOnAnyThreadCount();
+
+private:
+    Simulation::SimulationConfig config(unsigned int threads) const;
+};
+
+Simulation::SimulationConfig SimulationTest::config(unsigned int threads) const
+{
+    Simulation::SimulationConfig config;
+    config.games = TST_GAMES;
+    config.seed = TST_SEED;
+    config.threads = threads;
+    return config;
+}
+
+void SimulationTest::cleanupTestCase()
+{
+    QDir(TST_RECORD_DIRECTORY).removeRecursively();
+}
+
+void SimulationTest::testPoolRunsEveryTaskOnce()
+{
+    for (unsigned int threads : {1u, 2u, 3u, 8u}) {
+        Simulation::WorkStealingPool pool(threads);
+        QCOMPARE(pool.threadCount(), threads);
+
+        for (unsigned int tasks : {0u, 1u, 7u, 100u}) {
+            std::unique_ptr<std::atomic<int>[]> runs(
+                        new std::atomic<int>[tasks]);
+            std::unique_ptr<std::atomic<int>[]> busy(
+                        new std::atomic<int>[threads]);
+            for (unsigned int i = 0; i < tasks; ++i) {
+                runs[i] = 0;
+            }
+            for (unsigned int i = 0; i < threads; ++i) {
+                busy[i] = 0;
+            }
+            std::atomic<int> badWorkers(0);
+            std::atomic<int> overlaps(0);
+
+            pool.run(tasks, [&](unsigned int worker, unsigned int task) {
+                if (worker >= threads) {
+                    ++badWorkers;
+                    return;
+                }
+                // A worker runs one task at a time
+                if (busy[worker]++ != 0) {
+                    ++overlaps;
+                }
+                ++runs[task];
+                --busy[worker];
+            });
+
+            QCOMPARE(badWorkers.load(), 0);
+            QCOMPARE(overlaps.load(), 0);
+            for (unsigned int i = 0; i < tasks; ++i) {
+                QCOMPARE(runs[i].load(), 1);
+            }
+        }
+    }
+
+    // No threads means one
+    QCOMPARE(Simulation::WorkStealingPool(0).threadCount(), 1u);
+}
+
+void SimulationTest::testPoolRethrows()
+{
+    Simulation::WorkStealingPool pool(3);
+    QVERIFY_EXCEPTION_THROWN(
+                pool.run(100, [](unsigned int, unsigned int task) {
+                    if (task == 42) {
+                        throw std::runtime_error("task 42");
+                    }
+                }),
+                std::runtime_error);
+
+    // The pool runs the next batch in full
+    std::atomic<unsigned int> runs(0);
+    pool.run(100, [&runs](unsigned int, unsigned int) { ++runs; });
+    QCOMPARE(runs.load(), 100u);
+}
+
+void SimulationTest::testSameStatsOnAnyThreadCount()
+{
+    Simulation::SimStats single = Simulation::runSimulation(config(1));
+    QCOMPARE(single.games, static_cast<unsigned long>(TST_GAMES));
+    QVERIFY(single.turns > 0);
+    QVERIFY(single.moves > 0);
+
+    for (unsigned int threads : TST_THREADS) {
+        Simulation::SimStats stats = Simulation::runSimulation(
+                    config(threads));
+        QVERIFY(sameCounters(stats, single));
+    }
+
+    // Another seed plays other games
+    Simulation::SimulationConfig other = config(1);
+    other.seed = TST_SEED + 1;
+    QVERIFY(!sameCounters(Simulation::runSimulation(other), single));
+}
+
+void SimulationTest::testRecordingsOnAnyThreadCount()
+{
+    // Games recorded on several threads are played again the same on any
+    // number of threads
+    Simulation::SimulationConfig recorded = config(TST_THREADS.at(1));
+    recorded.recordDirectory = TST_RECORD_DIRECTORY;
+    Simulation::SimStats stats = Simulation::runSimulation(recorded);
+
+    for (unsigned int threads : {1u, TST_THREADS.at(0)}) {
+        Simulation::VerificationConfig verification;
+        verification.directory = TST_RECORD_DIRECTORY;
+        verification.threads = threads;
+        Simulation::VerificationResult result =
+                Simulation::verifyRecordings(verification);
+
+        QCOMPARE(result.files, static_cast<unsigned long>(TST_THREADS.at(1)));
+        QCOMPARE(result.games, static_cast<unsigned long>(TST_GAMES));
+        QCOMPARE(result.divergentGames, 0ul);
+        QVERIFY(result.divergences.empty());
+        QCOMPARE(result.stats.games, stats.games);
+        QCOMPARE(result.stats.turns, stats.turns);
+    }
+}
+
+QTEST_APPLESS_MAIN(SimulationTest)
+
+#include "tst_simulationtest.moc"
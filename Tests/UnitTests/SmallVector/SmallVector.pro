@@ -0,0 +1,25 @@
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_smallvectortest
+CONFIG   += console c++14
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DESTDIR = bin
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+QMAKE_CXXFLAGS += --coverage
+QMAKE_LFLAGS += --coverage
+
+SOURCES += \
+    tst_smallvectortest.cpp
+
+HEADERS += \
+    ../../../GameLogic/Engine/smallvector.hh
+
+INCLUDEPATH += ../../../GameLogic/Engine/
+DEPENDPATH  += ../../../GameLogic/Engine/
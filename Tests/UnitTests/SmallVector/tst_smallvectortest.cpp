@@ -0,0 +1,305 @@
+#include <QString>
+#include <QtTest>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "smallvector.hh"
+
+// Elements kept inside the tested vectors.
+const std::size_t TST_INLINE = 3;
+
+namespace {
+
+/**
+ * @brief Element that counts its live instances, so that every element the
+ * vector constructs is seen to be destroyed.
+ */
+class Counted
+{
+public:
+    explicit Counted(int value = 0): value_(value) { ++alive; }
+    Counted(const Counted& other): value_(other.value_) { ++alive; }
+    Counted(Counted&& other) noexcept: value_(other.value_)
+    {
+        other.value_ = -1;
+        ++alive;
+    }
+    ~Counted() { --alive; }
+
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept
+    {
+        value_ = other.value_;
+        other.value_ = -1;
+        return *this;
+    }
+
+    int value() const { return value_; }
+
+    static int alive;
+
+private:
+    int value_;
+};
+
+int Counted::alive = 0;
+
+using TestVector = Common::SmallVector<Counted, TST_INLINE>;
+
+// A vector of the values 0, 1, ... count - 1
+TestVector makeVector(int count)
+{
+    TestVector vector;
+    for (int i = 0; i < count; ++i) {
+        vector.push_back(Counted(i));
+    }
+    return vector;
+}
+
+// Tells if the vector holds the values first, first + 1, ...
+bool holdsSequence(const TestVector& vector, int first, int count)
+{
+    if (vector.size() != static_cast<std::size_t>(count)) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (vector[i].value() != first + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+class SmallVectorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SmallVectorTest() = default;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void testInline();
+    void testGrowPastInline();
+    void testInsert();
+    void testErase();
+    void testClearKeepsCapacity();
+    void testCopy();
+    void testMove();
+    void testAssign();
+    void testSpan();
+    void testSharedPointers();
+};
+
+void SmallVectorTest::init()
+{
+    Counted::alive = 0;
+}
+
+void SmallVectorTest::cleanup()
+{
+    // Every element constructed by the test is destroyed
+    QCOMPARE(Counted::alive, 0);
+}
+
+void SmallVectorTest::testInline()
+{
+    TestVector vector;
+    QVERIFY(vector.empty());
+    QCOMPARE(vector.capacity(), TST_INLINE);
+
+    for (std::size_t i = 0; i < TST_INLINE; ++i) {
+        vector.push_back(Counted(static_cast<int>(i)));
+    }
+    QCOMPARE(vector.capacity(), TST_INLINE);
+    QVERIFY(holdsSequence(vector, 0, TST_INLINE));
+
+    // The elements are inside the object
+    const char* object = reinterpret_cast<const char*>(&vector);
+    const char* elements = reinterpret_cast<const char*>(vector.data());
+    QVERIFY(elements >= object && elements < object + sizeof(vector));
+}
+
+void SmallVectorTest::testGrowPastInline()
+{
+    TestVector vector = makeVector(10);
+    QVERIFY(vector.capacity() >= 10);
+    QVERIFY(holdsSequence(vector, 0, 10));
+    QCOMPARE(Counted::alive, 10);
+
+    vector.reserve(100);
+    QCOMPARE(vector.capacity(), std::size_t(100));
+    QVERIFY(holdsSequence(vector, 0, 10));
+
+    // Reserving less does nothing
+    vector.reserve(5);
+    QCOMPARE(vector.capacity(), std::size_t(100));
+}
+
+void SmallVectorTest::testInsert()
+{
+    TestVector vector = makeVector(2);
+    vector.insert(vector.begin(), Counted(-2));
+    TestVector::iterator inserted = vector.insert(vector.begin() + 1,
+                                                  Counted(-1));
+    QCOMPARE(inserted->value(), -1);
+    QCOMPARE(vector.size(), std::size_t(4));
+    QCOMPARE(vector[0].value(), -2);
+    QCOMPARE(vector[1].value(), -1);
+    QCOMPARE(vector[2].value(), 0);
+    QCOMPARE(vector[3].value(), 1);
+
+    // Inserting an element of the vector itself while it grows
+    vector.insert(vector.begin(), vector[3]);
+    QCOMPARE(vector[0].value(), 1);
+    QCOMPARE(vector.size(), std::size_t(5));
+}
+
+void SmallVectorTest::testErase()
+{
+    TestVector vector = makeVector(6);
+    TestVector::iterator next = vector.erase(vector.begin() + 2);
+    QCOMPARE(next->value(), 3);
+    QCOMPARE(vector.size(), std::size_t(5));
+    QCOMPARE(Counted::alive, 5);
+
+    vector.erase(vector.begin());
+    vector.erase(vector.end() - 1);
+    QCOMPARE(vector.size(), std::size_t(3));
+    QCOMPARE(vector[0].value(), 1);
+    QCOMPARE(vector[1].value(), 3);
+    QCOMPARE(vector[2].value(), 4);
+
+    while (!vector.empty()) {
+        vector.erase(vector.begin());
+    }
+    QCOMPARE(Counted::alive, 0);
+}
+
+void SmallVectorTest::testClearKeepsCapacity()
+{
+    TestVector vector = makeVector(10);
+    std::size_t capacity = vector.capacity();
+    vector.clear();
+    QVERIFY(vector.empty());
+    QCOMPARE(vector.capacity(), capacity);
+    QCOMPARE(Counted::alive, 0);
+
+    vector.push_back(Counted(7));
+    QCOMPARE(vector[0].value(), 7);
+}
+
+void SmallVectorTest::testCopy()
+{
+    TestVector small = makeVector(2);
+    TestVector smallCopy(small);
+    QVERIFY(holdsSequence(small, 0, 2));
+    QVERIFY(holdsSequence(smallCopy, 0, 2));
+    QCOMPARE(smallCopy.capacity(), TST_INLINE);
+
+    TestVector large = makeVector(8);
+    TestVector largeCopy(large);
+    QVERIFY(holdsSequence(large, 0, 8));
+    QVERIFY(holdsSequence(largeCopy, 0, 8));
+    QVERIFY(largeCopy.data() != large.data());
+}
+
+void SmallVectorTest::testMove()
+{
+    TestVector small = makeVector(2);
+    TestVector smallMoved(std::move(small));
+    QVERIFY(small.empty());
+    QVERIFY(holdsSequence(smallMoved, 0, 2));
+
+    // A vector on the heap hands over its buffer
+    TestVector large = makeVector(8);
+    const Counted* buffer = large.data();
+    TestVector largeMoved(std::move(large));
+    QVERIFY(large.empty());
+    QCOMPARE(large.capacity(), TST_INLINE);
+    QVERIFY(largeMoved.data() == buffer);
+    QVERIFY(holdsSequence(largeMoved, 0, 8));
+
+    // The moved from vectors can be used again
+    large.push_back(Counted(5));
+    small.push_back(Counted(6));
+    QCOMPARE(large[0].value(), 5);
+    QCOMPARE(small[0].value(), 6);
+}
+
+void SmallVectorTest::testAssign()
+{
+    TestVector target = makeVector(8);
+    TestVector small = makeVector(2);
+    TestVector large = makeVector(6);
+
+    // Heap to inline, inline to heap and heap to heap
+    target = small;
+    QVERIFY(holdsSequence(target, 0, 2));
+    target = large;
+    QVERIFY(holdsSequence(target, 0, 6));
+    target = makeVector(9);
+    QVERIFY(holdsSequence(target, 0, 9));
+    target = std::move(small);
+    QVERIFY(holdsSequence(target, 0, 2));
+    QVERIFY(small.empty());
+
+    // Assigning to itself keeps the elements
+    TestVector& self = target;
+    target = self;
+    QVERIFY(holdsSequence(target, 0, 2));
+    target = std::move(self);
+    QVERIFY(holdsSequence(target, 0, 2));
+}
+
+void SmallVectorTest::testSpan()
+{
+    TestVector vector = makeVector(5);
+    Common::Span<const Counted> span = vector.span();
+    QCOMPARE(span.size(), std::size_t(5));
+    QVERIFY(span.data() == vector.data());
+    QCOMPARE(span.at(4).value(), 4);
+    QVERIFY_EXCEPTION_THROWN(span.at(5), std::out_of_range);
+
+    int sum = 0;
+    for (const auto& element : span) {
+        sum += element.value();
+    }
+    QCOMPARE(sum, 10);
+
+    Common::Span<const Counted> empty;
+    QVERIFY(empty.empty());
+    QVERIFY(empty.begin() == empty.end());
+    QVERIFY_EXCEPTION_THROWN(empty.at(0), std::out_of_range);
+}
+
+void SmallVectorTest::testSharedPointers()
+{
+    // The pieces of a hex are kept in SmallVectors of shared pointers, the
+    // vector must give up its references when elements leave it
+    std::shared_ptr<std::string> piece = std::make_shared<std::string>("a");
+    {
+        Common::SmallVector<std::shared_ptr<std::string>, 1> pieces;
+        for (int i = 0; i < 4; ++i) {
+            pieces.push_back(piece);
+        }
+        QCOMPARE(piece.use_count(), 5L);
+        pieces.erase(pieces.begin());
+        QCOMPARE(piece.use_count(), 4L);
+
+        Common::SmallVector<std::shared_ptr<std::string>, 1> moved(
+                    std::move(pieces));
+        QCOMPARE(piece.use_count(), 4L);
+    }
+    QCOMPARE(piece.use_count(), 1L);
+}
+
+QTEST_APPLESS_MAIN(SmallVectorTest)
+
+#include "tst_smallvectortest.moc"
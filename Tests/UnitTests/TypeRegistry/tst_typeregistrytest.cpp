@@ -0,0 +1,174 @@
+#include <QString>
+#include <QtTest>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "typeregistry.hh"
+
+const unsigned int TST_SEED = 20181121;
+
+// Threads that intern the same names at once, and the names they intern.
+const int TST_THREADS = 8;
+const int TST_NAMES = 500;
+
+class TypeRegistryTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    TypeRegistryTest() = default;
+
+private Q_SLOTS:
+    void testBuiltinTypes();
+    void testInternIsStable();
+    void testNameOfIntern();
+    void testFindUnknown();
+    void testNameOfUnknown();
+    void testConcurrentIntern();
+
+private:
+    // Names no other test uses
+    std::vector<std::string> uniqueNames(const std::string& prefix,
+                                         int count) const;
+};
+
+std::vector<std::string> TypeRegistryTest::uniqueNames(
+        const std::string& prefix, int count) const
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < count; ++i) {
+        names.push_back("TypeRegistryTest" + prefix + std::to_string(i));
+    }
+    return names;
+}
+
+void TypeRegistryTest::testBuiltinTypes()
+{
+    // The rules compare against these constants
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    QCOMPARE(registry.find(""), Common::NO_TYPE);
+    QCOMPARE(registry.intern("Water"), Common::WATER_TYPE);
+    QCOMPARE(registry.intern("Coral"), Common::CORAL_TYPE);
+    QCOMPARE(registry.intern("shark"), Common::SHARK_TYPE);
+    QCOMPARE(registry.intern("kraken"), Common::KRAKEN_TYPE);
+    QCOMPARE(registry.intern("seamunster"), Common::SEAMUNSTER_TYPE);
+    QCOMPARE(registry.intern("vortex"), Common::VORTEX_TYPE);
+    QCOMPARE(registry.intern("dolphin"), Common::DOLPHIN_TYPE);
+    QCOMPARE(registry.intern("boat"), Common::BOAT_TYPE);
+    QVERIFY(registry.nameOf(Common::NO_TYPE).empty());
+}
+
+void TypeRegistryTest::testInternIsStable()
+{
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    std::vector<std::string> names = uniqueNames("Stable", 50);
+
+    std::vector<Common::TypeId> ids;
+    for (const auto& name : names) {
+        ids.push_back(registry.intern(name));
+    }
+
+    // Other names in between don't move them
+    for (const auto& name : uniqueNames("Between", 50)) {
+        registry.intern(name);
+    }
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        QCOMPARE(registry.intern(names[i]), ids[i]);
+        QCOMPARE(registry.find(names[i]), ids[i]);
+    }
+
+    // Every name has an id of its own
+    std::set<Common::TypeId> distinct(ids.begin(), ids.end());
+    QCOMPARE(distinct.size(), names.size());
+    QVERIFY(distinct.count(Common::NO_TYPE) == 0);
+}
+
+void TypeRegistryTest::testNameOfIntern()
+{
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    for (const auto& name : uniqueNames("Name", 50)) {
+        QVERIFY(registry.nameOf(registry.intern(name)) == name);
+    }
+
+    // Names are compared as they are, case and spaces included
+    Common::TypeId lower = registry.intern("typeregistrytest case");
+    Common::TypeId upper = registry.intern("TypeRegistryTest Case");
+    QVERIFY(lower != upper);
+    QVERIFY(registry.nameOf(lower) == "typeregistrytest case");
+    QVERIFY(registry.nameOf(upper) == "TypeRegistryTest Case");
+}
+
+void TypeRegistryTest::testFindUnknown()
+{
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    const std::string unknown = "TypeRegistryTestUnknown";
+    QCOMPARE(registry.find(unknown), Common::NO_TYPE);
+
+    // find doesn't register the name
+    QCOMPARE(registry.find(unknown), Common::NO_TYPE);
+    Common::TypeId id = registry.intern(unknown);
+    QVERIFY(id != Common::NO_TYPE);
+    QCOMPARE(registry.find(unknown), id);
+}
+
+void TypeRegistryTest::testNameOfUnknown()
+{
+    // Ids that are not in use give the empty name
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    QVERIFY(registry.nameOf(std::numeric_limits<Common::TypeId>::max())
+            .empty());
+}
+
+void TypeRegistryTest::testConcurrentIntern()
+{
+    // Every thread interns the same names in its own order, and reads the
+    // names back while the others add theirs
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+    const std::vector<std::string> names = uniqueNames("Concurrent",
+                                                       TST_NAMES);
+
+    std::vector<std::vector<Common::TypeId>> ids(
+                TST_THREADS, std::vector<Common::TypeId>(TST_NAMES));
+    std::vector<int> misnamed(TST_THREADS, 0);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < TST_THREADS; ++thread) {
+        threads.emplace_back([&, thread]() {
+            std::vector<int> order(TST_NAMES);
+            for (int i = 0; i < TST_NAMES; ++i) {
+                order[i] = i;
+            }
+            std::mt19937 rng(TST_SEED + thread);
+            std::shuffle(order.begin(), order.end(), rng);
+            for (int i : order) {
+                Common::TypeId id = registry.intern(names[i]);
+                ids[thread][i] = id;
+                if (registry.nameOf(id) != names[i]) {
+                    ++misnamed[thread];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int thread = 0; thread < TST_THREADS; ++thread) {
+        QCOMPARE(misnamed[thread], 0);
+        QVERIFY(ids[thread] == ids.front());
+    }
+    std::set<Common::TypeId> distinct(ids.front().begin(),
+                                      ids.front().end());
+    QCOMPARE(distinct.size(), std::size_t(TST_NAMES));
+    for (int i = 0; i < TST_NAMES; ++i) {
+        QCOMPARE(registry.find(names[i]), ids.front()[i]);
+    }
+}
+
+QTEST_APPLESS_MAIN(TypeRegistryTest)
+
+#include "tst_typeregistrytest.moc"
@@ -2,5 +2,18 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     GameBoard \
-    GameState
-
+    FlatGameBoard \
+    ColumnGameBoard \
+    GameState \
+    GameRunner \
+    GameLog \
+    PathFinder \
+    GameRandom \
+    SmallVector \
+    Replay \
+    CubeKernels \
+    PackedCoordinate \
+    WheelLayoutParser \
+    TypeRegistry \
+    GameArena \
+    Simulation
@@ -0,0 +1,252 @@
+#include <QString>
+#include <QtTest>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "formatexception.hh"
+#include "gamerandom.hh"
+#include "ioexception.hh"
+#include "typeregistry.hh"
+#include "wheellayoutparser.hh"
+
+const unsigned int TST_SEED = 20181121;
+
+// Spins of each distribution test.
+const int TST_SPINS = 200000;
+
+// A count may be this many standard deviations off its expected value.
+const double TST_DEVIATIONS = 5.0;
+
+const char TST_LAYOUT_FILE[] = "tst_wheellayoutparsertest.json";
+
+namespace {
+
+//! Weights of the results of a test layout by section and move amount.
+using Weights = std::map<std::pair<std::string, std::string>, unsigned>;
+
+// Writes a layout with the given weights, in the format of layout.json
+void writeLayout(const Weights& weights)
+{
+    std::map<std::string, std::vector<std::pair<std::string, unsigned>>>
+            sections;
+    for (const auto& weight : weights) {
+        sections[weight.first.first].push_back(
+                    std::make_pair(weight.first.second, weight.second));
+    }
+
+    std::ofstream file(TST_LAYOUT_FILE, std::ios::trunc);
+    file << "[\n";
+    for (auto section = sections.begin(); section != sections.end();
+         ++section) {
+        file << (section == sections.begin() ? "" : ",\n")
+             << "  { \"name\": \"" << section->first
+             << "\", \"chances\": {";
+        for (std::size_t i = 0; i < section->second.size(); ++i) {
+            file << (i == 0 ? " " : ", ") << "\"" << section->second[i].first
+                 << "\": " << section->second[i].second;
+        }
+        file << " } }";
+    }
+    file << "\n]\n";
+}
+
+}
+
+class WheelLayoutParserTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    WheelLayoutParserTest() = default;
+
+private Q_SLOTS:
+    void cleanupTestCase();
+
+    // The results come up as often as their weights say
+    void testEvenWeights();
+    void testUnevenWeights();
+    void testZeroWeights();
+    void testSingleResult();
+
+    // The interned type of a spin
+    void testSpinType();
+
+    void testSectionsAndChances();
+
+    // Layouts that can't be spun
+    void testNegativeChance();
+    void testAllZero();
+    void testMissingFile();
+
+private:
+    // Spins the layout of weights TST_SPINS times and compares the counts
+    // to the weights
+    void checkDistribution(const Weights& weights);
+};
+
+void WheelLayoutParserTest::checkDistribution(const Weights& weights)
+{
+    writeLayout(weights);
+    Logic::WheelLayoutParser parser(TST_LAYOUT_FILE);
+
+    Weights counts;
+    Logic::GameRandom rng(TST_SEED);
+    for (int spin = 0; spin < TST_SPINS; ++spin) {
+        const Logic::WheelLayoutParser::SpinResult& result = parser.spin(rng);
+        QVERIFY(weights.count(result) == 1);
+        ++counts[result];
+    }
+
+    double total = 0;
+    for (const auto& weight : weights) {
+        total += weight.second;
+    }
+    for (const auto& weight : weights) {
+        double share = weight.second / total;
+        double expected = TST_SPINS * share;
+        double deviation = std::sqrt(TST_SPINS * share * (1 - share));
+        double count = counts[weight.first];
+        if (weight.second == 0) {
+            QCOMPARE(count, 0.0);
+        } else {
+            QVERIFY(std::abs(count - expected) <=
+                    TST_DEVIATIONS * deviation + 1);
+        }
+    }
+}
+
+void WheelLayoutParserTest::cleanupTestCase()
+{
+    std::remove(TST_LAYOUT_FILE);
+}
+
+void WheelLayoutParserTest::testEvenWeights()
+{
+    checkDistribution(Weights{
+        {{"shark", "1"}, 2}, {{"shark", "2"}, 2}, {{"shark", "D"}, 2},
+        {{"dolphin", "1"}, 2}, {{"dolphin", "2"}, 2}});
+}
+
+void WheelLayoutParserTest::testUnevenWeights()
+{
+    checkDistribution(Weights{
+        {{"shark", "1"}, 1}, {{"shark", "2"}, 10}, {{"shark", "3"}, 100},
+        {{"kraken", "D"}, 3}, {{"kraken", "1"}, 37},
+        {{"seamunster", "2"}, 1000}});
+}
+
+void WheelLayoutParserTest::testZeroWeights()
+{
+    // Zero weights never come up, whether the other weights are even or
+    // not
+    checkDistribution(Weights{
+        {{"shark", "1"}, 0}, {{"shark", "2"}, 5}, {{"shark", "D"}, 0},
+        {{"dolphin", "1"}, 5}, {{"vortex", "D"}, 0}});
+    checkDistribution(Weights{
+        {{"shark", "1"}, 0}, {{"shark", "2"}, 1}, {{"kraken", "3"}, 6},
+        {{"kraken", "D"}, 0}});
+
+    // A section with only zero chances is still a section
+    writeLayout(Weights{{{"shark", "1"}, 3}, {{"vortex", "D"}, 0}});
+    Logic::WheelLayoutParser parser(TST_LAYOUT_FILE);
+    QCOMPARE(parser.getSections().size(), std::size_t(2));
+}
+
+void WheelLayoutParserTest::testSingleResult()
+{
+    writeLayout(Weights{{{"shark", "3"}, 1}, {{"kraken", "1"}, 0}});
+    Logic::WheelLayoutParser parser(TST_LAYOUT_FILE);
+    Logic::GameRandom rng(TST_SEED);
+    for (int spin = 0; spin < 1000; ++spin) {
+        QVERIFY(parser.spin(rng) ==
+                Logic::WheelLayoutParser::SpinResult("shark", "3"));
+    }
+}
+
+void WheelLayoutParserTest::testSpinType()
+{
+    writeLayout(Weights{
+        {{"shark", "1"}, 1}, {{"kraken", "2"}, 1}, {{"dolphin", "D"}, 1}});
+    Logic::WheelLayoutParser parser(TST_LAYOUT_FILE);
+    Common::TypeRegistry& registry = Common::TypeRegistry::getInstance();
+
+    // Both overloads draw the same results, the type is the interned
+    // section
+    Logic::GameRandom rng(TST_SEED);
+    Logic::GameRandom typedRng(TST_SEED);
+    for (int spin = 0; spin < 1000; ++spin) {
+        Common::TypeId type = Common::NO_TYPE;
+        const Logic::WheelLayoutParser::SpinResult& typed =
+                parser.spin(typedRng, type);
+        QVERIFY(parser.spin(rng) == typed);
+        QCOMPARE(type, registry.find(typed.first));
+        QVERIFY(registry.nameOf(type) == typed.first);
+    }
+    QCOMPARE(rng.state(), typedRng.state());
+}
+
+void WheelLayoutParserTest::testSectionsAndChances()
+{
+    writeLayout(Weights{
+        {{"shark", "1"}, 4}, {{"shark", "D"}, 0}, {{"kraken", "2"}, 7}});
+    Logic::WheelLayoutParser parser;
+    QVERIFY(!parser.isFileRead());
+    parser.readJSON(TST_LAYOUT_FILE);
+    QVERIFY(parser.isFileRead());
+
+    std::vector<std::string> sections = parser.getSections();
+    QCOMPARE(sections.size(), std::size_t(2));
+    QVERIFY(sections.at(0) == "kraken");
+    QVERIFY(sections.at(1) == "shark");
+
+    auto chances = parser.getChancesForSection("shark");
+    QCOMPARE(chances.size(), std::size_t(2));
+    QVERIFY(chances.at(0) == std::make_pair(std::string("1"), 4u));
+    QVERIFY(chances.at(1) == std::make_pair(std::string("D"), 0u));
+    QVERIFY(parser.getChancesForSection("dolphin").empty());
+}
+
+void WheelLayoutParserTest::testNegativeChance()
+{
+    // Weights can't be negative, so the file is written by hand
+    {
+        std::ofstream file(TST_LAYOUT_FILE, std::ios::trunc);
+        file << "[ { \"name\": \"shark\", \"chances\": "
+                "{ \"1\": 3, \"2\": -1 } } ]\n";
+    }
+    QVERIFY_EXCEPTION_THROWN(Logic::WheelLayoutParser{TST_LAYOUT_FILE},
+                             Common::FormatException);
+}
+
+void WheelLayoutParserTest::testAllZero()
+{
+    writeLayout(Weights{{{"shark", "1"}, 0}, {{"kraken", "D"}, 0}});
+    QVERIFY_EXCEPTION_THROWN(Logic::WheelLayoutParser{TST_LAYOUT_FILE},
+                             Common::FormatException);
+
+    // A failed read keeps the layout read before
+    writeLayout(Weights{{{"shark", "2"}, 1}});
+    Logic::WheelLayoutParser parser(TST_LAYOUT_FILE);
+    writeLayout(Weights{{{"shark", "1"}, 0}});
+    QVERIFY_EXCEPTION_THROWN(parser.readJSON(TST_LAYOUT_FILE),
+                             Common::FormatException);
+    Logic::GameRandom rng(TST_SEED);
+    QVERIFY(parser.spin(rng) ==
+            Logic::WheelLayoutParser::SpinResult("shark", "2"));
+}
+
+void WheelLayoutParserTest::testMissingFile()
+{
+    QVERIFY_EXCEPTION_THROWN(
+                Logic::WheelLayoutParser{"tst_wheellayoutparsertest.missing"},
+                Common::IoException);
+}
+
+QTEST_APPLESS_MAIN(WheelLayoutParserTest)
+
+#include "tst_wheellayoutparsertest.moc"
@@ -17,7 +17,10 @@ SOURCES += main.cpp \
     mainwindow.cpp \
     player.cpp \
     gamestate.cpp \
+    gameboardbase.cpp \
     gameboard.cpp \
+    flatgameboard.cpp \
+    columngameboard.cpp \
     startdialog.cpp \
     hexitem.cpp \
     pawnitem.cpp \
@@ -28,7 +31,10 @@ SOURCES += main.cpp \
     zoomgraphicsview.cpp
 
 HEADERS  += \
+    gameboardbase.hh \
     gameboard.hh \
+    flatgameboard.hh \
+    columngameboard.hh \
     player.hh \
     gamestate.hh \
     mainwindow.hh \
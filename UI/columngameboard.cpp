@@ -0,0 +1,288 @@
+#include "columngameboard.hh"
+#include "hex.hh"
+#include "actor.hh"
+#include "transport.hh"
+#include "rules.hh"
+
+#include <algorithm>
+
+namespace Student {
+
+namespace {
+
+// Largest value of the 8 bit columns
+const int MAX_COUNT = 255;
+
+// Bit shared by the types that don't have one of their own
+const Common::TypeId SHARED_TYPE_BIT = 31;
+
+}
+
+ColumnGameBoard::ColumnGameBoard(int radius) :
+    FlatGameBoard(radius)
+{
+    rebuildColumns();
+}
+
+ColumnGameBoard::~ColumnGameBoard()
+{
+    const Common::BoardIndex& index = getIndex();
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        if (_hexes[slot]) {
+            findHex(index.coordinateOf(slot))->setListener(nullptr);
+        }
+    }
+}
+
+int ColumnGameBoard::checkTileOccupation(Common::CubeCoordinate tileCoord) const
+{
+    int slot = getIndex().slotOf(tileCoord);
+    if (slot < 0 || !_hexes[slot]) {
+        return -1;
+    }
+    return _pawnCounts[slot];
+}
+
+bool ColumnGameBoard::isWaterTile(Common::CubeCoordinate tileCoord) const
+{
+    int slot = getIndex().slotOf(tileCoord);
+    if (slot < 0) {
+        return false;
+    }
+    return _terrain[slot] == Common::WATER_TYPE;
+}
+
+void ColumnGameBoard::addHex(std::shared_ptr<Common::Hex> newHex)
+{
+    Common::Hex* oldHex = findHex(newHex->getCoordinates());
+    if (oldHex != nullptr && oldHex != newHex.get()) {
+        oldHex->setListener(nullptr);
+    }
+
+    FlatGameBoard::addHex(newHex);
+    newHex->setListener(this);
+    hexChanged(*newHex);
+}
+
+void ColumnGameBoard::reserveRadius(int radius)
+{
+    if (radius <= getIndex().radius()) {
+        return;
+    }
+    FlatGameBoard::reserveRadius(radius);
+    rebuildColumns();
+}
+
+const Common::BoardBitboards* ColumnGameBoard::getBitboards() const
+{
+    return &_bits;
+}
+
+void ColumnGameBoard::hexChanged(const Common::Hex& hex)
+{
+    int slot = getIndex().slotOf(hex.getCoordinates());
+    if (slot >= 0) {
+        writeSlot(slot, &hex);
+    }
+}
+
+std::uint32_t ColumnGameBoard::typeBit(Common::TypeId type)
+{
+    return std::uint32_t(1) << std::min(type, SHARED_TYPE_BIT);
+}
+
+std::size_t ColumnGameBoard::slotCount() const
+{
+    return _hexes.size();
+}
+
+Common::Span<const std::uint8_t> ColumnGameBoard::hexColumn() const
+{
+    return Common::Span<const std::uint8_t>(_hexes.data(), _hexes.size());
+}
+
+Common::Span<const Common::TypeId> ColumnGameBoard::terrainColumn() const
+{
+    return Common::Span<const Common::TypeId>(_terrain.data(),
+                                              _terrain.size());
+}
+
+Common::Span<const std::uint8_t> ColumnGameBoard::pawnCountColumn() const
+{
+    return Common::Span<const std::uint8_t>(_pawnCounts.data(),
+                                            _pawnCounts.size());
+}
+
+Common::Span<const std::uint32_t> ColumnGameBoard::actorMaskColumn() const
+{
+    return Common::Span<const std::uint32_t>(_actorMasks.data(),
+                                             _actorMasks.size());
+}
+
+Common::Span<const std::uint32_t> ColumnGameBoard::transportMaskColumn() const
+{
+    return Common::Span<const std::uint32_t>(_transportMasks.data(),
+                                             _transportMasks.size());
+}
+
+Common::Span<const std::uint8_t> ColumnGameBoard::transportRoomColumn() const
+{
+    return Common::Span<const std::uint8_t>(_transportRoom.data(),
+                                            _transportRoom.size());
+}
+
+Common::Span<const int> ColumnGameBoard::neighbourSlots(int slot) const
+{
+    return getTopology().neighbourSlots(slot);
+}
+
+// The mark functions read the columns through plain pointers and compute
+// the marks without branches, so that the loops vectorize
+
+std::size_t ColumnGameBoard::markWaterWithFreeTransport(
+        std::vector<std::uint8_t>& marks) const
+{
+    std::size_t slots = slotCount();
+    marks.resize(slots);
+    const Common::TypeId* terrain = _terrain.data();
+    const std::uint8_t* room = _transportRoom.data();
+    std::uint8_t* out = marks.data();
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < slots; ++i) {
+        std::uint8_t mark = (terrain[i] == Common::WATER_TYPE) &
+                (room[i] != 0);
+        out[i] = mark;
+        found += mark;
+    }
+    return found;
+}
+
+std::size_t ColumnGameBoard::markRoomForPawns(
+        std::vector<std::uint8_t>& marks) const
+{
+    std::size_t slots = slotCount();
+    marks.resize(slots);
+    const std::uint8_t* hexes = _hexes.data();
+    const std::uint8_t* pawns = _pawnCounts.data();
+    std::uint8_t* out = marks.data();
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < slots; ++i) {
+        std::uint8_t mark = hexes[i] &
+                (pawns[i] < Logic::MAX_PAWNS_PER_HEX);
+        out[i] = mark;
+        found += mark;
+    }
+    return found;
+}
+
+std::size_t ColumnGameBoard::markActorType(
+        Common::TypeId actorType, std::vector<std::uint8_t>& marks) const
+{
+    std::size_t slots = slotCount();
+    marks.resize(slots);
+    const std::uint32_t bit = typeBit(actorType);
+    const std::uint32_t* actors = _actorMasks.data();
+    std::uint8_t* out = marks.data();
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < slots; ++i) {
+        std::uint8_t mark = (actors[i] & bit) != 0;
+        out[i] = mark;
+        found += mark;
+    }
+    return found;
+}
+
+std::vector<Common::CubeCoordinate> ColumnGameBoard::coordinatesOf(
+        const std::vector<std::uint8_t>& marks) const
+{
+    const Common::BoardIndex& index = getIndex();
+    std::vector<Common::CubeCoordinate> coordinates;
+    for (std::size_t slot = 0; slot < marks.size(); ++slot) {
+        if (marks[slot]) {
+            coordinates.push_back(index.coordinateOf(static_cast<int>(slot)));
+        }
+    }
+    return coordinates;
+}
+
+std::vector<Common::CubeCoordinate>
+ColumnGameBoard::waterHexesWithFreeTransport() const
+{
+    std::vector<std::uint8_t> marks;
+    markWaterWithFreeTransport(marks);
+    return coordinatesOf(marks);
+}
+
+void ColumnGameBoard::rebuildColumns()
+{
+    const Common::BoardIndex& index = getIndex();
+    std::size_t slots = index.slotCount();
+    _hexes.assign(slots, 0);
+    _terrain.assign(slots, Common::NO_TYPE);
+    _pawnCounts.assign(slots, 0);
+    _actorMasks.assign(slots, 0);
+    _transportMasks.assign(slots, 0);
+    _transportRoom.assign(slots, 0);
+    _bits.resize(index.radius());
+
+    for (int slot = 0; slot < index.slotCount(); ++slot) {
+        writeSlot(slot, findHex(index.coordinateOf(slot)));
+    }
+}
+
+void ColumnGameBoard::writeSlot(int slot, const Common::Hex* hex)
+{
+    if (hex == nullptr) {
+        _hexes[slot] = 0;
+        _terrain[slot] = Common::NO_TYPE;
+        _pawnCounts[slot] = 0;
+        _actorMasks[slot] = 0;
+        _transportMasks[slot] = 0;
+        _transportRoom[slot] = 0;
+        writeBits(slot, false, false, false, false);
+        return;
+    }
+
+    std::uint32_t actorMask = 0;
+    for (const auto& actor : hex->getActorSpan()) {
+        actorMask |= typeBit(actor->getActorTypeId());
+    }
+    std::uint32_t transportMask = 0;
+    int room = 0;
+    for (const auto& transport : hex->getTransportSpan()) {
+        transportMask |= typeBit(transport->getTransportTypeId());
+        room += std::max(transport->getCapacity(), 0);
+    }
+
+    _hexes[slot] = 1;
+    _terrain[slot] = hex->getPieceTypeId();
+    _pawnCounts[slot] = static_cast<std::uint8_t>(
+                std::min(hex->getPawnAmount(), MAX_COUNT));
+    _actorMasks[slot] = actorMask;
+    _transportMasks[slot] = transportMask;
+    _transportRoom[slot] = static_cast<std::uint8_t>(
+                std::min(room, MAX_COUNT));
+    writeBits(slot, true, hex->isWaterTile(), actorMask != 0,
+              transportMask != 0);
+}
+
+void ColumnGameBoard::writeBits(int slot, bool isHex, bool isWater,
+                                bool hasActor, bool hasTransport)
+{
+    bool isFull = _pawnCounts[slot] >= Logic::MAX_PAWNS_PER_HEX;
+
+    _bits.hexes.assign(slot, isHex);
+    _bits.land.assign(slot, isHex && !isWater);
+    _bits.water.assign(slot, isHex && isWater);
+    _bits.full.assign(slot, isFull);
+    _bits.walkable.assign(slot, isHex && !isWater && !isFull);
+    _bits.occupied.assign(slot, _pawnCounts[slot] != 0 || hasActor ||
+                          hasTransport);
+    _bits.actors.assign(slot, hasActor);
+    _bits.transports.assign(slot, hasTransport);
+}
+
+}
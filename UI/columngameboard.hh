@@ -0,0 +1,244 @@
+#ifndef COLUMNGAMEBOARD_HH
+#define COLUMNGAMEBOARD_HH
+
+#include "flatgameboard.hh"
+#include "hexbitboard.hh"
+#include "ihexlistener.hh"
+#include "smallvector.hh"
+#include "typeregistry.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Student {
+
+/**
+ * @brief FlatGameBoard that also keeps the state of its hexes in parallel
+ * flat arrays, one value per slot of the board index.
+ * @details The hexes stay the authority, each of them tells the board when
+ * it changes and the board rewrites its slot of every column. Reading the
+ * columns needs no pointer chasing, so queries over the whole board are
+ * plain loops over small integers that the compiler can vectorize. Slots
+ * without a hex hold zeros. The neighbours of every slot come from the
+ * shared neighbour table of the board. The same state is kept in
+ * Common::BoardBitboards, which the game engine floods to find the routes
+ * of pawns.
+ */
+class ColumnGameBoard : public FlatGameBoard, public Common::IHexListener
+{
+public:
+    //! Entry of the neighbour table for a neighbour outside the board index.
+    static const int NO_SLOT = Common::BoardTopology::NO_SLOT;
+
+    /**
+     * @brief Constructor.
+     * @param radius The radius the board reserves room for.
+     */
+    explicit ColumnGameBoard(int radius = 0);
+
+    /**
+     * @brief Destructor, stops listening to the hexes.
+     */
+    virtual ~ColumnGameBoard();
+
+    ColumnGameBoard(const ColumnGameBoard&) = delete;
+    ColumnGameBoard& operator=(const ColumnGameBoard&) = delete;
+
+    /**
+     * @copydoc FlatGameBoard::checkTileOccupation()
+     */
+    virtual int checkTileOccupation(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @copydoc FlatGameBoard::isWaterTile()
+     */
+    virtual bool isWaterTile(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @copydoc FlatGameBoard::addHex()
+     * @details The board listens to the changes of the hex from now on.
+     */
+    virtual void addHex(std::shared_ptr<Common::Hex> newHex);
+
+    /**
+     * @copydoc FlatGameBoard::reserveRadius()
+     */
+    virtual void reserveRadius(int radius);
+
+    /**
+     * @copydoc Common::IGameBoard::getBitboards()
+     */
+    virtual const Common::BoardBitboards* getBitboards() const;
+
+    /**
+     * @copydoc Common::IHexListener::hexChanged()
+     */
+    virtual void hexChanged(const Common::Hex& hex);
+
+    /**
+     * @brief typeBit gives the bit of an actor or transport type in the
+     * masks of the board.
+     * @param type The type.
+     * @return The bit of the type. Types from 31 on share the highest bit.
+     */
+    static std::uint32_t typeBit(Common::TypeId type);
+
+    /**
+     * @brief slotCount tells the length of the columns.
+     * @return getIndex().slotCount()
+     */
+    std::size_t slotCount() const;
+
+    /**
+     * @brief hexColumn tells which slots have a hex.
+     * @return 1 for slots with a hex, 0 for the others.
+     */
+    Common::Span<const std::uint8_t> hexColumn() const;
+
+    /**
+     * @brief terrainColumn returns the piece types of the hexes.
+     * @return Piece type for each slot, NO_TYPE for slots without a hex.
+     */
+    Common::Span<const Common::TypeId> terrainColumn() const;
+
+    /**
+     * @brief pawnCountColumn returns the number of pawns on the hexes.
+     * @return Number of pawns for each slot.
+     */
+    Common::Span<const std::uint8_t> pawnCountColumn() const;
+
+    /**
+     * @brief actorMaskColumn returns the types of the actors on the hexes.
+     * @return typeBit() of every actor on the hex, or'ed together, for each
+     * slot.
+     */
+    Common::Span<const std::uint32_t> actorMaskColumn() const;
+
+    /**
+     * @brief transportMaskColumn returns the types of the transports on the
+     * hexes.
+     * @return typeBit() of every transport on the hex, or'ed together, for
+     * each slot.
+     */
+    Common::Span<const std::uint32_t> transportMaskColumn() const;
+
+    /**
+     * @brief transportRoomColumn returns the free seats of the transports on
+     * the hexes.
+     * @return Sum of Transport::getCapacity() of the transports on the hex,
+     * at most 255, for each slot.
+     */
+    Common::Span<const std::uint8_t> transportRoomColumn() const;
+
+    /**
+     * @brief neighbourSlots returns the slots of the neighbours of a slot.
+     * @param slot The slot.
+     * @pre 0 <= slot < slotCount()
+     * @return Six slots in the order of Common::NEIGHBOUR_OFFSETS, NO_SLOT
+     * for the neighbours outside the index. A slot in the table may still
+     * be empty.
+     */
+    Common::Span<const int> neighbourSlots(int slot) const;
+
+    /**
+     * @brief markWaterWithFreeTransport finds the water hexes with a
+     * transport that has room for a pawn.
+     * @param marks Set to one mark per slot, 1 for the found hexes, 0 for
+     * the others. Reused to avoid allocating.
+     * @return The number of found hexes.
+     * @post Exception quarantee: basic
+     */
+    std::size_t markWaterWithFreeTransport(
+            std::vector<std::uint8_t>& marks) const;
+
+    /**
+     * @brief markRoomForPawns finds the hexes a pawn can be added to without
+     * going over Logic::MAX_PAWNS_PER_HEX.
+     * @param marks Set to one mark per slot, as in
+     * markWaterWithFreeTransport().
+     * @return The number of found hexes.
+     * @post Exception quarantee: basic
+     */
+    std::size_t markRoomForPawns(std::vector<std::uint8_t>& marks) const;
+
+    /**
+     * @brief markActorType finds the hexes with an actor of the given type.
+     * @param actorType The type of the actor.
+     * @param marks Set to one mark per slot, as in
+     * markWaterWithFreeTransport().
+     * @return The number of found hexes. For types sharing a bit, see
+     * typeBit(), the hexes with any of those types.
+     * @post Exception quarantee: basic
+     */
+    std::size_t markActorType(Common::TypeId actorType,
+                              std::vector<std::uint8_t>& marks) const;
+
+    /**
+     * @brief coordinatesOf converts marks to the coordinates of the marked
+     * slots.
+     * @param marks One mark per slot, as set by the mark functions.
+     * @return Coordinates of the marked slots in the order of the slots.
+     */
+    std::vector<Common::CubeCoordinate> coordinatesOf(
+            const std::vector<std::uint8_t>& marks) const;
+
+    /**
+     * @brief waterHexesWithFreeTransport returns the water hexes with a
+     * transport that has room for a pawn.
+     * @return Coordinates of the hexes in the order of the slots.
+     */
+    std::vector<Common::CubeCoordinate> waterHexesWithFreeTransport() const;
+
+private:
+    // Sizes the columns for the index and refills them from the hexes
+    void rebuildColumns();
+
+    // Rewrites the columns of a slot from its hex, or clears them
+    void writeSlot(int slot, const Common::Hex* hex);
+
+    // Rewrites the bitboards of a slot, after its columns
+    void writeBits(int slot, bool isHex, bool isWater, bool hasActor,
+                   bool hasTransport);
+
+    /**
+     * @brief _hexes is 1 for the slots with a hex.
+     */
+    std::vector<std::uint8_t> _hexes;
+
+    /**
+     * @brief _terrain holds the piece types of the hexes.
+     */
+    std::vector<Common::TypeId> _terrain;
+
+    /**
+     * @brief _pawnCounts holds the number of pawns on the hexes.
+     */
+    std::vector<std::uint8_t> _pawnCounts;
+
+    /**
+     * @brief _actorMasks holds the actor types on the hexes.
+     */
+    std::vector<std::uint32_t> _actorMasks;
+
+    /**
+     * @brief _transportMasks holds the transport types on the hexes.
+     */
+    std::vector<std::uint32_t> _transportMasks;
+
+    /**
+     * @brief _transportRoom holds the free seats of the transports.
+     */
+    std::vector<std::uint8_t> _transportRoom;
+
+    /**
+     * @brief _bits holds the hexes and their properties one bit per slot.
+     */
+    Common::BoardBitboards _bits;
+
+};
+
+}
+
+#endif // COLUMNGAMEBOARD_HH
@@ -107,6 +107,12 @@ const static std::map<std::string, QString> TRANSPORT_IMAGES {
 
 //const static std::string RANKING_FILE = "C:/Users/Eeru/opisto_ohjelmointi/OTEK/kansakas/UI/ranking.csv";
 const static std::string RANKING_FILE = "ranking.csv";
+
+// Binary log of the last round of a finished game, see Common::GameLog
+const static std::string GAME_LOG_FILE = "lastgame.log";
+
+// Turns of the last round of a finished game, see Common::ReplayWriter
+const static std::string REPLAY_FILE = "lastgame.replay";
 }
 
 namespace ColorConstants {
@@ -0,0 +1,145 @@
+#include "flatgameboard.hh"
+
+#include "gameexception.hh"
+
+#include <algorithm>
+
+namespace Student {
+
+FlatGameBoard::FlatGameBoard(int radius) :
+    _index(radius),
+    _topology(Common::BoardTopology::forRadius(_index.radius())),
+    _slots(_index.slotCount())
+{
+}
+
+FlatGameBoard::~FlatGameBoard()
+{
+    for (const auto& hex : _slots) {
+        if (hex != nullptr && hex->getBoard() == this) {
+            hex->setBoard(nullptr);
+        }
+    }
+}
+
+int FlatGameBoard::checkTileOccupation(Common::CubeCoordinate tileCoord) const
+{
+    int slot = _index.slotOf(tileCoord);
+    if (slot < 0 || _slots[slot] == nullptr) {
+        return -1;
+    }
+    return _slots[slot]->getPawnAmount();
+}
+
+bool FlatGameBoard::isWaterTile(Common::CubeCoordinate tileCoord) const
+{
+    int slot = _index.slotOf(tileCoord);
+    if (slot < 0 || _slots[slot] == nullptr) {
+        return false;
+    }
+    return _slots[slot]->isWaterTile();
+}
+
+std::shared_ptr<Common::Hex> FlatGameBoard::getHex(
+        Common::CubeCoordinate hexCoord) const
+{
+    int slot = _index.slotOf(hexCoord);
+    if (slot < 0) {
+        return nullptr;
+    }
+    return _slots[slot];
+}
+
+Common::Hex* FlatGameBoard::findHex(Common::CubeCoordinate hexCoord) const
+{
+    int slot = _index.slotOf(hexCoord);
+    if (slot < 0) {
+        return nullptr;
+    }
+    return _slots[slot].get();
+}
+
+int FlatGameBoard::findNeighbours(
+        Common::CubeCoordinate hexCoord,
+        Common::Hex* neighbours[Common::HEX_NEIGHBOURS]) const
+{
+    int slot = _index.slotOf(hexCoord);
+    if (slot < 0) {
+        // Outside the table, only the sides facing the board can exist
+        return GameBoardBase::findNeighbours(hexCoord, neighbours);
+    }
+
+    int found = 0;
+    Common::Span<const int> neighbourSlots = _topology->neighbourSlots(slot);
+    for (int side = 0; side < Common::HEX_NEIGHBOURS; ++side) {
+        int neighbourSlot = neighbourSlots[side];
+        neighbours[side] = neighbourSlot == Common::BoardTopology::NO_SLOT ?
+                    nullptr : _slots[neighbourSlot].get();
+        found += neighbours[side] != nullptr;
+    }
+    return found;
+}
+
+void FlatGameBoard::addHex(std::shared_ptr<Common::Hex> newHex)
+{
+    Common::CubeCoordinate newHexCoordinates = newHex->getCoordinates();
+    if (!Common::BoardIndex::isValid(newHexCoordinates)) {
+        throw Common::GameException("The hex is not at a cube coordinate.");
+    }
+    if (!_index.contains(newHexCoordinates)) {
+        // Grow geometrically so that filling the board ring by ring without
+        // reserveRadius doesn't rebuild the array on every ring.
+        reserveRadius(std::max(
+                Common::BoardIndex::distanceFromCenter(newHexCoordinates),
+                2 * _index.radius()));
+    }
+    std::shared_ptr<Common::Hex>& hex =
+            _slots[_index.slotOf(newHexCoordinates)];
+    if (hex != nullptr && hex->getBoard() == this) {
+        hex->setBoard(nullptr);
+    }
+    hex = newHex;
+    newHex->setBoard(this);
+}
+
+void FlatGameBoard::reserveRadius(int radius)
+{
+    if (radius <= _index.radius()) {
+        return;
+    }
+
+    Common::BoardIndex newIndex(radius);
+    std::vector<std::shared_ptr<Common::Hex>> newSlots(newIndex.slotCount());
+    for (auto& hex : _slots) {
+        if (hex != nullptr) {
+            newSlots[newIndex.slotOf(hex->getCoordinates())] = std::move(hex);
+        }
+    }
+    _index = newIndex;
+    _topology = Common::BoardTopology::forRadius(radius);
+    _slots.swap(newSlots);
+}
+
+std::map<Common::CubeCoordinate, std::shared_ptr<Common::Hex>>
+FlatGameBoard::returnHexes()
+{
+    std::map<Common::CubeCoordinate, std::shared_ptr<Common::Hex>> hexes;
+    for (const auto& hex : _slots) {
+        if (hex != nullptr) {
+            hexes[hex->getCoordinates()] = hex;
+        }
+    }
+    return hexes;
+}
+
+const Common::BoardIndex& FlatGameBoard::getIndex() const
+{
+    return _index;
+}
+
+const Common::BoardTopology& FlatGameBoard::getTopology() const
+{
+    return *_topology;
+}
+
+}
@@ -0,0 +1,117 @@
+#ifndef FLATGAMEBOARD_HH
+#define FLATGAMEBOARD_HH
+
+#include "gameboardbase.hh"
+#include "boardindex.hh"
+#include "boardtopology.hh"
+
+#include <vector>
+
+
+namespace Student {
+
+/**
+ * @brief Game board that keeps its hexes in a dense array indexed by the
+ * axial coordinates of the hex.
+ * @details Looking up a hex is a bounds check and an array read instead of a
+ * tree walk. The array covers the radius given to reserveRadius() and grows
+ * if a hex is added outside of it. Neighbours are read from the shared
+ * Common::BoardTopology of the radius.
+ */
+class FlatGameBoard : public GameBoardBase
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param radius The radius the board reserves room for.
+     */
+    explicit FlatGameBoard(int radius = 0);
+
+    /**
+      * @brief Virtual destructor, takes the hexes off the board.
+      */
+    virtual ~FlatGameBoard();
+
+    /**
+     * @copydoc GameBoardBase::checkTileOccupation()
+     */
+    virtual int checkTileOccupation(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @copydoc GameBoardBase::isWaterTile()
+     */
+    virtual bool isWaterTile(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @copydoc Common::IGameBoard::getHex()
+     */
+    virtual std::shared_ptr<Common::Hex> getHex(
+            Common::CubeCoordinate hexCoord) const;
+
+    /**
+     * @copydoc Common::IGameBoard::findHex()
+     */
+    virtual Common::Hex* findHex(Common::CubeCoordinate hexCoord) const;
+
+    /**
+     * @brief findNeighbours returns the neighbours of a hex from the
+     * neighbour table of the board.
+     * @copydetails Common::IGameBoard::findNeighbours()
+     */
+    virtual int findNeighbours(
+            Common::CubeCoordinate hexCoord,
+            Common::Hex* neighbours[Common::HEX_NEIGHBOURS]) const;
+
+    /**
+     * @copydoc Common::IGameBoard::addHex()
+     */
+    virtual void addHex(std::shared_ptr<Common::Hex> newHex);
+
+    /**
+     * @brief reserveRadius makes room for hexes up to the given radius.
+     * @param radius The largest distance from the center of an added hex.
+     * @post Existing hexes are kept. Exception quarantee: basic
+     */
+    virtual void reserveRadius(int radius);
+
+    /**
+     * @copydoc GameBoardBase::returnHexes()
+     */
+    virtual std::map<Common::CubeCoordinate, std::shared_ptr<Common::Hex>>
+    returnHexes();
+
+    /**
+     * @brief getIndex returns the mapping between coordinates and slots.
+     * @return The index of the board.
+     */
+    const Common::BoardIndex& getIndex() const;
+
+    /**
+     * @brief getTopology returns the neighbour table of the board.
+     * @return The table, its slots are the slots of getIndex().
+     */
+    const Common::BoardTopology& getTopology() const;
+
+private:
+    /**
+     * @brief _index maps the coordinates to the slots of _slots. A copy of
+     * the index of _topology, kept here for the lookups.
+     */
+    Common::BoardIndex _index;
+
+    /**
+     * @brief _topology holds the neighbour slots of every slot, shared with
+     * the other boards of the same radius.
+     */
+    std::shared_ptr<const Common::BoardTopology> _topology;
+
+    /**
+     * @brief _slots holds the hexes, nullptr where there is no hex.
+     */
+    std::vector<std::shared_ptr<Common::Hex>> _slots;
+
+};
+
+}
+
+#endif // FLATGAMEBOARD_HH
@@ -0,0 +1,265 @@
+#include "gameboardbase.hh"
+
+#include "actor.hh"
+#include "gamelog.hh"
+#include "transport.hh"
+#include "undolog.hh"
+
+namespace Student {
+
+namespace {
+
+// Saves the entry of id in the map of pieces to the log, if it records
+template <class Map>
+void saveEntry(Common::UndoLog* log, Common::IUndoTarget& target, int table,
+               const Map& map, int id)
+{
+    if (log == nullptr || !log->isRecording()) {
+        return;
+    }
+    auto it = map.find(id);
+    log->saveEntry(target, table, id,
+                   it == map.end() ? nullptr : it->second);
+}
+
+// Puts back an entry saved with saveEntry
+template <class Map>
+void restoreMapEntry(Map& map, int id, const std::shared_ptr<void>& value)
+{
+    if (value == nullptr) {
+        map.erase(id);
+    } else {
+        map[id] = std::static_pointer_cast<
+                typename Map::mapped_type::element_type>(value);
+    }
+}
+
+}
+
+int GameBoardBase::checkTileOccupation(Common::CubeCoordinate tileCoord) const
+{
+    Common::Hex* hex = findHex(tileCoord);
+    if(hex == nullptr){
+        return -1;
+    }
+    else {
+       return hex->getPawnAmount();
+    }
+}
+
+bool GameBoardBase::isWaterTile(Common::CubeCoordinate tileCoord) const
+{
+    Common::Hex* hex = findHex(tileCoord);
+    return hex != nullptr && hex->isWaterTile();
+}
+
+void GameBoardBase::addPawn(int playerId, int pawnId)
+{
+   std::shared_ptr<Common::Pawn> pawn =
+           Common::GameArena::make<Common::Pawn>(_arena);
+   pawn->setId(pawnId,playerId);
+   saveEntry(_undoLog.get(), *this, PAWN_TABLE, _pawns, pawnId);
+   _pawns[pawnId] = pawn;
+}
+
+void GameBoardBase::addPawn(int playerId, int pawnId,
+                            Common::CubeCoordinate coord)
+{
+    std::shared_ptr<Common::Pawn> pawn =
+            Common::GameArena::make<Common::Pawn>(_arena, pawnId, playerId,
+                                                  coord);
+    saveEntry(_undoLog.get(), *this, PAWN_TABLE, _pawns, pawnId);
+    _pawns[pawnId] = pawn;
+    _pawns[pawnId]->setCoordinates(coord);
+    getHex(coord)->addPawn(pawn);
+    if (_gameLog != nullptr) {
+        _gameLog->pawnAdded(pawnId, playerId, coord);
+    }
+}
+
+void GameBoardBase::movePawn(int pawnId, Common::CubeCoordinate pawnCoord)
+{
+    Common::Hex* targetHex = findHex(pawnCoord);
+    if (targetHex == nullptr) {
+        return;
+    }
+    const std::shared_ptr<Common::Pawn>& pawn = _pawns.at(pawnId);
+
+    // Remove pawn from old coordinates and add to new
+    findHex(pawn->getCoordinates())->removePawn(pawn);
+    targetHex->addPawn(pawn);
+
+    pawn->setCoordinates(pawnCoord);
+}
+
+void GameBoardBase::removePawn(int pawnId)
+{
+    std::shared_ptr<Common::Pawn> pawn = _pawns.at(pawnId);
+
+    // Remove from hex and map
+    getHex(pawn->getCoordinates())->removePawn(pawn);
+    saveEntry(_undoLog.get(), *this, PAWN_TABLE, _pawns, pawnId);
+    _pawns.erase(pawnId);
+    if (_gameLog != nullptr) {
+        _gameLog->pawnRemoved(pawnId);
+    }
+}
+
+void GameBoardBase::addActor(
+        std::shared_ptr<Common::Actor> actor, Common::CubeCoordinate actorCoord)
+{
+    saveEntry(_undoLog.get(), *this, ACTOR_TABLE, _actors, actor->getId());
+    _actors[actor->getId()] = actor;
+    actor->move(getHex(actorCoord));
+}
+
+void GameBoardBase::moveActor(int actorId, Common::CubeCoordinate actorCoord)
+{
+    std::shared_ptr<Common::Hex> targetHex = getHex(actorCoord);
+    if (targetHex == nullptr) {
+        return;
+    }
+    _actors[actorId]->move(targetHex);
+}
+
+void GameBoardBase::removeActor(int actorId)
+{
+    std::shared_ptr<Common::Actor> actor = _actors.at(actorId);
+
+    // Remove from hex and map
+    actor->getHex()->removeActor(actor);
+    saveEntry(_undoLog.get(), *this, ACTOR_TABLE, _actors, actorId);
+    _actors.erase(actorId);
+    if (_gameLog != nullptr) {
+        _gameLog->actorRemoved(actorId);
+    }
+}
+
+void GameBoardBase::addTransport(
+        std::shared_ptr<Common::Transport> transport,
+        Common::CubeCoordinate coord)
+{
+    saveEntry(_undoLog.get(), *this, TRANSPORT_TABLE, _transports,
+              transport->getId());
+    _transports[transport->getId()] = transport;
+    transport->addHex(getHex(coord));
+}
+
+void GameBoardBase::moveTransport(int id, Common::CubeCoordinate coord)
+{
+    std::shared_ptr<Common::Hex> targetHex = getHex(coord);
+    if (targetHex == nullptr) {
+        return;
+    }
+    _transports[id]->move(targetHex);
+}
+
+void GameBoardBase::removeTransport(int id)
+{
+    std::shared_ptr<Common::Transport> transport = _transports.at(id);
+
+    // Remove from hex and map
+    transport->getHex()->removeTransport(transport);
+    saveEntry(_undoLog.get(), *this, TRANSPORT_TABLE, _transports, id);
+    _transports.erase(id);
+    if (_gameLog != nullptr) {
+        _gameLog->transportRemoved(id);
+    }
+}
+
+void GameBoardBase::setArena(std::shared_ptr<Common::GameArena> arena)
+{
+    _arena = std::move(arena);
+}
+
+void GameBoardBase::setUndoLog(std::shared_ptr<Common::UndoLog> log)
+{
+    _undoLog = std::move(log);
+}
+
+Common::UndoLog* GameBoardBase::getUndoLog() const
+{
+    return _undoLog.get();
+}
+
+void GameBoardBase::setGameLog(std::shared_ptr<Common::GameLog> log)
+{
+    _gameLog = std::move(log);
+}
+
+Common::GameLog* GameBoardBase::getGameLog() const
+{
+    return _gameLog.get();
+}
+
+void GameBoardBase::restoreEntry(int table, int key,
+                                 const std::shared_ptr<void>& value)
+{
+    switch (table) {
+    case PAWN_TABLE:
+        restoreMapEntry(_pawns, key, value);
+        break;
+    case ACTOR_TABLE:
+        restoreMapEntry(_actors, key, value);
+        break;
+    case TRANSPORT_TABLE:
+        restoreMapEntry(_transports, key, value);
+        break;
+    }
+}
+
+bool GameBoardBase::checkIfActorOrTransportExists(std::string type)
+{
+    Common::TypeId typeId = Common::TypeRegistry::getInstance().find(type);
+    if (typeId == Common::NO_TYPE) {
+        return false;
+    }
+    for(auto& actor : _actors) {
+        if(actor.second->getActorTypeId() == typeId){
+            return true;
+        }
+    }
+    for(auto& transport : _transports) {
+        if(transport.second->getTransportTypeId() == typeId){
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<Common::Actor> GameBoardBase::getActor(int actorID)
+{
+    return _actors.at(actorID);
+}
+
+std::shared_ptr<Common::Transport> GameBoardBase::getTransport(int transportID)
+{
+    return _transports.at(transportID);
+}
+
+std::shared_ptr<Common::Pawn> GameBoardBase::getPawn(int pawnId)
+{
+    if (_pawns.find(pawnId) == _pawns.end()) {
+        return nullptr;
+    }
+
+    return _pawns.at(pawnId);
+}
+
+
+int GameBoardBase::getWinner()
+{
+    if(_pawns.size() == 1){
+        return _pawns.begin()->second->getPlayerId();
+    }
+    else {
+        return 0;
+    }
+}
+
+unsigned int GameBoardBase::pawnsLeft()
+{
+    return _pawns.size();
+}
+
+}
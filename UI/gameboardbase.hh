@@ -0,0 +1,259 @@
+#ifndef GAMEBOARDBASE_HH
+#define GAMEBOARDBASE_HH
+
+#include "pawn.hh"
+#include "igameboard.hh"
+#include "iundotarget.hh"
+
+#include <map>
+#include <unordered_map>
+
+
+namespace Student {
+
+/**
+ * @brief The pawns, actors and transports of a game board, without the
+ * hexes.
+ * @details The boards derived from this class decide how the hexes are
+ * stored and looked up, and the pieces are kept here the same way for all
+ * of them.
+ */
+class GameBoardBase : public Common::IGameBoard, public Common::IUndoTarget
+{
+public:
+    /**
+      * @default Default constructor.
+      */
+    GameBoardBase() = default;
+
+    /**
+      * @brief Virtual destructor.
+      */
+    virtual ~GameBoardBase() = default;
+
+    /**
+     * @brief checkTileOccupation Checks the current amount of pawns on the tile
+     * @param tileCoord The location of the tile in coordinates.
+     * @return The number of the pawns in the tile or -1 if the tile does not exist.
+     * @post Exception quarantee: strong
+     */
+    virtual int checkTileOccupation(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @brief isWaterTile checks if the tile is a water tile.
+     * @param tileCoord The location of the tile in coordinates.
+     * @return true, if the tile is a water tile, else (or if the tile does not exist) false.
+     * @post Exception quarantee: nothrow
+     */
+    virtual bool isWaterTile(Common::CubeCoordinate tileCoord) const;
+
+    /**
+     * @brief addPawn adds a new pawn to the game
+     * @param playerId. Id of player, whose pawn is added
+     * @param pawnId. Id of the pawn
+     * @post Pawn is added to the game. Exception quarantee: basic
+     */
+    virtual void addPawn(int playerId, int pawnId);
+
+    /**
+     * @brief addPawn adds a new pawn to the game
+     * @param playerId. Id of player, whose pawn is added
+     * @param pawnId. Id of the pawn
+     * @param coord. CubeCoordinate, where pawn is added
+     * @post Pawn is added to the game. Exception quarantee: basic
+     */
+    virtual void addPawn(int playerId, int pawnId, Common::CubeCoordinate coord);
+
+    /**
+     * @brief movePawn sets a new location for the pawn.
+     * @param pawnId The identifier of the pawn.
+     * @param pawnCoord The target location of the pawn in coordinates.
+     * @pre Pawn exists
+     * @post Pawn is moved to the target location. Exception quarantee: basic
+     */
+    virtual void movePawn(int pawnId, Common::CubeCoordinate pawnCoord);
+
+    /**
+     * @brief removePawn removes a pawn.
+     * @param pawnId The identifier of the pawn.
+     * @pre Pawn exists
+     * @post pawn matching the id is removed. Exception quarantee: basic
+     */
+    virtual void removePawn(int pawnId);
+
+    /**
+     * @brief addActor adds a new actor to the game board
+     * @param actor
+     * @param actorCoord
+     * @pre coordinates must contain a hex
+     * @post actor has been added to the hex in target coordinates
+     */
+    virtual void addActor(std::shared_ptr<Common::Actor> actor,
+                          Common::CubeCoordinate actorCoord);
+
+    /**
+     * @brief moveActor sets a new location for the actor.
+     * @param actorId The identifier of the actor.
+     * @param actorCoord The target location of the actor in coordinates.
+     * @pre Actor exists
+     * @post actor actorId is moved to a new location: Exception quarantee: basic
+     */
+    virtual void moveActor(int actorId, Common::CubeCoordinate actorCoord);
+
+    /**
+     * @brief removeActor removes an actor.
+     * @param actorId The identifier of the actor.
+     * @pre Actor exists
+     * @post Actor actorId is removed. Exception quarantee: basic
+     */
+    virtual void removeActor(int actorId);
+
+    /**
+     * @brief addTransport adds a new transport to the game board
+     * @param transport transport to be added
+     * @param coord
+     * @pre coordinates must contain a hex
+     * @post Transport has been added to the hex in target coordinates
+     */
+    virtual void addTransport(std::shared_ptr<Common::Transport> transport,
+                              Common::CubeCoordinate coord);
+
+    /**
+     * @brief moveTransport sets a new location for the transport.
+     * @param id The identifier of the transport.
+     * @param coord The target location of the transport in coordinates.
+     * @post transport is moved to a new location: Exception quarantee: basic
+     */
+    virtual void moveTransport(int id, Common::CubeCoordinate coord);
+
+    /**
+     * @brief removeTransport removes an transport.
+     * @param id The identifier of the transport.
+     * @post transport removed from the gameboard. Exception quarantee: basic
+     */
+    virtual void removeTransport(int id);
+
+    /**
+     * @brief setArena sets the arena new pawns are allocated from.
+     * @param arena The arena of the game.
+     * @post Exception quarantee: nothrow
+     */
+    virtual void setArena(std::shared_ptr<Common::GameArena> arena);
+
+    /**
+     * @copydoc Common::IGameBoard::setUndoLog()
+     */
+    virtual void setUndoLog(std::shared_ptr<Common::UndoLog> log);
+
+    /**
+     * @copydoc Common::IGameBoard::getUndoLog()
+     */
+    virtual Common::UndoLog* getUndoLog() const;
+
+    /**
+     * @copydoc Common::IGameBoard::setGameLog()
+     */
+    virtual void setGameLog(std::shared_ptr<Common::GameLog> log);
+
+    /**
+     * @copydoc Common::IGameBoard::getGameLog()
+     */
+    virtual Common::GameLog* getGameLog() const;
+
+    /**
+     * @copydoc Common::IUndoTarget::restoreEntry()
+     */
+    virtual void restoreEntry(int table, int key,
+                              const std::shared_ptr<void>& value);
+
+    /**
+     * @brief returnHexes, returns the hexes of the board
+     * @return map of the hexes by their coordinates
+     */
+    virtual std::map<Common::CubeCoordinate, std::shared_ptr<Common::Hex>>
+    returnHexes() = 0;
+
+    /**
+     * @brief checkIfActorExists checks if any actors or Transports of a given
+     * type are on the board.
+     * @param type, the type of the actor or Transport to search for.
+     * @return bool:true, if actor or transport exists, false otherwise.
+     */
+    bool checkIfActorOrTransportExists(std::string type);
+
+    /**
+     * @brief getActor returns an actor.
+     * @param actorID The id of the actor that is to be returned.
+     * @pre actor exists
+     * @return std::shared_ptr<Common::Actor>, pointer to
+     * the actor indicated by the paramer actorID.
+     */
+    std::shared_ptr<Common::Actor> getActor(int actorID);
+
+    /**
+     * @brief getActor returns an transport.
+     * @param actorID The id of the transport that is to be returned.
+     * @pre transport exists
+     * @return std::shared_ptr<Common::Transport>, pointer to
+     * the transport indicated by the paramer transportID.
+     */
+    std::shared_ptr<Common::Transport> getTransport(int transportID);
+
+    /**
+     * @brief getPawnsLeft returns a pawn ptr from given pawnId
+     * @return the pawn
+     */
+    std::shared_ptr<Common::Pawn> getPawn(int pawnId);
+
+    /**
+     * @brief getWinner returns the winning player's Id if there is only one pawn
+     * left in the game, otherwise returns 0.
+     * @return The winning player's Id if there is one, 0 otherwise.
+     */
+    int getWinner();
+
+    /**
+     * @brief pawnsLeft - return the amount of pawns left
+     * @return pawns left
+     */
+    unsigned int pawnsLeft();
+
+
+private:
+    //! Tables of the board in the undo log.
+    enum Table {
+        PAWN_TABLE,
+        ACTOR_TABLE,
+        TRANSPORT_TABLE
+    };
+
+    /**
+     * @brief Data structures required for storing the GameEngine's logical
+     * pawns, actors and transports.
+     */
+    std::unordered_map<int, std::shared_ptr<Common::Pawn>> _pawns;
+    std::map<int, std::shared_ptr<Common::Actor>> _actors;
+    std::map<int, std::shared_ptr<Common::Transport>> _transports;
+
+    /**
+     * @brief _arena is the memory of the pawns, nullptr for the heap.
+     */
+    std::shared_ptr<Common::GameArena> _arena;
+
+    /**
+     * @brief _undoLog saves the entries of the maps of pieces while it has
+     * an open level, nullptr if the moves are not taken back.
+     */
+    std::shared_ptr<Common::UndoLog> _undoLog;
+
+    /**
+     * @brief _gameLog records the pieces added and removed by the board,
+     * nullptr if the game is not recorded.
+     */
+    std::shared_ptr<Common::GameLog> _gameLog;
+
+};
+
+}
+
+#endif // GAMEBOARDBASE_HH
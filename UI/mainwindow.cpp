@@ -1,4 +1,5 @@
 #include "mainwindow.hh"
+#include "flatgameboard.hh"
 #include "initialize.hh"
 #include "pawn.hh"
 #include "shark.hh"
@@ -7,6 +8,8 @@
 #include "startdialog.hh"
 #include "helpers.hh"
 #include "illegalmoveexception.hh"
+#include "ioexception.hh"
+#include "formatexception.hh"
 
 #include <QDesktopWidget>
 #include <QGridLayout>
@@ -31,15 +34,17 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
    _layout = new QGridLayout();
    _centralWidget = new QWidget();
    _view = new ZoomGraphicsView();
+   _replaySlider = nullptr;
 }
 
 void MainWindow::initBoard(int playersAmount, const bool reset)
 {
     _playersAmount = playersAmount;
 
-    _gameBoard = std::shared_ptr<Student::GameBoard>(new Student::GameBoard());
+    _gameBoard = std::shared_ptr<Student::GameBoardBase>(new Student::FlatGameBoard());
     _gameState = std::shared_ptr<GameState>(new GameState(_playersAmount));
     _spinned = false;
+    _animalTypeFromSpinner = Common::NO_TYPE;
 
     if (!reset) {
         initPlayers();
@@ -52,12 +57,25 @@ void MainWindow::initBoard(int playersAmount, const bool reset)
     }
     _gameRunner = Common::Initialization::getGameRunner(_gameBoard, _gameState,
                                                         iPlayers);
+    _gameLog = std::make_shared<Common::GameLog>();
+    _gameRunner->setGameLog(_gameLog);
     _scene = new QGraphicsScene(this);
 
     drawGameBoard();
     drawPawns();
     setupGameInfoBox();
 
+    // The replay of the last round is overwritten, finish it first
+    _replayWriter.reset();
+    try {
+        _replayWriter.reset(new Common::ReplayWriter(PathConstants::REPLAY_FILE));
+    } catch (Common::IoException& e) {
+        QMessageBox replayError;
+        replayError.setText(QString::fromStdString(e.msg()));
+        replayError.exec();
+    }
+    recordTurn();
+
     _view->setScene(_scene);
     _layout->addWidget(_view, 0, 0, 10, 10);
     _layout->addWidget(_gameInfoBox, 1, 11, 2, 2);
@@ -119,7 +137,8 @@ void MainWindow::spinWheel()
                     spinResult.second,
                     actorExists);
     }
-    _animalTypeFromSpinner = spinResult.first;
+    _animalTypeFromSpinner =
+            Common::TypeRegistry::getInstance().intern(spinResult.first);
     _movesFromSpinner = spinResult.second;
     _spinned = true;
 }
@@ -141,6 +160,7 @@ void MainWindow::continueFromSpinning()
     _playerMap.at(_gameState->currentPlayer())->addTurn();
     _gameState->changePlayerTurn(getNextPlayerId());
     _gameInfoBox->updateGameState();
+    recordTurn();
 }
 
 void MainWindow::eraseTransportItem(const int transportId)
@@ -196,7 +216,7 @@ void MainWindow::movePawnWithTransport(const Common::CubeCoordinate &target,
 
 
     // Switch rider
-    if (transport->getTransportType() == "dolphin"
+    if (transport->getTransportTypeId() == Common::DOLPHIN_TYPE
             and transport->getCapacity() == 0)
     {
         std::shared_ptr<Common::Pawn> oldPawn =
@@ -221,7 +241,8 @@ bool MainWindow::validPawnMove(const Common::CubeCoordinate &target)
             _gameState->currentGamePhase() != Common::GamePhase::MOVEMENT
          || (
                 (!targetHex->getActors().empty() &&
-                   (targetHex->getActors().at(0)->getActorType() != "kraken"))
+                   (targetHex->getActors().at(0)->getActorTypeId()
+                    != Common::KRAKEN_TYPE))
 
          && (
                 !targetHex->getTransports().empty() &&
@@ -254,7 +275,7 @@ void MainWindow::movePawn(const Common::CubeCoordinate origin,
     if (_gameBoard->getHex(target)->getTransports().empty())
     {
         PawnItem* pawnItem = _pawnItems.at(pawnId);
-        HexItem* newParent = _hexItems.at(target);
+        HexItem* newParent = hexItemAt(target);
 
         pawnItem->setOffset(newParent->getPawnPosition(pawnId));
         pawnItem->setParent(newParent);
@@ -282,7 +303,7 @@ bool MainWindow::validActorMove(const Common::CubeCoordinate &target,
     if (
             (_gameState->currentGamePhase() != Common::GamePhase::SPINNING)
          || !_spinned
-         || (_gameBoard->getActor(actorId)->getActorType()
+         || (_gameBoard->getActor(actorId)->getActorTypeId()
              != _animalTypeFromSpinner
            )
          || (!( _gameBoard->getHex(target)->getActors().empty()))
@@ -310,7 +331,7 @@ void MainWindow::moveActor(const Common::CubeCoordinate &origin,
     doActorAction(target, actorId);
 
     ActorItem* actorItem = _actorItems.at(actorId);
-    HexItem* newParent = _hexItems.at(target);
+    HexItem* newParent = hexItemAt(target);
 
     actorItem->setPos(newParent->getActorPosition());
     actorItem->setParent(newParent);
@@ -336,13 +357,14 @@ bool MainWindow::validTransportMove(const bool spinning,
         || (spinning && !_spinned)
         || (
                 spinning &&
-                _gameBoard->getTransport(transportId)->getTransportType()
+                _gameBoard->getTransport(transportId)->getTransportTypeId()
                 != _animalTypeFromSpinner
            )
         || (!(targetHex->getTransports().empty()))
         || (
                 !(targetHex->getActors().empty()) &&
-                targetHex->getActors().at(0)->getActorType() != "shark"
+                targetHex->getActors().at(0)->getActorTypeId()
+                != Common::SHARK_TYPE
            )
     )
     {
@@ -357,7 +379,7 @@ void MainWindow::moveTransportAction(const Common::CubeCoordinate &target,
                                      const bool spinning)
 {
     TransportItem* transportItem = _transportItems.at(transportId);
-    HexItem* newParent = _hexItems.at(target);
+    HexItem* newParent = hexItemAt(target);
 
     transportItem->setPos(newParent->getTransportPosition());
     transportItem->setParent(newParent);
@@ -415,7 +437,7 @@ void MainWindow::flipHex(const Common::CubeCoordinate &tileCoord)
         return;
     }
 
-    _hexItems.at(tileCoord)->flip();
+    hexItemAt(tileCoord)->flip();
 
     flipHexFollowUp(tileCoord, actorType);
 
@@ -465,7 +487,7 @@ void MainWindow::drawGameBoard()
         connect(newHex, &HexItem::transportDropped,
                 this, &MainWindow::moveTransport);
 
-        _hexItems[cubeCoord] = newHex;
+        _hexItems[Common::PackedCoordinate(cubeCoord)] = newHex;
         _scene->addItem(newHex);
     }
 }
@@ -482,7 +504,7 @@ void MainWindow::drawPawns()
         std::shared_ptr<Common::Pawn> pawn =
                 _gameBoard->getHex(coord)->givePawn(id);
         PawnItem* pawnItem = new PawnItem(
-                    player.second->getPawnColor(), pawn, _hexItems[coord]);
+                    player.second->getPawnColor(), pawn, hexItemAt(coord));
         _pawnItems[id] = pawnItem;
         _scene->addItem(pawnItem);
     }
@@ -491,7 +513,7 @@ void MainWindow::drawPawns()
 void MainWindow::addActorItem(std::shared_ptr<Common::Hex> hex)
 {
     ActorItem* actorItem = new ActorItem((hex->getActors().at(0)),
-                                         _hexItems.at(hex->getCoordinates()));
+                                         hexItemAt(hex->getCoordinates()));
     _actorItems[hex->getActors().at(0)->getId()] = actorItem;
     _scene->addItem(actorItem);
 }
@@ -500,11 +522,16 @@ void MainWindow::addTransportItem(std::shared_ptr<Common::Hex> hex)
 {
     TransportItem* transportItem =
             new TransportItem((hex->getTransports().at(0)),
-                              _hexItems.at(hex->getCoordinates()));
+                              hexItemAt(hex->getCoordinates()));
     _transportItems[hex->getTransports().at(0)->getId()] = transportItem;
     _scene->addItem(transportItem);
 }
 
+HexItem* MainWindow::hexItemAt(const Common::CubeCoordinate &coord) const
+{
+    return _hexItems.at(Common::PackedCoordinate(coord));
+}
+
 void MainWindow::doTheVortex(const Common::CubeCoordinate &coord)
 {
     QPixmap vortexIcon(PathConstants::ACTOR_IMAGES.at("vortex"));
@@ -665,9 +692,146 @@ void MainWindow::finishGame(std::shared_ptr<Player> winner)
     if(topTen){
         updateRanking(winner,ranking);
     }
+    try {
+        _gameLog->save(PathConstants::GAME_LOG_FILE);
+    } catch (Common::IoException& e) {
+        QMessageBox logError;
+        logError.setText(QString::fromStdString(e.msg()));
+        logError.exec();
+    }
+
+    // The winning position is the last turn of the replay
+    recordTurn();
+    if (_replayWriter != nullptr) {
+        try {
+            _replayWriter->finish();
+        } catch (Common::IoException& e) {
+            _replayWriter.reset();
+            QMessageBox replayError;
+            replayError.setText(QString::fromStdString(e.msg()));
+            replayError.exec();
+        }
+    }
+    if (_replayWriter != nullptr &&
+            QMessageBox::question(this, "Replay",
+                                  "Watch the replay of the last round?")
+            == QMessageBox::Yes) {
+        _replayWriter.reset();
+        // Replace the scene only after the current event has been processed
+        QTimer::singleShot(0, this, [this] () { startReplay(); });
+        return;
+    }
+    _replayWriter.reset();
     qApp->quit();
 }
 
+void MainWindow::recordTurn()
+{
+    if (_replayWriter == nullptr) {
+        return;
+    }
+    try {
+        _replayWriter->addTurn(*_gameRunner->snapshot());
+    } catch (Common::GameException& e) {
+        _replayWriter.reset();
+        QMessageBox replayError;
+        replayError.setText(QString::fromStdString(e.msg()));
+        replayError.exec();
+    }
+}
+
+void MainWindow::startReplay()
+{
+    try {
+        _replayReader.reset(new Common::ReplayReader(PathConstants::REPLAY_FILE));
+    } catch (Common::GameException& e) {
+        QMessageBox replayError;
+        replayError.setText(QString::fromStdString(e.msg()));
+        replayError.exec();
+        qApp->quit();
+        return;
+    }
+
+    _gameInfoBox->hide();
+    _view->setInteractive(false);
+
+    _replaySlider = new QSlider(Qt::Horizontal);
+    _replaySlider->setRange(0, _replayReader->turnCount() - 1);
+    _replaySlider->setValue(_replaySlider->maximum());
+    connect(_replaySlider, &QSlider::valueChanged,
+            this, &MainWindow::showReplayTurn);
+    _layout->addWidget(_replaySlider, 10, 0, 1, 10);
+
+    showReplayTurn(_replaySlider->value());
+}
+
+void MainWindow::showReplayTurn(int turn)
+{
+    std::shared_ptr<const Common::GameSnapshot> snapshot;
+    try {
+        snapshot = _replayReader->snapshotAt(turn);
+    } catch (Common::FormatException& e) {
+        QMessageBox replayError;
+        replayError.setText(QString::fromStdString(e.msg()));
+        replayError.exec();
+        return;
+    }
+    if (snapshot == nullptr) {
+        return;
+    }
+
+    // The turn is forked onto a board of its own, with players of its own so
+    // that the scores of the game stay as they are
+    std::vector<std::shared_ptr<Common::IPlayer>> iPlayers;
+    for (const auto& player : snapshot->players) {
+        iPlayers.push_back(std::make_shared<Player>(player.id));
+    }
+    _gameBoard = std::shared_ptr<Student::GameBoardBase>(new Student::FlatGameBoard());
+    _gameState = std::shared_ptr<GameState>(new GameState(_playersAmount));
+    _gameRunner = Common::Initialization::forkGameRunner(
+                _gameBoard, _gameState, iPlayers, snapshot);
+
+    QGraphicsScene* oldScene = _scene;
+    _scene = new QGraphicsScene(this);
+    _hexItems.clear();
+    _pawnItems.clear();
+    _actorItems.clear();
+    _transportItems.clear();
+
+    drawGameBoard();
+    for (const auto& hex : _gameBoard->returnHexes()) {
+        for (const auto& pawn : hex.second->getPawns()) {
+            PawnItem* pawnItem = new PawnItem(
+                        _playerMap.at(pawn->getPlayerId())->getPawnColor(),
+                        pawn, hexItemAt(hex.first));
+            _pawnItems[pawn->getId()] = pawnItem;
+            _scene->addItem(pawnItem);
+        }
+        if (!hex.second->getActors().empty()) {
+            addActorItem(hex.second);
+        }
+        if (!hex.second->getTransports().empty()) {
+            addTransportItem(hex.second);
+            std::shared_ptr<Common::Transport> transport =
+                    hex.second->getTransports().at(0);
+            for (const auto& pawn : transport->getPawnsInTransport()) {
+                auto pawnItem = _pawnItems.find(pawn->getId());
+                if (pawnItem != _pawnItems.end()) {
+                    _transportItems.at(transport->getId())->addToTransport(
+                                pawnItem->second);
+                    pawnItem->second->hide();
+                }
+            }
+        }
+    }
+
+    _view->setScene(_scene);
+    delete oldScene;
+
+    setWindowTitle("Replay: turn " + QString::number(turn + 1) + " / " +
+                   QString::number(_replayReader->turnCount()));
+}
+
 void MainWindow::sortAndValidateRanking(
         std::vector<std::vector<std::string>> &ranking)
 {
@@ -6,6 +6,8 @@
 #include "igamerunner.hh"
 
 #include "gameboard.hh"
+#include "packedcoordinate.hh"
+#include "replay.hh"
 #include "hexitem.hh"
 #include "pawnitem.hh"
 #include "actoritem.hh"
@@ -15,8 +17,10 @@
 
 #include <QMainWindow>
 #include <QGraphicsView>
+#include <QSlider>
 #include <memory>
 #include <map>
+#include <unordered_map>
 
 #include "zoomgraphicsview.hh"
 
@@ -206,6 +210,13 @@ private:
     void addActorItem(std::shared_ptr<Common::Hex> hex);
     void addTransportItem(std::shared_ptr<Common::Hex> hex);
 
+    /**
+     * @brief hexItemAt - returns the HexItem of the given coordinate
+     * @param coord The coordinate of the HexItem, a valid cube coordinate.
+     * @exception std::out_of_range if there is no HexItem at coord.
+     */
+    HexItem* hexItemAt(const Common::CubeCoordinate &coord) const;
+
     /**
      * @brief addVortex - adds a vortex to the given coordinate
      * @param coord - CubeCoordinate represation of the coordinate
@@ -278,6 +289,27 @@ private:
      */
     void writeRanking(std::vector<std::vector<std::string>> ranking);
 
+    /**
+     * @brief recordTurn - adds the state of the game to the replay of the
+     * round. Recording stops if the replay can't be written.
+     */
+    void recordTurn();
+
+    /**
+     * @brief startReplay - opens the replay of the last round and replaces
+     * the game with a slider for scrubbing through its turns.
+     * @details The board can't be played while the replay is shown, closing
+     * the window quits.
+     */
+    void startReplay();
+
+    /**
+     * @brief showReplayTurn - draws the board as it was at the start of a
+     * turn of the replay.
+     * @param turn - number of the turn, from 0.
+     */
+    void showReplayTurn(int turn);
+
     /**
      * @brief _movesFromSpinner - tells the amount of moves a spinner has
      * given an actor in the spin.
@@ -287,7 +319,7 @@ private:
     /**
      * @brief _animalTypeFromSpinner - stores the animal that was spinned.
      */
-    std::string _animalTypeFromSpinner;
+    Common::TypeId _animalTypeFromSpinner;
 
     /**
      * @brief _spinned - tells if the player has spinned the disc this round.
@@ -303,7 +335,7 @@ private:
      * @brief Data structures for storing all the UI's Items
      */
     std::map<int, std::shared_ptr<Player>> _playerMap;
-    std::map<Common::CubeCoordinate, HexItem*> _hexItems;
+    std::unordered_map<Common::PackedCoordinate, HexItem*> _hexItems;
     std::map<int, PawnItem*> _pawnItems;
     std::map<int, ActorItem*> _actorItems;
     std::map<int, TransportItem*> _transportItems;
@@ -311,10 +343,22 @@ private:
     /**
      * @brief Pointers to all of the required GameEngine stuff
      */
-    std::shared_ptr<Student::GameBoard> _gameBoard;
+    std::shared_ptr<Student::GameBoardBase> _gameBoard;
     std::shared_ptr<GameState> _gameState;
     std::shared_ptr<Common::IGameRunner> _gameRunner;
 
+    /**
+     * @brief _gameLog records the current round, saved when the game ends
+     */
+    std::shared_ptr<Common::GameLog> _gameLog;
+
+    /**
+     * @brief _replayWriter records the state of every turn of the current
+     * round, _replayReader reads them back when the replay is shown
+     */
+    std::unique_ptr<Common::ReplayWriter> _replayWriter;
+    std::unique_ptr<Common::ReplayReader> _replayReader;
+
     /**
      * @brief Mainwindow's graphical components
      */
@@ -323,6 +367,7 @@ private:
     GameInfoBox* _gameInfoBox;
     QGridLayout* _layout;
     QWidget* _centralWidget;
+    QSlider* _replaySlider;
 };
 
 }